@@ -101,6 +101,23 @@ ESCARGOT_LDFLAGS_STATICLIB += -Wl,--gc-sections
 ESCARGOT_CXXFLAGS_LTO += -flto -ffat-lto-objects
 ESCARGOT_LDFLAGS_LTO += -flto
 
+#######################################################
+# flags for THREADING
+#######################################################
+ESCARGOT_CXXFLAGS_THREADING += -DESCARGOT_ENABLE_THREADING -pthread
+ESCARGOT_LDFLAGS_THREADING += -pthread
+
+#######################################################
+# flags for PARALLEL_MARKING
+#######################################################
+ESCARGOT_CXXFLAGS_PARALLEL_MARKING += -DESCARGOT_ENABLE_PARALLEL_MARKING -pthread
+ESCARGOT_LDFLAGS_PARALLEL_MARKING += -pthread
+
+#######################################################
+# flags for INCREMENTAL_GC
+#######################################################
+ESCARGOT_CXXFLAGS_INCREMENTAL_GC += -DESCARGOT_ENABLE_INCREMENTAL_GC
+
 #######################################################
 # flags for TEST
 #######################################################
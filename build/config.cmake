@@ -337,6 +337,38 @@ SET (ESCARGOT_LDFLAGS_LTO)
 SET (ESCARGOT_LDFLAGS_LTO "${ESCARGOT_LDFLAGS_LTO} -flto")
 
 
+#######################################################
+# FLAGS FOR THREADING
+#######################################################
+# THREADING CXXFLAGS
+SET (ESCARGOT_CXXFLAGS_THREADING)
+SET (ESCARGOT_CXXFLAGS_THREADING "${ESCARGOT_CXXFLAGS_THREADING} -DESCARGOT_ENABLE_THREADING -pthread")
+
+# THREADING LDFLAGS
+SET (ESCARGOT_LDFLAGS_THREADING)
+SET (ESCARGOT_LDFLAGS_THREADING "${ESCARGOT_LDFLAGS_THREADING} -pthread")
+
+
+#######################################################
+# FLAGS FOR PARALLEL MARKING
+#######################################################
+# PARALLEL_MARKING CXXFLAGS
+SET (ESCARGOT_CXXFLAGS_PARALLEL_MARKING)
+SET (ESCARGOT_CXXFLAGS_PARALLEL_MARKING "${ESCARGOT_CXXFLAGS_PARALLEL_MARKING} -DESCARGOT_ENABLE_PARALLEL_MARKING -pthread")
+
+# PARALLEL_MARKING LDFLAGS
+SET (ESCARGOT_LDFLAGS_PARALLEL_MARKING)
+SET (ESCARGOT_LDFLAGS_PARALLEL_MARKING "${ESCARGOT_LDFLAGS_PARALLEL_MARKING} -pthread")
+
+
+#######################################################
+# FLAGS FOR INCREMENTAL GC
+#######################################################
+# INCREMENTAL_GC CXXFLAGS
+SET (ESCARGOT_CXXFLAGS_INCREMENTAL_GC)
+SET (ESCARGOT_CXXFLAGS_INCREMENTAL_GC "${ESCARGOT_CXXFLAGS_INCREMENTAL_GC} -DESCARGOT_ENABLE_INCREMENTAL_GC")
+
+
 #######################################################
 # FLAGS FOR TEST
 #######################################################
@@ -74,6 +74,20 @@ IF ("${LTO}" EQUAL 1)
     ENDIF()
 ENDIF()
 
+IF ("${THREADING}" EQUAL 1)
+    SET (ESCARGOT_CXXFLAGS "${ESCARGOT_CXXFLAGS} ${ESCARGOT_CXXFLAGS_THREADING}")
+    SET (ESCARGOT_LDFLAGS "${ESCARGOT_LDFLAGS} ${ESCARGOT_LDFLAGS_THREADING}")
+ENDIF()
+
+IF ("${PARALLEL_MARKING}" EQUAL 1)
+    SET (ESCARGOT_CXXFLAGS "${ESCARGOT_CXXFLAGS} ${ESCARGOT_CXXFLAGS_PARALLEL_MARKING}")
+    SET (ESCARGOT_LDFLAGS "${ESCARGOT_LDFLAGS} ${ESCARGOT_LDFLAGS_PARALLEL_MARKING}")
+ENDIF()
+
+IF ("${INCREMENTAL_GC}" EQUAL 1)
+    SET (ESCARGOT_CXXFLAGS "${ESCARGOT_CXXFLAGS} ${ESCARGOT_CXXFLAGS_INCREMENTAL_GC}")
+ENDIF()
+
 IF ("${VENDORTEST}" EQUAL 1)
     SET (ESCARGOT_CXXFLAGS "${ESCARGOT_CXXFLAGS} ${ESCARGOT_CXXFLAGS_VENDORTEST}")
 ENDIF()
@@ -123,7 +137,15 @@ IF (${ESCARGOT_OUTPUT} STREQUAL "bin")
     SET (GC_CFLAGS "${GC_CFLAGS_COMMON} ${GC_CFLAGS_ARCH} ${GC_CFLAGS_MODE} $ENV{CFLAGS}")
     SET (GC_LDFLAGS "${GC_LDFLAGS_ARCH} ${GC_CFLAGS}")
     
-    SET (GC_CONFFLAGS_COMMON --enable-munmap --disable-parallel-mark --enable-large-config --disable-pthread --disable-threads)
+    SET (GC_CONFFLAGS_COMMON --enable-munmap --enable-large-config)
+    IF ("${PARALLEL_MARKING}" EQUAL 1)
+        # marker threads need thread support of GC
+        SET (GC_CONFFLAGS_COMMON ${GC_CONFFLAGS_COMMON} --enable-parallel-mark --enable-threads=posix)
+    ELSEIF ("${THREADING}" EQUAL 1)
+        SET (GC_CONFFLAGS_COMMON ${GC_CONFFLAGS_COMMON} --disable-parallel-mark --enable-threads=posix)
+    ELSE()
+        SET (GC_CONFFLAGS_COMMON ${GC_CONFFLAGS_COMMON} --disable-parallel-mark --disable-pthread --disable-threads)
+    ENDIF()
     IF (${ESCARGOT_MODE} STREQUAL "debug")
         SET (GC_CONFFLAGS_MODE --enable-debug --enable-gc-debug)
     ELSE()
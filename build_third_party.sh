@@ -38,9 +38,15 @@ fi
 CFLAGS_FROM_ENV=$(echo $CFLAGS)
 CXXFLAGS_FROM_ENV=$(echo $CXXFLAGS)
 
-GCCONFFLAGS_COMMON=" --enable-munmap --disable-parallel-mark --enable-large-config " # --enable-large-config --enable-cplusplus"
-if [[ $PORT == PANDO_EFL ]]; then
-    GCCONFFLAGS_COMMON+=" --disable-pthread --disable-threads "
+GCCONFFLAGS_COMMON=" --enable-munmap --enable-large-config " # --enable-large-config --enable-cplusplus"
+if [[ $PARALLEL_MARKING == 1 ]]; then
+    GCCONFFLAGS_COMMON+=" --enable-parallel-mark --enable-threads=posix "
+elif [[ $THREADING == 1 ]]; then
+    GCCONFFLAGS_COMMON+=" --disable-parallel-mark --enable-threads=posix "
+elif [[ $PORT == PANDO_EFL ]]; then
+    GCCONFFLAGS_COMMON+=" --disable-parallel-mark --disable-pthread --disable-threads "
+else
+    GCCONFFLAGS_COMMON+=" --disable-parallel-mark "
 fi
 CFLAGS_COMMON=" -g3 "
 CFLAGS_COMMON+=" -DESCARGOT "
@@ -323,6 +323,21 @@ typedef uint16_t ByteCodeRegisterIndex;
 #define STRING_SUB_STRING_MIN_VIEW_LENGTH 32
 #endif
 
+// substring is copied instead of being a view when source is longer than (length of substring * this)
+#ifndef STRING_SUB_STRING_MAX_RETENTION_RATIO
+#define STRING_SUB_STRING_MAX_RETENTION_RATIO 16
+#endif
+
+// entries of direct-mapped number to string cache of each VMInstance. rounded up to power of two
+#ifndef STRING_NUMBER_TO_STRING_CACHE_SIZE
+#define STRING_NUMBER_TO_STRING_CACHE_SIZE 256
+#endif
+
+// larger size given to VMInstance is clamped to this. should be power of two
+#ifndef STRING_NUMBER_TO_STRING_CACHE_MAX_SIZE
+#define STRING_NUMBER_TO_STRING_CACHE_MAX_SIZE (1 << 20)
+#endif
+
 #ifndef STRING_BUILDER_INLINE_STORAGE_MAX
 #define STRING_BUILDER_INLINE_STORAGE_MAX 24
 #endif
@@ -336,6 +351,17 @@ typedef uint16_t ByteCodeRegisterIndex;
 #define ROPE_STRING_MIN_LENGTH 24
 #endif
 
+// charAt and substring of unflattened rope string look for a leaf within this depth before flattening it
+#ifndef ROPE_STRING_MAX_SEARCH_DEPTH
+#define ROPE_STRING_MAX_SEARCH_DEPTH 16
+#endif
+
+// appending to rope string moves it into growable append buffer when left spine of the rope has this many ropes,
+// that is, after the rope is appended repeatedly like s += x
+#ifndef ROPE_STRING_APPEND_BUFFER_MIN_DEPTH
+#define ROPE_STRING_APPEND_BUFFER_MIN_DEPTH 4
+#endif
+
 #include "heap/Heap.h"
 #include "CheckedArithmetic.h"
 #include "runtime/String.h"
@@ -41,6 +41,7 @@
 #include "runtime/NumberObject.h"
 #include "runtime/BooleanObject.h"
 #include "runtime/RegExpObject.h"
+#include "runtime/HeapSnapshot.h"
 #ifdef ESCARGOT_ENABLE_PROMISE
 #include "runtime/Job.h"
 #include "runtime/JobQueue.h"
@@ -94,6 +95,10 @@ DEFINE_CAST(Job);
 #endif
 DEFINE_CAST(Script);
 DEFINE_CAST(ScriptParser);
+DEFINE_CAST(HeapSnapshot);
+#ifdef ESCARGOT_ENABLE_THREADING
+DEFINE_CAST(BackgroundParseTask);
+#endif
 
 #if ESCARGOT_ENABLE_TYPEDARRAY
 DEFINE_CAST(ArrayBufferObject);
@@ -142,9 +147,9 @@ inline AtomicString toImpl(AtomicStringRef* v)
     return AtomicString::fromPayload(reinterpret_cast<void*>(v));
 }
 
-void Globals::initialize(bool applyMallOpt, bool applyGcOpt)
+void Globals::initialize(bool applyMallOpt, bool applyGcOpt, size_t gcMarkerThreadCount)
 {
-    Heap::initialize(applyMallOpt, applyGcOpt);
+    Heap::initialize(applyMallOpt, applyGcOpt, gcMarkerThreadCount);
 }
 
 void Globals::finalize()
@@ -464,6 +469,104 @@ SymbolRef* VMInstanceRef::unscopablesSymbol()
     return toRef(toImpl(this)->globalSymbols().unscopables);
 }
 
+void VMInstanceRef::setGCIncrementTimeLimit(unsigned long ms)
+{
+    Heap::setIncrementTimeLimit(ms);
+}
+
+unsigned long VMInstanceRef::gcIncrementTimeLimit()
+{
+    return Heap::incrementTimeLimit();
+}
+
+VMInstanceRef::HeapStatistics VMInstanceRef::heapStatistics()
+{
+    Heap::Statistics s = Heap::statistics();
+    HeapStatistics result;
+    result.heapSize = s.m_heapSize;
+    result.freeBytes = s.m_freeBytes;
+    result.unmappedBytes = s.m_unmappedBytes;
+    result.bytesAllocatedSinceLastGC = s.m_bytesAllocatedSinceLastGC;
+    result.totalBytesAllocated = s.m_totalBytesAllocated;
+    result.gcCount = s.m_gcCount;
+    return result;
+}
+
+void VMInstanceRef::startAllocationProfiling(size_t samplingInterval)
+{
+    AllocationProfiler::start(samplingInterval);
+}
+
+void VMInstanceRef::stopAllocationProfiling()
+{
+    AllocationProfiler::stop();
+}
+
+std::string VMInstanceRef::allocationProfileReport()
+{
+    return AllocationProfiler::report(toImpl(this));
+}
+
+void VMInstanceRef::setSubStringViewRetentionRatio(size_t ratio)
+{
+    toImpl(this)->setSubStringViewRetentionRatio(ratio);
+}
+
+size_t VMInstanceRef::subStringViewRetentionRatio()
+{
+    return toImpl(this)->subStringViewRetentionRatio();
+}
+
+VMInstanceRef::SubStringViewStatistics VMInstanceRef::subStringViewStatistics()
+{
+    const StringView::Statistics& s = toImpl(this)->subStringViewStatistics();
+    SubStringViewStatistics result;
+    result.viewCount = s.m_viewCount;
+    result.viewBytes = s.m_viewBytes;
+    result.viewedSourceBytes = s.m_viewedSourceBytes;
+    result.copiedCount = s.m_copiedCount;
+    result.copiedBytes = s.m_copiedBytes;
+    return result;
+}
+
+VMInstanceRef::ObjectStructureStatistics VMInstanceRef::objectStructureStatistics()
+{
+    ObjectStructureStatistics result;
+#ifndef NDEBUG
+    const ObjectStructure::Statistics& s = ObjectStructure::statistics();
+    result.structureCount = s.m_structureCount;
+    result.transitionCount = s.m_transitionCount;
+    result.vectorTableCount = s.m_vectorTableCount;
+    result.hashMapTableCount = s.m_hashMapTableCount;
+    result.maxTransitionFanOut = s.m_maxTransitionFanOut;
+    result.transitionLookupCount = s.m_transitionLookupCount;
+    result.transitionLookupDepth = s.m_transitionLookupDepth;
+#else
+    memset(&result, 0, sizeof(ObjectStructureStatistics));
+#endif
+    return result;
+}
+
+void VMInstanceRef::setNumberToStringCacheSize(size_t size)
+{
+    toImpl(this)->setNumberToStringCacheSize(size);
+}
+
+size_t VMInstanceRef::numberToStringCacheSize()
+{
+    return toImpl(this)->numberToStringCacheSize();
+}
+
+void VMInstanceRef::setKeepsSourceLocationTable(bool keeps)
+{
+    toImpl(this)->setKeepsSourceLocationTable(keeps);
+}
+
+bool VMInstanceRef::keepsSourceLocationTable()
+{
+    return toImpl(this)->keepsSourceLocationTable();
+}
+
 #ifdef ESCARGOT_ENABLE_PROMISE
 ValueRef* VMInstanceRef::drainJobQueue()
 {
@@ -492,16 +595,7 @@ void ContextRef::clearRelatedQueuedPromiseJobs()
 {
     Context* imp = toImpl(this);
 #ifdef ESCARGOT_ENABLE_PROMISE
-    DefaultJobQueue* jobQueue = DefaultJobQueue::get(imp->vmInstance()->jobQueue());
-    std::list<Job*, gc_allocator<Job*>>& impl = jobQueue->impl();
-    auto iter = impl.begin();
-    while (iter != impl.end()) {
-        if ((*iter)->relatedContext() == imp) {
-            iter = impl.erase(iter);
-        } else {
-            iter++;
-        }
-    }
+    DefaultJobQueue::get(imp->vmInstance()->jobQueue())->removeJobsRelatedWith(imp);
 #endif
 }
 
@@ -1382,6 +1476,55 @@ void ContextRef::setSecurityPolicyCheckCallback(SecurityPolicyCheckCallback cb)
     });
 }
 
+HeapSnapshotRef* HeapSnapshotRef::take(ContextRef* context)
+{
+    return toRef(new HeapSnapshot(toImpl(context)));
+}
+
+void HeapSnapshotRef::destroy()
+{
+    HeapSnapshot* imp = toImpl(this);
+    delete imp;
+}
+
+size_t HeapSnapshotRef::nodeCount()
+{
+    return toImpl(this)->nodeCount();
+}
+
+size_t HeapSnapshotRef::edgeCount()
+{
+    return toImpl(this)->edgeCount();
+}
+
+size_t HeapSnapshotRef::selfSize(ValueRef* value)
+{
+    Value v = toImpl(value);
+    if (!v.isPointerValue()) {
+        return 0;
+    }
+    return toImpl(this)->selfSize(v.asPointerValue());
+}
+
+size_t HeapSnapshotRef::retainedSize(ValueRef* value)
+{
+    Value v = toImpl(value);
+    if (!v.isPointerValue()) {
+        return 0;
+    }
+    return toImpl(this)->retainedSize(v.asPointerValue());
+}
+
+bool HeapSnapshotRef::writeToFile(const char* fileName)
+{
+    FILE* fp = fopen(fileName, "w");
+    if (!fp) {
+        return false;
+    }
+    bool result = toImpl(this)->write(fp);
+    return fclose(fp) == 0 && result;
+}
+
 ExecutionStateRef* ExecutionStateRef::create(ContextRef* ctxref)
 {
     Context* ctx = toImpl(ctxref);
@@ -1939,6 +2082,27 @@ ScriptParserRef::ScriptParserResult ScriptParserRef::parse(StringRef* script, St
     return ScriptParserRef::ScriptParserResult(toRef(result.m_script), StringRef::emptyString());
 }
 
+#ifdef ESCARGOT_ENABLE_THREADING
+BackgroundParseTaskRef* ScriptParserRef::createBackgroundParseTask(StringRef* script, StringRef* fileName)
+{
+    return toRef(toImpl(this)->createBackgroundParseTask(toImpl(script), toImpl(fileName)));
+}
+
+ScriptParserRef::ScriptParserResult ScriptParserRef::finalizeBackgroundParseTask(BackgroundParseTaskRef* task)
+{
+    auto result = toImpl(this)->finalizeBackgroundParseTask(toImpl(task));
+    if (result.m_error) {
+        return ScriptParserRef::ScriptParserResult(nullptr, toRef(result.m_error->message));
+    }
+    return ScriptParserRef::ScriptParserResult(toRef(result.m_script), StringRef::emptyString());
+}
+
+void BackgroundParseTaskRef::run()
+{
+    toImpl(this)->run();
+}
+#endif
+
 ValueRef* ScriptRef::execute(ExecutionStateRef* state)
 {
     return toRef(toImpl(this)->execute(*toImpl(state)));
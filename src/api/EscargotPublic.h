@@ -68,13 +68,18 @@ class BooleanObjectRef;
 class RegExpObjectRef;
 class ScriptRef;
 class ScriptParserRef;
+#ifdef ESCARGOT_ENABLE_THREADING
+class BackgroundParseTaskRef;
+#endif
 class ExecutionStateRef;
 class ValueVectorRef;
 class JobRef;
+class HeapSnapshotRef;
 
 class EXPORT Globals {
 public:
-    static void initialize(bool applyMallOpt = false, bool applyGcOpt = false);
+    // gcMarkerThreadCount is effective only when escargot is built with PARALLEL_MARKING=1 (0 = number of processors)
+    static void initialize(bool applyMallOpt = false, bool applyGcOpt = false, size_t gcMarkerThreadCount = 0);
     static void finalize();
 };
 
@@ -205,6 +210,69 @@ public:
     SymbolRef* iteratorSymbol();
     SymbolRef* unscopablesSymbol();
 
+    // maximum pause of each GC step in milliseconds when escargot is built with INCREMENTAL_GC=1
+    // GC is shared by every VMInstance, so this changes limit of whole process
+    void setGCIncrementTimeLimit(unsigned long ms);
+    unsigned long gcIncrementTimeLimit();
+
+    struct HeapStatistics {
+        size_t heapSize; // including free and unmapped area
+        size_t freeBytes;
+        size_t unmappedBytes;
+        size_t bytesAllocatedSinceLastGC;
+        size_t totalBytesAllocated;
+        size_t gcCount;
+    };
+    HeapStatistics heapStatistics();
+
+    // allocation profiler counts allocations of runtime types (objects, strings, bytecode, ...)
+    // if samplingInterval is not zero, about one allocation per samplingInterval bytes is attributed to JS source location
+    // profiler is shared by every VMInstance like GC
+    void startAllocationProfiling(size_t samplingInterval = 0);
+    void stopAllocationProfiling();
+    std::string allocationProfileReport();
+
+    // substring, trim and regexp match results can be views which keep whole source string alive.
+    // view is made only when source is not longer than (length of result * ratio), otherwise result is copied.
+    // 0 means views are always made
+    void setSubStringViewRetentionRatio(size_t ratio);
+    size_t subStringViewRetentionRatio();
+
+    // accumulated since VMInstance was created. nothing is subtracted when views are collected
+    struct SubStringViewStatistics {
+        size_t viewCount;
+        size_t viewBytes;
+        size_t viewedSourceBytes; // sum of source string sizes when each view was made, so a source shared by views is counted for each
+        size_t copiedCount; // results copied instead of being a view due to retention ratio
+        size_t copiedBytes;
+    };
+    SubStringViewStatistics subStringViewStatistics();
+
+    // hidden classes of objects and transitions between them. accumulated since process started
+    // counted only in debug build, all zero in release build
+    struct ObjectStructureStatistics {
+        size_t structureCount;
+        size_t transitionCount;
+        size_t vectorTableCount; // transition tables grown over one transition
+        size_t hashMapTableCount; // transition tables moved into hash map
+        size_t maxTransitionFanOut;
+        size_t transitionLookupCount;
+        size_t transitionLookupDepth; // sum of entries compared by lookups
+    };
+    ObjectStructureStatistics objectStructureStatistics();
+
+    // number to string conversion results are kept in direct-mapped cache of this size (rounded up to power of two).
+    // size over STRING_NUMBER_TO_STRING_CACHE_MAX_SIZE is clamped to it.
+    // 0 disables cache. cache is shared by every context of VMInstance
+    void setNumberToStringCacheSize(size_t size);
+    size_t numberToStringCacheSize();
+
+    // source locations of stack trace are found by parsing function again when error is made first time in it.
+    // if this is true, compact table of source locations is made with bytecode instead,
+    // which costs a few bytes per bytecode and removes reparsing from first throw.
+    void setKeepsSourceLocationTable(bool keeps);
+    bool keepsSourceLocationTable();
+
 #ifdef ESCARGOT_ENABLE_PROMISE
     // if there is an error, executing will be stopped and returns ErrorValue
     // if thres is no job or no error, returns EmptyValue
@@ -237,6 +305,23 @@ public:
     void setSecurityPolicyCheckCallback(SecurityPolicyCheckCallback cb);
 };
 
+// snapshot of objects reachable from global object of context and persistent handles of its VMInstance.
+// snapshot should be taken while no script is running, since values on stack are not walked
+class EXPORT HeapSnapshotRef {
+public:
+    static HeapSnapshotRef* take(ContextRef* context);
+    void destroy();
+
+    size_t nodeCount();
+    size_t edgeCount();
+    // returns 0 if value is not a heap object in this snapshot
+    size_t selfSize(ValueRef* value);
+    size_t retainedSize(ValueRef* value);
+
+    // writes .heapsnapshot file which can be loaded in Chrome devtools
+    bool writeToFile(const char* fileName);
+};
+
 class EXPORT AtomicStringRef {
 public:
     static AtomicStringRef* create(ContextRef* c, const char* src); // from ASCII string
@@ -865,8 +950,25 @@ public:
     };
 
     ScriptParserResult parse(StringRef* script, StringRef* fileName);
+
+#ifdef ESCARGOT_ENABLE_THREADING
+    // parse script on another thread. bytecode is generated when the script is executed
+    // create and finalize task on the thread which owns the context.
+    // BackgroundParseTaskRef::run can be called on any thread between them
+    // finalizeBackgroundParseTask releases the task
+    BackgroundParseTaskRef* createBackgroundParseTask(StringRef* script, StringRef* fileName);
+    ScriptParserResult finalizeBackgroundParseTask(BackgroundParseTaskRef* task);
+#endif
 };
 
+#ifdef ESCARGOT_ENABLE_THREADING
+class EXPORT BackgroundParseTaskRef {
+public:
+    // calling thread is registered to GC while running if it is not registered yet
+    void run();
+};
+#endif
+
 class EXPORT ScriptRef {
 public:
     ValueRef* execute(ExecutionStateRef* state);
@@ -0,0 +1,255 @@
+/*
+ * Copyright (c) 2018-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#include "Escargot.h"
+#include "AllocationProfiler.h"
+#include "interpreter/ByteCode.h"
+#include "parser/CodeBlock.h"
+#include "parser/Script.h"
+#include "runtime/StringView.h"
+#include "runtime/VMInstance.h"
+#include "runtime/ObjectStructure.h"
+#if defined(ESCARGOT_ENABLE_THREADING)
+#include <atomic>
+#include <mutex>
+#endif
+
+namespace Escargot {
+
+#if defined(ESCARGOT_ENABLE_THREADING)
+// background parsing threads allocate code blocks too
+typedef std::atomic<size_t> AllocationCounter;
+static std::mutex g_allocationSampleMutex;
+#define LOCK_ALLOCATION_SAMPLES() std::lock_guard<std::mutex> allocationSampleLock(g_allocationSampleMutex)
+#else
+typedef size_t AllocationCounter;
+#define LOCK_ALLOCATION_SAMPLES()
+#endif
+
+bool AllocationProfiler::s_isEnabled;
+size_t AllocationProfiler::s_samplingInterval;
+
+static AllocationCounter g_allocationCount[AllocationProfiler::NumberOfType];
+static AllocationCounter g_allocatedBytes[AllocationProfiler::NumberOfType];
+static AllocationCounter g_bytesSinceLastSample;
+
+// site is set only by interpreter, so it is shared by threads.
+// these are stored in data segment which GC scans, so code block of site is kept alive
+static InterpretedCodeBlock* g_currentSiteCodeBlock;
+static size_t g_currentSitePosition;
+
+struct AllocationSiteCount {
+    size_t m_count;
+    size_t m_bytes;
+};
+typedef std::pair<InterpretedCodeBlock*, size_t> AllocationSite;
+typedef std::map<AllocationSite, AllocationSiteCount, std::less<AllocationSite>, gc_allocator<std::pair<const AllocationSite, AllocationSiteCount>>> AllocationSiteMap;
+static AllocationSiteMap* g_allocationSites;
+static size_t g_samplingIntervalOfSites;
+
+static const char* g_allocationTypeNames[AllocationProfiler::NumberOfType] = {
+#define DECLARE_ALLOCATION_TYPE_NAME(name) #name,
+    FOR_EACH_PROFILED_ALLOCATION_TYPE(DECLARE_ALLOCATION_TYPE_NAME)
+#undef DECLARE_ALLOCATION_TYPE_NAME
+};
+
+void AllocationProfiler::start(size_t samplingInterval)
+{
+    LOCK_ALLOCATION_SAMPLES();
+    for (size_t i = 0; i < NumberOfType; i++) {
+        g_allocationCount[i] = 0;
+        g_allocatedBytes[i] = 0;
+    }
+    g_bytesSinceLastSample = 0;
+    g_currentSiteCodeBlock = nullptr;
+    g_currentSitePosition = SIZE_MAX;
+    if (!g_allocationSites) {
+        g_allocationSites = new (GC) AllocationSiteMap();
+    }
+    g_allocationSites->clear();
+    g_samplingIntervalOfSites = samplingInterval;
+
+    s_samplingInterval = samplingInterval;
+    s_isEnabled = true;
+}
+
+void AllocationProfiler::stop()
+{
+    s_isEnabled = false;
+    s_samplingInterval = 0;
+    // current site should not keep its code block alive after profiling
+    g_currentSiteCodeBlock = nullptr;
+}
+
+void AllocationProfiler::recordAllocation(Type type, size_t size)
+{
+    ASSERT(type < NumberOfType);
+    g_allocationCount[type] += 1;
+    g_allocatedBytes[type] += size;
+
+    if (s_samplingInterval) {
+        g_bytesSinceLastSample += size;
+        if (UNLIKELY(g_bytesSinceLastSample >= s_samplingInterval)) {
+            recordSample();
+        }
+    }
+}
+
+void AllocationProfiler::setCurrentSite(ByteCodeBlock* byteCodeBlock, size_t byteCodePosition)
+{
+    g_currentSiteCodeBlock = byteCodeBlock->m_codeBlock;
+    g_currentSitePosition = byteCodePosition;
+}
+
+void AllocationProfiler::recordSample()
+{
+    LOCK_ALLOCATION_SAMPLES();
+    if (!s_samplingInterval || g_bytesSinceLastSample < s_samplingInterval) {
+        // other thread took this sample
+        return;
+    }
+    // each sample represents allocations of whole interval
+    size_t bytes = g_bytesSinceLastSample;
+    g_bytesSinceLastSample = 0;
+
+    // allocations from native code before any JS code runs have no site
+    AllocationSiteCount& c = (*g_allocationSites)[AllocationSite(g_currentSiteCodeBlock, g_currentSitePosition)];
+    c.m_count++;
+    c.m_bytes += bytes;
+}
+
+const char* AllocationProfiler::typeName(Type type)
+{
+    ASSERT(type < NumberOfType);
+    return g_allocationTypeNames[type];
+}
+
+size_t AllocationProfiler::allocationCount(Type type)
+{
+    ASSERT(type < NumberOfType);
+    return g_allocationCount[type];
+}
+
+size_t AllocationProfiler::allocatedBytes(Type type)
+{
+    ASSERT(type < NumberOfType);
+    return g_allocatedBytes[type];
+}
+
+static void appendAllocationSite(std::string& out, const AllocationSite& site)
+{
+    InterpretedCodeBlock* codeBlock = site.first;
+    if (!codeBlock) {
+        out += "(native)";
+        return;
+    }
+
+    AtomicString name = codeBlock->functionName();
+    out += name.string()->length() ? name.string()->toNonGCUTF8StringData().data() : "(anonymous)";
+    out += " ";
+    out += codeBlock->script()->fileName()->toNonGCUTF8StringData().data();
+
+    char buf[64];
+    if (codeBlock->byteCodeBlock()) {
+        ExtendedNodeLOC loc = codeBlock->byteCodeBlock()->computeNodeLOCFromByteCode(codeBlock->context(), site.second, codeBlock);
+        if (loc.index != SIZE_MAX) {
+            snprintf(buf, sizeof(buf), ":%zu:%zu", loc.line, loc.column);
+            out += buf;
+            return;
+        }
+    }
+    // bytecode was released after sampling
+    snprintf(buf, sizeof(buf), " @%zu", site.second);
+    out += buf;
+}
+
+std::string AllocationProfiler::report(VMInstance* instance)
+{
+    std::string out;
+    char buf[256];
+
+    Heap::Statistics heap = Heap::statistics();
+    snprintf(buf, sizeof(buf), "Heap: %zu bytes (free %zu, unmapped %zu), allocated %zu bytes since last GC, %zu bytes in total, %zu GCs\n",
+             heap.m_heapSize, heap.m_freeBytes, heap.m_unmappedBytes, heap.m_bytesAllocatedSinceLastGC, heap.m_totalBytesAllocated, heap.m_gcCount);
+    out += buf;
+
+    const StringView::Statistics& views = instance->subStringViewStatistics();
+    snprintf(buf, sizeof(buf), "Substring views: %zu views (%zu bytes) onto sources of %zu bytes, %zu copied (%zu bytes) by retention ratio %zu\n",
+             views.m_viewCount, views.m_viewBytes, views.m_viewedSourceBytes, views.m_copiedCount, views.m_copiedBytes, instance->subStringViewRetentionRatio());
+    out += buf;
+
+#ifndef NDEBUG
+    const ObjectStructure::Statistics& structures = ObjectStructure::statistics();
+    snprintf(buf, sizeof(buf), "Object structures: %zu structures, %zu transitions (%zu vector tables, %zu hash map tables, max fan-out %zu), %zu lookups (%zu entries compared)\n",
+             structures.m_structureCount, structures.m_transitionCount, structures.m_vectorTableCount, structures.m_hashMapTableCount,
+             structures.m_maxTransitionFanOut, structures.m_transitionLookupCount, structures.m_transitionLookupDepth);
+    out += buf;
+#endif
+
+    std::vector<size_t> types;
+    size_t totalCount = 0;
+    size_t totalBytes = 0;
+    for (size_t i = 0; i < NumberOfType; i++) {
+        if (g_allocationCount[i]) {
+            types.push_back(i);
+            totalCount += g_allocationCount[i];
+            totalBytes += g_allocatedBytes[i];
+        }
+    }
+    std::sort(types.begin(), types.end(), [](size_t a, size_t b) -> bool {
+        return g_allocatedBytes[a] > g_allocatedBytes[b];
+    });
+
+    snprintf(buf, sizeof(buf), "Allocations by type: %zu allocations, %zu bytes\n", totalCount, totalBytes);
+    out += buf;
+    for (size_t i = 0; i < types.size(); i++) {
+        size_t t = types[i];
+        size_t bytes = g_allocatedBytes[t];
+        snprintf(buf, sizeof(buf), "  %-24s %12zu %14zu %6.2f%%\n", g_allocationTypeNames[t], (size_t)g_allocationCount[t], bytes,
+                 totalBytes ? bytes * 100.0 / totalBytes : 0.0);
+        out += buf;
+    }
+
+    // copy sites into GC heap since computing location of site allocates and can take a sample
+    std::vector<std::pair<AllocationSite, AllocationSiteCount>, gc_allocator<std::pair<AllocationSite, AllocationSiteCount>>> sites;
+    {
+        LOCK_ALLOCATION_SAMPLES();
+        if (g_allocationSites) {
+            sites.assign(g_allocationSites->begin(), g_allocationSites->end());
+        }
+    }
+
+    if (sites.size()) {
+        std::sort(sites.begin(), sites.end(), [](const std::pair<AllocationSite, AllocationSiteCount>& a, const std::pair<AllocationSite, AllocationSiteCount>& b) -> bool {
+            return a.second.m_bytes > b.second.m_bytes;
+        });
+
+        snprintf(buf, sizeof(buf), "Allocation sites (sampled every %zu bytes):\n", g_samplingIntervalOfSites);
+        out += buf;
+        for (size_t i = 0; i < sites.size(); i++) {
+            snprintf(buf, sizeof(buf), "  %14zu %8zu  ", sites[i].second.m_bytes, sites[i].second.m_count);
+            out += buf;
+            appendAllocationSite(out, sites[i].first);
+            out += "\n";
+        }
+    }
+
+    return out;
+}
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2018-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#ifndef __EscargotAllocationProfiler__
+#define __EscargotAllocationProfiler__
+
+namespace Escargot {
+
+class ByteCodeBlock;
+class VMInstance;
+
+// Object means plain objects and every subclass of Object which has no operator new of its own
+#define FOR_EACH_PROFILED_ALLOCATION_TYPE(F) \
+    F(Object)                                \
+    F(ObjectRareData)                        \
+    F(ArrayObject)                           \
+    F(FunctionObject)                        \
+    F(ArgumentsObject)                       \
+    F(ErrorObject)                           \
+    F(BooleanObject)                         \
+    F(NumberObject)                          \
+    F(StringObject)                          \
+    F(SymbolObject)                          \
+    F(DateObject)                            \
+    F(RegExpObject)                          \
+    F(MapObject)                             \
+    F(SetObject)                             \
+    F(WeakMapObject)                         \
+    F(WeakSetObject)                         \
+    F(PromiseObject)                         \
+    F(ProxyObject)                           \
+    F(ArrayBufferObject)                     \
+    F(TypedArrayObject)                      \
+    F(IteratorObject)                        \
+    F(ASCIIString)                           \
+    F(Latin1String)                          \
+    F(UTF16String)                           \
+    F(RopeString)                            \
+    F(StringView)                            \
+    F(ObjectStructure)                       \
+    F(CodeBlock)                             \
+    F(InterpretedCodeBlock)                  \
+    F(ByteCodeBlock)                         \
+    F(InlineCache)                           \
+    F(EnvironmentRecord)                     \
+    F(ExecutionContext)
+
+// Counts allocations of runtime types by number and bytes.
+// Counting is done in operator new of each type, so it costs only one branch while profiler is stopped.
+// With sampling interval, about one allocation per interval bytes is attributed to the JS function
+// and bytecode position which was executing the nearest allocating or call instruction.
+// Profiler is process-wide like GC heap
+class AllocationProfiler {
+public:
+    enum Type {
+#define DECLARE_ALLOCATION_TYPE(name) name##Type,
+        FOR_EACH_PROFILED_ALLOCATION_TYPE(DECLARE_ALLOCATION_TYPE)
+#undef DECLARE_ALLOCATION_TYPE
+            NumberOfType,
+    };
+
+    static bool isEnabled()
+    {
+        return s_isEnabled;
+    }
+
+    static bool isSampling()
+    {
+        return s_samplingInterval != 0;
+    }
+
+    // starting profiler again clears previous result
+    static void start(size_t samplingInterval = 0);
+    static void stop();
+
+    static void recordAllocation(Type type, size_t size);
+    static void setCurrentSite(ByteCodeBlock* byteCodeBlock, size_t byteCodePosition);
+
+    static const char* typeName(Type type);
+    static size_t allocationCount(Type type);
+    static size_t allocatedBytes(Type type);
+
+    // human readable report of heap statistics, counts of each type and sampled allocation sites.
+    // substring view statistics are taken from instance
+    // NOTE computing location of sites can re-generate bytecode of function
+    static std::string report(VMInstance* instance);
+
+private:
+    static void recordSample();
+
+    static bool s_isEnabled;
+    static size_t s_samplingInterval;
+};
+}
+
+// should be used inside namespace Escargot
+#define ESCARGOT_PROFILE_ALLOCATION(type, size)                                         \
+    do {                                                                                \
+        if (UNLIKELY(AllocationProfiler::isEnabled())) {                                \
+            AllocationProfiler::recordAllocation(AllocationProfiler::type##Type, size); \
+        }                                                                               \
+    } while (0)
+
+#endif
@@ -29,6 +29,10 @@ namespace Escargot {
 
 static int s_gcKinds[HeapObjectKind::NumberOfKind];
 
+// With parallel marking, mark procedures below can run on several marker threads at once.
+// Marking happens while the world is stopped, so objects do not change under them.
+// They keep their state on the stack and only push into the mark stack they are given,
+// so they need no lock. Keep it that way: do not touch shared state or allocate in them.
 template <GC_get_next_pointer_proc proc>
 GC_ms_entry* markAndPushCustomIterable(GC_word* addr,
                                        struct GC_ms_entry* mark_stack_ptr,
@@ -64,15 +68,15 @@ int getValidValueInArrayObject(void* ptr, GC_mark_custom_result* arr)
 
 GC_word* getNextValidInValueVector(GC_word* ptr, GC_word** next_ptr)
 {
-    Value* current = (Value*)ptr;
+    const Value current = *((Value*)ptr);
 #ifdef ESCARGOT_32
     *next_ptr = ptr + 2;
 #else
     *next_ptr = ptr + 1;
 #endif
     GC_word* ret = NULL;
-    if (*current && current->isPointerValue()) {
-        ret = (GC_word*)current->asPointerValue();
+    if (current && current.isPointerValue()) {
+        ret = (GC_word*)current.asPointerValue();
     }
     return ret;
 }
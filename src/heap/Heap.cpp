@@ -21,19 +21,65 @@
 
 #include "Heap.h"
 #include "LeakChecker.h"
+#include "util/Util.h"
 
 #include <malloc.h>
+#if defined(ESCARGOT_ENABLE_THREADING)
+#include <thread>
+#endif
 
 namespace Escargot {
 
 static bool g_isInited = false;
 
-void Heap::initialize(bool applyMallOpt, bool applyGcOpt)
+#ifndef PROFILE_MASSIF
+// collected only when DUMP_GC_PAUSE_TIME is set
+#define GC_PAUSE_TIME_HISTOGRAM_SIZE 8
+struct GCPauseTimeStatistics {
+    size_t m_count;
+    size_t m_depth;
+    uint64_t m_start;
+    uint64_t m_total;
+    uint64_t m_max;
+    // [0] < 1ms, [1] < 2ms, [2] < 4ms ... [7] >= 64ms
+    size_t m_histogram[GC_PAUSE_TIME_HISTOGRAM_SIZE];
+
+    void record(uint64_t elapsed)
+    {
+        m_count++;
+        m_total += elapsed;
+        m_max = std::max(m_max, elapsed);
+        size_t bucket = 0;
+        uint64_t limit = 1000;
+        while (bucket < GC_PAUSE_TIME_HISTOGRAM_SIZE - 1 && elapsed >= limit) {
+            bucket++;
+            limit *= 2;
+        }
+        m_histogram[bucket]++;
+    }
+};
+static GCPauseTimeStatistics* g_gcPauseTimeStatistics;
+#endif
+#if defined(ESCARGOT_ENABLE_THREADING)
+static std::thread::id g_mainThreadID;
+#endif
+
+void Heap::initialize(bool applyMallOpt, bool applyGcOpt, size_t gcMarkerThreadCount)
 {
     if (g_isInited)
         return;
 
     g_isInited = true;
+
+#if defined(ESCARGOT_ENABLE_PARALLEL_MARKING)
+    // GC reads number of marker threads only while initializing itself
+    if (gcMarkerThreadCount) {
+        char buf[32];
+        snprintf(buf, sizeof(buf), "%zu", gcMarkerThreadCount);
+        setenv("GC_MARKERS", buf, 1);
+    }
+    GC_INIT();
+#endif
     if (applyMallOpt) {
 #ifdef M_MMAP_THRESHOLD
         mallopt(M_MMAP_THRESHOLD, 2048);
@@ -47,20 +93,108 @@ void Heap::initialize(bool applyMallOpt, bool applyGcOpt)
         GC_set_free_space_divisor(24);
     }
     GC_set_force_unmap_on_gcollect(1);
+
+#if defined(ESCARGOT_ENABLE_THREADING)
+    // other threads (e.g. background parsing) register itself before using GC heap
+    GC_allow_register_threads();
+    // finalizers of runtime objects are not thread-safe.
+    // they should run only on the thread which initialized heap
+    g_mainThreadID = std::this_thread::get_id();
+    GC_set_finalize_on_demand(1);
+    GC_set_finalizer_notifier([]() {
+        if (std::this_thread::get_id() == g_mainThreadID) {
+            GC_invoke_finalizers();
+        }
+    });
+#endif
     // GC_set_full_freq(1);
     // GC_set_time_limit(GC_TIME_UNLIMITED);
 
+#if defined(ESCARGOT_ENABLE_INCREMENTAL_GC)
+    // collect young objects (allocated or modified after last collection) with small steps
+    // and do full collection only periodically.
+    // pointers are stored into heap without write barrier, so only dirty bits from OS (mprotect, soft-dirty)
+    // can find every modified object. GC must not fall back to manual dirty tracking,
+    // and it stays non-incremental if OS does not provide dirty bits
+#if GC_VERSION_MAJOR > 8 || (GC_VERSION_MAJOR == 8 && GC_VERSION_MINOR >= 2)
+    GC_set_manual_vdb_allowed(0);
+#else
+#error "INCREMENTAL_GC needs bdwgc 8.2 or later. older versions may fall back to manual dirty tracking"
+#endif
+    GC_set_time_limit(ESCARGOT_GC_INCREMENT_TIME_LIMIT);
+    GC_enable_incremental();
+#endif
+
     initializeCustomAllocators();
 
+#ifndef PROFILE_MASSIF
+    if (getenv("DUMP_GC_PAUSE_TIME")) {
+        g_gcPauseTimeStatistics = new GCPauseTimeStatistics();
+        memset(g_gcPauseTimeStatistics, 0, sizeof(GCPauseTimeStatistics));
+        // a pause is a full collection (START-END) or a stop-the-world step of incremental collection (PRE_STOP_WORLD-POST_START_WORLD)
+        // world events are nested in collection events, so only outermost pair is recorded
+        GC_set_on_collection_event([](GC_EventType evtType) {
+            GCPauseTimeStatistics* s = g_gcPauseTimeStatistics;
+            if (evtType == GC_EVENT_START || evtType == GC_EVENT_PRE_STOP_WORLD) {
+                if (s->m_depth++ == 0) {
+                    s->m_start = longTickCount();
+                }
+            } else if (evtType == GC_EVENT_END || evtType == GC_EVENT_POST_START_WORLD) {
+                if (s->m_depth && --s->m_depth == 0) {
+                    s->record(longTickCount() - s->m_start);
+                }
+            }
+        });
+    }
+#endif
+
 #ifdef PROFILE_BDWGC
     GCUtil::HeapUsageVisualizer::initialize();
 #endif
 }
 
+void Heap::setIncrementTimeLimit(unsigned long ms)
+{
+    GC_set_time_limit(ms);
+}
+
+unsigned long Heap::incrementTimeLimit()
+{
+    return GC_get_time_limit();
+}
+
+Heap::Statistics Heap::statistics()
+{
+    Statistics s;
+    s.m_heapSize = GC_get_heap_size();
+    s.m_freeBytes = GC_get_free_bytes();
+    s.m_unmappedBytes = GC_get_unmapped_bytes();
+    s.m_bytesAllocatedSinceLastGC = GC_get_bytes_since_gc();
+    s.m_totalBytesAllocated = GC_get_total_bytes();
+    s.m_gcCount = GC_get_gc_no();
+    return s;
+}
+
 void Heap::finalize()
 {
     for (size_t i = 0; i < 5; i++) {
         GC_gcollect_and_unmap();
     }
+
+#ifndef PROFILE_MASSIF
+    if (g_gcPauseTimeStatistics) {
+        GCPauseTimeStatistics* s = g_gcPauseTimeStatistics;
+        fprintf(stderr, "GC pause: %zu pauses, total %.3fms, max %.3fms, average %.3fms\n", s->m_count,
+                s->m_total / 1000.0, s->m_max / 1000.0, s->m_count ? (s->m_total / 1000.0) / s->m_count : 0);
+        unsigned limit = 1;
+        for (size_t i = 0; i < GC_PAUSE_TIME_HISTOGRAM_SIZE; i++, limit *= 2) {
+            if (i == GC_PAUSE_TIME_HISTOGRAM_SIZE - 1) {
+                fprintf(stderr, "  >= %ums: %zu\n", limit / 2, s->m_histogram[i]);
+            } else {
+                fprintf(stderr, "  < %ums: %zu\n", limit, s->m_histogram[i]);
+            }
+        }
+    }
+#endif
 }
 }
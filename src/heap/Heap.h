@@ -25,11 +25,34 @@ namespace Escargot {
 
 class Heap {
 public:
-    static void initialize(bool applyMallOpt = true, bool applyGcOpt = true);
+    // gcMarkerThreadCount is used only with parallel marking build. 0 means GC decides it with number of processors
+    static void initialize(bool applyMallOpt = true, bool applyGcOpt = true, size_t gcMarkerThreadCount = 0);
     static void finalize();
+
+    // maximum pause of one collection step in milliseconds. it is effective only in incremental mode
+    // NOTE this is process-wide setting of GC
+    static void setIncrementTimeLimit(unsigned long ms);
+    static unsigned long incrementTimeLimit();
+
+    struct Statistics {
+        size_t m_heapSize; // bytes of heap including free and unmapped area
+        size_t m_freeBytes;
+        size_t m_unmappedBytes;
+        size_t m_bytesAllocatedSinceLastGC;
+        size_t m_totalBytesAllocated;
+        size_t m_gcCount;
+    };
+
+    // cheap to call. every value is read from GC without walking heap
+    static Statistics statistics();
 };
 }
 
+#ifndef ESCARGOT_GC_INCREMENT_TIME_LIMIT
+#define ESCARGOT_GC_INCREMENT_TIME_LIMIT 8 // ms
+#endif
+
 #include "CustomAllocator.h"
+#include "AllocationProfiler.h"
 
 #endif
@@ -21,7 +21,11 @@
 #include "ByteCode.h"
 #include "ByteCodeInterpreter.h"
 #include "runtime/Context.h"
+#include "runtime/Environment.h"
+#include "runtime/EnvironmentRecord.h"
+#include "runtime/ExecutionContext.h"
 #include "parser/ScriptParser.h"
+#include "parser/Script.h"
 #include "parser/ast/AST.h"
 #include "parser/esprima_cpp/esprima.h"
 
@@ -43,6 +47,7 @@ OpcodeTable::OpcodeTable()
 
 void* ByteCodeBlock::operator new(size_t size)
 {
+    ESCARGOT_PROFILE_ALLOCATION(ByteCodeBlock, size);
     static bool typeInited = false;
     static GC_descr descr;
     if (!typeInited) {
@@ -56,14 +61,37 @@ void* ByteCodeBlock::operator new(size_t size)
     return GC_MALLOC_EXPLICITLY_TYPED(size, descr);
 }
 
+void ByteCodeBlock::computeFrameLayout()
+{
+    InterpretedCodeBlock* codeBlock = m_codeBlock;
+    ByteCodeFrameLayout& layout = m_frameLayout;
+
+    layout.m_stackStorageSize = codeBlock->identifierOnStackCount();
+    layout.m_parameterCount = codeBlock->parameterCount();
+    layout.m_isStrict = codeBlock->isStrict();
+    layout.m_isArrowFunction = codeBlock->isArrowFunctionExpression();
+    layout.m_hasSimplePrologue = codeBlock->canAllocateEnvironmentOnStack() && !codeBlock->needsComplexParameterCopy()
+        && !codeBlock->m_isFunctionNameSaveOnHeap && !codeBlock->m_isFunctionNameExplicitlyDeclared && !codeBlock->usesArgumentsObject();
+
+    // ExecutionContext is never referenced after call returns, so it is always in frame
+    size_t size = CALL_FRAME_ALIGNED_SIZE(ExecutionState) + CALL_FRAME_ALIGNED_SIZE(ExecutionContext);
+    if (codeBlock->canAllocateEnvironmentOnStack()) {
+        size += CALL_FRAME_ALIGNED_SIZE(FunctionEnvironmentRecordSimple) + CALL_FRAME_ALIGNED_SIZE(LexicalEnvironment);
+    }
+    size += (m_requiredRegisterFileSizeInValueSize + layout.m_stackStorageSize + m_numeralLiteralData.size()) * sizeof(Value);
+    layout.m_frameSize = size;
+}
+
 void ByteCodeBlock::fillLocDataIfNeeded(Context* c)
 {
-    if (!m_codeBlock->isInterpretedCodeBlock() || m_locData || (m_codeBlock->isInterpretedCodeBlock() && m_codeBlock->asInterpretedCodeBlock()->src().length() == 0)) {
+    if (!m_codeBlock->isInterpretedCodeBlock() || m_locTable || (m_codeBlock->isInterpretedCodeBlock() && m_codeBlock->asInterpretedCodeBlock()->src().length() == 0)) {
         return;
     }
 
     ByteCodeGenerator g;
     ByteCodeBlock* block;
+    ASTAllocator allocator;
+    ASTAllocatorScope allocatorScope(&allocator);
     // TODO
     // give correct stack limit to parser
     if (m_codeBlock->asInterpretedCodeBlock()->isGlobalScopeCodeBlock()) {
@@ -73,10 +101,8 @@ void ByteCodeBlock::fillLocDataIfNeeded(Context* c)
         auto ret = c->scriptParser().parseFunction(m_codeBlock->asInterpretedCodeBlock(), SIZE_MAX);
         block = g.generateByteCode(c, m_codeBlock->asInterpretedCodeBlock(), std::get<0>(ret).get(), std::get<1>(ret), m_isEvalMode, m_isOnGlobal, true);
     }
-    m_locData = block->m_locData;
-    block->m_locData = nullptr;
-    // prevent infinate fillLocDataIfNeeded if m_locData.size() == 0 in here
-    m_locData->push_back(std::make_pair(SIZE_MAX, SIZE_MAX));
+    m_locTable = block->m_locTable;
+    block->m_locTable = nullptr;
 }
 
 ExtendedNodeLOC ByteCodeBlock::computeNodeLOCFromByteCode(Context* c, size_t codePosition, CodeBlock* cb)
@@ -87,21 +113,20 @@ ExtendedNodeLOC ByteCodeBlock::computeNodeLOCFromByteCode(Context* c, size_t cod
 
     fillLocDataIfNeeded(c);
 
-    size_t index = 0;
-    for (size_t i = 0; i < m_locData->size(); i++) {
-        if ((*m_locData)[i].first == codePosition) {
-            index = (*m_locData)[i].second;
-            if (index == SIZE_MAX) {
-                return ExtendedNodeLOC(SIZE_MAX, SIZE_MAX, SIZE_MAX);
-            }
-            break;
-        }
+    size_t index = m_locTable ? m_locTable->sourceIndex(codePosition) : SIZE_MAX;
+    if (index == SIZE_MAX) {
+        return ExtendedNodeLOC(SIZE_MAX, SIZE_MAX, SIZE_MAX);
+    }
+
+    InterpretedCodeBlock* codeBlock = cb->asInterpretedCodeBlock();
+    if (LIKELY(codeBlock->script() != nullptr)) {
+        return codeBlock->script()->computeNodeLOC(index, codeBlock->sourceElementStart());
     }
 
     size_t indexRelatedWithScript = index;
-    index -= cb->asInterpretedCodeBlock()->sourceElementStart().index;
+    index -= codeBlock->sourceElementStart().index;
 
-    auto result = computeNodeLOC(cb->asInterpretedCodeBlock()->src(), cb->asInterpretedCodeBlock()->sourceElementStart(), index);
+    auto result = computeNodeLOC(codeBlock->src(), codeBlock->sourceElementStart(), index);
     result.index = indexRelatedWithScript;
 
     return result;
@@ -127,8 +152,69 @@ ExtendedNodeLOC ByteCodeBlock::computeNodeLOC(StringView src, ExtendedNodeLOC so
     return ExtendedNodeLOC(line, column, index);
 }
 
+static void appendLOCTableNumber(std::vector<uint8_t>& data, size_t value)
+{
+    while (value >= 0x80) {
+        data.push_back((uint8_t)(value | 0x80));
+        value >>= 7;
+    }
+    data.push_back((uint8_t)value);
+}
+
+static size_t readLOCTableNumber(const uint8_t*& ptr)
+{
+    size_t value = 0;
+    size_t shift = 0;
+    while (*ptr & 0x80) {
+        value |= (size_t)(*ptr & 0x7f) << shift;
+        shift += 7;
+        ptr++;
+    }
+    value |= (size_t)*ptr << shift;
+    ptr++;
+    return value;
+}
+
+// entry is (delta of code position, zigzag encoded delta of source index + 1).
+// source index + 1 is 0 for code without source location
+ByteCodeLOCTable::ByteCodeLOCTable(const ByteCodeLOCData& data)
+{
+    size_t lastPosition = 0;
+    size_t lastIndex = 0;
+    for (size_t i = 0; i < data.size(); i++) {
+        ASSERT(data[i].first >= lastPosition);
+        size_t index = data[i].second + 1;
+        intptr_t indexDelta = (intptr_t)(index - lastIndex);
+        appendLOCTableNumber(m_data, data[i].first - lastPosition);
+        appendLOCTableNumber(m_data, ((size_t)indexDelta << 1) ^ (size_t)(indexDelta >> (sizeof(intptr_t) * 8 - 1)));
+        lastPosition = data[i].first;
+        lastIndex = index;
+    }
+    m_data.shrink_to_fit();
+}
+
+size_t ByteCodeLOCTable::sourceIndex(size_t codePosition) const
+{
+    const uint8_t* ptr = m_data.data();
+    const uint8_t* end = ptr + m_data.size();
+    size_t position = 0;
+    size_t index = 0;
+    while (ptr < end) {
+        position += readLOCTableNumber(ptr);
+        size_t zigzag = readLOCTableNumber(ptr);
+        index += (size_t)((intptr_t)(zigzag >> 1) ^ -(intptr_t)(zigzag & 1));
+        if (position == codePosition) {
+            return index - 1;
+        } else if (position > codePosition) {
+            break;
+        }
+    }
+    return SIZE_MAX;
+}
+
 void* SetObjectInlineCache::operator new(size_t size)
 {
+    ESCARGOT_PROFILE_ALLOCATION(InlineCache, size);
     static bool typeInited = false;
     static GC_descr descr;
     if (!typeInited) {
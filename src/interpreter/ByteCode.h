@@ -23,6 +23,7 @@
 #include "interpreter/ByteCodeGenerator.h"
 #include "parser/CodeBlock.h"
 #include "parser/ast/Node.h"
+#include "runtime/MathIntrinsic.h"
 #include "runtime/SmallValue.h"
 #include "runtime/String.h"
 #include "runtime/Value.h"
@@ -89,6 +90,8 @@ class Node;
     F(JumpIfFalse, 0, 0)                              \
     F(CallFunction, -1, 0)                            \
     F(CallFunctionWithReceiver, -1, 0)                \
+    F(CallMathIntrinsic, -1, 0)                       \
+    F(CallStringIntrinsic, -1, 0)                     \
     F(ReturnFunction, 0, 0)                           \
     F(ReturnFunctionWithValue, 0, 0)                  \
     F(ReturnFunctionSlowCase, 0, 0)                   \
@@ -657,17 +660,21 @@ struct SetObjectInlineCache {
     size_t m_cachedIndex;
     ObjectStructure* m_hiddenClassWillBe;
     size_t m_cacheMissCount;
+    // representation of cached field. it is fixed for cached structure
+    bool m_cachedFieldHasDoubleRepresentation;
     SetObjectInlineCache()
     {
         m_cachedIndex = SIZE_MAX;
         m_hiddenClassWillBe = nullptr;
         m_cacheMissCount = 0;
+        m_cachedFieldHasDoubleRepresentation = false;
     }
 
     void invalidateCache()
     {
         m_cachedIndex = SIZE_MAX;
         m_hiddenClassWillBe = nullptr;
+        m_cachedFieldHasDoubleRepresentation = false;
         m_cachedhiddenClassChain.clear();
     }
 
@@ -1170,6 +1177,77 @@ public:
 #endif
 };
 
+// Math.xxx(...) call. if callee is the builtin function of kind and arguments are numbers,
+// result is computed without calling. otherwise this works like CallFunctionWithReceiver.
+// callee is not loaded before this unless m_isCalleeLoaded. then Math is checked instead (see GlobalObject::mathStructure),
+// and callee is loaded into m_calleeIndex only when function should be called
+class CallMathIntrinsic : public ByteCode {
+public:
+    CallMathIntrinsic(const ByteCodeLOC& loc, MathIntrinsicKind kind, bool isCalleeLoaded, AtomicString propertyName, const size_t& receiverIndex, const size_t& calleeIndex, const size_t& argumentsStartIndex, const size_t& argumentCount, const size_t& resultIndex)
+        : ByteCode(Opcode::CallMathIntrinsicOpcode, loc)
+        , m_kind(kind)
+        , m_isCalleeLoaded(isCalleeLoaded)
+        , m_propertyName(propertyName)
+        , m_receiverIndex(receiverIndex)
+        , m_calleeIndex(calleeIndex)
+        , m_argumentsStartIndex(argumentsStartIndex)
+        , m_argumentCount(argumentCount)
+        , m_resultIndex(resultIndex)
+    {
+    }
+
+    MathIntrinsicKind m_kind;
+    bool m_isCalleeLoaded;
+    AtomicString m_propertyName;
+    ByteCodeRegisterIndex m_receiverIndex;
+    ByteCodeRegisterIndex m_calleeIndex;
+    ByteCodeRegisterIndex m_argumentsStartIndex;
+    uint16_t m_argumentCount;
+    ByteCodeRegisterIndex m_resultIndex;
+
+#ifndef NDEBUG
+    virtual void dump()
+    {
+        printf("call math intrinsic(%d) r%d <- r%d,r%d(r%d-r%d)", (int)m_kind, (int)m_resultIndex, (int)m_receiverIndex, (int)m_calleeIndex, (int)m_argumentsStartIndex, (int)m_argumentsStartIndex + (int)m_argumentCount);
+    }
+#endif
+};
+
+// str.charAt(i) or str.charCodeAt(i). if callee is the builtin function, receiver is string
+// and index is in range, character is read without calling. otherwise this works like CallFunctionWithReceiver
+class CallStringIntrinsic : public ByteCode {
+public:
+    enum Kind : uint8_t {
+        CharAt,
+        CharCodeAt
+    };
+
+    CallStringIntrinsic(const ByteCodeLOC& loc, Kind kind, const size_t& receiverIndex, const size_t& calleeIndex, const size_t& argumentsStartIndex, const size_t& argumentCount, const size_t& resultIndex)
+        : ByteCode(Opcode::CallStringIntrinsicOpcode, loc)
+        , m_kind(kind)
+        , m_receiverIndex(receiverIndex)
+        , m_calleeIndex(calleeIndex)
+        , m_argumentsStartIndex(argumentsStartIndex)
+        , m_argumentCount(argumentCount)
+        , m_resultIndex(resultIndex)
+    {
+    }
+
+    Kind m_kind;
+    ByteCodeRegisterIndex m_receiverIndex;
+    ByteCodeRegisterIndex m_calleeIndex;
+    ByteCodeRegisterIndex m_argumentsStartIndex;
+    uint16_t m_argumentCount;
+    ByteCodeRegisterIndex m_resultIndex;
+
+#ifndef NDEBUG
+    virtual void dump()
+    {
+        printf("call string intrinsic(%s) r%d <- r%d,r%d(r%d-r%d)", m_kind == CharAt ? "charAt" : "charCodeAt", (int)m_resultIndex, (int)m_receiverIndex, (int)m_calleeIndex, (int)m_argumentsStartIndex, (int)m_argumentsStartIndex + (int)m_argumentCount);
+    }
+#endif
+};
+
 class CallEvalFunction : public ByteCode {
 public:
     CallEvalFunction(const ByteCodeLOC& loc, const size_t& evalIndex, const size_t& argumentsStartIndex, size_t argumentCount, const size_t& resultIndex, bool inWithScope)
@@ -1561,11 +1639,47 @@ public:
 
 typedef Vector<char, std::allocator<char>, 200> ByteCodeBlockData;
 typedef std::vector<std::pair<size_t, size_t>, std::allocator<std::pair<size_t, size_t>>> ByteCodeLOCData;
+
+// Table of code position -> source index of bytecode block.
+// Each entry is stored as deltas from previous entry in variable length bytes,
+// so it takes a few bytes per bytecode instead of ByteCodeLOCData's pair of size_t
+class ByteCodeLOCTable {
+public:
+    explicit ByteCodeLOCTable(const ByteCodeLOCData& data);
+
+    // returns SIZE_MAX if there is no source index for codePosition
+    size_t sourceIndex(size_t codePosition) const;
+
+    size_t memoryAllocatedSize() const
+    {
+        return m_data.size();
+    }
+
+private:
+    std::vector<uint8_t> m_data;
+};
 typedef Vector<void*, GCUtil::gc_malloc_ignore_off_page_allocator<void*>> ByteCodeLiteralData;
 typedef Vector<Value, std::allocator<Value>> ByteCodeNumeralLiteralData;
 typedef std::unordered_set<ObjectStructure*, std::hash<ObjectStructure*>, std::equal_to<ObjectStructure*>,
                            GCUtil::gc_malloc_ignore_off_page_allocator<ObjectStructure*>>
     ObjectStructuresInUse;
+
+#define CALL_FRAME_ALIGNED_SIZE(T) ((sizeof(T) + sizeof(Value) - 1) & ~(sizeof(Value) - 1))
+
+// Call setup of function computed once when its bytecode is generated.
+// FunctionObject::prepareCallFrame reads this instead of checking flags of code block on every call
+struct ByteCodeFrameLayout {
+    // bytes of ExecutionState, environment (when it is on stack) and register file of a call
+    size_t m_frameSize;
+    size_t m_stackStorageSize;
+    uint16_t m_parameterCount;
+    // environment is on stack, parameters are copied into stack storage in order,
+    // function name needs no extra binding and there is no arguments object
+    bool m_hasSimplePrologue : 1;
+    bool m_isStrict : 1;
+    bool m_isArrowFunction : 1;
+};
+
 class ByteCodeBlock : public gc {
     friend struct OpcodeTable;
     ByteCodeBlock()
@@ -1581,6 +1695,8 @@ public:
         m_isOnGlobal = false;
         m_shouldClearStack = false;
         m_locData = nullptr;
+        m_locTable = nullptr;
+        memset(&m_frameLayout, 0, sizeof(ByteCodeFrameLayout));
 
         if (!codeBlock->hasCallNativeFunctionCode()) {
             m_objectStructuresInUse = new (GC) ObjectStructuresInUse();
@@ -1599,6 +1715,8 @@ public:
             self->m_code.clear();
             if (self->m_locData)
                 delete self->m_locData;
+            if (self->m_locTable)
+                delete self->m_locTable;
         },
                                        nullptr, nullptr, nullptr);
     }
@@ -1658,7 +1776,7 @@ public:
     size_t memoryAllocatedSize()
     {
         size_t siz = m_code.size();
-        siz += m_locData ? (m_locData->size() * sizeof(std::pair<size_t, size_t>)) : 0;
+        siz += m_locTable ? m_locTable->memoryAllocatedSize() : 0;
         siz += m_literalData.size() * sizeof(size_t);
         siz += m_objectStructuresInUse->size() * sizeof(size_t);
         siz += m_getObjectCodePositions.size() * sizeof(size_t);
@@ -1668,18 +1786,23 @@ public:
     ExtendedNodeLOC computeNodeLOCFromByteCode(Context* c, size_t codePosition, CodeBlock* cb);
     ExtendedNodeLOC computeNodeLOC(StringView src, ExtendedNodeLOC sourceElementStart, size_t index);
     void fillLocDataIfNeeded(Context* c);
+    // should be called after register file size and numeral literals are fixed
+    void computeFrameLayout();
 
     bool m_isEvalMode : 1;
     bool m_isOnGlobal : 1;
     bool m_shouldClearStack : 1;
     ByteCodeRegisterIndex m_requiredRegisterFileSizeInValueSize : REGISTER_INDEX_IN_BIT;
+    ByteCodeFrameLayout m_frameLayout;
 
     ByteCodeBlockData m_code;
     ByteCodeNumeralLiteralData m_numeralLiteralData;
     ByteCodeLiteralData m_literalData;
     ObjectStructuresInUse* m_objectStructuresInUse;
 
+    // m_locData is filled while generating bytecode, and is packed into m_locTable when generation is done
     ByteCodeLOCData* m_locData;
+    ByteCodeLOCTable* m_locTable;
     InterpretedCodeBlock* m_codeBlock;
 
     std::vector<size_t> m_getObjectCodePositions;
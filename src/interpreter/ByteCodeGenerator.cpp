@@ -21,6 +21,7 @@
 #include "ByteCodeGenerator.h"
 #include "interpreter/ByteCode.h"
 #include "parser/ast/AST.h"
+#include "runtime/VMInstance.h"
 
 namespace Escargot {
 
@@ -158,6 +159,10 @@ ByteCodeBlock* ByteCodeGenerator::generateByteCode(Context* c, InterpretedCodeBl
         nData = nullptr;
     }
 
+    if (!shouldGenerateLOCData && c->vmInstance()->keepsSourceLocationTable() && codeBlock->src().length()) {
+        shouldGenerateLOCData = true;
+    }
+
     ByteCodeGenerateContext ctx(codeBlock, block, info, nData);
     ctx.m_shouldGenerateLOCData = shouldGenerateLOCData;
     if (shouldGenerateLOCData) {
@@ -427,6 +432,22 @@ ByteCodeBlock* ByteCodeGenerator::generateByteCode(Context* c, InterpretedCodeBl
                 assignStackIndexIfNeeded(cd->m_resultIndex, stackBase, stackBaseWillBe, stackVariableSize);
                 break;
             }
+            case CallMathIntrinsicOpcode: {
+                CallMathIntrinsic* cd = (CallMathIntrinsic*)currentCode;
+                assignStackIndexIfNeeded(cd->m_receiverIndex, stackBase, stackBaseWillBe, stackVariableSize);
+                assignStackIndexIfNeeded(cd->m_calleeIndex, stackBase, stackBaseWillBe, stackVariableSize);
+                assignStackIndexIfNeeded(cd->m_argumentsStartIndex, stackBase, stackBaseWillBe, stackVariableSize);
+                assignStackIndexIfNeeded(cd->m_resultIndex, stackBase, stackBaseWillBe, stackVariableSize);
+                break;
+            }
+            case CallStringIntrinsicOpcode: {
+                CallStringIntrinsic* cd = (CallStringIntrinsic*)currentCode;
+                assignStackIndexIfNeeded(cd->m_receiverIndex, stackBase, stackBaseWillBe, stackVariableSize);
+                assignStackIndexIfNeeded(cd->m_calleeIndex, stackBase, stackBaseWillBe, stackVariableSize);
+                assignStackIndexIfNeeded(cd->m_argumentsStartIndex, stackBase, stackBaseWillBe, stackVariableSize);
+                assignStackIndexIfNeeded(cd->m_resultIndex, stackBase, stackBaseWillBe, stackVariableSize);
+                break;
+            }
             case CallEvalFunctionOpcode: {
                 CallEvalFunction* cd = (CallEvalFunction*)currentCode;
                 assignStackIndexIfNeeded(cd->m_argumentsStartIndex, stackBase, stackBaseWillBe, stackVariableSize);
@@ -583,6 +604,16 @@ ByteCodeBlock* ByteCodeGenerator::generateByteCode(Context* c, InterpretedCodeBl
     }
 #endif
 
+    if (!isGlobalScope && !isEvalMode) {
+        block->computeFrameLayout();
+    }
+
+    if (block->m_locData) {
+        block->m_locTable = new ByteCodeLOCTable(*block->m_locData);
+        delete block->m_locData;
+        block->m_locData = nullptr;
+    }
+
     return block;
 }
 }
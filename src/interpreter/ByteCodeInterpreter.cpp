@@ -24,6 +24,7 @@
 #include "runtime/EnvironmentRecord.h"
 #include "runtime/FunctionObject.h"
 #include "runtime/Context.h"
+#include "runtime/VMInstance.h"
 #include "runtime/SandBox.h"
 #include "runtime/GlobalObject.h"
 #include "runtime/StringObject.h"
@@ -37,6 +38,11 @@
 namespace Escargot {
 
 #define ADD_PROGRAM_COUNTER(CodeType) programCounter += sizeof(CodeType);
+// allocations sampled by AllocationProfiler are attributed to the last allocating or call instruction
+#define RECORD_ALLOCATION_SITE()                                                                              \
+    if (UNLIKELY(AllocationProfiler::isSampling())) {                                                         \
+        AllocationProfiler::setCurrentSite(byteCodeBlock, resolveProgramCounter(codeBuffer, programCounter)); \
+    }
 
 ALWAYS_INLINE size_t jumpTo(char* codeBuffer, const size_t& jumpPosition)
 {
@@ -48,15 +54,71 @@ ALWAYS_INLINE size_t resolveProgramCounter(char* codeBuffer, const size_t progra
     return programCounter - (size_t)codeBuffer;
 }
 
-Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteCodeBlock, register size_t programCounter, Value* registerFile, void* initAddressFiller)
+// frame of JS function called inside interpreter loop without recursion of ByteCodeInterpreter::interpret.
+// ExecutionState, environment and register file of callee follow this on InterpreterStack
+struct InterpretedCallFrame {
+    InterpretedCallFrame* m_callerFrame;
+    ExecutionState* m_state;
+    ByteCodeBlock* m_byteCodeBlock;
+    ByteCodeBlock* m_callerByteCodeBlock;
+    Value* m_callerRegisterFile;
+    size_t m_callerProgramCounter;
+    size_t m_returnProgramCounter;
+    ByteCodeRegisterIndex m_resultIndex;
+    InterpreterStack::Mark m_stackMark;
+};
+
+ALWAYS_INLINE bool isInterpretedFunction(const Value& callee)
+{
+    return callee.isObject() && callee.asPointerValue()->hasTag(g_functionObjectTag) && callee.asFunction()->codeBlock()->isInterpretedCodeBlock();
+}
+
+// single character string. latin-1 characters are cached in static strings
+ALWAYS_INLINE Value characterToString(ExecutionState& state, char16_t c)
+{
+    if (LIKELY(c < ESCARGOT_ASCII_TABLE_MAX)) {
+        return Value(state.context()->staticStrings().asciiTable[c].string());
+    }
+    return Value(String::fromCharCode(c));
+}
+
+// callee runs in same loop of caller from its first instruction
+#define ENTER_CALL_FRAME(frame, CodeType)                              \
+    frame->m_resultIndex = code->m_resultIndex;                        \
+    frame->m_returnProgramCounter = programCounter + sizeof(CodeType); \
+    frame->m_callerFrame = callFrame;                                  \
+    frame->m_callerByteCodeBlock = byteCodeBlock;                      \
+    frame->m_callerRegisterFile = registerFile;                        \
+    frame->m_callerProgramCounter = programCounter;                    \
+    callFrame = frame;                                                 \
+    currentState = frame->m_state;                                     \
+    byteCodeBlock = frame->m_byteCodeBlock;                            \
+    registerFile = currentState->registerFile();                       \
+    programCounter = (size_t)byteCodeBlock->m_code.data();             \
+    goto ChangeFrame;
+
+// returning from function called inside this loop continues its caller
+#define RETURN_FROM_FUNCTION(value)                                        \
+    if (callFrame) {                                                       \
+        callFrame->m_callerRegisterFile[callFrame->m_resultIndex] = value; \
+        goto ReturnToCaller;                                               \
+    }                                                                      \
+    return value;
+
+Value ByteCodeInterpreter::interpret(ExecutionState& entryState, ByteCodeBlock* byteCodeBlock, register size_t programCounter, Value* registerFile, void* initAddressFiller)
 {
 #if defined(COMPILER_GCC)
     *((size_t*)initAddressFiller) = ((size_t) && FillOpcodeTableOpcodeLbl);
 #endif
+    ExecutionState* currentState = &entryState;
+    InterpretedCallFrame* callFrame = nullptr;
+    programCounter = (size_t)(byteCodeBlock->m_code.data() + programCounter);
+
+ChangeFrame:
     {
+        ExecutionState& state = *currentState;
         ExecutionContext* ec = state.executionContext();
         char* codeBuffer = byteCodeBlock->m_code.data();
-        programCounter = (size_t)(&codeBuffer[programCounter]);
 
         try {
 #define NEXT_INSTRUCTION() goto NextInstruction;
@@ -395,6 +457,18 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
                             }
                         }
                     }
+                } else if (willBeObject.isString() && property.isUInt32()) {
+                    // character of flat string. rope is left to slow case not to flatten it by indexing
+                    String* str = willBeObject.asString();
+                    if (LIKELY(str->hasFlatBuffer())) {
+                        const StringBufferAccessData& data = str->bufferAccessData();
+                        uint32_t idx = property.asUInt32();
+                        if (LIKELY(idx < data.length)) {
+                            registerFile[code->m_storeRegisterIndex] = characterToString(state, data.charAt(idx));
+                            ADD_PROGRAM_COUNTER(GetObject);
+                            NEXT_INSTRUCTION();
+                        }
+                    }
                 }
 #if defined(COMPILER_GCC)
                 goto GetObjectOpcodeSlowCaseOpcodeLbl;
@@ -512,7 +586,14 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
                 :
             {
                 CallFunction* code = (CallFunction*)programCounter;
+                RECORD_ALLOCATION_SITE();
                 const Value& callee = registerFile[code->m_calleeIndex];
+                if (LIKELY(isInterpretedFunction(callee))) {
+                    InterpretedCallFrame* frame = pushCallFrame(state, callee.asFunction(), Value(), code->m_argumentCount, &registerFile[code->m_argumentsStartIndex]);
+                    if (LIKELY(frame != nullptr)) {
+                        ENTER_CALL_FRAME(frame, CallFunction);
+                    }
+                }
                 registerFile[code->m_resultIndex] = FunctionObject::call(state, callee, Value(), code->m_argumentCount, &registerFile[code->m_argumentsStartIndex]);
                 ADD_PROGRAM_COUNTER(CallFunction);
                 NEXT_INSTRUCTION();
@@ -522,13 +603,99 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
                 :
             {
                 CallFunctionWithReceiver* code = (CallFunctionWithReceiver*)programCounter;
+                RECORD_ALLOCATION_SITE();
                 const Value& callee = registerFile[code->m_calleeIndex];
                 const Value& receiver = registerFile[code->m_receiverIndex];
+                if (LIKELY(isInterpretedFunction(callee))) {
+                    InterpretedCallFrame* frame = pushCallFrame(state, callee.asFunction(), receiver, code->m_argumentCount, &registerFile[code->m_argumentsStartIndex]);
+                    if (LIKELY(frame != nullptr)) {
+                        ENTER_CALL_FRAME(frame, CallFunctionWithReceiver);
+                    }
+                }
                 registerFile[code->m_resultIndex] = FunctionObject::call(state, callee, receiver, code->m_argumentCount, &registerFile[code->m_argumentsStartIndex]);
                 ADD_PROGRAM_COUNTER(CallFunctionWithReceiver);
                 NEXT_INSTRUCTION();
             }
 
+            DEFINE_OPCODE(CallMathIntrinsic)
+                :
+            {
+                CallMathIntrinsic* code = (CallMathIntrinsic*)programCounter;
+                const Value& receiver = registerFile[code->m_receiverIndex];
+                Value* argv = &registerFile[code->m_argumentsStartIndex];
+                GlobalObject* globalObject = state.context()->globalObject();
+                FunctionObject* builtin = globalObject->mathIntrinsic(code->m_kind);
+                bool isBuiltinCallee;
+                if (code->m_isCalleeLoaded) {
+                    const Value& callee = registerFile[code->m_calleeIndex];
+                    isBuiltinCallee = callee.isObject() && callee.asObject() == builtin;
+                } else {
+                    // same structure means same property layout and attributes, so only value of the slot can be changed
+                    Object* math = globalObject->math();
+                    isBuiltinCallee = receiver.isObject() && receiver.asObject() == math && math->structure() == globalObject->mathStructure()
+                        && math->m_values[globalObject->mathIntrinsicIndex(code->m_kind)].payload() == (intptr_t)builtin;
+                }
+                if (LIKELY(isBuiltinCallee) && LIKELY(argv[0].isNumber()) && (code->m_argumentCount == 1 || LIKELY(argv[1].isNumber()))) {
+                    double y = code->m_argumentCount == 1 ? 0 : argv[1].asNumber();
+                    registerFile[code->m_resultIndex] = Value(runMathIntrinsic(code->m_kind, argv[0].asNumber(), y));
+                    ADD_PROGRAM_COUNTER(CallMathIntrinsic);
+                    NEXT_INSTRUCTION();
+                }
+                RECORD_ALLOCATION_SITE();
+                if (!code->m_isCalleeLoaded) {
+                    Object* obj = receiver.isObject() ? receiver.asObject() : fastToObject(state, receiver);
+                    registerFile[code->m_calleeIndex] = obj->get(state, ObjectPropertyName(code->m_propertyName)).value(state, receiver);
+                }
+                const Value& callee = registerFile[code->m_calleeIndex];
+                if (LIKELY(isInterpretedFunction(callee))) {
+                    InterpretedCallFrame* frame = pushCallFrame(state, callee.asFunction(), receiver, code->m_argumentCount, argv);
+                    if (LIKELY(frame != nullptr)) {
+                        ENTER_CALL_FRAME(frame, CallMathIntrinsic);
+                    }
+                }
+                registerFile[code->m_resultIndex] = FunctionObject::call(state, callee, receiver, code->m_argumentCount, argv);
+                ADD_PROGRAM_COUNTER(CallMathIntrinsic);
+                NEXT_INSTRUCTION();
+            }
+
+            DEFINE_OPCODE(CallStringIntrinsic)
+                :
+            {
+                CallStringIntrinsic* code = (CallStringIntrinsic*)programCounter;
+                const Value& callee = registerFile[code->m_calleeIndex];
+                const Value& receiver = registerFile[code->m_receiverIndex];
+                Value* argv = &registerFile[code->m_argumentsStartIndex];
+                if (LIKELY(receiver.isString() && argv[0].isUInt32() && callee.isObject())) {
+                    GlobalObject* globalObject = state.context()->globalObject();
+                    FunctionObject* builtin = code->m_kind == CallStringIntrinsic::CharAt ? globalObject->stringCharAt() : globalObject->stringCharCodeAt();
+                    if (LIKELY(callee.asObject() == builtin)) {
+                        // builtin flattens rope too
+                        const StringBufferAccessData& data = receiver.asString()->bufferAccessData();
+                        uint32_t idx = argv[0].asUInt32();
+                        if (LIKELY(idx < data.length)) {
+                            char16_t c = data.charAt(idx);
+                            if (code->m_kind == CallStringIntrinsic::CharCodeAt) {
+                                registerFile[code->m_resultIndex] = Value(c);
+                            } else {
+                                registerFile[code->m_resultIndex] = characterToString(state, c);
+                            }
+                            ADD_PROGRAM_COUNTER(CallStringIntrinsic);
+                            NEXT_INSTRUCTION();
+                        }
+                    }
+                }
+                RECORD_ALLOCATION_SITE();
+                if (LIKELY(isInterpretedFunction(callee))) {
+                    InterpretedCallFrame* frame = pushCallFrame(state, callee.asFunction(), receiver, code->m_argumentCount, argv);
+                    if (LIKELY(frame != nullptr)) {
+                        ENTER_CALL_FRAME(frame, CallStringIntrinsic);
+                    }
+                }
+                registerFile[code->m_resultIndex] = FunctionObject::call(state, callee, receiver, code->m_argumentCount, argv);
+                ADD_PROGRAM_COUNTER(CallStringIntrinsic);
+                NEXT_INSTRUCTION();
+            }
+
             DEFINE_OPCODE(LoadByHeapIndex)
                 :
             {
@@ -539,7 +706,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
                 }
                 FunctionEnvironmentRecord* record = upperEnv->record()->asDeclarativeEnvironmentRecord()->asFunctionEnvironmentRecord();
                 ASSERT(record->isFunctionEnvironmentRecordOnHeap() || record->isFunctionEnvironmentRecordNotIndexed());
-                registerFile[code->m_registerIndex] = ((FunctionEnvironmentRecordOnHeap*)record)->m_heapStorage[code->m_index];
+                registerFile[code->m_registerIndex] = ((FunctionEnvironmentRecordWithHeapSlots*)record)->m_heapSlots[code->m_index];
                 ADD_PROGRAM_COUNTER(LoadByHeapIndex);
                 NEXT_INSTRUCTION();
             }
@@ -554,7 +721,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
                 }
                 FunctionEnvironmentRecord* record = upperEnv->record()->asDeclarativeEnvironmentRecord()->asFunctionEnvironmentRecord();
                 ASSERT(record->isFunctionEnvironmentRecordOnHeap() || record->isFunctionEnvironmentRecordNotIndexed());
-                ((FunctionEnvironmentRecordOnHeap*)record)->m_heapStorage[code->m_index] = registerFile[code->m_registerIndex];
+                ((FunctionEnvironmentRecordWithHeapSlots*)record)->m_heapSlots[code->m_index] = registerFile[code->m_registerIndex];
                 ADD_PROGRAM_COUNTER(StoreByHeapIndex);
                 NEXT_INSTRUCTION();
             }
@@ -659,13 +826,13 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
                 :
             {
                 ReturnFunctionWithValue* code = (ReturnFunctionWithValue*)programCounter;
-                return registerFile[code->m_registerIndex];
+                RETURN_FROM_FUNCTION(registerFile[code->m_registerIndex]);
             }
 
             DEFINE_OPCODE(ReturnFunction)
                 :
             {
-                return Value();
+                RETURN_FROM_FUNCTION(Value());
             }
 
             DEFINE_OPCODE(ToNumber)
@@ -682,6 +849,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
                 :
             {
                 CreateObject* code = (CreateObject*)programCounter;
+                RECORD_ALLOCATION_SITE();
                 registerFile[code->m_registerIndex] = new Object(state);
                 ADD_PROGRAM_COUNTER(CreateObject);
                 NEXT_INSTRUCTION();
@@ -691,6 +859,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
                 :
             {
                 CreateArray* code = (CreateArray*)programCounter;
+                RECORD_ALLOCATION_SITE();
                 ArrayObject* arr = new ArrayObject(state);
                 arr->setArrayLength(state, code->m_length);
                 registerFile[code->m_registerIndex] = arr;
@@ -757,6 +926,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
                 :
             {
                 NewOperation* code = (NewOperation*)programCounter;
+                RECORD_ALLOCATION_SITE();
                 registerFile[code->m_resultIndex] = newOperation(state, registerFile[code->m_calleeIndex], code->m_argumentCount, &registerFile[code->m_argumentsStartIndex]);
                 ADD_PROGRAM_COUNTER(NewOperation);
                 NEXT_INSTRUCTION();
@@ -859,6 +1029,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
                 :
             {
                 CreateFunction* code = (CreateFunction*)programCounter;
+                RECORD_ALLOCATION_SITE();
                 registerFile[code->m_registerIndex] = new FunctionObject(state, code->m_codeBlock, ec->lexicalEnvironment());
                 ADD_PROGRAM_COUNTER(CreateFunction);
                 NEXT_INSTRUCTION();
@@ -911,7 +1082,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
                             state.rareData()->m_controlFlowRecord->back() = record;
                             return Value();
                         } else {
-                            return record->value();
+                            RETURN_FROM_FUNCTION(record->value());
                         }
                     }
                 } else {
@@ -935,7 +1106,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
                 Value* stackStorage = registerFile + byteCodeBlock->m_requiredRegisterFileSizeInValueSize;
                 Value v = withOperation(state, code, registerFile[code->m_registerIndex].toObject(state), ec, ec->lexicalEnvironment(), newPc, byteCodeBlock, registerFile, stackStorage);
                 if (!v.isEmpty()) {
-                    return v;
+                    RETURN_FROM_FUNCTION(v);
                 }
                 if (programCounter == newPc) {
                     return Value();
@@ -1115,7 +1286,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
                         state.rareData()->m_controlFlowRecord->back() = new ControlFlowRecord(ControlFlowRecord::NeedsReturn, ret, state.rareData()->m_controlFlowRecord->size());
                     }
                 }
-                return ret;
+                RETURN_FROM_FUNCTION(ret);
             }
 
             DEFINE_OPCODE(ThrowStaticErrorOperation)
@@ -1127,6 +1298,25 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
             DEFINE_OPCODE(End)
                 : return registerFile[0];
 
+        ReturnToCaller : {
+            InterpretedCallFrame* frame = callFrame;
+            callFrame = frame->m_callerFrame;
+            currentState = frame->m_state->parent();
+            byteCodeBlock = frame->m_callerByteCodeBlock;
+            registerFile = frame->m_callerRegisterFile;
+            programCounter = frame->m_returnProgramCounter;
+            // frame is released by rewind, so it is read before
+            bool shouldClearStack = frame->m_byteCodeBlock->m_shouldClearStack;
+            InterpreterStack& stack = state.context()->vmInstance()->interpreterStack();
+            stack.rewind(frame->m_stackMark);
+            // same as return from FunctionObject::call
+            if (UNLIKELY(shouldClearStack)) {
+                stack.clearReleasedFrames();
+                clearStack<512>();
+            }
+            goto ChangeFrame;
+        }
+
 #if !defined(COMPILER_GCC)
         default:
             RELEASE_ASSERT_NOT_REACHED();
@@ -1135,10 +1325,24 @@ Value ByteCodeInterpreter::interpret(ExecutionState& state, ByteCodeBlock* byteC
     }
     catch (const Value& v)
     {
-        if (byteCodeBlock->m_codeBlock->isInterpretedCodeBlock() && byteCodeBlock->m_codeBlock->asInterpretedCodeBlock()->byteCodeBlock() == nullptr) {
-            byteCodeBlock->m_codeBlock->asInterpretedCodeBlock()->m_byteCodeBlock = byteCodeBlock;
+        // functions called inside this loop have no C++ activation of their own, so they are unwound here
+        while (true) {
+            if (byteCodeBlock->m_codeBlock->isInterpretedCodeBlock() && byteCodeBlock->m_codeBlock->asInterpretedCodeBlock()->byteCodeBlock() == nullptr) {
+                byteCodeBlock->m_codeBlock->asInterpretedCodeBlock()->m_byteCodeBlock = byteCodeBlock;
+            }
+            if (!callFrame) {
+                break;
+            }
+            addStackTraceData(*currentState, currentState->executionContext(), programCounter);
+
+            InterpretedCallFrame* frame = callFrame;
+            callFrame = frame->m_callerFrame;
+            currentState = frame->m_state->parent();
+            byteCodeBlock = frame->m_callerByteCodeBlock;
+            programCounter = frame->m_callerProgramCounter;
+            state.context()->vmInstance()->interpreterStack().rewind(frame->m_stackMark);
         }
-        processException(state, v, ec, programCounter);
+        processException(*currentState, v, currentState->executionContext(), programCounter);
     }
 }
 #if defined(COMPILER_GCC)
@@ -1469,6 +1673,13 @@ NEVER_INLINE Value ByteCodeInterpreter::getObjectPrecomputedCaseOperationCacheMi
         return obj->get(state, ObjectPropertyName(state, name)).value(state, receiver);
     }
 
+    // dictionary mode structure is changed in place, so it cannot be cached.
+    // prototypes leave dictionary mode in markAsPrototypeObject, so only receiver can be in it
+    if (UNLIKELY(obj->structure()->isDictionaryMode())) {
+        obj->noteInlineCacheMissInDictionaryMode(state);
+        return obj->get(state, ObjectPropertyName(state, name)).value(state, receiver);
+    }
+
     Object* orgObj = obj;
     inlineCache.m_cache.insert(inlineCache.m_cache.begin(), GetObjectInlineCacheData());
 
@@ -1476,6 +1687,7 @@ NEVER_INLINE Value ByteCodeInterpreter::getObjectPrecomputedCaseOperationCacheMi
 
     ObjectStructureChainItem newItem;
     while (true) {
+        ASSERT(!obj->structure()->isDictionaryMode());
         newItem.m_objectStructure = obj->structure();
 
         cachedHiddenClassChain->push_back(newItem);
@@ -1522,8 +1734,17 @@ ALWAYS_INLINE void ByteCodeInterpreter::setObjectPreComputedCaseOperation(Execut
     if (inlineCache.m_cachedIndex != SIZE_MAX && inlineCache.m_cachedhiddenClassChain[0] == testItem) {
         ASSERT(inlineCache.m_cachedhiddenClassChain.size() == 1);
         // cache hit!
-        obj->m_values[inlineCache.m_cachedIndex] = value;
-        return;
+        if (LIKELY(!inlineCache.m_cachedFieldHasDoubleRepresentation)) {
+            obj->m_values[inlineCache.m_cachedIndex] = value;
+            return;
+        }
+#ifdef ESCARGOT_64
+        if (value.isNumber()) {
+            obj->m_values[inlineCache.m_cachedIndex].setUnboxedDouble(value.asNumber());
+            return;
+        }
+#endif
+        // storing non-number value changes structure. fall through to cache miss
     } else if (inlineCache.m_hiddenClassWillBe) {
         int cSiz = inlineCache.m_cachedhiddenClassChain.size();
         bool miss = false;
@@ -1546,9 +1767,19 @@ ALWAYS_INLINE void ByteCodeInterpreter::setObjectPreComputedCaseOperation(Execut
                 // cache hit!
                 obj = originalObject;
                 ASSERT(!obj->structure()->isStructureWithFastAccess());
-                obj->m_values.push_back(value, inlineCache.m_hiddenClassWillBe->propertyCount());
-                obj->m_structure = inlineCache.m_hiddenClassWillBe;
-                return;
+                if (LIKELY(!inlineCache.m_cachedFieldHasDoubleRepresentation)) {
+                    obj->m_values.push_back(value, inlineCache.m_hiddenClassWillBe->propertyCount());
+                    obj->m_structure = inlineCache.m_hiddenClassWillBe;
+                    return;
+                }
+#ifdef ESCARGOT_64
+                if (value.isDouble()) {
+                    obj->m_values.push_back(SmallValue::fromUnboxedDouble(value.asNumber()), inlineCache.m_hiddenClassWillBe->propertyCount());
+                    obj->m_structure = inlineCache.m_hiddenClassWillBe;
+                    return;
+                }
+#endif
+                // structure for non-number value is different. fall through to cache miss
             }
         }
     }
@@ -1570,6 +1801,12 @@ NEVER_INLINE void ByteCodeInterpreter::setObjectPreComputedCaseOperationCacheMis
         return;
     }
 
+    if (UNLIKELY(originalObject->structure()->isDictionaryMode())) {
+        originalObject->noteInlineCacheMissInDictionaryMode(state);
+        originalObject->setThrowsExceptionWhenStrictMode(state, ObjectPropertyName(state, name), value, willBeObject);
+        return;
+    }
+
     inlineCache.invalidateCache();
     inlineCache.m_cacheMissCount++;
 
@@ -1583,8 +1820,9 @@ NEVER_INLINE void ByteCodeInterpreter::setObjectPreComputedCaseOperationCacheMis
 
         obj->setOwnPropertyThrowsExceptionWhenStrictMode(state, idx, value, willBeObject);
         auto desc = obj->structure()->readProperty(state, idx).m_descriptor;
-        if (desc.isPlainDataProperty() && desc.isWritable()) {
+        if (desc.isPlainDataProperty() && desc.isWritable() && obj->structure() == newItem.m_objectStructure) {
             inlineCache.m_cachedIndex = idx;
+            inlineCache.m_cachedFieldHasDoubleRepresentation = desc.hasDoubleRepresentation();
             inlineCache.m_cachedhiddenClassChain.push_back(newItem);
         }
     } else {
@@ -1601,6 +1839,7 @@ NEVER_INLINE void ByteCodeInterpreter::setObjectPreComputedCaseOperationCacheMis
         Value proto = obj->getPrototype(state);
         while (proto.isObject()) {
             obj = proto.asObject();
+            ASSERT(!obj->structure()->isDictionaryMode());
             newItem.m_objectStructure = obj->structure();
             inlineCache.m_cachedhiddenClassChain.push_back(newItem);
             proto = obj->getPrototype(state);
@@ -1625,6 +1864,8 @@ NEVER_INLINE void ByteCodeInterpreter::setObjectPreComputedCaseOperationCacheMis
         }
 
         inlineCache.m_hiddenClassWillBe = orgObject->structure();
+        const size_t newPropertyCount = inlineCache.m_hiddenClassWillBe->propertyCount();
+        inlineCache.m_cachedFieldHasDoubleRepresentation = inlineCache.m_hiddenClassWillBe->readProperty(state, newPropertyCount - 1).m_descriptor.hasDoubleRepresentation();
     }
 }
 
@@ -2036,7 +2277,7 @@ NEVER_INLINE void ByteCodeInterpreter::declareFunctionDeclarations(ExecutionStat
                 } else {
                     FunctionEnvironmentRecord* record = lexicalEnvironment->record()->asDeclarativeEnvironmentRecord()->asFunctionEnvironmentRecord();
                     ASSERT(record->isFunctionEnvironmentRecordOnHeap() || record->isFunctionEnvironmentRecordNotIndexed());
-                    ((FunctionEnvironmentRecordOnHeap*)record)->m_heapStorage[info.m_indexForIndexedStorage] = fn;
+                    ((FunctionEnvironmentRecordWithHeapSlots*)record)->m_heapSlots[info.m_indexForIndexedStorage] = fn;
                 }
             }
         }
@@ -2094,7 +2335,35 @@ NEVER_INLINE void ByteCodeInterpreter::defineObjectSetter(ExecutionState& state,
     registerFile[code->m_objectRegisterIndex].toObject(state)->defineOwnPropertyThrowsExceptionWhenStrictMode(state, ObjectPropertyName(state, pName), desc);
 }
 
-NEVER_INLINE void ByteCodeInterpreter::processException(ExecutionState& state, const Value& value, ExecutionContext* ecInput, size_t programCounter)
+NEVER_INLINE InterpretedCallFrame* ByteCodeInterpreter::pushCallFrame(ExecutionState& state, FunctionObject* callee, const Value& receiver, size_t argc, Value* argv)
+{
+    InterpreterStack& stack = state.context()->vmInstance()->interpreterStack();
+    size_t frameSize = sizeof(InterpretedCallFrame) + callee->callFrameSize(state);
+    InterpreterStack::Mark mark = stack.mark();
+    InterpretedCallFrame* frame = (InterpretedCallFrame*)stack.allocate(frameSize);
+    if (UNLIKELY(frame == nullptr)) {
+        // interpreter stack is full. callee is called with recursion of interpreter until C++ stack limit
+        return nullptr;
+    }
+
+    try {
+        frame->m_state = callee->prepareCallFrame(state, frame + 1, receiver, argc, argv);
+    } catch (const Value&) {
+        stack.rewind(mark);
+        throw;
+    }
+    frame->m_byteCodeBlock = callee->codeBlock()->asInterpretedCodeBlock()->byteCodeBlock();
+    frame->m_stackMark = mark;
+    return frame;
+}
+
+NEVER_INLINE void ByteCodeInterpreter::processException(ExecutionState& state, const Value& value, ExecutionContext* ec, size_t programCounter)
+{
+    addStackTraceData(state, ec, programCounter);
+    state.context()->m_sandBoxStack.back()->throwException(state, value);
+}
+
+void ByteCodeInterpreter::addStackTraceData(ExecutionState& state, ExecutionContext* ecInput, size_t programCounter)
 {
     ASSERT(state.context()->m_sandBoxStack.size());
     SandBox* sb = state.context()->m_sandBoxStack.back();
@@ -2165,6 +2434,5 @@ NEVER_INLINE void ByteCodeInterpreter::processException(ExecutionState& state, c
             sb->m_stackTraceData.pushBack(std::make_pair(ec, data));
         }
     }
-    sb->throwException(state, value);
 }
 }
@@ -45,6 +45,8 @@ class DeclareFunctionDeclarations;
 class ObjectDefineGetter;
 class ObjectDefineSetter;
 class GlobalObject;
+class FunctionObject;
+struct InterpretedCallFrame;
 
 class ByteCodeInterpreter {
 public:
@@ -88,7 +90,11 @@ public:
     static void defineObjectGetter(ExecutionState& state, ObjectDefineGetter* code, Value* registerFile);
     static void defineObjectSetter(ExecutionState& state, ObjectDefineSetter* code, Value* registerFile);
 
+    // returns nullptr if there is no room for callee on InterpreterStack
+    static InterpretedCallFrame* pushCallFrame(ExecutionState& state, FunctionObject* callee, const Value& receiver, size_t argc, Value* argv);
+
     static void processException(ExecutionState& state, const Value& value, ExecutionContext* ec, size_t programCounter);
+    static void addStackTraceData(ExecutionState& state, ExecutionContext* ec, size_t programCounter);
 };
 }
 
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2018-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#include "Escargot.h"
+#include "InterpreterStack.h"
+
+namespace Escargot {
+
+InterpreterStack::~InterpreterStack()
+{
+    for (size_t i = 0; i < m_chunks.size(); i++) {
+        GC_FREE(m_chunks[i]);
+    }
+}
+
+void* InterpreterStack::allocateSlowCase(size_t size)
+{
+    if (size > INTERPRETER_STACK_CHUNK_SIZE) {
+        return nullptr;
+    }
+
+    // SIZE_MAX + 1 is first chunk
+    size_t next = m_currentChunk + 1;
+    if (next == m_chunks.size()) {
+        if ((next + 1) * INTERPRETER_STACK_CHUNK_SIZE > INTERPRETER_STACK_LIMIT) {
+            return nullptr;
+        }
+        m_chunks.push_back((char*)GC_MALLOC_UNCOLLECTABLE(INTERPRETER_STACK_CHUNK_SIZE));
+        m_chunkTops.push_back(nullptr);
+    }
+
+    if (m_currentChunk != SIZE_MAX) {
+        // released frames of the chunk being left are cleared now, because only current chunk tracks them
+        if (m_dirtyEnd > m_currentPosition) {
+            memset(m_currentPosition, 0, m_dirtyEnd - m_currentPosition);
+        }
+        m_chunkTops[m_currentChunk] = m_currentPosition;
+    }
+
+    char* chunk = m_chunks[next];
+    m_currentChunk = next;
+    m_currentPosition = chunk + size;
+    m_currentEnd = chunk + INTERPRETER_STACK_CHUNK_SIZE;
+    // reused chunk may have released frames from last use
+    m_dirtyEnd = std::max(m_chunkTops[next], m_currentPosition);
+    m_chunkTops[next] = nullptr;
+    return chunk;
+}
+
+void InterpreterStack::rewindSlowCase(const Mark& mark)
+{
+    // chunk above the mark is kept with its released frames. chunks above it are freed
+    size_t kept = mark.m_chunk + 1;
+    char* keptDirtyEnd = (kept == m_currentChunk) ? std::max(m_currentPosition, m_dirtyEnd) : m_chunkTops[kept];
+
+    m_currentChunk = mark.m_chunk;
+    m_currentPosition = mark.m_currentPosition;
+    m_currentEnd = mark.m_currentPosition ? m_chunks[mark.m_chunk] + INTERPRETER_STACK_CHUNK_SIZE : nullptr;
+    m_dirtyEnd = mark.m_currentPosition ? m_chunkTops[mark.m_chunk] : nullptr;
+
+    while (m_chunks.size() > kept + 1) {
+        GC_FREE(m_chunks.back());
+        m_chunks.pop_back();
+        m_chunkTops.pop_back();
+    }
+    m_chunkTops[kept] = keptDirtyEnd;
+}
+
+void InterpreterStack::clearReleasedFrames()
+{
+    if (m_dirtyEnd > m_currentPosition) {
+        memset(m_currentPosition, 0, m_dirtyEnd - m_currentPosition);
+    }
+    m_dirtyEnd = m_currentPosition;
+
+    size_t above = m_currentChunk + 1;
+    if (above < m_chunks.size() && m_chunkTops[above]) {
+        memset(m_chunks[above], 0, m_chunkTops[above] - m_chunks[above]);
+        m_chunkTops[above] = nullptr;
+    }
+}
+}
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2018-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#ifndef __EscargotInterpreterStack__
+#define __EscargotInterpreterStack__
+
+namespace Escargot {
+
+#ifndef INTERPRETER_STACK_CHUNK_SIZE
+#define INTERPRETER_STACK_CHUNK_SIZE (256 * 1024)
+#endif
+
+#ifndef INTERPRETER_STACK_LIMIT
+#define INTERPRETER_STACK_LIMIT (1024 * 1024 * 32) // 32MB
+#endif
+
+// Stack of frames for JS functions which are called inside loop of ByteCodeInterpreter without C++ recursion.
+// Frames are allocated and released in LIFO order.
+// Chunks are allocated as uncollectable memory so GC pointers inside frames are traced.
+// GC scans whole chunks, so released frames would retain dead objects. they are not cleared on every return,
+// but by clearReleasedFrames at the places that clear C++ stack (see clearStack), and when a chunk is left.
+// Incremental GC finds stores into frames with dirty bits of OS, so frames need no write barrier.
+// One chunk above current chunk is kept after rewind, so recursion around chunk boundary does not allocate repeatedly.
+class InterpreterStack {
+public:
+    InterpreterStack()
+        : m_currentChunk(SIZE_MAX)
+        , m_currentPosition(nullptr)
+        , m_currentEnd(nullptr)
+        , m_dirtyEnd(nullptr)
+    {
+    }
+
+    ~InterpreterStack();
+
+    // returns nullptr if frame cannot fit in INTERPRETER_STACK_LIMIT
+    ALWAYS_INLINE void* allocate(size_t size)
+    {
+        size = (size + (sizeof(double) - 1)) & ~(sizeof(double) - 1);
+        if (LIKELY(size <= (size_t)(m_currentEnd - m_currentPosition))) {
+            void* ret = m_currentPosition;
+            m_currentPosition += size;
+            return ret;
+        }
+        return allocateSlowCase(size);
+    }
+
+    struct Mark {
+        size_t m_chunk;
+        char* m_currentPosition;
+    };
+
+    Mark mark()
+    {
+        Mark m;
+        m.m_chunk = m_currentChunk;
+        m.m_currentPosition = m_currentPosition;
+        return m;
+    }
+
+    // release every frame allocated after the mark. released frames are left as they are until clearReleasedFrames.
+    // mark is taken by value because it is usually stored in a frame being released
+    ALWAYS_INLINE void rewind(Mark mark)
+    {
+        if (LIKELY(mark.m_chunk == m_currentChunk)) {
+            if (m_currentPosition > m_dirtyEnd) {
+                m_dirtyEnd = m_currentPosition;
+            }
+            m_currentPosition = mark.m_currentPosition;
+            return;
+        }
+        rewindSlowCase(mark);
+    }
+
+    // zero frames released since last call, so GC does not find dead objects in them
+    void clearReleasedFrames();
+
+private:
+    void* allocateSlowCase(size_t size);
+    void rewindSlowCase(const Mark& mark);
+
+    size_t m_currentChunk;
+    char* m_currentPosition;
+    char* m_currentEnd;
+    // end of memory used by released frames in current chunk
+    char* m_dirtyEnd;
+    std::vector<char*> m_chunks;
+    // top of each chunk below current chunk when next chunk was entered.
+    // for chunk above current chunk, end of memory used by released frames (nullptr if it is clean)
+    std::vector<char*> m_chunkTops;
+};
+}
+
+#endif
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2018-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#include "Escargot.h"
+#include "ASTAllocator.h"
+
+namespace Escargot {
+
+#if defined(ESCARGOT_ENABLE_THREADING)
+thread_local ASTAllocator* ASTAllocator::s_current;
+#else
+ASTAllocator* ASTAllocator::s_current;
+#endif
+
+void* ASTAllocator::allocateSlowCase(size_t size)
+{
+    if (size > AST_ALLOCATOR_CHUNK_SIZE / 4) {
+        // big request gets its own chunk so we don't waste rest of current chunk
+        void* ret = GC_MALLOC_UNCOLLECTABLE(size);
+        m_chunks.push_back(ret);
+        m_allocatedSize += size;
+        return ret;
+    }
+
+    char* chunk = (char*)GC_MALLOC_UNCOLLECTABLE(AST_ALLOCATOR_CHUNK_SIZE);
+    m_chunks.push_back(chunk);
+    m_currentPosition = chunk + size;
+    m_currentEnd = chunk + AST_ALLOCATOR_CHUNK_SIZE;
+    m_allocatedSize += size;
+    return chunk;
+}
+
+void ASTAllocator::release()
+{
+    ASSERT(s_current != this);
+    for (size_t i = 0; i < m_chunks.size(); i++) {
+        GC_FREE(m_chunks[i]);
+    }
+    m_chunks.clear();
+    m_currentPosition = m_currentEnd = nullptr;
+    m_allocatedSize = 0;
+}
+}
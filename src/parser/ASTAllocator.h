@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2018-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#ifndef __EscargotASTAllocator__
+#define __EscargotASTAllocator__
+
+namespace Escargot {
+
+#ifndef AST_ALLOCATOR_CHUNK_SIZE
+#define AST_ALLOCATOR_CHUNK_SIZE (32 * 1024)
+#endif
+
+// Bump pointer arena for AST nodes and scanner tokens.
+// Every allocation made while parsing (and generating bytecode from) one source
+// is released at once when the allocator is destroyed.
+// Chunks are allocated as uncollectable memory so GC pointers inside nodes are traced.
+class ASTAllocator {
+public:
+    ASTAllocator()
+        : m_currentPosition(nullptr)
+        , m_currentEnd(nullptr)
+        , m_allocatedSize(0)
+    {
+    }
+
+    ~ASTAllocator()
+    {
+        release();
+    }
+
+    ALWAYS_INLINE void* allocate(size_t size)
+    {
+        size = (size + (sizeof(double) - 1)) & ~(sizeof(double) - 1);
+        if (LIKELY(size <= (size_t)(m_currentEnd - m_currentPosition))) {
+            void* ret = m_currentPosition;
+            m_currentPosition += size;
+            m_allocatedSize += size;
+            return ret;
+        }
+        return allocateSlowCase(size);
+    }
+
+    void release();
+
+    size_t allocatedSize()
+    {
+        return m_allocatedSize;
+    }
+
+    static ASTAllocator* current()
+    {
+        return s_current;
+    }
+
+private:
+    friend class ASTAllocatorScope;
+    void* allocateSlowCase(size_t size);
+
+    char* m_currentPosition;
+    char* m_currentEnd;
+    size_t m_allocatedSize;
+    std::vector<void*> m_chunks;
+
+#if defined(ESCARGOT_ENABLE_THREADING)
+    static thread_local ASTAllocator* s_current;
+#else
+    static ASTAllocator* s_current;
+#endif
+};
+
+// Makes given allocator the target of AST node and token allocation while this scope is alive
+class ASTAllocatorScope {
+    MAKE_STACK_ALLOCATED();
+
+public:
+    explicit ASTAllocatorScope(ASTAllocator* allocator)
+        : m_previous(ASTAllocator::s_current)
+    {
+        ASTAllocator::s_current = allocator;
+    }
+
+    ~ASTAllocatorScope()
+    {
+        ASTAllocator::s_current = m_previous;
+    }
+
+private:
+    ASTAllocator* m_previous;
+};
+}
+
+#endif
@@ -28,6 +28,7 @@ namespace Escargot {
 
 void* CodeBlock::operator new(size_t size)
 {
+    ESCARGOT_PROFILE_ALLOCATION(CodeBlock, size);
 #ifdef GC_DEBUG
     return CustomAllocator<CodeBlock>().allocate(1);
 #else
@@ -46,6 +47,7 @@ void* CodeBlock::operator new(size_t size)
 
 void* InterpretedCodeBlock::operator new(size_t size)
 {
+    ESCARGOT_PROFILE_ALLOCATION(InterpretedCodeBlock, size);
 #ifdef GC_DEBUG
     return CustomAllocator<InterpretedCodeBlock>().allocate(1);
 #else
@@ -87,6 +87,7 @@ class CodeBlock : public gc {
     friend class Script;
     friend class ScriptParser;
     friend class ByteCodeGenerator;
+    friend class ByteCodeBlock;
     friend class FunctionObject;
     friend class InterpretedCodeBlock;
     friend int getValidValueInCodeBlock(void* ptr, GC_mark_custom_result* arr);
@@ -28,22 +28,89 @@
 #include "runtime/EnvironmentRecord.h"
 #include "runtime/ErrorObject.h"
 #include "runtime/SandBox.h"
+#include "runtime/VMInstance.h"
 #include "util/Util.h"
 #include "parser/ast/AST.h"
+#include "parser/esprima_cpp/esprima.h"
 
 namespace Escargot {
 
-Value Script::execute(ExecutionState& state, bool isEvalMode, bool needNewEnv, bool isOnGlobal)
+Script::Script(String* fileName, String* src, ASTAllocator* astAllocator)
+    : m_fileName(fileName)
+    , m_src(src)
+    , m_topCodeBlock(nullptr)
+    , m_astAllocator(astAllocator)
+    , m_isByteCodeBlockGenerated(false)
+    , m_lineStartsComputed(false)
+{
+    GC_REGISTER_FINALIZER_NO_ORDER(this, [](void* obj,
+                                            void*) {
+        Script* self = (Script*)obj;
+        delete self->m_astAllocator;
+    },
+                                   nullptr, nullptr, nullptr);
+}
+
+void Script::generateByteCodeBlock(Context* context, bool isEvalMode, bool isOnGlobal)
+{
+    ASSERT(!m_isByteCodeBlockGenerated);
+    ASSERT(m_astAllocator);
+    {
+        ASTAllocatorScope allocatorScope(m_astAllocator);
+        RefPtr<Node> programNode = m_topCodeBlock->cachedASTNode();
+        ASSERT(programNode && programNode->type() == ASTNodeType::Program);
+        if (m_topCodeBlock->m_cachedASTNode) {
+            m_topCodeBlock->m_cachedASTNode->deref();
+        }
+        m_topCodeBlock->m_cachedASTNode = nullptr;
+
+        ByteCodeGenerator g;
+        m_topCodeBlock->m_byteCodeBlock = g.generateByteCode(context, m_topCodeBlock, programNode.get(), ((ProgramNode*)programNode.get())->scopeContext(), isEvalMode, isOnGlobal);
+    }
+    // whole AST is released at once here
+    delete m_astAllocator;
+    m_astAllocator = nullptr;
+    m_isByteCodeBlockGenerated = true;
+}
+
+ExtendedNodeLOC Script::computeNodeLOC(size_t index, const ExtendedNodeLOC& codeBlockStart)
 {
-    RefPtr<Node> programNode = m_topCodeBlock->cachedASTNode();
-    if (m_topCodeBlock->m_cachedASTNode) {
-        m_topCodeBlock->m_cachedASTNode->deref();
+    if (!m_lineStartsComputed) {
+        const StringBufferAccessData& data = m_src->bufferAccessData();
+        for (size_t i = 0; i < data.length; i++) {
+            char16_t c = data.charAt(i);
+            if (esprima::isLineTerminator(c)) {
+                // skip \r\n
+                if (c == 13 && i + 1 < data.length && data.charAt(i + 1) == 10) {
+                    i++;
+                }
+                m_lineStarts.pushBack(i + 1);
+            }
+        }
+        m_lineStartsComputed = true;
     }
-    m_topCodeBlock->m_cachedASTNode = nullptr;
-    ASSERT(programNode && programNode->type() == ASTNodeType::Program);
 
-    ByteCodeGenerator g;
-    m_topCodeBlock->m_byteCodeBlock = g.generateByteCode(state.context(), m_topCodeBlock, programNode.get(), ((ProgramNode*)programNode.get())->scopeContext(), isEvalMode, isOnGlobal);
+    // lines started in (codeBlockStart.index, index]
+    size_t* begin = m_lineStarts.data();
+    size_t* end = begin + m_lineStarts.size();
+    size_t* first = std::upper_bound(begin, end, codeBlockStart.index);
+    size_t* last = std::upper_bound(first, end, index);
+    if (first == last) {
+        return ExtendedNodeLOC(codeBlockStart.line, codeBlockStart.column + index - codeBlockStart.index, index);
+    }
+    return ExtendedNodeLOC(codeBlockStart.line + (last - first), index - *(last - 1) + 1, index);
+}
+
+Value Script::execute(ExecutionState& state, bool isEvalMode, bool needNewEnv, bool isOnGlobal)
+{
+    if (m_isByteCodeBlockGenerated) {
+        // generated by previous execution
+        // isOnGlobal only matters to eval code
+        ASSERT(!isEvalMode && !m_topCodeBlock->byteCodeBlock()->m_isEvalMode);
+        m_topCodeBlock->byteCodeBlock()->m_isOnGlobal = isOnGlobal;
+    } else {
+        generateByteCodeBlock(state.context(), isEvalMode, isOnGlobal);
+    }
 
     LexicalEnvironment* env;
     ExecutionContext* prevEc;
@@ -78,6 +145,7 @@ Value Script::execute(ExecutionState& state, bool isEvalMode, bool needNewEnv, b
 
     size_t unused;
     Value resultValue = ByteCodeInterpreter::interpret(newState, m_topCodeBlock->byteCodeBlock(), 0, registerFile, &unused);
+    state.context()->vmInstance()->interpreterStack().clearReleasedFrames();
     clearStack<512>();
 
     return resultValue;
@@ -110,13 +178,6 @@ Script::ScriptSandboxExecuteResult Script::sandboxExecute(ExecutionState& state)
 // NOTE: eval by direct call
 Value Script::executeLocal(ExecutionState& state, Value thisValue, InterpretedCodeBlock* parentCodeBlock, bool isEvalMode, bool needNewRecord)
 {
-    RefPtr<Node> programNode = m_topCodeBlock->cachedASTNode();
-    ASSERT(programNode && programNode->type() == ASTNodeType::Program);
-    if (m_topCodeBlock->m_cachedASTNode) {
-        m_topCodeBlock->m_cachedASTNode->deref();
-    }
-    m_topCodeBlock->m_cachedASTNode = nullptr;
-
     bool isOnGlobal = true;
     FunctionEnvironmentRecord* fnRecord = nullptr;
     {
@@ -131,8 +192,7 @@ Value Script::executeLocal(ExecutionState& state, Value thisValue, InterpretedCo
         }
     }
 
-    ByteCodeGenerator g;
-    m_topCodeBlock->m_byteCodeBlock = g.generateByteCode(state.context(), m_topCodeBlock, programNode.get(), ((ProgramNode*)programNode.get())->scopeContext(), isEvalMode, isOnGlobal);
+    generateByteCodeBlock(state.context(), isEvalMode, isOnGlobal);
 
     EnvironmentRecord* record;
     bool inStrict = false;
@@ -185,6 +245,7 @@ Value Script::executeLocal(ExecutionState& state, Value thisValue, InterpretedCo
 
     size_t unused;
     Value resultValue = ByteCodeInterpreter::interpret(newState, m_topCodeBlock->byteCodeBlock(), 0, registerFile, &unused);
+    state.context()->vmInstance()->interpreterStack().clearReleasedFrames();
     clearStack<512>();
 
     return resultValue;
@@ -26,16 +26,13 @@ namespace Escargot {
 
 class InterpretedCodeBlock;
 class Context;
+class ASTAllocator;
+struct ExtendedNodeLOC;
 
 class Script : public gc {
     friend class ScriptParser;
     friend class GlobalObject;
-    Script(String* fileName, String* src)
-        : m_fileName(fileName)
-        , m_src(src)
-        , m_topCodeBlock(nullptr)
-    {
-    }
+    Script(String* fileName, String* src, ASTAllocator* astAllocator);
 
 public:
     struct ScriptSandboxExecuteResult {
@@ -69,11 +66,24 @@ public:
         return m_topCodeBlock;
     }
 
+    // compute location of index of source relatively to start of code block
+    // line terminators of source are indexed once when this is called first time
+    ExtendedNodeLOC computeNodeLOC(size_t index, const ExtendedNodeLOC& codeBlockStart);
+
 protected:
     Value executeLocal(ExecutionState& state, Value thisValue, InterpretedCodeBlock* parentCodeBlock, bool isEvalMode = false, bool needNewEnv = false);
+    // generate bytecode of top code block from cached AST and release the AST
+    void generateByteCodeBlock(Context* context, bool isEvalMode, bool isOnGlobal);
     String* m_fileName;
     String* m_src;
     InterpretedCodeBlock* m_topCodeBlock;
+    // owns AST of top code block until bytecode is generated.
+    // script which is never executed releases it when collected
+    ASTAllocator* m_astAllocator;
+    bool m_isByteCodeBlockGenerated;
+    // start index of every line except first line
+    Vector<size_t, GCUtil::gc_malloc_atomic_ignore_off_page_allocator<size_t>> m_lineStarts;
+    bool m_lineStartsComputed;
 };
 }
 
@@ -26,6 +26,7 @@
 #include "parser/ScriptParser.h"
 #include "parser/ast/AST.h"
 #include "parser/CodeBlock.h"
+#include "util/Util.h"
 
 namespace Escargot {
 
@@ -167,7 +168,8 @@ void ScriptParser::generateCodeBlockTreeFromASTWalkerPostProcess(InterpretedCode
     }
     cb->computeVariables();
     if (cb->m_identifierOnStackCount > VARIABLE_LIMIT || cb->m_identifierOnHeapCount > VARIABLE_LIMIT) {
-        auto err = new esprima::Error(new ASCIIString("variable limit exceeded"));
+        // thrown pointer is not seen by GC, so error is uncollectable like errors of esprima
+        auto err = new (NoGC) esprima::Error(new ASCIIString("variable limit exceeded"));
         err->errorCode = ErrorObject::SyntaxError;
         err->lineNumber = cb->m_sourceElementStart.line;
         err->column = cb->m_sourceElementStart.column;
@@ -177,17 +179,33 @@ void ScriptParser::generateCodeBlockTreeFromASTWalkerPostProcess(InterpretedCode
 }
 
 ScriptParser::ScriptParserResult ScriptParser::parse(StringView scriptSource, String* fileName, InterpretedCodeBlock* parentCodeBlock, bool strictFromOutside, bool isEvalCodeInFunction, size_t stackSizeRemain)
+{
+    m_context->vmInstance()->m_parsedSourceCodes.push_back(scriptSource.string());
+    GC_disable();
+    ScriptParserResult result = parseSource(scriptSource, fileName, parentCodeBlock, strictFromOutside, isEvalCodeInFunction, stackSizeRemain);
+    GC_enable();
+    return result;
+}
+
+ScriptParser::ScriptParserResult ScriptParser::parseSource(StringView scriptSource, String* fileName, InterpretedCodeBlock* parentCodeBlock, bool strictFromOutside, bool isEvalCodeInFunction, size_t stackSizeRemain)
 {
     Script* script = nullptr;
     ScriptParseError* error = nullptr;
 
-    GC_disable();
+    // AST is alive until Script::execute generates bytecode from it
+    ASTAllocator* allocator = new ASTAllocator();
 
     try {
-        m_context->vmInstance()->m_parsedSourceCodes.push_back(scriptSource.string());
+        ASTAllocatorScope allocatorScope(allocator);
+#ifndef NDEBUG
+        uint64_t parseStartTime = longTickCount();
+#endif
         RefPtr<ProgramNode> program = esprima::parseProgram(m_context, scriptSource, nullptr, strictFromOutside, stackSizeRemain);
+#ifndef NDEBUG
+        uint64_t parseTime = longTickCount() - parseStartTime;
+#endif
 
-        script = new Script(fileName, new StringView(scriptSource));
+        script = new Script(fileName, new StringView(scriptSource), allocator);
         InterpretedCodeBlock* topCodeBlock;
         if (parentCodeBlock) {
             program->scopeContext()->m_hasEval = parentCodeBlock->hasEval();
@@ -254,10 +272,28 @@ ScriptParser::ScriptParserResult ScriptParser::parse(StringView scriptSource, St
             };
             fn(topCodeBlock, 0);
         }
+
+        if (getenv("DUMP_PREPARSE_STATS") && strlen(getenv("DUMP_PREPARSE_STATS"))) {
+            // parse the source again building AST of every function body
+            // to see what checking function bodies without building AST saves
+            ASTAllocator eagerAllocator;
+            uint64_t eagerParseStartTime = longTickCount();
+            {
+                ASTAllocatorScope eagerAllocatorScope(&eagerAllocator);
+                esprima::parseProgram(m_context, scriptSource, nullptr, strictFromOutside, stackSizeRemain, true);
+            }
+            uint64_t eagerParseTime = longTickCount() - eagerParseStartTime;
+            printf("Parse time %lluus (%lluus saved), AST bytes %zu (%zu saved)\n", (unsigned long long)parseTime, (unsigned long long)(eagerParseTime - std::min(parseTime, eagerParseTime)),
+                   allocator->allocatedSize(), eagerAllocator.allocatedSize() - std::min(allocator->allocatedSize(), eagerAllocator.allocatedSize()));
+        }
 #endif
 
     } catch (esprima::Error* orgError) {
-        script = nullptr;
+        if (script) {
+            // allocator is deleted below, not by finalizer of script
+            script->m_astAllocator = nullptr;
+            script = nullptr;
+        }
         error = new ScriptParseError();
         error->column = orgError->column;
         error->description = orgError->description;
@@ -267,10 +303,9 @@ ScriptParser::ScriptParserResult ScriptParser::parse(StringView scriptSource, St
         error->name = orgError->name;
         error->errorCode = orgError->errorCode;
         delete orgError;
+        delete allocator;
     }
 
-    GC_enable();
-
     ScriptParser::ScriptParserResult result(script, error);
     return result;
 }
@@ -285,4 +320,46 @@ std::tuple<RefPtr<Node>, ASTScopeContext*> ScriptParser::parseFunction(Interpret
         RELEASE_ASSERT_NOT_REACHED();
     }
 }
+
+#if defined(ESCARGOT_ENABLE_THREADING)
+BackgroundParseTask* ScriptParser::createBackgroundParseTask(String* script, String* fileName)
+{
+    return new (NoGC) BackgroundParseTask(this, script, fileName);
+}
+
+ScriptParser::ScriptParserResult ScriptParser::finalizeBackgroundParseTask(BackgroundParseTask* task)
+{
+    ASSERT(task->m_parser == this);
+    ScriptParserResult result = task->m_result;
+    if (result.m_script) {
+        m_context->vmInstance()->m_parsedSourceCodes.push_back(task->m_source);
+    }
+    delete task;
+    return result;
+}
+
+void BackgroundParseTask::run()
+{
+    bool shouldRegisterThread = !GC_thread_is_registered();
+    if (shouldRegisterThread) {
+        struct GC_stack_base stackBase;
+        GC_get_stack_base(&stackBase);
+        GC_register_my_thread(&stackBase);
+    }
+
+    // GC is not disabled here because GC_disable stops collection of every thread.
+    // other threads can collect while this thread parses, so everything parser makes stays reachable from roots:
+    // - nodes and tokens live in ASTAllocator chunks which are uncollectable, so GC scans them as roots
+    // - scope contexts, literal strings and code blocks are pointed by the chunks, the stack of this thread or the task
+    // - atomic strings are kept by AtomicStringMap
+    // - thrown parse errors are uncollectable until ScriptParser::parseSource deletes them
+    // bytecode is not generated here because ByteCodeGenerator is not thread-safe.
+    // Script::execute generates it on the owning thread like for scripts parsed synchronously
+    m_result = m_parser->parseSource(StringView(m_source, 0, m_source->length()), m_fileName, nullptr, false, false, SIZE_MAX);
+
+    if (shouldRegisterThread) {
+        GC_unregister_my_thread();
+    }
+}
+#endif
 }
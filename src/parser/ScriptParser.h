@@ -32,6 +32,9 @@ class InterpretedCodeBlock;
 class Context;
 class ProgramNode;
 class Node;
+#if defined(ESCARGOT_ENABLE_THREADING)
+class BackgroundParseTask;
+#endif
 typedef Vector<void*, GCUtil::gc_malloc_ignore_off_page_allocator<void*>, 150> LiteralValueRooterVector;
 
 class ScriptParser : public gc {
@@ -65,13 +68,52 @@ public:
     ScriptParserResult parse(StringView script, String* fileName = String::emptyString, InterpretedCodeBlock* parentCodeBlock = nullptr, bool strictFromOutside = false, bool isEvalCodeInFunction = false, size_t stackSizeRemain = SIZE_MAX);
     std::tuple<RefPtr<Node>, ASTScopeContext*> parseFunction(InterpretedCodeBlock* codeBlock, size_t stackSizeRemain, ExecutionState* state = nullptr);
 
+#if defined(ESCARGOT_ENABLE_THREADING)
+    // these two functions should be called on the thread which owns the context.
+    // BackgroundParseTask::run can be called on any thread between them
+    BackgroundParseTask* createBackgroundParseTask(String* script, String* fileName = String::emptyString);
+    ScriptParserResult finalizeBackgroundParseTask(BackgroundParseTask* task);
+#endif
+
 protected:
+    friend class BackgroundParseTask;
+    // this does not touch any state of VMInstance except AtomicStringMap.
+    // caller decides whether GC is disabled while parsing
+    ScriptParserResult parseSource(StringView script, String* fileName, InterpretedCodeBlock* parentCodeBlock, bool strictFromOutside, bool isEvalCodeInFunction, size_t stackSizeRemain);
     InterpretedCodeBlock* generateCodeBlockTreeFromAST(Context* ctx, StringView source, Script* script, ProgramNode* program);
     InterpretedCodeBlock* generateCodeBlockTreeFromASTWalker(Context* ctx, StringView source, Script* script, ASTScopeContext* scopeCtx, InterpretedCodeBlock* parentCodeBlock);
     void generateCodeBlockTreeFromASTWalkerPostProcess(InterpretedCodeBlock* cb);
 
     Context* m_context;
 };
+
+#if defined(ESCARGOT_ENABLE_THREADING)
+// parses source on another thread. bytecode is generated on the owning thread when the script is executed.
+// result is not reachable from the context until ScriptParser::finalizeBackgroundParseTask
+// so task is allocated as uncollectable memory and roots its inputs and result
+class BackgroundParseTask : public gc {
+    friend class ScriptParser;
+
+public:
+    // calling thread is registered to GC while running if it is not registered yet
+    // the thread should have STACK_LIMIT_FROM_BASE bytes of stack at least
+    void run();
+
+private:
+    BackgroundParseTask(ScriptParser* parser, String* source, String* fileName)
+        : m_parser(parser)
+        , m_source(source)
+        , m_fileName(fileName)
+        , m_result(nullptr, nullptr)
+    {
+    }
+
+    ScriptParser* m_parser;
+    String* m_source;
+    String* m_fileName;
+    ScriptParser::ScriptParserResult m_result;
+};
+#endif
 }
 
 #endif
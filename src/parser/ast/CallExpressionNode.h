@@ -92,6 +92,77 @@ public:
         return ret;
     }
 
+    // Math.xxx(...) with arguments of intrinsic can be run by CallMathIntrinsic.
+    // Math may be shadowed or replaced, so interpreter checks callee again
+    bool isMathIntrinsicCall(ByteCodeBlock* codeBlock, MathIntrinsicKind& kind)
+    {
+        MemberExpressionNode* callee = m_callee->asMemberExpression();
+        if (!callee->isPreComputedCase() || !callee->object()->isIdentifier()) {
+            return false;
+        }
+
+        const StaticStrings& strings = codeBlock->m_codeBlock->context()->staticStrings();
+        if (callee->object()->asIdentifier()->name() != strings.Math) {
+            return false;
+        }
+
+        AtomicString name = callee->propertyName();
+#define CHECK_MATH_INTRINSIC(lname, Name, argc)                  \
+    if (name == strings.lname && m_arguments.size() == argc) { \
+        kind = Math##Name##Intrinsic;                           \
+        return true;                                            \
+    }
+        FOR_EACH_MATH_INTRINSIC(CHECK_MATH_INTRINSIC)
+#undef CHECK_MATH_INTRINSIC
+        return false;
+    }
+
+    // spec loads callee before evaluating arguments. CallMathIntrinsic loads it after them only when
+    // arguments are literals or declared variables, which cannot run code that changes Math
+    // (variables declared in global code are not configurable, so they cannot become accessors)
+    bool canLoadCalleeAfterArguments(ByteCodeBlock* codeBlock, ByteCodeGenerateContext* context)
+    {
+        if (context->m_isWithScope) {
+            return false;
+        }
+        InterpretedCodeBlock* cb = codeBlock->m_codeBlock->asInterpretedCodeBlock();
+        for (size_t i = 0; i < m_arguments.size(); i++) {
+            Node* argument = m_arguments[i].get();
+            if (argument->isLiteral()) {
+                continue;
+            }
+            if (argument->isIdentifier()) {
+                AtomicString name = argument->asIdentifier()->name();
+                if (cb->indexedIdentifierInfo(name).m_isResultSaved || (cb->isGlobalScopeCodeBlock() && cb->hasName(name))) {
+                    continue;
+                }
+            }
+            return false;
+        }
+        return true;
+    }
+
+    // xxx.charAt(i) or xxx.charCodeAt(i) can be run by CallStringIntrinsic.
+    // receiver may not be string, so interpreter checks receiver and callee
+    bool isStringIntrinsicCall(ByteCodeBlock* codeBlock, CallStringIntrinsic::Kind& kind)
+    {
+        MemberExpressionNode* callee = m_callee->asMemberExpression();
+        if (!callee->isPreComputedCase() || m_arguments.size() != 1) {
+            return false;
+        }
+
+        const StaticStrings& strings = codeBlock->m_codeBlock->context()->staticStrings();
+        AtomicString name = callee->propertyName();
+        if (name == strings.charAt) {
+            kind = CallStringIntrinsic::CharAt;
+            return true;
+        } else if (name == strings.charCodeAt) {
+            kind = CallStringIntrinsic::CharCodeAt;
+            return true;
+        }
+        return false;
+    }
+
     static bool canUseDirectRegister(ByteCodeGenerateContext* context, Node* callee, const ArgumentVector& args)
     {
         if (!context->m_canSkipCopyToRegister) {
@@ -173,8 +244,19 @@ public:
         size_t receiverIndex = SIZE_MAX;
         size_t calleeIndex = SIZE_MAX;
 
+        MathIntrinsicKind intrinsicKind;
+        bool isMathIntrinsic = isCalleeHasReceiver && isMathIntrinsicCall(codeBlock, intrinsicKind);
+        bool isCalleeLoaded = !isMathIntrinsic || !canLoadCalleeAfterArguments(codeBlock, context);
+
         calleeIndex = m_callee->getRegister(codeBlock, context);
-        m_callee->generateExpressionByteCode(codeBlock, context, calleeIndex);
+        if (!isCalleeLoaded) {
+            // only Math is loaded. CallMathIntrinsic loads callee into calleeIndex when it calls function
+            Node* math = m_callee->asMemberExpression()->object();
+            context->m_isHeadOfMemberExpression = false;
+            math->generateExpressionByteCode(codeBlock, context, math->getRegister(codeBlock, context));
+        } else {
+            m_callee->generateExpressionByteCode(codeBlock, context, calleeIndex);
+        }
 
 
         if (isCalleeHasReceiver) {
@@ -191,7 +273,12 @@ public:
             context->giveUpRegister();
         }
 
-        if (isCalleeHasReceiver) {
+        CallStringIntrinsic::Kind stringIntrinsicKind;
+        if (isMathIntrinsic) {
+            codeBlock->pushCode(CallMathIntrinsic(ByteCodeLOC(m_loc.index), intrinsicKind, isCalleeLoaded, m_callee->asMemberExpression()->propertyName(), receiverIndex, calleeIndex, argumentsStartIndex, m_arguments.size(), dstRegister), context, this);
+        } else if (isCalleeHasReceiver && isStringIntrinsicCall(codeBlock, stringIntrinsicKind)) {
+            codeBlock->pushCode(CallStringIntrinsic(ByteCodeLOC(m_loc.index), stringIntrinsicKind, receiverIndex, calleeIndex, argumentsStartIndex, m_arguments.size(), dstRegister), context, this);
+        } else if (isCalleeHasReceiver) {
             codeBlock->pushCode(CallFunctionWithReceiver(ByteCodeLOC(m_loc.index), receiverIndex, calleeIndex, argumentsStartIndex, m_arguments.size(), dstRegister), context, this);
         } else {
             codeBlock->pushCode(CallFunction(ByteCodeLOC(m_loc.index), calleeIndex, argumentsStartIndex, m_arguments.size(), dstRegister), context, this);
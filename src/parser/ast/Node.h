@@ -22,6 +22,7 @@
 
 #include "runtime/AtomicString.h"
 #include "runtime/Value.h"
+#include "parser/ASTAllocator.h"
 
 namespace Escargot {
 
@@ -184,12 +185,13 @@ public:
 
     inline void *operator new(size_t size)
     {
-        return GC_MALLOC_UNCOLLECTABLE(size);
+        ASSERT(ASTAllocator::current());
+        return ASTAllocator::current()->allocate(size);
     }
 
     inline void operator delete(void *obj)
     {
-        GC_FREE(obj);
+        // memory of node is released with its ASTAllocator
     }
 
     bool isIdentifier()
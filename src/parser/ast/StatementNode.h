@@ -54,6 +54,16 @@ public:
         return adoptRef(new StatementContainer());
     }
 
+    inline void* operator new(size_t size)
+    {
+        ASSERT(ASTAllocator::current());
+        return ASTAllocator::current()->allocate(size);
+    }
+
+    inline void operator delete(void* obj)
+    {
+    }
+
     ~StatementContainer()
     {
         RefPtr<StatementNode> c = m_firstChild.release();
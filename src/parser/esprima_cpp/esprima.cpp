@@ -699,10 +699,16 @@ public:
     size_t lineNumber;
     size_t lineStart;
     std::vector<Curly> curlyStack;
+    // buffer of source if it has 8-bit content, otherwise nullptr.
+    // Latin-1 source cannot have U+2028, U+2029 and surrogates so scanning loops can be simplified
+    const LChar* source8Bit;
     bool isPoolEnabled;
     ScannerResult* initialResultMemoryPool[SCANNER_RESULT_POOL_INITIAL_SIZE];
     size_t initialResultMemoryPoolSize;
     std::vector<ScannerResult*, gc_allocator<ScannerResult*>> resultMemoryPool;
+    // released results are recycled through resultMemoryPool
+    // so overflowing results should come from allocator which lives as long as scanner
+    ASTAllocator* allocator;
     char scannerResultInnerPool[SCANNER_RESULT_POOL_INITIAL_SIZE * sizeof(ScannerResult)];
 
     ~Scanner()
@@ -717,9 +723,11 @@ public:
         isPoolEnabled = true;
         source = code;
         errorHandler = handler;
+        allocator = ASTAllocator::current();
         // trackComment = false;
 
         length = code.length();
+        source8Bit = code.has8BitContent() ? (const LChar*)code.bufferAccessData().buffer : nullptr;
         index = 0;
         lineNumber = ((length > 0) ? 1 : 0) + startLine;
         lineStart = startColumn;
@@ -738,7 +746,7 @@ public:
             initialResultMemoryPoolSize--;
             return initialResultMemoryPool[initialResultMemoryPoolSize];
         } else if (resultMemoryPool.size() == 0) {
-            auto ret = (ScannerResult*)GC_MALLOC(sizeof(ScannerResult));
+            auto ret = (ScannerResult*)allocator->allocate(sizeof(ScannerResult));
             return ret;
         } else {
             auto ret = resultMemoryPool.back();
@@ -787,6 +795,16 @@ public:
             };
         }*/
 
+        if (this->source8Bit) {
+            const LChar* buffer = this->source8Bit;
+            size_t idx = this->index;
+            const size_t end = this->length;
+            while (idx < end && buffer[idx] != '\n' && buffer[idx] != '\r') {
+                idx++;
+            }
+            this->index = idx;
+        }
+
         while (!this->eof()) {
             char16_t ch = this->source.bufferedCharAt(this->index);
             ++this->index;
@@ -853,6 +871,19 @@ public:
         }
          */
         while (!this->eof()) {
+            if (this->source8Bit) {
+                const LChar* buffer = this->source8Bit;
+                size_t idx = this->index;
+                const size_t end = this->length;
+                while (idx < end && buffer[idx] != '*' && buffer[idx] != '\n' && buffer[idx] != '\r') {
+                    idx++;
+                }
+                this->index = idx;
+                if (idx == end) {
+                    break;
+                }
+            }
+
             char16_t ch = this->source.bufferedCharAt(this->index);
             if (isLineTerminator(ch)) {
                 if (ch == 0x0D && this->source.bufferedCharAt(this->index + 1) == 0x0A) {
@@ -918,6 +949,13 @@ public:
 
             if (isWhiteSpace(ch)) {
                 ++this->index;
+                if (this->source8Bit) {
+                    // indentation usually comes as a run of spaces or tabs
+                    const LChar* buffer = this->source8Bit;
+                    while (this->index < this->length && (buffer[this->index] == ' ' || buffer[this->index] == '\t')) {
+                        ++this->index;
+                    }
+                }
             } else if (isLineTerminator(ch)) {
                 ++this->index;
                 if (ch == 0x0D && this->source.bufferedCharAt(this->index) == 0x0A) {
@@ -1323,6 +1361,31 @@ public:
     StringView getIdentifier()
     {
         const size_t start = this->index++;
+        if (this->source8Bit) {
+            const LChar* buffer = this->source8Bit;
+            size_t idx = this->index;
+            const size_t end = this->length;
+            while (idx < end) {
+                const LChar ch = buffer[idx];
+                if (LIKELY(ch < 128)) {
+                    if (!(g_asciiRangeCharMap[ch] & ESPRIMA_IS_IDENT)) {
+                        break;
+                    }
+                } else if (!isIdentifierPartSlow(ch)) {
+                    break;
+                }
+                idx++;
+            }
+            this->index = idx;
+            if (UNLIKELY(idx < end && buffer[idx] == 0x5C)) {
+                // Blackslash (U+005C) marks Unicode escape sequence.
+                this->index = start;
+                return this->getComplexIdentifier();
+            }
+            // identifier is a view of source. no copy here
+            return StringView(this->source, start, idx);
+        }
+
         while (UNLIKELY(!this->eof())) {
             const char16_t ch = this->source.bufferedCharAt(this->index);
             if (UNLIKELY(ch == 0x5C)) {
@@ -1971,6 +2034,22 @@ public:
         size_t plainCaseStart = start + 1;
         size_t plainCaseEnd = start + 1;
 
+        if (this->source8Bit) {
+            // skip plain characters at once
+            const LChar* buffer = this->source8Bit;
+            size_t idx = this->index;
+            const size_t end = this->length;
+            while (idx < end) {
+                const LChar ch = buffer[idx];
+                if (ch == quote || ch == '\\' || ch == '\n' || ch == '\r') {
+                    break;
+                }
+                idx++;
+            }
+            plainCaseEnd += idx - this->index;
+            this->index = idx;
+        }
+
 #define CONVERT_UNPLAIN_CASE_IF_NEEDED()                                                   \
     if (isPlainCase) {                                                                     \
         auto temp = StringView(this->source, start + 1, plainCaseEnd).toUTF16StringData(); \
@@ -2480,6 +2559,7 @@ struct Config : public gc {
     bool comment : 1;
     bool tolerant : 1;
     bool parseSingleFunction : 1;
+    bool eagerlyParseFunctionBodies : 1; // build AST of every function body while parsing program (used for measuring)
     CodeBlock* parseSingleFunctionTarget;
     SmallValue parseSingleFunctionChildIndex; // use SmallValue for saving index. this reduce memory leak from stack
 };
@@ -2496,7 +2576,6 @@ struct Context : public gc {
     bool inCatch : 1;
     bool inArrowFunction : 1;
     bool inDirectCatchScope : 1;
-    bool inParsingDirective : 1;
     bool inWith : 1;
     bool inLoop : 1;
     bool strict : 1;
@@ -2517,6 +2596,632 @@ struct MetaNode : public gc {
     size_t column;
 };
 
+// Parse functions of Parser are templates over an AST builder.
+// NodeGenerator builds AST nodes. SyntaxChecker builds nothing but SyntaxNodes that carry
+// what the grammar reads back for early errors and scope analysis (node type and identifier name).
+// While parsing program, bodies of functions are parsed with SyntaxChecker
+// and parseSingleFunction builds AST of a function with NodeGenerator when it is called first time.
+
+// <node class name without Node suffix, ASTNodeType>
+#define FOR_EACH_ESPRIMA_UNARY_NODE(F)                                    \
+    F(UnaryExpressionBitwiseNot, UnaryExpressionBitwiseNot)               \
+    F(UnaryExpressionDelete, UnaryExpressionDelete)                       \
+    F(UnaryExpressionLogicalNot, UnaryExpressionLogicalNot)               \
+    F(UnaryExpressionMinus, UnaryExpressionMinus)                         \
+    F(UnaryExpressionPlus, UnaryExpressionPlus)                           \
+    F(UnaryExpressionTypeOf, UnaryExpressionTypeOf)                       \
+    F(UnaryExpressionVoid, UnaryExpressionVoid)                           \
+    F(UpdateExpressionDecrementPostfix, UpdateExpressionDecrementPostfix) \
+    F(UpdateExpressionDecrementPrefix, UpdateExpressionDecrementPrefix)   \
+    F(UpdateExpressionIncrementPostfix, UpdateExpressionIncrementPostfix) \
+    F(UpdateExpressionIncrementPrefix, UpdateExpressionIncrementPrefix)   \
+    F(SpreadElement, SpreadElement)                                       \
+    F(ExpressionStatement, ExpressionStatement)                           \
+    F(ThrowStatement, ThrowStatement)
+
+#define FOR_EACH_ESPRIMA_BINARY_NODE(F)                                                 \
+    F(AssignmentExpressionBitwiseAnd, AssignmentExpressionBitwiseAnd)                   \
+    F(AssignmentExpressionBitwiseOr, AssignmentExpressionBitwiseOr)                     \
+    F(AssignmentExpressionBitwiseXor, AssignmentExpressionBitwiseXor)                   \
+    F(AssignmentExpressionDivision, AssignmentExpressionDivision)                       \
+    F(AssignmentExpressionLeftShift, AssignmentExpressionLeftShift)                     \
+    F(AssignmentExpressionMinus, AssignmentExpressionMinus)                             \
+    F(AssignmentExpressionMod, AssignmentExpressionMod)                                 \
+    F(AssignmentExpressionMultiply, AssignmentExpressionMultiply)                       \
+    F(AssignmentExpressionPlus, AssignmentExpressionPlus)                               \
+    F(AssignmentExpressionSignedRightShift, AssignmentExpressionSignedRightShift)       \
+    F(AssignmentExpressionUnsignedShift, AssignmentExpressionUnsignedRightShift)        \
+    F(AssignmentExpressionSimple, AssignmentExpressionSimple)                           \
+    F(BinaryExpressionBitwiseAnd, BinaryExpressionBitwiseAnd)                           \
+    F(BinaryExpressionBitwiseOr, BinaryExpressionBitwiseOr)                             \
+    F(BinaryExpressionBitwiseXor, BinaryExpressionBitwiseXor)                           \
+    F(BinaryExpressionDivision, BinaryExpressionDivison)                                \
+    F(BinaryExpressionEqual, BinaryExpressionEqual)                                     \
+    F(BinaryExpressionGreaterThan, BinaryExpressionGreaterThan)                         \
+    F(BinaryExpressionGreaterThanOrEqual, BinaryExpressionGreaterThanOrEqual)           \
+    F(BinaryExpressionIn, BinaryExpressionIn)                                           \
+    F(BinaryExpressionInstanceOf, BinaryExpressionInstanceOf)                           \
+    F(BinaryExpressionLeftShift, BinaryExpressionLeftShift)                             \
+    F(BinaryExpressionLessThan, BinaryExpressionLessThan)                               \
+    F(BinaryExpressionLessThanOrEqual, BinaryExpressionLessThanOrEqual)                 \
+    F(BinaryExpressionLogicalAnd, BinaryExpressionLogicalAnd)                           \
+    F(BinaryExpressionLogicalOr, BinaryExpressionLogicalOr)                             \
+    F(BinaryExpressionMinus, BinaryExpressionMinus)                                     \
+    F(BinaryExpressionMod, BinaryExpressionMod)                                         \
+    F(BinaryExpressionMultiply, BinaryExpressionMultiply)                               \
+    F(BinaryExpressionNotEqual, BinaryExpressionNotEqual)                               \
+    F(BinaryExpressionNotStrictEqual, BinaryExpressionNotStrictEqual)                   \
+    F(BinaryExpressionPlus, BinaryExpressionPlus)                                       \
+    F(BinaryExpressionSignedRightShift, BinaryExpressionSignedRightShift)               \
+    F(BinaryExpressionStrictEqual, BinaryExpressionStrictEqual)                         \
+    F(BinaryExpressionUnsignedRightShift, BinaryExpressionUnsignedRightShift)           \
+    F(DoWhileStatement, DoWhileStatement)                                               \
+    F(WhileStatement, WhileStatement)                                                   \
+    F(TaggedTemplateExpression, TaggedTemplateExpression)
+
+class NodeGenerator {
+public:
+    typedef RefPtr<Node> ASTNode;
+    typedef NodeVector ASTNodeVector;
+    typedef PropertiesNodeVector ASTPropertyNodeVector;
+    typedef VariableDeclaratorVector ASTVariableDeclaratorVector;
+    typedef RefPtr<StatementContainer> ASTStatementContainer;
+
+    bool isNodeGenerator()
+    {
+        return true;
+    }
+
+    ASTStatementContainer createStatementContainer()
+    {
+        return StatementContainer::create();
+    }
+
+    StatementNode* appendChild(const ASTStatementContainer& container, const ASTNode& statement, StatementNode* referNode = nullptr)
+    {
+        return container->appendChild(statement->asStatementNode(), referNode);
+    }
+
+    void appendProperty(ASTPropertyNodeVector& properties, const ASTNode& property)
+    {
+        properties.push_back((PropertyNode*)property.get());
+    }
+
+    void appendVariableDeclarator(ASTVariableDeclaratorVector& declarations, const ASTNode& declarator)
+    {
+        declarations.push_back((VariableDeclaratorNode*)declarator.get());
+    }
+
+    const ASTNodeVector& arrowParameterPlaceHolderParams(const ASTNode& placeHolder)
+    {
+        return ((ArrowParameterPlaceHolderNode*)placeHolder.get())->params();
+    }
+
+    void addFunctionDeclarationInDirectCatchScope(std::vector<FunctionDeclarationNode*>& declarations, const ASTNode& declaration)
+    {
+        declarations.push_back((FunctionDeclarationNode*)declaration.get());
+    }
+
+#define DECLARE_UNARY_NODE_CREATOR(ClassName, TypeName)                   \
+    ClassName##Node* create##ClassName##Node(const ASTNode& argument) \
+    {                                                                 \
+        return new ClassName##Node(argument.get());                   \
+    }
+    FOR_EACH_ESPRIMA_UNARY_NODE(DECLARE_UNARY_NODE_CREATOR)
+#undef DECLARE_UNARY_NODE_CREATOR
+
+#define DECLARE_BINARY_NODE_CREATOR(ClassName, TypeName)                                        \
+    ClassName##Node* create##ClassName##Node(const ASTNode& left, const ASTNode& right) \
+    {                                                                                   \
+        return new ClassName##Node(left.get(), right.get());                            \
+    }
+    FOR_EACH_ESPRIMA_BINARY_NODE(DECLARE_BINARY_NODE_CREATOR)
+#undef DECLARE_BINARY_NODE_CREATOR
+
+    IdentifierNode* createIdentifierNode(const AtomicString& name)
+    {
+        return new IdentifierNode(name);
+    }
+
+    LiteralNode* createLiteralNode(const Value& value)
+    {
+        return new LiteralNode(value);
+    }
+
+    RegExpLiteralNode* createRegExpLiteralNode(String* body, String* flags)
+    {
+        return new RegExpLiteralNode(body, flags);
+    }
+
+    ThisExpressionNode* createThisExpressionNode()
+    {
+        return new ThisExpressionNode();
+    }
+
+    ArrayExpressionNode* createArrayExpressionNode(ASTNodeVector&& elements)
+    {
+        return new ArrayExpressionNode(std::move(elements));
+    }
+
+    ObjectExpressionNode* createObjectExpressionNode(ASTPropertyNodeVector&& properties)
+    {
+        return new ObjectExpressionNode(std::move(properties));
+    }
+
+    PropertyNode* createPropertyNode(const ASTNode& key, const ASTNode& value, PropertyNode::Kind kind, bool computed)
+    {
+        return new PropertyNode(key.get(), value.get(), kind, computed);
+    }
+
+    TemplateLiteralNode* createTemplateLiteralNode(TemplateElementVector* quasis, ASTNodeVector&& expressions)
+    {
+        return new TemplateLiteralNode(quasis, std::move(expressions));
+    }
+
+    SequenceExpressionNode* createSequenceExpressionNode(ASTNodeVector&& expressions)
+    {
+        return new SequenceExpressionNode(std::move(expressions));
+    }
+
+    ArrowParameterPlaceHolderNode* createArrowParameterPlaceHolderNode(ASTNodeVector&& params)
+    {
+        return new ArrowParameterPlaceHolderNode(std::move(params));
+    }
+
+    ArrowFunctionExpressionNode* createArrowFunctionExpressionNode(ASTNodeVector&& params, const ASTNode& body, ASTScopeContext* scopeContext, bool expression)
+    {
+        return new ArrowFunctionExpressionNode(std::move(params), body.get(), scopeContext, expression);
+    }
+
+    FunctionExpressionNode* createFunctionExpressionNode(const AtomicString& id, ASTNodeVector&& params, const ASTNode& body, ASTScopeContext* scopeContext, bool isGenerator)
+    {
+        return new FunctionExpressionNode(id, std::move(params), body.get(), scopeContext, isGenerator);
+    }
+
+    FunctionDeclarationNode* createFunctionDeclarationNode(const AtomicString& id, ASTNodeVector&& params, const ASTNode& body, ASTScopeContext* scopeContext, bool isGenerator)
+    {
+        return new FunctionDeclarationNode(id, std::move(params), body.get(), scopeContext, isGenerator);
+    }
+
+    RestElementNode* createRestElementNode(const ASTNode& argument)
+    {
+        return new RestElementNode(argument->asIdentifier());
+    }
+
+    CallExpressionNode* createCallExpressionNode(const ASTNode& callee, ASTNodeVector&& arguments)
+    {
+        return new CallExpressionNode(callee.get(), std::move(arguments));
+    }
+
+    NewExpressionNode* createNewExpressionNode(const ASTNode& callee, ASTNodeVector&& arguments)
+    {
+        return new NewExpressionNode(callee.get(), std::move(arguments));
+    }
+
+    MemberExpressionNode* createMemberExpressionNode(const ASTNode& object, const ASTNode& property, bool computed)
+    {
+        return new MemberExpressionNode(object.get(), property.get(), computed);
+    }
+
+    ConditionalExpressionNode* createConditionalExpressionNode(const ASTNode& test, const ASTNode& consequent, const ASTNode& alternate)
+    {
+        return new ConditionalExpressionNode(test.get(), consequent.get(), alternate.get());
+    }
+
+    VariableDeclaratorNode* createVariableDeclaratorNode(const ASTNode& id, const ASTNode& init)
+    {
+        return new VariableDeclaratorNode(id.get(), init.get());
+    }
+
+    VariableDeclarationNode* createVariableDeclarationNode(ASTVariableDeclaratorVector&& declarations)
+    {
+        return new VariableDeclarationNode(std::move(declarations));
+    }
+
+    EmptyStatementNode* createEmptyStatementNode()
+    {
+        return new EmptyStatementNode();
+    }
+
+    DirectiveNode* createDirectiveNode(const ASTNode& expression, StringView value)
+    {
+        ASSERT(expression->isExpressionNode());
+        return new DirectiveNode((ExpressionNode*)expression.get(), value);
+    }
+
+    BlockStatementNode* createBlockStatementNode(const ASTStatementContainer& body)
+    {
+        return new BlockStatementNode(body.get());
+    }
+
+    IfStatementNode* createIfStatementNode(const ASTNode& test, const ASTNode& consequent, const ASTNode& alternate)
+    {
+        return new IfStatementNode(test.get(), consequent.get(), alternate.get());
+    }
+
+    ForStatementNode* createForStatementNode(const ASTNode& init, const ASTNode& test, const ASTNode& update, const ASTNode& body)
+    {
+        return new ForStatementNode(init.get(), test.get(), update.get(), body.get());
+    }
+
+    ForInStatementNode* createForInStatementNode(const ASTNode& left, const ASTNode& right, const ASTNode& body)
+    {
+        return new ForInStatementNode(left.get(), right.get(), body.get(), false);
+    }
+
+    ContinueStatementNode* createContinueStatementNode()
+    {
+        return new ContinueStatementNode();
+    }
+
+    ContinueLabelStatementNode* createContinueLabelStatementNode(String* label)
+    {
+        return new ContinueLabelStatementNode(label);
+    }
+
+    BreakStatementNode* createBreakStatementNode()
+    {
+        return new BreakStatementNode();
+    }
+
+    BreakLabelStatementNode* createBreakLabelStatementNode(String* label)
+    {
+        return new BreakLabelStatementNode(label);
+    }
+
+    ReturnStatmentNode* createReturnStatementNode(const ASTNode& argument)
+    {
+        return new ReturnStatmentNode(argument.get());
+    }
+
+    WithStatementNode* createWithStatementNode(const ASTNode& object, const ASTNode& body)
+    {
+        return new WithStatementNode(object, body->asStatementNode());
+    }
+
+    SwitchCaseNode* createSwitchCaseNode(const ASTNode& test, const ASTStatementContainer& consequent)
+    {
+        return new SwitchCaseNode(test.get(), consequent.get());
+    }
+
+    SwitchStatementNode* createSwitchStatementNode(const ASTNode& discriminant, const ASTStatementContainer& casesA, const ASTNode& deflt, const ASTStatementContainer& casesB)
+    {
+        return new SwitchStatementNode(discriminant.get(), casesA.get(), deflt.get(), casesB.get(), false);
+    }
+
+    LabeledStatementNode* createLabeledStatementNode(const ASTNode& body, String* label)
+    {
+        return new LabeledStatementNode(body->asStatementNode(), label);
+    }
+
+    CatchClauseNode* createCatchClauseNode(const ASTNode& param, const ASTNode& body, std::vector<FunctionDeclarationNode*>& functionDeclarations)
+    {
+        return new CatchClauseNode(param.get(), nullptr, body.get(), functionDeclarations);
+    }
+
+    TryStatementNode* createTryStatementNode(const ASTNode& block, const ASTNode& handler, const ASTNode& finalizer)
+    {
+        return new TryStatementNode(block.get(), handler.get(), CatchClauseNodeVector(), finalizer.get());
+    }
+};
+
+class SyntaxNode {
+public:
+    SyntaxNode(ASTNodeType type = ASTNodeTypeError)
+        : m_type(type)
+    {
+    }
+
+    SyntaxNode(ASTNodeType type, const AtomicString& name)
+        : m_type(type)
+        , m_name(name)
+    {
+    }
+
+    ASTNodeType type() const
+    {
+        return m_type;
+    }
+
+    bool isIdentifier() const
+    {
+        return m_type == ASTNodeType::Identifier;
+    }
+
+    bool isLiteral() const
+    {
+        return m_type == ASTNodeType::Literal;
+    }
+
+    const SyntaxNode* asIdentifier() const
+    {
+        ASSERT(isIdentifier());
+        return this;
+    }
+
+    const AtomicString& name() const
+    {
+        return m_name;
+    }
+
+    // SyntaxNode is used like RefPtr<Node> by the grammar
+    const SyntaxNode* operator->() const
+    {
+        return this;
+    }
+
+    explicit operator bool() const
+    {
+        return m_type != ASTNodeTypeError;
+    }
+
+private:
+    ASTNodeType m_type;
+    AtomicString m_name;
+};
+
+class SyntaxChecker {
+public:
+    typedef SyntaxNode ASTNode;
+    typedef std::vector<SyntaxNode> ASTNodeVector;
+    typedef ASTNodeVector ASTPropertyNodeVector;
+    typedef ASTNodeVector ASTVariableDeclaratorVector;
+    struct ASTStatementContainer {
+    };
+
+    bool isNodeGenerator()
+    {
+        return false;
+    }
+
+    ASTStatementContainer createStatementContainer()
+    {
+        return ASTStatementContainer();
+    }
+
+    StatementNode* appendChild(const ASTStatementContainer& container, const ASTNode& statement, StatementNode* referNode = nullptr)
+    {
+        return nullptr;
+    }
+
+    void appendProperty(ASTPropertyNodeVector& properties, const ASTNode& property)
+    {
+        properties.push_back(property);
+    }
+
+    void appendVariableDeclarator(ASTVariableDeclaratorVector& declarations, const ASTNode& declarator)
+    {
+        declarations.push_back(declarator);
+    }
+
+    // only one ArrowParameterPlaceHolder is alive at a time.
+    // parseAssignmentExpression consumes it right after parseGroupExpression returns it
+    const ASTNodeVector& arrowParameterPlaceHolderParams(const ASTNode& placeHolder)
+    {
+        ASSERT(placeHolder.type() == ArrowParameterPlaceHolder);
+        return m_arrowParameterPlaceHolderParams;
+    }
+
+    void addFunctionDeclarationInDirectCatchScope(std::vector<FunctionDeclarationNode*>& declarations, const ASTNode& declaration)
+    {
+    }
+
+#define DECLARE_UNARY_NODE_CREATOR(ClassName, TypeName)      \
+    SyntaxNode create##ClassName##Node(const ASTNode&) \
+    {                                                  \
+        return SyntaxNode(TypeName);                   \
+    }
+    FOR_EACH_ESPRIMA_UNARY_NODE(DECLARE_UNARY_NODE_CREATOR)
+#undef DECLARE_UNARY_NODE_CREATOR
+
+#define DECLARE_BINARY_NODE_CREATOR(ClassName, TypeName)                     \
+    SyntaxNode create##ClassName##Node(const ASTNode&, const ASTNode&) \
+    {                                                                  \
+        return SyntaxNode(TypeName);                                   \
+    }
+    FOR_EACH_ESPRIMA_BINARY_NODE(DECLARE_BINARY_NODE_CREATOR)
+#undef DECLARE_BINARY_NODE_CREATOR
+
+    SyntaxNode createIdentifierNode(const AtomicString& name)
+    {
+        return SyntaxNode(Identifier, name);
+    }
+
+    SyntaxNode createLiteralNode(const Value&)
+    {
+        return SyntaxNode(Literal);
+    }
+
+    SyntaxNode createRegExpLiteralNode(String*, String*)
+    {
+        return SyntaxNode(RegExpLiteral);
+    }
+
+    SyntaxNode createThisExpressionNode()
+    {
+        return SyntaxNode(ThisExpression);
+    }
+
+    SyntaxNode createArrayExpressionNode(ASTNodeVector&&)
+    {
+        return SyntaxNode(ArrayExpression);
+    }
+
+    SyntaxNode createObjectExpressionNode(ASTPropertyNodeVector&&)
+    {
+        return SyntaxNode(ObjectExpression);
+    }
+
+    SyntaxNode createPropertyNode(const ASTNode&, const ASTNode&, PropertyNode::Kind, bool)
+    {
+        return SyntaxNode(Property);
+    }
+
+    SyntaxNode createTemplateLiteralNode(TemplateElementVector*, ASTNodeVector&&)
+    {
+        return SyntaxNode(TemplateLiteral);
+    }
+
+    SyntaxNode createSequenceExpressionNode(ASTNodeVector&&)
+    {
+        return SyntaxNode(SequenceExpression);
+    }
+
+    SyntaxNode createArrowParameterPlaceHolderNode(ASTNodeVector&& params)
+    {
+        m_arrowParameterPlaceHolderParams = std::move(params);
+        return SyntaxNode(ArrowParameterPlaceHolder);
+    }
+
+    // scope context of a function node is marked by constructor of the node in NodeGenerator
+    SyntaxNode createArrowFunctionExpressionNode(ASTNodeVector&&, const ASTNode&, ASTScopeContext* scopeContext, bool)
+    {
+        scopeContext->m_nodeType = ArrowFunctionExpression;
+        scopeContext->m_isArrowFunctionExpression = true;
+        return SyntaxNode(ArrowFunctionExpression);
+    }
+
+    SyntaxNode createFunctionExpressionNode(const AtomicString&, ASTNodeVector&&, const ASTNode&, ASTScopeContext* scopeContext, bool)
+    {
+        scopeContext->m_nodeType = FunctionExpression;
+        return SyntaxNode(FunctionExpression);
+    }
+
+    SyntaxNode createFunctionDeclarationNode(const AtomicString&, ASTNodeVector&&, const ASTNode&, ASTScopeContext* scopeContext, bool)
+    {
+        scopeContext->m_nodeType = FunctionDeclaration;
+        return SyntaxNode(FunctionDeclaration);
+    }
+
+    SyntaxNode createRestElementNode(const ASTNode&)
+    {
+        return SyntaxNode(RestElement);
+    }
+
+    SyntaxNode createCallExpressionNode(const ASTNode&, ASTNodeVector&&)
+    {
+        return SyntaxNode(CallExpression);
+    }
+
+    SyntaxNode createNewExpressionNode(const ASTNode&, ASTNodeVector&&)
+    {
+        return SyntaxNode(NewExpression);
+    }
+
+    SyntaxNode createMemberExpressionNode(const ASTNode&, const ASTNode&, bool)
+    {
+        return SyntaxNode(MemberExpression);
+    }
+
+    SyntaxNode createConditionalExpressionNode(const ASTNode&, const ASTNode&, const ASTNode&)
+    {
+        return SyntaxNode(ConditionalExpression);
+    }
+
+    SyntaxNode createVariableDeclaratorNode(const ASTNode&, const ASTNode&)
+    {
+        return SyntaxNode(VariableDeclarator);
+    }
+
+    SyntaxNode createVariableDeclarationNode(ASTVariableDeclaratorVector&&)
+    {
+        return SyntaxNode(VariableDeclaration);
+    }
+
+    SyntaxNode createEmptyStatementNode()
+    {
+        return SyntaxNode(EmptyStatement);
+    }
+
+    SyntaxNode createDirectiveNode(const ASTNode&, StringView)
+    {
+        return SyntaxNode(Directive);
+    }
+
+    SyntaxNode createBlockStatementNode(const ASTStatementContainer&)
+    {
+        return SyntaxNode(BlockStatement);
+    }
+
+    SyntaxNode createIfStatementNode(const ASTNode&, const ASTNode&, const ASTNode&)
+    {
+        return SyntaxNode(IfStatement);
+    }
+
+    SyntaxNode createForStatementNode(const ASTNode&, const ASTNode&, const ASTNode&, const ASTNode&)
+    {
+        return SyntaxNode(ForStatement);
+    }
+
+    SyntaxNode createForInStatementNode(const ASTNode&, const ASTNode&, const ASTNode&)
+    {
+        return SyntaxNode(ForInStatement);
+    }
+
+    SyntaxNode createContinueStatementNode()
+    {
+        return SyntaxNode(ContinueStatement);
+    }
+
+    SyntaxNode createContinueLabelStatementNode(String*)
+    {
+        return SyntaxNode(ContinueLabelStatement);
+    }
+
+    SyntaxNode createBreakStatementNode()
+    {
+        return SyntaxNode(BreakStatement);
+    }
+
+    SyntaxNode createBreakLabelStatementNode(String*)
+    {
+        return SyntaxNode(BreakLabelStatement);
+    }
+
+    SyntaxNode createReturnStatementNode(const ASTNode&)
+    {
+        return SyntaxNode(ReturnStatement);
+    }
+
+    SyntaxNode createWithStatementNode(const ASTNode&, const ASTNode&)
+    {
+        return SyntaxNode(WithStatement);
+    }
+
+    SyntaxNode createSwitchCaseNode(const ASTNode&, const ASTStatementContainer&)
+    {
+        return SyntaxNode(SwitchCase);
+    }
+
+    SyntaxNode createSwitchStatementNode(const ASTNode&, const ASTStatementContainer&, const ASTNode&, const ASTStatementContainer&)
+    {
+        return SyntaxNode(SwitchStatement);
+    }
+
+    SyntaxNode createLabeledStatementNode(const ASTNode&, String*)
+    {
+        return SyntaxNode(LabeledStatement);
+    }
+
+    SyntaxNode createCatchClauseNode(const ASTNode&, const ASTNode&, std::vector<FunctionDeclarationNode*>&)
+    {
+        return SyntaxNode(CatchClause);
+    }
+
+    SyntaxNode createTryStatementNode(const ASTNode&, const ASTNode&, const ASTNode&)
+    {
+        return SyntaxNode(TryStatement);
+    }
+
+private:
+    ASTNodeVector m_arrowParameterPlaceHolderParams;
+};
+
+#define ASTNode typename ASTBuilder::ASTNode
+#define ASTNodeVector typename ASTBuilder::ASTNodeVector
+#define ASTPropertyNodeVector typename ASTBuilder::ASTPropertyNodeVector
+#define ASTVariableDeclaratorVector typename ASTBuilder::ASTVariableDeclaratorVector
+#define ASTStatementContainer typename ASTBuilder::ASTStatementContainer
 
 /*
 struct ArrowParameterPlaceHolderNode : public gc {
@@ -2573,24 +3278,37 @@ public:
         return ret;
     }
 
-    void extractNamesFromFunctionParams(const PatternNodeVector& vector)
+    template <typename ParamVector>
+    void extractNamesFromFunctionParams(const ParamVector& vector)
     {
         if (this->config.parseSingleFunction)
             return;
         for (size_t i = 0; i < vector.size(); i++) {
             ASSERT(vector[i]->isIdentifier());
-            IdentifierNode* id = (IdentifierNode*)vector[i].get();
-            scopeContexts.back()->insertName(id->name(), true);
+            scopeContexts.back()->insertName(vector[i]->asIdentifier()->name(), true);
         }
     }
 
-    void pushScopeContext(const PatternNodeVector& params, AtomicString functionName)
+    template <typename ParamVector>
+    void pushScopeContext(const ParamVector& params, AtomicString functionName)
     {
         if (this->config.parseSingleFunction) {
             fakeContext = ASTScopeContext();
             scopeContexts.push_back(&fakeContext);
             return;
         }
+        AtomicStringVector names;
+        names.resizeWithUninitializedValues(params.size());
+        for (size_t i = 0; i < params.size(); i++) {
+            ASSERT(params[i]->isIdentifier());
+            names[i] = params[i]->asIdentifier()->name();
+        }
+        pushScopeContext(names, functionName);
+    }
+
+    void pushScopeContext(const AtomicStringVector& params, AtomicString functionName)
+    {
+        ASSERT(!this->config.parseSingleFunction);
         auto parentContext = scopeContexts.back();
         scopeContexts.push_back(new ASTScopeContext(this->context->strict));
         scopeContexts.back()->m_functionName = functionName;
@@ -2598,9 +3316,7 @@ public:
         scopeContexts.back()->m_inWith = this->context->inWith;
         scopeContexts.back()->m_parameters.resizeWithUninitializedValues(params.size());
         for (size_t i = 0; i < params.size(); i++) {
-            ASSERT(params[i]->isIdentifier());
-            IdentifierNode* id = (IdentifierNode*)params[i].get();
-            scopeContexts.back()->m_parameters[i] = id->name();
+            scopeContexts.back()->m_parameters[i] = params[i];
         }
         if (parentContext) {
             parentContext->m_childScopes.push_back(scopeContexts.back());
@@ -2630,6 +3346,7 @@ public:
         config.comment = false;
         config.tolerant = false;
         config.parseSingleFunction = false;
+        config.eagerlyParseFunctionBodies = false;
         config.parseSingleFunctionTarget = nullptr;
         config.parseSingleFunctionChildIndex = SmallValue((uint32_t)0);
         /*
@@ -2669,7 +3386,6 @@ public:
         this->context->inCatch = false;
         this->context->inArrowFunction = false;
         this->context->inDirectCatchScope = false;
-        this->context->inParsingDirective = false;
         this->context->inWith = false;
         this->context->inLoop = false;
         this->context->strict = this->sourceType == Module;
@@ -2894,11 +3610,6 @@ public:
         return token.release();
     }
 
-    bool shouldCreateAST()
-    {
-        return !inProgramParsingAndInFunctionSourceNode() || this->context->inParsingDirective;
-    }
-
     bool inProgramParsingAndInFunctionSourceNode()
     {
         return !this->config.parseSingleFunction && this->scopeContexts.size() > 1;
@@ -2945,25 +3656,6 @@ public:
                 node.loc.source = this->config.source;
             }
         }*/
-        auto type = node->type();
-        if (type == CallExpression) {
-            CallExpressionNode* c = (CallExpressionNode*)node;
-            if (c->callee()->isIdentifier()) {
-                if (((IdentifierNode*)c->callee())->name().string()->equals("eval")) {
-                    scopeContexts.back()->m_hasEval = true;
-                    if (this->context->inArrowFunction) {
-                        scopeContexts.back()->insertUsingName(this->escargotContext->staticStrings().stringThis);
-                    }
-                }
-            }
-        } else if (type == WithStatement) {
-            scopeContexts.back()->m_hasWith = true;
-        } else if (type == YieldExpression) {
-            scopeContexts.back()->m_hasYield = true;
-        } else if (type == CatchClause) {
-            scopeContexts.back()->m_hasCatch = true;
-        }
-
         node->m_loc = NodeLOC(meta.index);
         if (this->delegate) {
             this->delegate(node, NodeLOC(meta.index),
@@ -2973,6 +3665,27 @@ public:
         return adoptRef(node);
     }
 
+    SyntaxNode finalize(MetaNode meta, SyntaxNode node)
+    {
+        return node;
+    }
+
+    void markEvalCall()
+    {
+        scopeContexts.back()->m_hasEval = true;
+        if (this->context->inArrowFunction) {
+            scopeContexts.back()->insertUsingName(this->escargotContext->staticStrings().stringThis);
+        }
+    }
+
+    template <typename CalleeNode>
+    void markEvalCallIfNeeded(const CalleeNode& callee)
+    {
+        if (callee->isIdentifier() && callee->asIdentifier()->name().string()->equals("eval")) {
+            markEvalCall();
+        }
+    }
+
     // Expect the next token to match the specified punctuator.
     // If not, an exception will be thrown.
 
@@ -3085,8 +3798,6 @@ public:
     // the flags outside of the parser. This means the production the parser parses is used as a part of a potential
     // pattern. The CoverInitializedName check is deferred.
 
-    typedef Node* (Parser::*ParseFunction)();
-
     void checkRecursiveLimit()
     {
         volatile int sp;
@@ -3100,8 +3811,8 @@ public:
         }
     }
 
-    template <typename T>
-    PassRefPtr<Node> isolateCoverGrammar(T parseFunction)
+    template <class ASTBuilder>
+    ASTNode isolateCoverGrammar(ASTBuilder& builder, ASTNode (Parser::*parseFunction)(ASTBuilder&))
     {
         const bool previousIsBindingElement = this->context->isBindingElement;
         const bool previousIsAssignmentTarget = this->context->isAssignmentTarget;
@@ -3112,7 +3823,7 @@ public:
         this->context->firstCoverInitializedNameError = nullptr;
 
         this->checkRecursiveLimit();
-        PassRefPtr<Node> result = (this->*parseFunction)();
+        ASTNode result = (this->*parseFunction)(builder);
         if (this->context->firstCoverInitializedNameError != nullptr) {
             this->throwUnexpectedToken(this->context->firstCoverInitializedNameError);
         }
@@ -3124,8 +3835,8 @@ public:
         return result;
     }
 
-    template <typename T>
-    PassRefPtr<Node> isolateCoverGrammarWithFunctor(T parseFunction)
+    template <class ASTBuilder, typename T>
+    ASTNode isolateCoverGrammarWithFunctor(ASTBuilder& builder, T parseFunction)
     {
         const bool previousIsBindingElement = this->context->isBindingElement;
         const bool previousIsAssignmentTarget = this->context->isAssignmentTarget;
@@ -3136,7 +3847,7 @@ public:
         this->context->firstCoverInitializedNameError = nullptr;
 
         this->checkRecursiveLimit();
-        PassRefPtr<Node> result = parseFunction();
+        ASTNode result = parseFunction();
         if (this->context->firstCoverInitializedNameError != nullptr) {
             this->throwUnexpectedToken(this->context->firstCoverInitializedNameError);
         }
@@ -3148,8 +3859,8 @@ public:
         return result;
     }
 
-    template <typename T>
-    PassRefPtr<Node> inheritCoverGrammar(T parseFunction)
+    template <class ASTBuilder>
+    ASTNode inheritCoverGrammar(ASTBuilder& builder, ASTNode (Parser::*parseFunction)(ASTBuilder&))
     {
         const bool previousIsBindingElement = this->context->isBindingElement;
         const bool previousIsAssignmentTarget = this->context->isAssignmentTarget;
@@ -3160,7 +3871,7 @@ public:
         this->context->firstCoverInitializedNameError = nullptr;
 
         this->checkRecursiveLimit();
-        PassRefPtr<Node> result = (this->*parseFunction)();
+        ASTNode result = (this->*parseFunction)(builder);
 
         this->context->isBindingElement = this->context->isBindingElement && previousIsBindingElement;
         this->context->isAssignmentTarget = this->context->isAssignmentTarget && previousIsAssignmentTarget;
@@ -3184,39 +3895,34 @@ public:
         }
     }
 
-    IdentifierNode* finishIdentifier(PassRefPtr<ScannerResult> token, bool isScopeVariableName)
+    AtomicString finishIdentifierName(PassRefPtr<ScannerResult> token)
     {
-        IdentifierNode* ret;
+        AtomicString name;
         StringView sv = token->valueStringLiteral();
         const auto& a = sv.bufferAccessData();
         char16_t firstCh = a.charAt(0);
         if (a.length == 1 && firstCh < ESCARGOT_ASCII_TABLE_MAX) {
-            ret = new IdentifierNode(this->escargotContext->staticStrings().asciiTable[firstCh]);
+            name = this->escargotContext->staticStrings().asciiTable[firstCh];
         } else {
-            ret = new IdentifierNode(AtomicString(this->escargotContext, SourceStringView(sv)));
+            name = AtomicString(this->escargotContext, SourceStringView(sv));
         }
-        //nodeExtraInfo.insert(std::make_pair(ret, token));
         if (trackUsingNames) {
-            scopeContexts.back()->insertUsingName(ret->name());
+            scopeContexts.back()->insertUsingName(name);
         }
-        return ret;
+        return name;
     }
 
-#define DEFINE_AS_NODE(TypeName)                                 \
-    RefPtr<TypeName##Node> as##TypeName##Node(RefPtr<Node> n)    \
-    {                                                            \
-        if (!n)                                                  \
-            return RefPtr<TypeName##Node>(nullptr);              \
-        ASSERT(n->is##TypeName##Node());                         \
-        return RefPtr<TypeName##Node>((TypeName##Node*)n.get()); \
+    template <class ASTBuilder>
+    auto finishIdentifier(ASTBuilder& builder, PassRefPtr<ScannerResult> token, bool isScopeVariableName) -> decltype(builder.createIdentifierNode(AtomicString()))
+    {
+        //nodeExtraInfo.insert(std::make_pair(ret, token));
+        return builder.createIdentifierNode(finishIdentifierName(token));
     }
 
-    DEFINE_AS_NODE(Expression);
-    DEFINE_AS_NODE(Statement);
-
     // ECMA-262 12.2 Primary Expressions
 
-    PassRefPtr<Node> parsePrimaryExpression()
+    template <class ASTBuilder>
+    ASTNode parsePrimaryExpression(ASTBuilder& builder)
     {
         MetaNode node = this->createNode();
 
@@ -3226,7 +3932,7 @@ public:
             if (this->sourceType == SourceType::Module && this->lookahead->valueKeywordKind == KeywordKind::Await) {
                 this->tolerateUnexpectedToken(this->lookahead);
             }
-            return this->finalize(node, finishIdentifier(this->nextToken(), true));
+            return this->finalize(node, finishIdentifier(builder, this->nextToken(), true));
             break;
         case Token::NumericLiteralToken:
         case Token::StringLiteralToken:
@@ -3244,13 +3950,9 @@ public:
                 if (token->type == Token::NumericLiteralToken) {
                     if (this->context->inLoop || token->valueNumber == 0)
                         this->scopeContexts.back()->insertNumeralLiteral(Value(token->valueNumber));
-                    return this->finalize(node, new LiteralNode(Value(token->valueNumber)));
+                    return this->finalize(node, builder.createLiteralNode(Value(token->valueNumber)));
                 } else {
-                    if (shouldCreateAST()) {
-                        return this->finalize(node, new LiteralNode(token->valueStringLiteralForAST()));
-                    } else {
-                        return this->finalize(node, new LiteralNode(Value(String::emptyString)));
-                    }
+                    return this->finalize(node, builder.createLiteralNode(builder.isNodeGenerator() ? token->valueStringLiteralForAST() : Value()));
                 }
             }
             break;
@@ -3264,7 +3966,7 @@ public:
             {
                 bool value = token->relatedSource() == "true";
                 this->scopeContexts.back()->insertNumeralLiteral(Value(value));
-                return this->finalize(node, new LiteralNode(Value(value)));
+                return this->finalize(node, builder.createLiteralNode(Value(value)));
             }
             break;
         }
@@ -3276,11 +3978,11 @@ public:
             // token.value = null;
             // raw = this->getTokenRaw(token);
             this->scopeContexts.back()->insertNumeralLiteral(Value(Value::Null));
-            return this->finalize(node, new LiteralNode(Value(Value::Null)));
+            return this->finalize(node, builder.createLiteralNode(Value(Value::Null)));
             break;
         }
         case Token::TemplateToken:
-            return this->parseTemplateLiteral();
+            return this->parseTemplateLiteral(builder);
             break;
 
         case Token::PunctuatorToken: {
@@ -3288,13 +3990,13 @@ public:
             switch (value) {
             case LeftParenthesis:
                 this->context->isBindingElement = false;
-                return this->inheritCoverGrammar(&Parser::parseGroupExpression);
+                return this->inheritCoverGrammar(builder, &Parser::parseGroupExpression<ASTBuilder>);
                 break;
             case LeftSquareBracket:
-                return this->inheritCoverGrammar(&Parser::parseArrayInitializer);
+                return this->inheritCoverGrammar(builder, &Parser::parseArrayInitializer<ASTBuilder>);
                 break;
             case LeftBrace:
-                return this->inheritCoverGrammar(&Parser::parseObjectInitializer);
+                return this->inheritCoverGrammar(builder, &Parser::parseObjectInitializer<ASTBuilder>);
                 break;
             case Divide:
             case DivideEqual: {
@@ -3303,7 +4005,7 @@ public:
                 this->scanner->index = this->startMarker.index;
                 PassRefPtr<ScannerResult> token = this->nextRegexToken();
                 // raw = this->getTokenRaw(token);
-                return this->finalize(node, new RegExpLiteralNode(token->valueRegexp.body, token->valueRegexp.flags));
+                return this->finalize(node, builder.createRegExpLiteralNode(token->valueRegexp.body, token->valueRegexp.flags));
                 break;
             }
             default:
@@ -3314,22 +4016,22 @@ public:
 
         case Token::KeywordToken:
             if (!this->context->strict && this->context->allowYield && this->matchKeyword(KeywordKind::Yield)) {
-                return this->parseIdentifierName();
+                return this->parseIdentifierName(builder);
             } else if (!this->context->strict && this->matchKeyword(KeywordKind::Let)) {
                 throwUnexpectedToken(this->nextToken());
             } else {
                 this->context->isAssignmentTarget = false;
                 this->context->isBindingElement = false;
                 if (this->matchKeyword(KeywordKind::Function)) {
-                    return this->parseFunctionExpression();
+                    return this->parseFunctionExpression(builder);
                 } else if (this->matchKeyword(KeywordKind::This)) {
                     if (this->context->inArrowFunction) {
                         scopeContexts.back()->insertUsingName(this->escargotContext->staticStrings().stringThis);
                     }
                     this->nextToken();
-                    return this->finalize(node, new ThisExpressionNode());
+                    return this->finalize(node, builder.createThisExpressionNode());
                 } else if (this->matchKeyword(KeywordKind::Class)) {
-                    return this->parseClassExpression();
+                    return this->parseClassExpression(builder);
                 } else {
                     this->throwUnexpectedToken(this->nextToken());
                 }
@@ -3340,11 +4042,12 @@ public:
         }
 
         ASSERT_NOT_REACHED();
-        return nullptr;
+        return ASTNode();
     }
 
+    template <class ASTBuilder>
     struct ParseParameterOptions {
-        PatternNodeVector params;
+        ASTNodeVector params;
         std::vector<AtomicString, gc_allocator<AtomicString>> paramSet;
         RefPtr<ScannerResult> stricted;
         const char* message;
@@ -3358,7 +4061,8 @@ public:
     };
 
 
-    void validateParam(ParseParameterOptions& options, const RefPtr<ScannerResult>& param, AtomicString name)
+    template <class ASTBuilder>
+    void validateParam(ParseParameterOptions<ASTBuilder>& options, const RefPtr<ScannerResult>& param, AtomicString name)
     {
         if (this->context->strict) {
             if (this->scanner->isRestrictedWord(name)) {
@@ -3384,7 +4088,8 @@ public:
         options.paramSet.push_back(name);
     }
 
-    PassRefPtr<RestElementNode> parseRestElement(std::vector<RefPtr<ScannerResult>, GCUtil::gc_malloc_ignore_off_page_allocator<RefPtr<ScannerResult>>>& params)
+    template <class ASTBuilder>
+    ASTNode parseRestElement(ASTBuilder& builder, std::vector<RefPtr<ScannerResult>, GCUtil::gc_malloc_ignore_off_page_allocator<RefPtr<ScannerResult>>>& params)
     {
         this->throwError("Rest element is not supported yet");
 
@@ -3396,7 +4101,7 @@ public:
 
         MetaNode node = this->createNode();
 
-        RefPtr<IdentifierNode> param = this->parseVariableIdentifier();
+        ASTNode param = this->parseVariableIdentifier(builder);
         if (this->match(Equal)) {
             this->throwError(Messages::DefaultRestParameter);
         }
@@ -3404,10 +4109,11 @@ public:
             this->throwError(Messages::ParameterAfterRestParameter);
         }
 
-        return this->finalize(node, new RestElementNode(param.get()));
+        return this->finalize(node, builder.createRestElementNode(param));
     }
 
-    PassRefPtr<Node> parsePattern(std::vector<RefPtr<ScannerResult>, GCUtil::gc_malloc_ignore_off_page_allocator<RefPtr<ScannerResult>>>& params, String* kind = String::emptyString)
+    template <class ASTBuilder>
+    ASTNode parsePattern(ASTBuilder& builder, std::vector<RefPtr<ScannerResult>, GCUtil::gc_malloc_ignore_off_page_allocator<RefPtr<ScannerResult>>>& params, String* kind = String::emptyString)
     {
         if (this->match(LeftSquareBracket)) {
             this->throwError("Array pattern is not supported yet");
@@ -3422,45 +4128,47 @@ public:
                 this->tolerateUnexpectedToken(this->lookahead, Messages::UnexpectedToken);
             }
             params.push_back(this->lookahead);
-            return this->parseVariableIdentifier(kind);
+            return this->parseVariableIdentifier(builder, kind);
         }
     }
 
-    PassRefPtr<Node> parsePatternWithDefault(std::vector<RefPtr<ScannerResult>, GCUtil::gc_malloc_ignore_off_page_allocator<RefPtr<ScannerResult>>>& params, String* kind = String::emptyString)
+    template <class ASTBuilder>
+    ASTNode parsePatternWithDefault(ASTBuilder& builder, std::vector<RefPtr<ScannerResult>, GCUtil::gc_malloc_ignore_off_page_allocator<RefPtr<ScannerResult>>>& params, String* kind = String::emptyString)
     {
         RefPtr<ScannerResult> startToken = this->lookahead;
 
-        PassRefPtr<Node> pattern = this->parsePattern(params, kind);
+        ASTNode pattern = this->parsePattern(builder, params, kind);
         if (this->match(PunctuatorsKind::Substitution)) {
             this->throwError("Assignment in parameter is not supported yet");
 
             this->nextToken();
             const bool previousAllowYield = this->context->allowYield;
             this->context->allowYield = true;
-            PassRefPtr<Node> right = this->isolateCoverGrammar(&Parser::parseAssignmentExpression);
+            ASTNode right = this->isolateCoverGrammar(builder, &Parser::parseAssignmentExpression<ASTBuilder>);
             this->context->allowYield = previousAllowYield;
-            return this->finalize(this->startNode(startToken), new AssignmentExpressionSimpleNode(pattern.get(), right.get()));
+            return this->finalize(this->startNode(startToken), builder.createAssignmentExpressionSimpleNode(pattern, right));
         }
 
         return pattern;
     }
 
-    bool parseFormalParameter(ParseParameterOptions& options)
+    template <class ASTBuilder>
+    bool parseFormalParameter(ASTBuilder& builder, ParseParameterOptions<ASTBuilder>& options)
     {
-        RefPtr<Node> param;
+        ASTNode param;
         bool trackUsingNamesBefore = trackUsingNames;
         trackUsingNames = false;
         std::vector<RefPtr<ScannerResult>, GCUtil::gc_malloc_ignore_off_page_allocator<RefPtr<ScannerResult>>> params;
         RefPtr<ScannerResult> token = this->lookahead;
         if (token->type == Token::PunctuatorToken && token->valuePunctuatorsKind == PunctuatorsKind::PeriodPeriodPeriod) {
-            RefPtr<RestElementNode> param = this->parseRestElement(params);
-            this->validateParam(options, params.back(), param->argument()->name());
+            ASTNode param = this->parseRestElement(builder, params);
+            this->validateParam(options, params.back(), AtomicString(this->escargotContext, params.back()->relatedSource()));
             options.params.push_back(param);
             trackUsingNames = true;
             return false;
         }
 
-        param = this->parsePatternWithDefault(params);
+        param = this->parsePatternWithDefault(builder, params);
         for (size_t i = 0; i < params.size(); i++) {
             AtomicString as(this->escargotContext, params[i]->relatedSource());
             this->validateParam(options, params[i], as);
@@ -3470,8 +4178,9 @@ public:
         return !this->match(PunctuatorsKind::RightParenthesis);
     }
 
+    template <class ASTBuilder>
     struct ParseFormalParametersResult {
-        PatternNodeVector params;
+        ASTNodeVector params;
         RefPtr<ScannerResult> stricted;
         RefPtr<ScannerResult> firstRestricted;
         const char* message;
@@ -3482,7 +4191,7 @@ public:
             , valid(false)
         {
         }
-        ParseFormalParametersResult(PatternNodeVector params, RefPtr<ScannerResult> stricted, RefPtr<ScannerResult> firstRestricted, const char* message)
+        ParseFormalParametersResult(ASTNodeVector params, RefPtr<ScannerResult> stricted, RefPtr<ScannerResult> firstRestricted, const char* message)
         {
             this->params = std::move(params);
             this->stricted = stricted;
@@ -3492,16 +4201,17 @@ public:
         }
     };
 
-    ParseFormalParametersResult parseFormalParameters(RefPtr<ScannerResult> firstRestricted = nullptr)
+    template <class ASTBuilder>
+    ParseFormalParametersResult<ASTBuilder> parseFormalParameters(ASTBuilder& builder, RefPtr<ScannerResult> firstRestricted = nullptr)
     {
-        ParseParameterOptions options;
+        ParseParameterOptions<ASTBuilder> options;
 
         options.firstRestricted = firstRestricted;
 
         if (!this->match(RightParenthesis)) {
             options.paramSet.clear();
             while (this->startMarker.index < this->scanner->length) {
-                if (!this->parseFormalParameter(options)) {
+                if (!this->parseFormalParameter(builder, options)) {
                     break;
                 }
                 this->expect(Comma);
@@ -3509,25 +4219,27 @@ public:
         }
         this->expect(RightParenthesis);
 
-        return ParseFormalParametersResult(options.params, options.stricted, options.firstRestricted, options.message);
+        return ParseFormalParametersResult<ASTBuilder>(std::move(options.params), options.stricted, options.firstRestricted, options.message);
     }
 
     // ECMA-262 12.2.5 Array Initializer
 
-    PassRefPtr<SpreadElementNode> parseSpreadElement()
+    template <class ASTBuilder>
+    ASTNode parseSpreadElement(ASTBuilder& builder)
     {
         this->expect(PunctuatorsKind::PeriodPeriodPeriod);
         MetaNode node = this->createNode();
 
-        RefPtr<Node> arg = this->inheritCoverGrammar(&Parser::parseAssignmentExpression);
+        ASTNode arg = this->inheritCoverGrammar(builder, &Parser::parseAssignmentExpression<ASTBuilder>);
         this->throwError("Spread element is not supported yet");
-        return this->finalize(node, new SpreadElementNode(arg.get()));
+        return this->finalize(node, builder.createSpreadElementNode(arg));
     }
 
-    PassRefPtr<Node> parseArrayInitializer()
+    template <class ASTBuilder>
+    ASTNode parseArrayInitializer(ASTBuilder& builder)
     {
         // const elements: Node.ArrayExpressionElement[] = [];
-        ExpressionNodeVector elements;
+        ASTNodeVector elements;
 
         this->expect(LeftSquareBracket);
         MetaNode node = this->createNode();
@@ -3535,9 +4247,9 @@ public:
         while (!this->match(RightSquareBracket)) {
             if (this->match(Comma)) {
                 this->nextToken();
-                elements.push_back(nullptr);
+                elements.push_back(ASTNode());
             } else if (this->match(PeriodPeriodPeriod)) {
-                PassRefPtr<SpreadElementNode> element = this->parseSpreadElement();
+                ASTNode element = this->parseSpreadElement(builder);
                 if (!this->match(RightSquareBracket)) {
                     this->context->isAssignmentTarget = false;
                     this->context->isBindingElement = false;
@@ -3545,7 +4257,7 @@ public:
                 }
                 elements.push_back(element);
             } else {
-                elements.push_back(this->inheritCoverGrammar(&Parser::parseAssignmentExpression));
+                elements.push_back(this->inheritCoverGrammar(builder, &Parser::parseAssignmentExpression<ASTBuilder>));
                 if (!this->match(RightSquareBracket)) {
                     this->expect(Comma);
                 }
@@ -3553,12 +4265,13 @@ public:
         }
         this->expect(RightSquareBracket);
 
-        return this->finalize(node, new ArrayExpressionNode(std::move(elements)));
+        return this->finalize(node, builder.createArrayExpressionNode(std::move(elements)));
     }
 
     // ECMA-262 12.2.6 Object Initializer
 
-    PassRefPtr<Node> parsePropertyMethod(ParseFormalParametersResult& params)
+    template <class ASTBuilder>
+    ASTNode parsePropertyMethod(ASTBuilder& builder, ParseFormalParametersResult<ASTBuilder>& params)
     {
         bool previousInArrowFunction = this->context->inArrowFunction;
 
@@ -3569,7 +4282,7 @@ public:
         pushScopeContext(params.params, AtomicString());
         extractNamesFromFunctionParams(params.params);
         const bool previousStrict = this->context->strict;
-        PassRefPtr<Node> body = this->isolateCoverGrammar(&Parser::parseFunctionSourceElements);
+        ASTNode body = this->isolateCoverGrammar(builder, &Parser::parseFunctionSourceElements<ASTBuilder>);
         if (this->context->strict && params.firstRestricted) {
             this->tolerateUnexpectedToken(params.firstRestricted, params.message);
         }
@@ -3582,26 +4295,28 @@ public:
         return body;
     }
 
-    PassRefPtr<FunctionExpressionNode> parsePropertyMethodFunction()
+    template <class ASTBuilder>
+    ASTNode parsePropertyMethodFunction(ASTBuilder& builder)
     {
         const bool isGenerator = false;
         const bool previousAllowYield = this->context->allowYield;
         this->context->allowYield = false;
         this->expect(LeftParenthesis);
         MetaNode node = this->createNode();
-        ParseFormalParametersResult params = this->parseFormalParameters();
-        RefPtr<Node> method = this->parsePropertyMethod(params);
+        ParseFormalParametersResult<ASTBuilder> params = this->parseFormalParameters(builder);
+        ASTNode method = this->parsePropertyMethod(builder, params);
         this->context->allowYield = previousAllowYield;
 
-        return this->finalize(node, new FunctionExpressionNode(AtomicString(), std::move(params.params), method.get(), popScopeContext(node), isGenerator));
+        return this->finalize(node, builder.createFunctionExpressionNode(AtomicString(), std::move(params.params), method, popScopeContext(node), isGenerator));
     }
 
-    PassRefPtr<Node> parseObjectPropertyKey()
+    template <class ASTBuilder>
+    ASTNode parseObjectPropertyKey(ASTBuilder& builder)
     {
         RefPtr<ScannerResult> token = this->nextToken();
         MetaNode node = this->createNode();
 
-        RefPtr<Node> key;
+        ASTNode key;
         switch (token->type) {
         case Token::NumericLiteralToken:
         case Token::StringLiteralToken:
@@ -3618,10 +4333,10 @@ public:
                     if (this->context->inLoop || token->valueNumber == 0)
                         this->scopeContexts.back()->insertNumeralLiteral(Value(token->valueNumber));
                     v = Value(token->valueNumber);
-                } else {
+                } else if (builder.isNodeGenerator()) {
                     v = Value(token->valueStringLiteralForAST());
                 }
-                key = this->finalize(node, new LiteralNode(v));
+                key = this->finalize(node, builder.createLiteralNode(v));
             }
             break;
 
@@ -3631,13 +4346,13 @@ public:
         case Token::KeywordToken: {
             bool trackUsingNamesBefore = this->trackUsingNames;
             this->trackUsingNames = false;
-            key = this->finalize(node, finishIdentifier(token, false));
+            key = this->finalize(node, finishIdentifier(builder, token, false));
             this->trackUsingNames = trackUsingNamesBefore;
             break;
         }
         case Token::PunctuatorToken:
             if (token->valuePunctuatorsKind == LeftSquareBracket) {
-                key = this->isolateCoverGrammar(&Parser::parseAssignmentExpression);
+                key = this->isolateCoverGrammar(builder, &Parser::parseAssignmentExpression<ASTBuilder>);
                 this->expect(RightSquareBracket);
             } else {
                 this->throwUnexpectedToken(token);
@@ -3669,27 +4384,25 @@ public:
     }
 
 
-    bool isPropertyKey(Node* key, const char* value)
+    // checks the token of a property key because SyntaxChecker does not keep values of literals
+    bool isPropertyKey(const RefPtr<ScannerResult>& keyToken, const char* value)
     {
-        if (key->type() == Identifier) {
-            return ((IdentifierNode*)key)->name() == value;
-        } else if (key->type() == Literal) {
-            if (((LiteralNode*)key)->value().isString()) {
-                return ((LiteralNode*)key)->value().asString()->equals(value);
-            }
+        if (keyToken->type == Token::IdentifierToken || keyToken->type == Token::StringLiteralToken) {
+            return keyToken->valueStringLiteral().equals(value);
         }
 
         return false;
     }
 
-    PassRefPtr<PropertyNode> parseObjectProperty(bool& hasProto, std::vector<std::pair<AtomicString, size_t>>& usedNames) //: Node.Property
+    template <class ASTBuilder>
+    ASTNode parseObjectProperty(ASTBuilder& builder, bool& hasProto, std::vector<std::pair<AtomicString, size_t>>& usedNames)
     {
         MetaNode node = this->createNode();
         RefPtr<ScannerResult> token = this->lookahead;
 
         PropertyNode::Kind kind;
-        RefPtr<Node> key; //'': Node.PropertyKey;
-        RefPtr<Node> value; //: Node.PropertyValue;
+        ASTNode key; //'': Node.PropertyKey;
+        ASTNode value; //: Node.PropertyValue;
 
         bool computed = false;
         bool method = false;
@@ -3698,12 +4411,12 @@ public:
         if (token->type == Token::IdentifierToken) {
             this->nextToken();
             MetaNode node = this->createNode();
-            key = this->finalize(node, finishIdentifier(token, true));
+            key = this->finalize(node, finishIdentifier(builder, token, true));
         } else if (this->match(PunctuatorsKind::Multiply)) {
             this->nextToken();
         } else {
             computed = this->match(LeftSquareBracket);
-            key = this->parseObjectPropertyKey();
+            key = this->parseObjectPropertyKey(builder);
         }
 
         bool lookaheadPropertyKey = this->qualifiedPropertyName(this->lookahead);
@@ -3726,21 +4439,21 @@ public:
         if (isGet) {
             kind = PropertyNode::Kind::Get;
             computed = this->match(LeftSquareBracket);
-            key = this->parseObjectPropertyKey();
+            key = this->parseObjectPropertyKey(builder);
             this->context->allowYield = false;
-            value = this->parseGetterMethod();
+            value = this->parseGetterMethod(builder);
 
         } else if (isSet) {
             kind = PropertyNode::Kind::Set;
             computed = this->match(LeftSquareBracket);
-            key = this->parseObjectPropertyKey();
-            value = this->parseSetterMethod();
+            key = this->parseObjectPropertyKey(builder);
+            value = this->parseSetterMethod(builder);
 
         } else if (token->type == Token::PunctuatorToken && token->valuePunctuatorsKind == PunctuatorsKind::Multiply && lookaheadPropertyKey) {
             kind = PropertyNode::Kind::Init;
             computed = this->match(LeftSquareBracket);
-            key = this->parseObjectPropertyKey();
-            value = this->parseGeneratorMethod();
+            key = this->parseObjectPropertyKey(builder);
+            value = this->parseGeneratorMethod(builder);
             method = true;
 
         } else {
@@ -3750,14 +4463,14 @@ public:
 
             kind = PropertyNode::Kind::Init;
             if (this->match(PunctuatorsKind::Colon)) {
-                if (!computed && this->isPropertyKey(key.get(), "__proto__")) {
+                if (!computed && this->isPropertyKey(token, "__proto__")) {
                     if (hasProto) {
                         this->tolerateError(Messages::DuplicateProtoProperty);
                     }
                     hasProto = true;
                 }
                 this->nextToken();
-                value = this->inheritCoverGrammar(&Parser::parseAssignmentExpression);
+                value = this->inheritCoverGrammar(builder, &Parser::parseAssignmentExpression<ASTBuilder>);
 
                 /* TODO(ES6) this part is only for es6
             } else if (this->match(LeftParenthesis)) {
@@ -3783,62 +4496,67 @@ public:
         }
 
         if (key->isIdentifier()) {
-            AtomicString as = key->asIdentifier()->name();
-            bool seenInit = kind == PropertyNode::Kind::Init;
-            bool seenGet = kind == PropertyNode::Kind::Get;
-            bool seenSet = kind == PropertyNode::Kind::Set;
-            size_t len = usedNames.size();
-
-            for (size_t i = 0; i < len; i++) {
-                const auto& n = usedNames[i];
-                if (n.first == as) {
-                    if (n.second == PropertyNode::Kind::Init) {
-                        if (this->context->strict) {
-                            if (seenInit || seenGet || seenSet) {
-                                this->throwError("invalid object literal");
-                            }
-                        } else {
-                            if (seenGet || seenSet) {
-                                this->throwError("invalid object literal");
-                            }
-                        }
-                        seenInit = true;
-                    } else if (n.second == PropertyNode::Kind::Get) {
-                        if (seenInit || seenGet) {
+            checkDuplicatedPropertyName(key->asIdentifier()->name(), kind, usedNames);
+        }
+
+        // return this->finalize(node, new PropertyNode(kind, key, computed, value, method, shorthand));
+        return this->finalize(node, builder.createPropertyNode(key, value, kind, computed));
+    }
+
+    void checkDuplicatedPropertyName(AtomicString as, PropertyNode::Kind kind, std::vector<std::pair<AtomicString, size_t>>& usedNames)
+    {
+        bool seenInit = kind == PropertyNode::Kind::Init;
+        bool seenGet = kind == PropertyNode::Kind::Get;
+        bool seenSet = kind == PropertyNode::Kind::Set;
+        size_t len = usedNames.size();
+
+        for (size_t i = 0; i < len; i++) {
+            const auto& n = usedNames[i];
+            if (n.first == as) {
+                if (n.second == PropertyNode::Kind::Init) {
+                    if (this->context->strict) {
+                        if (seenInit || seenGet || seenSet) {
                             this->throwError("invalid object literal");
                         }
-                        seenGet = true;
-                    } else if (n.second == PropertyNode::Kind::Set) {
-                        if (seenInit || seenSet) {
+                    } else {
+                        if (seenGet || seenSet) {
                             this->throwError("invalid object literal");
                         }
-                        seenSet = true;
                     }
+                    seenInit = true;
+                } else if (n.second == PropertyNode::Kind::Get) {
+                    if (seenInit || seenGet) {
+                        this->throwError("invalid object literal");
+                    }
+                    seenGet = true;
+                } else if (n.second == PropertyNode::Kind::Set) {
+                    if (seenInit || seenSet) {
+                        this->throwError("invalid object literal");
+                    }
+                    seenSet = true;
                 }
             }
-            usedNames.push_back(std::make_pair(as, kind));
         }
-
-        // return this->finalize(node, new PropertyNode(kind, key, computed, value, method, shorthand));
-        return this->finalize(node, new PropertyNode(key.get(), value.get(), kind, computed));
+        usedNames.push_back(std::make_pair(as, kind));
     }
 
-    PassRefPtr<Node> parseObjectInitializer()
+    template <class ASTBuilder>
+    ASTNode parseObjectInitializer(ASTBuilder& builder)
     {
         this->expect(LeftBrace);
         MetaNode node = this->createNode();
-        PropertiesNodeVector properties;
+        ASTPropertyNodeVector properties;
         bool hasProto = false;
         std::vector<std::pair<AtomicString, size_t>> usedNames;
         while (!this->match(RightBrace)) {
-            properties.push_back(this->parseObjectProperty(hasProto, usedNames));
+            builder.appendProperty(properties, this->parseObjectProperty(builder, hasProto, usedNames));
             if (!this->match(RightBrace)) {
                 this->expectCommaSeparator();
             }
         }
         this->expect(RightBrace);
 
-        return this->finalize(node, new ObjectExpressionNode(std::move(properties)));
+        return this->finalize(node, builder.createObjectExpressionNode(std::move(properties)));
     }
 
     // ECMA-262 12.2.9 Template Literals
@@ -3870,20 +4588,21 @@ public:
         return tm;
     }
 
-    PassRefPtr<Node> parseTemplateLiteral()
+    template <class ASTBuilder>
+    ASTNode parseTemplateLiteral(ASTBuilder& builder)
     {
         MetaNode node = this->createNode();
 
-        ExpressionNodeVector expressions;
+        ASTNodeVector expressions;
         TemplateElementVector* quasis = new (GC) TemplateElementVector;
         quasis->push_back(this->parseTemplateHead());
         while (!quasis->back()->tail) {
-            expressions.push_back(this->parseExpression());
+            expressions.push_back(this->parseExpression(builder));
             TemplateElement* quasi = this->parseTemplateElement();
             quasis->push_back(quasi);
         }
 
-        return this->finalize(node, new TemplateLiteralNode(quasis, std::move(expressions)));
+        return this->finalize(node, builder.createTemplateLiteralNode(quasis, std::move(expressions)));
     }
     /*
      // ECMA-262 12.2.10 The Grouping Operator
@@ -4036,7 +4755,12 @@ public:
     */
     void reinterpretExpressionAsPattern(Node* expr)
     {
-        switch (expr->type()) {
+        reinterpretExpressionAsPattern(expr->type());
+    }
+
+    void reinterpretExpressionAsPattern(ASTNodeType type)
+    {
+        switch (type) {
         case ArrayExpression:
             this->throwError("Array pattern is not supported yet");
             RELEASE_ASSERT_NOT_REACHED();
@@ -4064,9 +4788,10 @@ public:
         }
     }
 
-    PassRefPtr<Node> parseGroupExpression()
+    template <class ASTBuilder>
+    ASTNode parseGroupExpression(ASTBuilder& builder)
     {
-        RefPtr<Node> expr;
+        ASTNode expr;
 
         this->expect(LeftParenthesis);
         if (this->match(RightParenthesis)) {
@@ -4076,17 +4801,18 @@ public:
             }
 
             //TODO
-            expr = this->finalize(this->startNode(this->lookahead), new ArrowParameterPlaceHolderNode());
+            expr = this->finalize(this->startNode(this->lookahead), builder.createArrowParameterPlaceHolderNode(ASTNodeVector()));
         } else {
             RefPtr<ScannerResult> startToken = this->lookahead;
 
             bool arrow = false;
             this->context->isBindingElement = true;
-            expr = this->inheritCoverGrammar(&Parser::parseAssignmentExpression);
+            expr = this->inheritCoverGrammar(builder, &Parser::parseAssignmentExpression<ASTBuilder>);
 
+            // the sequence node is created after the closing parenthesis
+            // because elements of it become arrow parameters when "=>" follows
+            ASTNodeVector expressions;
             if (this->match(Comma)) {
-                ExpressionNodeVector expressions;
-
                 this->context->isAssignmentTarget = false;
                 expressions.push_back(expr);
                 while (this->startMarker.index < this->scanner->length) {
@@ -4095,17 +4821,14 @@ public:
                     }
                     this->nextToken();
 
-                    expressions.push_back(this->inheritCoverGrammar(&Parser::parseAssignmentExpression));
-                }
-                if (!arrow) {
-                    expr = this->finalize(this->startNode(startToken), new SequenceExpressionNode(std::move(expressions)));
+                    expressions.push_back(this->inheritCoverGrammar(builder, &Parser::parseAssignmentExpression<ASTBuilder>));
                 }
             }
 
             if (!arrow) {
                 this->expect(RightParenthesis);
                 if (this->match(Arrow)) {
-                    if (expr->type() == Identifier && expr->asIdentifier()->name() == "yield") {
+                    if (expressions.empty() && expr->type() == Identifier && expr->asIdentifier()->name() == "yield") {
                         this->throwError("Yield property is not supported yet");
                         RELEASE_ASSERT_NOT_REACHED();
                         /*
@@ -4121,45 +4844,47 @@ public:
                         if (!this->context->isBindingElement) {
                             this->throwUnexpectedToken(this->lookahead);
                         }
-                        if (expr->type() == SequenceExpression) {
-                            const ExpressionNodeVector& expressions = ((SequenceExpressionNode*)expr.get())->expressions();
+                        if (expressions.size()) {
                             for (size_t i = 0; i < expressions.size(); i++) {
-                                this->reinterpretExpressionAsPattern(expressions[i].get());
+                                this->reinterpretExpressionAsPattern(expressions[i]->type());
                             }
                         } else {
-                            this->reinterpretExpressionAsPattern(expr.get());
+                            this->reinterpretExpressionAsPattern(expr->type());
                         }
 
                         //TODO
-                        ExpressionNodeVector params;
-                        if (expr->type() == SequenceExpression) {
-                            params = ((SequenceExpressionNode*)expr.get())->expressions();
+                        ASTNodeVector params;
+                        if (expressions.size()) {
+                            params = std::move(expressions);
                         } else {
                             params.push_back(expr);
                         }
 
-                        expr = this->finalize(this->startNode(this->lookahead), new ArrowParameterPlaceHolderNode(std::move(params)));
+                        expr = this->finalize(this->startNode(this->lookahead), builder.createArrowParameterPlaceHolderNode(std::move(params)));
                     }
+                } else if (expressions.size()) {
+                    expr = this->finalize(this->startNode(startToken), builder.createSequenceExpressionNode(std::move(expressions)));
                 }
                 this->context->isBindingElement = false;
             }
         }
 
-        return expr.release();
+        return expr;
     }
     // ECMA-262 12.3 Left-Hand-Side Expressions
 
-    ArgumentVector parseArguments()
+    template <class ASTBuilder>
+    ASTNodeVector parseArguments(ASTBuilder& builder)
     {
         this->expect(LeftParenthesis);
-        ArgumentVector args;
+        ASTNodeVector args;
         if (!this->match(RightParenthesis)) {
             while (true) {
-                RefPtr<Node> expr;
+                ASTNode expr;
                 if (this->match(PeriodPeriodPeriod)) {
-                    expr = this->parseSpreadElement();
+                    expr = this->parseSpreadElement(builder);
                 } else {
-                    expr = this->isolateCoverGrammar(&Parser::parseAssignmentExpression);
+                    expr = this->isolateCoverGrammar(builder, &Parser::parseAssignmentExpression<ASTBuilder>);
                 }
                 args.push_back(expr);
                 if (this->match(RightParenthesis)) {
@@ -4181,28 +4906,30 @@ public:
         return token->type == Token::IdentifierToken || token->type == Token::KeywordToken || token->type == Token::BooleanLiteralToken || token->type == Token::NullLiteralToken;
     }
 
-    PassRefPtr<IdentifierNode> parseIdentifierName()
+    template <class ASTBuilder>
+    ASTNode parseIdentifierName(ASTBuilder& builder)
     {
         MetaNode node = this->createNode();
         RefPtr<ScannerResult> token = this->nextToken();
         if (!this->isIdentifierName(token)) {
             this->throwUnexpectedToken(token);
         }
-        return this->finalize(node, finishIdentifier(token, true));
+        return this->finalize(node, finishIdentifier(builder, token, true));
     }
 
-    PassRefPtr<Node> parseNewExpression()
+    template <class ASTBuilder>
+    ASTNode parseNewExpression(ASTBuilder& builder)
     {
         MetaNode node = this->createNode();
 
-        RefPtr<IdentifierNode> id = this->parseIdentifierName();
+        ASTNode id = this->parseIdentifierName(builder);
         // assert(id.name === 'new', 'New expression must start with `new`');
 
         if (this->match(Period)) {
             this->nextToken();
             if (this->lookahead->type == Token::IdentifierToken && this->context->inFunctionBody && this->lookahead->relatedSource() == "target") {
                 // TODO
-                RefPtr<IdentifierNode> property = this->parseIdentifierName();
+                ASTNode property = this->parseIdentifierName(builder);
                 this->throwError("Meta property is not supported yet");
                 RELEASE_ASSERT_NOT_REACHED();
                 // expr = new Node.MetaProperty(id, property);
@@ -4211,25 +4938,24 @@ public:
             }
         }
 
-        Node* expr;
-        RefPtr<Node> callee = this->isolateCoverGrammar(&Parser::parseLeftHandSideExpression);
-        ArgumentVector args;
+        ASTNode callee = this->isolateCoverGrammar(builder, &Parser::parseLeftHandSideExpression<ASTBuilder>);
+        ASTNodeVector args;
         if (this->match(LeftParenthesis)) {
-            args = this->parseArguments();
+            args = this->parseArguments(builder);
         }
-        expr = new NewExpressionNode(callee.get(), std::move(args));
         this->context->isAssignmentTarget = false;
         this->context->isBindingElement = false;
-        return this->finalize(node, expr);
+        return this->finalize(node, builder.createNewExpressionNode(callee, std::move(args)));
     }
 
-    PassRefPtr<Node> parseLeftHandSideExpressionAllowCall()
+    template <class ASTBuilder>
+    ASTNode parseLeftHandSideExpressionAllowCall(ASTBuilder& builder)
     {
         RefPtr<ScannerResult> startToken = this->lookahead;
         bool previousAllowIn = this->context->allowIn;
         this->context->allowIn = true;
 
-        RefPtr<Node> expr;
+        ASTNode expr;
         if (this->context->inFunctionBody && this->matchKeyword(Super)) {
             MetaNode node = this->createNode();
             this->nextToken();
@@ -4240,7 +4966,7 @@ public:
                 this->throwUnexpectedToken(this->lookahead);
             }
         } else {
-            expr = this->inheritCoverGrammar(this->matchKeyword(New) ? &Parser::parseNewExpression : &Parser::parsePrimaryExpression);
+            expr = this->inheritCoverGrammar(builder, this->matchKeyword(New) ? &Parser::parseNewExpression<ASTBuilder> : &Parser::parsePrimaryExpression<ASTBuilder>);
         }
 
         while (true) {
@@ -4252,26 +4978,29 @@ public:
                     this->nextToken();
                     bool trackUsingNamesBefore = this->trackUsingNames;
                     this->trackUsingNames = false;
-                    PassRefPtr<IdentifierNode> property = this->parseIdentifierName();
+                    ASTNode property = this->parseIdentifierName(builder);
                     this->trackUsingNames = trackUsingNamesBefore;
-                    expr = this->finalize(this->startNode(startToken), new MemberExpressionNode(expr.get(), property.get(), true));
+                    expr = this->finalize(this->startNode(startToken), builder.createMemberExpressionNode(expr, property, true));
                 } else if (this->lookahead->valuePunctuatorsKind == LeftParenthesis) {
                     this->context->isBindingElement = false;
                     this->context->isAssignmentTarget = false;
-                    expr = this->finalize(this->startNode(startToken), new CallExpressionNode(expr.get(), this->parseArguments()));
+                    ASTNodeVector arguments = this->parseArguments(builder);
+                    this->markEvalCallIfNeeded(expr);
+                    expr = this->finalize(this->startNode(startToken), builder.createCallExpressionNode(expr, std::move(arguments)));
                 } else if (this->lookahead->valuePunctuatorsKind == LeftSquareBracket) {
                     this->context->isBindingElement = false;
                     this->context->isAssignmentTarget = true;
                     this->nextToken();
-                    RefPtr<Node> property = this->isolateCoverGrammar(&Parser::parseExpression);
+                    ASTNode property = this->isolateCoverGrammar(builder, &Parser::parseExpression<ASTBuilder>);
                     this->expect(RightSquareBracket);
-                    expr = this->finalize(this->startNode(startToken), new MemberExpressionNode(expr.get(), property.get(), false));
+                    expr = this->finalize(this->startNode(startToken), builder.createMemberExpressionNode(expr, property, false));
                 } else {
                     break;
                 }
             } else if (this->lookahead->type == Token::TemplateToken && this->lookahead->valueTemplate->head) {
-                RefPtr<Node> quasi = this->parseTemplateLiteral();
-                expr = this->convertTaggedTempleateExpressionToCallExpression(this->startNode(startToken), this->finalize(this->startNode(startToken), new TaggedTemplateExpressionNode(expr.get(), quasi.get())));
+                ASTNode quasi = this->parseTemplateLiteral(builder);
+                this->markEvalCallIfNeeded(expr);
+                expr = this->convertTaggedTempleateExpressionToCallExpression(builder, this->startNode(startToken), expr, quasi);
             } else {
                 break;
             }
@@ -4281,7 +5010,8 @@ public:
         return expr;
     }
 
-    PassRefPtr<Node> parseSuper()
+    template <class ASTBuilder>
+    ASTNode parseSuper(ASTBuilder& builder)
     {
         MetaNode node = this->createNode();
 
@@ -4293,25 +5023,26 @@ public:
         this->throwError("super keyword is not supported yet");
         RELEASE_ASSERT_NOT_REACHED();
         // return this->finalize(node, new Node.Super());
-        return nullptr;
+        return ASTNode();
     }
 
-    PassRefPtr<Node> parseLeftHandSideExpression()
+    template <class ASTBuilder>
+    ASTNode parseLeftHandSideExpression(ASTBuilder& builder)
     {
         // assert(this->context->allowIn, 'callee of new expression always allow in keyword.');
         ASSERT(this->context->allowIn);
 
         MetaNode node = this->startNode(this->lookahead);
-        RefPtr<Node> expr = (this->matchKeyword(Super) && this->context->inFunctionBody) ? this->parseSuper() : this->inheritCoverGrammar(this->matchKeyword(New) ? &Parser::parseNewExpression : &Parser::parsePrimaryExpression);
+        ASTNode expr = (this->matchKeyword(Super) && this->context->inFunctionBody) ? this->parseSuper(builder) : this->inheritCoverGrammar(builder, this->matchKeyword(New) ? &Parser::parseNewExpression<ASTBuilder> : &Parser::parsePrimaryExpression<ASTBuilder>);
 
         while (true) {
             if (this->match(LeftSquareBracket)) {
                 this->context->isBindingElement = false;
                 this->context->isAssignmentTarget = true;
                 this->expect(LeftSquareBracket);
-                RefPtr<Node> property = this->isolateCoverGrammar(&Parser::parseExpression);
+                ASTNode property = this->isolateCoverGrammar(builder, &Parser::parseExpression<ASTBuilder>);
                 this->expect(RightSquareBracket);
-                expr = this->finalize(node, new MemberExpressionNode(expr.get(), property.get(), false));
+                expr = this->finalize(node, builder.createMemberExpressionNode(expr, property, false));
 
             } else if (this->match(Period)) {
                 this->context->isBindingElement = false;
@@ -4319,13 +5050,14 @@ public:
                 this->expect(Period);
                 bool trackUsingNamesBefore = this->trackUsingNames;
                 this->trackUsingNames = false;
-                RefPtr<IdentifierNode> property = this->parseIdentifierName();
+                ASTNode property = this->parseIdentifierName(builder);
                 this->trackUsingNames = trackUsingNamesBefore;
-                expr = this->finalize(node, new MemberExpressionNode(expr.get(), property.get(), true));
+                expr = this->finalize(node, builder.createMemberExpressionNode(expr, property, true));
 
             } else if (this->lookahead->type == Token::TemplateToken && this->lookahead->valueTemplate->head) {
-                RefPtr<Node> quasi = this->parseTemplateLiteral();
-                expr = this->convertTaggedTempleateExpressionToCallExpression(node, this->finalize(node, new TaggedTemplateExpressionNode(expr.get(), quasi.get())).get());
+                ASTNode quasi = this->parseTemplateLiteral(builder);
+                this->markEvalCallIfNeeded(expr);
+                expr = this->convertTaggedTempleateExpressionToCallExpression(builder, node, expr, quasi);
             } else {
                 break;
             }
@@ -4334,8 +5066,9 @@ public:
         return expr;
     }
 
-    PassRefPtr<Node> convertTaggedTempleateExpressionToCallExpression(MetaNode node, RefPtr<TaggedTemplateExpressionNode> taggedTemplateExpression)
+    RefPtr<Node> convertTaggedTempleateExpressionToCallExpression(NodeGenerator& builder, MetaNode node, const RefPtr<Node>& expr, const RefPtr<Node>& quasi)
     {
+        RefPtr<TaggedTemplateExpressionNode> taggedTemplateExpression = this->finalize(node, builder.createTaggedTemplateExpressionNode(expr, quasi));
         TemplateLiteralNode* templateLiteral = (TemplateLiteralNode*)taggedTemplateExpression->quasi();
         ArgumentVector args;
         ExpressionNodeVector elements;
@@ -4363,22 +5096,28 @@ public:
         return this->finalize(node, new CallExpressionNode(taggedTemplateExpression->expr(), std::move(args)));
     }
 
+    SyntaxNode convertTaggedTempleateExpressionToCallExpression(SyntaxChecker& builder, MetaNode node, const SyntaxNode& expr, const SyntaxNode& quasi)
+    {
+        return SyntaxNode(CallExpression);
+    }
+
     // ECMA-262 12.4 Update Expressions
 
-    PassRefPtr<Node> parseUpdateExpression()
+    template <class ASTBuilder>
+    ASTNode parseUpdateExpression(ASTBuilder& builder)
     {
-        RefPtr<Node> expr;
+        ASTNode expr;
         RefPtr<ScannerResult> startToken = this->lookahead;
 
         if (this->match(PlusPlus) || this->match(MinusMinus)) {
             bool isPlus = this->match(PlusPlus);
             MetaNode node = this->startNode(startToken);
             RefPtr<ScannerResult> token = this->nextToken();
-            expr = this->inheritCoverGrammar(&Parser::parseUnaryExpression);
+            expr = this->inheritCoverGrammar(builder, &Parser::parseUnaryExpression<ASTBuilder>);
             if (expr->isLiteral() || expr->type() == ASTNodeType::ThisExpression) {
                 this->throwError(Messages::InvalidLHSInAssignment, String::emptyString, String::emptyString, ErrorObject::ReferenceError);
             }
-            if (this->context->strict && expr->type() == Identifier && this->scanner->isRestrictedWord(((IdentifierNode*)expr.get())->name())) {
+            if (this->context->strict && expr->type() == Identifier && this->scanner->isRestrictedWord(expr->asIdentifier()->name())) {
                 this->tolerateError(Messages::StrictLHSPrefix);
             }
             if (!this->context->isAssignmentTarget && this->context->strict) {
@@ -4387,18 +5126,18 @@ public:
             bool prefix = true;
 
             if (isPlus) {
-                expr = this->finalize(node, new UpdateExpressionIncrementPrefixNode(expr.get()));
+                expr = this->finalize(node, builder.createUpdateExpressionIncrementPrefixNode(expr));
             } else {
-                expr = this->finalize(node, new UpdateExpressionDecrementPrefixNode(expr.get()));
+                expr = this->finalize(node, builder.createUpdateExpressionDecrementPrefixNode(expr));
             }
             this->context->isAssignmentTarget = false;
             this->context->isBindingElement = false;
         } else {
-            expr = this->inheritCoverGrammar(&Parser::parseLeftHandSideExpressionAllowCall);
+            expr = this->inheritCoverGrammar(builder, &Parser::parseLeftHandSideExpressionAllowCall<ASTBuilder>);
             if (!this->hasLineTerminator && this->lookahead->type == Token::PunctuatorToken) {
                 if (this->match(PlusPlus) || this->match(MinusMinus)) {
                     bool isPlus = this->match(PlusPlus);
-                    if (this->context->strict && expr->isIdentifier() && this->scanner->isRestrictedWord(((IdentifierNode*)expr.get())->name())) {
+                    if (this->context->strict && expr->isIdentifier() && this->scanner->isRestrictedWord(expr->asIdentifier()->name())) {
                         this->tolerateError(Messages::StrictLHSPostfix);
                     }
                     if (!this->context->isAssignmentTarget && this->context->strict) {
@@ -4413,9 +5152,9 @@ public:
                     }
 
                     if (isPlus) {
-                        expr = this->finalize(this->startNode(startToken), new UpdateExpressionIncrementPostfixNode(expr.get()));
+                        expr = this->finalize(this->startNode(startToken), builder.createUpdateExpressionIncrementPostfixNode(expr));
                     } else {
-                        expr = this->finalize(this->startNode(startToken), new UpdateExpressionDecrementPostfixNode(expr.get()));
+                        expr = this->finalize(this->startNode(startToken), builder.createUpdateExpressionDecrementPostfixNode(expr));
                     }
                 }
             }
@@ -4426,7 +5165,8 @@ public:
 
     // ECMA-262 12.5 Unary Operators
 
-    PassRefPtr<Node> parseUnaryExpression()
+    template <class ASTBuilder>
+    ASTNode parseUnaryExpression(ASTBuilder& builder)
     {
         bool matchPun = this->lookahead->type == Token::PunctuatorToken;
         if (matchPun) {
@@ -4434,32 +5174,32 @@ public:
             if (punctuatorsKind == Plus) {
                 MetaNode node = this->startNode(this->lookahead);
                 this->nextToken();
-                auto subExpr = this->inheritCoverGrammar(&Parser::parseUnaryExpression);
-                auto expr(this->finalize(node, new UnaryExpressionPlusNode(subExpr.get())));
+                auto subExpr = this->inheritCoverGrammar(builder, &Parser::parseUnaryExpression<ASTBuilder>);
+                auto expr(this->finalize(node, builder.createUnaryExpressionPlusNode(subExpr)));
                 this->context->isAssignmentTarget = false;
                 this->context->isBindingElement = false;
                 return expr;
             } else if (punctuatorsKind == Minus) {
                 MetaNode node = this->startNode(this->lookahead);
                 this->nextToken();
-                auto subExpr = this->inheritCoverGrammar(&Parser::parseUnaryExpression);
-                auto expr(this->finalize(node, new UnaryExpressionMinusNode(subExpr.get())));
+                auto subExpr = this->inheritCoverGrammar(builder, &Parser::parseUnaryExpression<ASTBuilder>);
+                auto expr(this->finalize(node, builder.createUnaryExpressionMinusNode(subExpr)));
                 this->context->isAssignmentTarget = false;
                 this->context->isBindingElement = false;
                 return expr;
             } else if (punctuatorsKind == Wave) {
                 MetaNode node = this->startNode(this->lookahead);
                 this->nextToken();
-                auto subExpr = this->inheritCoverGrammar(&Parser::parseUnaryExpression);
-                auto expr(this->finalize(node, new UnaryExpressionBitwiseNotNode(subExpr.get())));
+                auto subExpr = this->inheritCoverGrammar(builder, &Parser::parseUnaryExpression<ASTBuilder>);
+                auto expr(this->finalize(node, builder.createUnaryExpressionBitwiseNotNode(subExpr)));
                 this->context->isAssignmentTarget = false;
                 this->context->isBindingElement = false;
                 return expr;
             } else if (punctuatorsKind == ExclamationMark) {
                 MetaNode node = this->startNode(this->lookahead);
                 this->nextToken();
-                auto subExpr = this->inheritCoverGrammar(&Parser::parseUnaryExpression);
-                auto expr(this->finalize(node, new UnaryExpressionLogicalNotNode(subExpr.get())));
+                auto subExpr = this->inheritCoverGrammar(builder, &Parser::parseUnaryExpression<ASTBuilder>);
+                auto expr(this->finalize(node, builder.createUnaryExpressionLogicalNotNode(subExpr)));
                 this->context->isAssignmentTarget = false;
                 this->context->isBindingElement = false;
                 return expr;
@@ -4472,8 +5212,8 @@ public:
             if (this->lookahead->valueKeywordKind == Delete) {
                 MetaNode node = this->startNode(this->lookahead);
                 this->nextToken();
-                auto subExpr = this->inheritCoverGrammar(&Parser::parseUnaryExpression);
-                auto expr(this->finalize(node, new UnaryExpressionDeleteNode(subExpr.get())));
+                auto subExpr = this->inheritCoverGrammar(builder, &Parser::parseUnaryExpression<ASTBuilder>);
+                auto expr(this->finalize(node, builder.createUnaryExpressionDeleteNode(subExpr)));
                 this->context->isAssignmentTarget = false;
                 this->context->isBindingElement = false;
 
@@ -4487,16 +5227,16 @@ public:
             } else if (this->lookahead->valueKeywordKind == Void) {
                 MetaNode node = this->startNode(this->lookahead);
                 this->nextToken();
-                auto subExpr = this->inheritCoverGrammar(&Parser::parseUnaryExpression);
-                auto expr(this->finalize(node, new UnaryExpressionVoidNode(subExpr.get())));
+                auto subExpr = this->inheritCoverGrammar(builder, &Parser::parseUnaryExpression<ASTBuilder>);
+                auto expr(this->finalize(node, builder.createUnaryExpressionVoidNode(subExpr)));
                 this->context->isAssignmentTarget = false;
                 this->context->isBindingElement = false;
                 return expr;
             } else if (this->lookahead->valueKeywordKind == Typeof) {
                 MetaNode node = this->startNode(this->lookahead);
                 this->nextToken();
-                auto subExpr = this->inheritCoverGrammar(&Parser::parseUnaryExpression);
-                auto expr(this->finalize(node, new UnaryExpressionTypeOfNode(subExpr.get())));
+                auto subExpr = this->inheritCoverGrammar(builder, &Parser::parseUnaryExpression<ASTBuilder>);
+                auto expr(this->finalize(node, builder.createUnaryExpressionTypeOfNode(subExpr)));
                 this->context->isAssignmentTarget = false;
                 this->context->isBindingElement = false;
 
@@ -4510,13 +5250,14 @@ public:
             }
         }
 
-        return this->parseUpdateExpression();
+        return this->parseUpdateExpression(builder);
     }
 
-    PassRefPtr<Node> parseExponentiationExpression()
+    template <class ASTBuilder>
+    ASTNode parseExponentiationExpression(ASTBuilder& builder)
     {
         RefPtr<ScannerResult> startToken = this->lookahead;
-        RefPtr<Node> expr = this->inheritCoverGrammar(&Parser::parseUnaryExpression);
+        ASTNode expr = this->inheritCoverGrammar(builder, &Parser::parseUnaryExpression<ASTBuilder>);
         // TODO
         /*
          if (expr->type != Syntax.UnaryExpression && this->match('**')) {
@@ -4601,14 +5342,14 @@ public:
         return 0;
     }
 
-    PassRefPtr<Node> parseBinaryExpression()
+    template <class ASTBuilder>
+    ASTNode parseBinaryExpression(ASTBuilder& builder)
     {
         RefPtr<ScannerResult> startToken = this->lookahead;
 
-        RefPtr<Node> expr = this->inheritCoverGrammar(&Parser::parseExponentiationExpression);
+        ASTNode expr = this->inheritCoverGrammar(builder, &Parser::parseExponentiationExpression<ASTBuilder>);
 
         RefPtr<ScannerResult> token = this->lookahead;
-        std::vector<RefPtr<ScannerResult>, GCUtil::gc_malloc_ignore_off_page_allocator<RefPtr<ScannerResult>>> tokenKeeper;
         int prec = this->binaryPrecedence(token);
         if (prec > 0) {
             this->nextToken();
@@ -4620,16 +5361,15 @@ public:
             std::vector<RefPtr<ScannerResult>, GCUtil::gc_malloc_ignore_off_page_allocator<RefPtr<ScannerResult>>> markers;
             markers.push_back(startToken);
             markers.push_back(this->lookahead);
-            RefPtr<Node> left = expr;
-            RefPtr<Node> right = this->isolateCoverGrammar(&Parser::parseExponentiationExpression);
+            ASTNode left = expr;
+            ASTNode right = this->isolateCoverGrammar(builder, &Parser::parseExponentiationExpression<ASTBuilder>);
 
-            std::vector<void*, GCUtil::gc_malloc_ignore_off_page_allocator<void*>> stack;
-            left->ref();
-            stack.push_back(left.get());
-            token->ref();
-            stack.push_back(token.get());
-            right->ref();
-            stack.push_back(right.get());
+            // operands[i] and operands[i + 1] are the operands of operators[i]
+            std::vector<ASTNode> operands;
+            std::vector<RefPtr<ScannerResult>, GCUtil::gc_malloc_ignore_off_page_allocator<RefPtr<ScannerResult>>> operators;
+            operands.push_back(left);
+            operators.push_back(token);
+            operands.push_back(right);
 
             while (true) {
                 prec = this->binaryPrecedence(this->lookahead);
@@ -4638,151 +5378,145 @@ public:
                 }
 
                 // Reduce: make a binary expression from the three topmost entries.
-                while ((stack.size() > 2) && (prec <= ((ScannerResult*)stack[stack.size() - 2])->prec)) {
-                    right = (Node*)stack.back();
-                    right->deref();
-                    stack.pop_back();
-                    RefPtr<ScannerResult> operator_ = (ScannerResult*)stack.back();
-                    operator_->deref();
-                    stack.pop_back();
-                    left = (Node*)stack.back();
-                    left->deref();
-                    stack.pop_back();
+                while (operators.size() && (prec <= operators.back()->prec)) {
+                    right = operands.back();
+                    operands.pop_back();
+                    RefPtr<ScannerResult> operator_ = operators.back();
+                    operators.pop_back();
+                    left = operands.back();
+                    operands.pop_back();
                     markers.pop_back();
                     MetaNode node = this->startNode(markers.back());
-                    auto e = this->finalize(node, finishBinaryExpression(left.get(), right.get(), operator_.get()));
-                    e->ref();
-                    stack.push_back(e.get());
+                    operands.push_back(this->finishBinaryExpression(builder, node, left, right, operator_.get()));
                 }
 
                 // Shift.
                 token = this->nextToken();
                 token->prec = prec;
-                token->ref();
-                stack.push_back(token.get());
+                operators.push_back(token);
                 markers.push_back(this->lookahead);
-                auto e = this->isolateCoverGrammar(&Parser::parseExponentiationExpression);
-                e->ref();
-                stack.push_back(e.get());
+                operands.push_back(this->isolateCoverGrammar(builder, &Parser::parseExponentiationExpression<ASTBuilder>));
             }
 
             // Final reduce to clean-up the stack.
-            size_t i = stack.size() - 1;
-            expr = (Node*)stack[i];
-            expr->deref();
+            expr = operands.back();
+            operands.pop_back();
             markers.pop_back();
-            while (i > 1) {
+            while (operators.size()) {
                 MetaNode node = this->startNode(markers.back());
-                expr = this->finalize(node, finishBinaryExpression((Node*)stack[i - 2], expr.get(), (ScannerResult*)stack[i - 1]));
-                ((Node*)stack[i - 2])->deref();
-                ((ScannerResult*)stack[i - 1])->deref();
-                i -= 2;
+                expr = this->finishBinaryExpression(builder, node, operands.back(), expr, operators.back().get());
+                operands.pop_back();
+                operators.pop_back();
             }
-            RELEASE_ASSERT(i == 0);
+            RELEASE_ASSERT(operands.empty());
         }
 
-        return expr.release();
+        return expr;
     }
 
-    Node* finishBinaryExpression(Node* left, Node* right, ScannerResult* token)
+    template <class ASTBuilder>
+    ASTNode finishBinaryExpression(ASTBuilder& builder, MetaNode node, const ASTNode& left, const ASTNode& right, ScannerResult* token)
     {
-        Node* nd;
         if (token->type == Token::PunctuatorToken) {
             PunctuatorsKind oper = token->valuePunctuatorsKind;
             // Additive Operators
             if (oper == Plus) {
-                nd = new BinaryExpressionPlusNode(left, right);
+                return this->finalize(node, builder.createBinaryExpressionPlusNode(left, right));
             } else if (oper == Minus) {
-                nd = new BinaryExpressionMinusNode(left, right);
+                return this->finalize(node, builder.createBinaryExpressionMinusNode(left, right));
             } else if (oper == LeftShift) { // Bitwise Shift Operators
-                nd = new BinaryExpressionLeftShiftNode(left, right);
+                return this->finalize(node, builder.createBinaryExpressionLeftShiftNode(left, right));
             } else if (oper == RightShift) {
-                nd = new BinaryExpressionSignedRightShiftNode(left, right);
+                return this->finalize(node, builder.createBinaryExpressionSignedRightShiftNode(left, right));
             } else if (oper == UnsignedRightShift) {
-                nd = new BinaryExpressionUnsignedRightShiftNode(left, right);
+                return this->finalize(node, builder.createBinaryExpressionUnsignedRightShiftNode(left, right));
             } else if (oper == Multiply) { // Multiplicative Operators
-                nd = new BinaryExpressionMultiplyNode(left, right);
+                return this->finalize(node, builder.createBinaryExpressionMultiplyNode(left, right));
             } else if (oper == Divide) {
-                nd = new BinaryExpressionDivisionNode(left, right);
+                return this->finalize(node, builder.createBinaryExpressionDivisionNode(left, right));
             } else if (oper == Mod) {
-                nd = new BinaryExpressionModNode(left, right);
+                return this->finalize(node, builder.createBinaryExpressionModNode(left, right));
             } else if (oper == LeftInequality) { // Relational Operators
-                nd = new BinaryExpressionLessThanNode(left, right);
+                return this->finalize(node, builder.createBinaryExpressionLessThanNode(left, right));
             } else if (oper == RightInequality) {
-                nd = new BinaryExpressionGreaterThanNode(left, right);
+                return this->finalize(node, builder.createBinaryExpressionGreaterThanNode(left, right));
             } else if (oper == LeftInequalityEqual) {
-                nd = new BinaryExpressionLessThanOrEqualNode(left, right);
+                return this->finalize(node, builder.createBinaryExpressionLessThanOrEqualNode(left, right));
             } else if (oper == RightInequalityEqual) {
-                nd = new BinaryExpressionGreaterThanOrEqualNode(left, right);
+                return this->finalize(node, builder.createBinaryExpressionGreaterThanOrEqualNode(left, right));
             } else if (oper == Equal) { // Equality Operators
-                nd = new BinaryExpressionEqualNode(left, right);
+                return this->finalize(node, builder.createBinaryExpressionEqualNode(left, right));
             } else if (oper == NotEqual) {
-                nd = new BinaryExpressionNotEqualNode(left, right);
+                return this->finalize(node, builder.createBinaryExpressionNotEqualNode(left, right));
             } else if (oper == StrictEqual) {
-                nd = new BinaryExpressionStrictEqualNode(left, right);
+                return this->finalize(node, builder.createBinaryExpressionStrictEqualNode(left, right));
             } else if (oper == NotStrictEqual) {
-                nd = new BinaryExpressionNotStrictEqualNode(left, right);
+                return this->finalize(node, builder.createBinaryExpressionNotStrictEqualNode(left, right));
             } else if (oper == BitwiseAnd) { // Binary Bitwise Operator
-                nd = new BinaryExpressionBitwiseAndNode(left, right);
+                return this->finalize(node, builder.createBinaryExpressionBitwiseAndNode(left, right));
             } else if (oper == BitwiseXor) {
-                nd = new BinaryExpressionBitwiseXorNode(left, right);
+                return this->finalize(node, builder.createBinaryExpressionBitwiseXorNode(left, right));
             } else if (oper == BitwiseOr) {
-                nd = new BinaryExpressionBitwiseOrNode(left, right);
+                return this->finalize(node, builder.createBinaryExpressionBitwiseOrNode(left, right));
             } else if (oper == LogicalOr) {
-                nd = new BinaryExpressionLogicalOrNode(left, right);
+                return this->finalize(node, builder.createBinaryExpressionLogicalOrNode(left, right));
             } else if (oper == LogicalAnd) {
-                nd = new BinaryExpressionLogicalAndNode(left, right);
+                return this->finalize(node, builder.createBinaryExpressionLogicalAndNode(left, right));
             } else {
                 RELEASE_ASSERT_NOT_REACHED();
             }
         } else {
             ASSERT(token->type == Token::KeywordToken);
             if (token->valueKeywordKind == KeywordKind::In) {
-                nd = new BinaryExpressionInNode(left, right);
+                return this->finalize(node, builder.createBinaryExpressionInNode(left, right));
             } else if (token->valueKeywordKind == KeywordKind::InstanceofKeyword) {
-                nd = new BinaryExpressionInstanceOfNode(left, right);
+                return this->finalize(node, builder.createBinaryExpressionInstanceOfNode(left, right));
             } else {
                 RELEASE_ASSERT_NOT_REACHED();
             }
         }
-        return nd;
+        ASSERT_NOT_REACHED();
+        return ASTNode();
     }
 
     // ECMA-262 12.14 Conditional Operator
 
-    PassRefPtr<Node> parseConditionalExpression()
+    template <class ASTBuilder>
+    ASTNode parseConditionalExpression(ASTBuilder& builder)
     {
         RefPtr<ScannerResult> startToken = this->lookahead;
 
-        RefPtr<Node> expr = this->inheritCoverGrammar(&Parser::parseBinaryExpression);
+        ASTNode expr = this->inheritCoverGrammar(builder, &Parser::parseBinaryExpression<ASTBuilder>);
         if (this->match(GuessMark)) {
             this->nextToken();
 
             bool previousAllowIn = this->context->allowIn;
             this->context->allowIn = true;
-            RefPtr<Node> consequent = this->isolateCoverGrammar(&Parser::parseAssignmentExpression);
+            ASTNode consequent = this->isolateCoverGrammar(builder, &Parser::parseAssignmentExpression<ASTBuilder>);
             this->context->allowIn = previousAllowIn;
 
             this->expect(Colon);
-            RefPtr<Node> alternate = this->isolateCoverGrammar(&Parser::parseAssignmentExpression);
+            ASTNode alternate = this->isolateCoverGrammar(builder, &Parser::parseAssignmentExpression<ASTBuilder>);
 
-            expr = this->finalize(this->startNode(startToken), new ConditionalExpressionNode(expr.get(), consequent.get(), alternate.get()));
+            expr = this->finalize(this->startNode(startToken), builder.createConditionalExpressionNode(expr, consequent, alternate));
             this->context->isAssignmentTarget = false;
             this->context->isBindingElement = false;
         }
 
-        return expr.release();
+        return expr;
     }
 
     // ECMA-262 12.15 Assignment Operators
-    void checkPatternParam(ParseParameterOptions& options, Node* param)
+    template <class ASTBuilder>
+    void checkPatternParam(ParseParameterOptions<ASTBuilder>& options, const ASTNode& param)
     {
         switch (param->type()) {
         case Identifier:
-            this->validateParam(options, nullptr, ((IdentifierNode*)param)->name());
+            this->validateParam(options, nullptr, param->asIdentifier()->name());
             break;
-        case RestElement:
-            this->checkPatternParam(options, ((RestElementNode*)param)->argument());
+        // parseRestElement throws before RestElement is created
+        case AssignmentExpressionSimple:
+            this->throwError("Assignment in parameter is not supported yet");
             break;
         /*
         // case AssignmentPattern:
@@ -4803,7 +5537,7 @@ public:
             break;
             */
         default:
-            RELEASE_ASSERT_NOT_REACHED();
+            this->throwUnexpectedToken(this->lookahead);
             /*
              case Syntax.ArrayPattern:
                  for (let i = 0; i < param.elements.length; i++) {
@@ -4825,24 +5559,25 @@ public:
         }
     }
 
-    ParseFormalParametersResult reinterpretAsCoverFormalsList(Node* expr)
+    template <class ASTBuilder>
+    ParseFormalParametersResult<ASTBuilder> reinterpretAsCoverFormalsList(ASTBuilder& builder, const ASTNode& expr)
     {
-        PatternNodeVector params;
-        params.push_back(expr);
-        ParseParameterOptions options;
+        ASTNodeVector params;
+        ParseParameterOptions<ASTBuilder> options;
 
         switch (expr->type()) {
         case Identifier:
+            params.push_back(expr);
             break;
         case ArrowParameterPlaceHolder:
-            params = ((ArrowParameterPlaceHolderNode*)expr)->params();
+            params = builder.arrowParameterPlaceHolderParams(expr);
             break;
         default:
-            return ParseFormalParametersResult();
+            return ParseFormalParametersResult<ASTBuilder>();
         }
 
         for (size_t i = 0; i < params.size(); ++i) {
-            RefPtr<Node> param = params[i];
+            ASTNode param = params[i];
             /*
              if (param->type() == AssignmentPattern) {
                  if (param->right()->type() == YieldExpression) {
@@ -4856,13 +5591,13 @@ public:
                  }
              }
              */
-            this->checkPatternParam(options, param.get());
+            this->checkPatternParam(options, param);
             //params[i] = param;
         }
 
         if (this->context->strict || !this->context->allowYield) {
             for (size_t i = 0; i < params.size(); ++i) {
-                RefPtr<Node> param = params[i];
+                ASTNode param = params[i];
                 if (param->type() == YieldExpression) {
                     this->throwUnexpectedToken(this->lookahead);
                 }
@@ -4874,19 +5609,20 @@ public:
             this->throwUnexpectedToken(token, options.message);
         }
 
-        return ParseFormalParametersResult(params, options.stricted, options.firstRestricted, options.message);
+        return ParseFormalParametersResult<ASTBuilder>(std::move(params), options.stricted, options.firstRestricted, options.message);
     }
 
-    PassRefPtr<Node> parseAssignmentExpression()
+    template <class ASTBuilder>
+    ASTNode parseAssignmentExpression(ASTBuilder& builder)
     {
-        RefPtr<Node> expr;
+        ASTNode expr;
 
         if (!this->context->allowYield && this->matchKeyword(Yield)) {
-            expr = this->parseYieldExpression();
+            expr = this->parseYieldExpression(builder);
         } else {
             RefPtr<ScannerResult> startToken = this->lookahead;
             RefPtr<ScannerResult> token = startToken;
-            expr = this->parseConditionalExpression();
+            expr = this->parseConditionalExpression(builder);
 
             /*
             if (token.type === Token.Identifier && (token.lineNumber === this.lookahead.lineNumber) && token.value === 'async' && (this.lookahead.type === Token.Identifier)) {
@@ -4902,7 +5638,7 @@ public:
                 // ECMA-262 14.2 Arrow Function Definitions
                 this->context->isAssignmentTarget = false;
                 this->context->isBindingElement = false;
-                ParseFormalParametersResult list = this->reinterpretAsCoverFormalsList(expr.get()); //TODO
+                ParseFormalParametersResult<ASTBuilder> list = this->reinterpretAsCoverFormalsList(builder, expr); //TODO
 
                 if (list.valid) {
                     if (this->hasLineTerminator) {
@@ -4923,22 +5659,25 @@ public:
                     MetaNode nodeStart = this->createNode();
 
                     this->expect(Arrow);
-                    RefPtr<Node> body = this->match(LeftBrace) ? this->parseFunctionSourceElements() : this->isolateCoverGrammar(&Parser::parseAssignmentExpression);
-                    bool expression = body->type() != BlockStatement;
+                    ASTNode body;
+                    bool expression = !this->match(LeftBrace);
+                    if (!expression) {
+                        body = this->parseFunctionSourceElements(builder);
+                    } else if (builder.isNodeGenerator() && this->config.eagerlyParseFunctionBodies) {
+                        body = this->isolateCoverGrammar(builder, &Parser::parseAssignmentExpression<ASTBuilder>);
+                    } else {
+                        // like other function bodies, expression body is only checked here.
+                        // parseArrowFunctionSourceElements builds it when the arrow function is called first time
+                        SyntaxChecker checker;
+                        this->isolateCoverGrammar(checker, &Parser::parseAssignmentExpression<SyntaxChecker>);
+                        body = this->finalize(nodeStart, builder.createBlockStatementNode(builder.createStatementContainer()));
+                    }
                     if (expression) {
-                        if (this->config.parseSingleFunction) {
+                        if (this->config.parseSingleFunction && builder.isNodeGenerator()) {
                             ASSERT(this->config.parseSingleFunctionChildIndex.asUint32());
                             this->config.parseSingleFunctionChildIndex = SmallValue(this->config.parseSingleFunctionChildIndex.asUint32() + 1);
                         }
-                        scopeContexts.back()->m_locStart.line = nodeStart.line;
-                        scopeContexts.back()->m_locStart.column = nodeStart.column;
-                        scopeContexts.back()->m_locStart.index = nodeStart.index;
-
-                        scopeContexts.back()->m_locEnd.index = this->lastMarker.index;
-#ifndef NDEBUG
-                        scopeContexts.back()->m_locEnd.line = this->lastMarker.lineNumber;
-                        scopeContexts.back()->m_locEnd.column = this->lastMarker.index - this->lastMarker.lineStart;
-#endif
+                        recordFunctionBodyLocation(nodeStart);
                     }
 
                     if (this->context->strict && list.firstRestricted) {
@@ -4947,7 +5686,7 @@ public:
                     if (this->context->strict && list.stricted) {
                         this->tolerateUnexpectedToken(list.stricted, list.message);
                     }
-                    expr = this->finalize(node, new ArrowFunctionExpressionNode(std::move(list.params), body.get(), popScopeContext(node), expression)); //TODO
+                    expr = this->finalize(node, builder.createArrowFunctionExpressionNode(std::move(list.params), body, popScopeContext(node), expression)); //TODO
 
                     this->context->strict = previousStrict;
                     this->context->allowYield = previousAllowYield;
@@ -4960,11 +5699,11 @@ public:
                     }
 
                     if (this->context->strict && expr->type() == Identifier) {
-                        IdentifierNode* id = expr->asIdentifier();
-                        if (this->scanner->isRestrictedWord(id->name())) {
+                        AtomicString name = expr->asIdentifier()->name();
+                        if (this->scanner->isRestrictedWord(name)) {
                             this->tolerateUnexpectedToken(token, Messages::StrictLHSAssignment);
                         }
-                        if (this->scanner->isStrictModeReservedWord(id->name())) {
+                        if (this->scanner->isStrictModeReservedWord(name)) {
                             this->tolerateUnexpectedToken(token, Messages::StrictReservedWord);
                         }
                     }
@@ -4973,93 +5712,94 @@ public:
                         this->context->isAssignmentTarget = false;
                         this->context->isBindingElement = false;
                     } else {
-                        this->reinterpretExpressionAsPattern(expr.get());
+                        this->reinterpretExpressionAsPattern(expr->type());
                     }
 
                     if (expr->isLiteral() || expr->type() == ASTNodeType::ThisExpression) {
                         this->throwError(Messages::InvalidLHSInAssignment, String::emptyString, String::emptyString, ErrorObject::ReferenceError);
                     }
 
-                    Node* exprResult;
                     token = this->nextToken();
-                    RefPtr<Node> right = this->isolateCoverGrammar(&Parser::parseAssignmentExpression);
+                    ASTNode right = this->isolateCoverGrammar(builder, &Parser::parseAssignmentExpression<ASTBuilder>);
+                    MetaNode node = this->startNode(startToken);
                     if (token->valuePunctuatorsKind == Substitution) {
-                        exprResult = new AssignmentExpressionSimpleNode(expr.get(), right.get());
+                        expr = this->finalize(node, builder.createAssignmentExpressionSimpleNode(expr, right));
                     } else if (token->valuePunctuatorsKind == PlusEqual) {
-                        exprResult = new AssignmentExpressionPlusNode(expr.get(), right.get());
+                        expr = this->finalize(node, builder.createAssignmentExpressionPlusNode(expr, right));
                     } else if (token->valuePunctuatorsKind == MinusEqual) {
-                        exprResult = new AssignmentExpressionMinusNode(expr.get(), right.get());
+                        expr = this->finalize(node, builder.createAssignmentExpressionMinusNode(expr, right));
                     } else if (token->valuePunctuatorsKind == MultiplyEqual) {
-                        exprResult = new AssignmentExpressionMultiplyNode(expr.get(), right.get());
+                        expr = this->finalize(node, builder.createAssignmentExpressionMultiplyNode(expr, right));
                     } else if (token->valuePunctuatorsKind == DivideEqual) {
-                        exprResult = new AssignmentExpressionDivisionNode(expr.get(), right.get());
+                        expr = this->finalize(node, builder.createAssignmentExpressionDivisionNode(expr, right));
                     } else if (token->valuePunctuatorsKind == ModEqual) {
-                        exprResult = new AssignmentExpressionModNode(expr.get(), right.get());
+                        expr = this->finalize(node, builder.createAssignmentExpressionModNode(expr, right));
                     } else if (token->valuePunctuatorsKind == LeftShiftEqual) {
-                        exprResult = new AssignmentExpressionLeftShiftNode(expr.get(), right.get());
+                        expr = this->finalize(node, builder.createAssignmentExpressionLeftShiftNode(expr, right));
                     } else if (token->valuePunctuatorsKind == RightShiftEqual) {
-                        exprResult = new AssignmentExpressionSignedRightShiftNode(expr.get(), right.get());
+                        expr = this->finalize(node, builder.createAssignmentExpressionSignedRightShiftNode(expr, right));
                     } else if (token->valuePunctuatorsKind == UnsignedRightShiftEqual) {
-                        exprResult = new AssignmentExpressionUnsignedShiftNode(expr.get(), right.get());
+                        expr = this->finalize(node, builder.createAssignmentExpressionUnsignedShiftNode(expr, right));
                     } else if (token->valuePunctuatorsKind == BitwiseXorEqual) {
-                        exprResult = new AssignmentExpressionBitwiseXorNode(expr.get(), right.get());
+                        expr = this->finalize(node, builder.createAssignmentExpressionBitwiseXorNode(expr, right));
                     } else if (token->valuePunctuatorsKind == BitwiseAndEqual) {
-                        exprResult = new AssignmentExpressionBitwiseAndNode(expr.get(), right.get());
+                        expr = this->finalize(node, builder.createAssignmentExpressionBitwiseAndNode(expr, right));
                     } else if (token->valuePunctuatorsKind == BitwiseOrEqual) {
-                        exprResult = new AssignmentExpressionBitwiseOrNode(expr.get(), right.get());
+                        expr = this->finalize(node, builder.createAssignmentExpressionBitwiseOrNode(expr, right));
                     } else {
                         RELEASE_ASSERT_NOT_REACHED();
                     }
-                    expr = this->finalize(this->startNode(startToken), exprResult);
                     this->context->firstCoverInitializedNameError = nullptr;
                 }
             }
         }
-        return expr.release();
+        return expr;
     }
 
     // ECMA-262 12.16 Comma Operator
 
-    PassRefPtr<Node> parseExpression()
+    template <class ASTBuilder>
+    ASTNode parseExpression(ASTBuilder& builder)
     {
         RefPtr<ScannerResult> startToken = this->lookahead;
-        RefPtr<Node> expr = this->isolateCoverGrammar(&Parser::parseAssignmentExpression);
+        ASTNode expr = this->isolateCoverGrammar(builder, &Parser::parseAssignmentExpression<ASTBuilder>);
 
         if (this->match(Comma)) {
-            ExpressionNodeVector expressions;
+            ASTNodeVector expressions;
             expressions.push_back(expr);
             while (this->startMarker.index < this->scanner->length) {
                 if (!this->match(Comma)) {
                     break;
                 }
                 this->nextToken();
-                expressions.push_back(this->isolateCoverGrammar(&Parser::parseAssignmentExpression));
+                expressions.push_back(this->isolateCoverGrammar(builder, &Parser::parseAssignmentExpression<ASTBuilder>));
             }
 
-            expr = this->finalize(this->startNode(startToken), new SequenceExpressionNode(std::move(expressions)));
+            expr = this->finalize(this->startNode(startToken), builder.createSequenceExpressionNode(std::move(expressions)));
         }
 
-        return expr.release();
+        return expr;
     }
 
     // ECMA-262 13.2 Block
 
-    PassRefPtr<StatementNode> parseStatementListItem()
+    template <class ASTBuilder>
+    ASTNode parseStatementListItem(ASTBuilder& builder)
     {
-        RefPtr<StatementNode> statement;
+        ASTNode statement;
         this->context->isAssignmentTarget = true;
         this->context->isBindingElement = true;
         if (this->lookahead->type == KeywordToken) {
             switch (this->lookahead->valueKeywordKind) {
             case Function:
-                statement = this->parseFunctionDeclaration();
+                statement = this->parseFunctionDeclaration(builder);
                 break;
             default:
-                statement = this->parseStatement();
+                statement = this->parseStatement(builder);
                 break;
             }
         } else {
-            statement = this->parseStatement();
+            statement = this->parseStatement(builder);
         }
         /*
          if (this->lookahead.type === Token.Keyword) {
@@ -5096,24 +5836,25 @@ public:
              statement = this->parseStatement();
          }*/
 
-        return statement.release();
+        return statement;
     }
 
-    PassRefPtr<BlockStatementNode> parseBlock()
+    template <class ASTBuilder>
+    ASTNode parseBlock(ASTBuilder& builder)
     {
         this->expect(LeftBrace);
         MetaNode node = this->createNode();
-        RefPtr<StatementContainer> block = StatementContainer::create();
+        ASTStatementContainer block = builder.createStatementContainer();
         StatementNode* referNode = nullptr;
         while (true) {
             if (this->match(RightBrace)) {
                 break;
             }
-            referNode = block->appendChild(this->parseStatementListItem().get(), referNode);
+            referNode = builder.appendChild(block, this->parseStatementListItem(builder), referNode);
         }
         this->expect(RightBrace);
 
-        return this->finalize(node, new BlockStatementNode(block.get()));
+        return this->finalize(node, builder.createBlockStatementNode(block));
     }
     /*
          // ECMA-262 13.3.1 Let and Const Declarations
@@ -5311,7 +6052,8 @@ public:
     */
 
     // ECMA-262 13.3.2 Variable Statement
-    PassRefPtr<IdentifierNode> parseVariableIdentifier(String* kind = String::emptyString)
+    template <class ASTBuilder>
+    ASTNode parseVariableIdentifier(ASTBuilder& builder, String* kind = String::emptyString)
     {
         MetaNode node = this->createNode();
 
@@ -5335,143 +6077,156 @@ public:
             this->tolerateUnexpectedToken(token);
         }
 
-        return this->finalize(node, finishIdentifier(token, true));
+        return this->finalize(node, finishIdentifier(builder, token, true));
     }
 
     struct DeclarationOptions {
         bool inFor;
+        // set by parseVariableDeclarationList for the for-in checks
+        bool firstDeclaratorHasInit;
     };
 
-    PassRefPtr<VariableDeclaratorNode> parseVariableDeclaration(DeclarationOptions& options)
+    template <class ASTBuilder>
+    ASTNode parseVariableDeclaration(ASTBuilder& builder, DeclarationOptions& options, bool& hasInit)
     {
         MetaNode node = this->createNode();
 
         std::vector<RefPtr<ScannerResult>, GCUtil::gc_malloc_ignore_off_page_allocator<RefPtr<ScannerResult>>> params;
-        RefPtr<Node> id = this->parsePattern(params, new ASCIIString("var"));
+        ASTNode id = this->parsePattern(builder, params, new ASCIIString("var"));
 
         // ECMA-262 12.2.1
         if (this->context->strict && id->type() == Identifier) {
-            if (this->scanner->isRestrictedWord(((IdentifierNode*)id.get())->name())) {
+            if (this->scanner->isRestrictedWord(id->asIdentifier()->name())) {
                 this->tolerateError(Messages::StrictVarName);
             }
         }
 
         if (id->type() == Identifier && !this->config.parseSingleFunction) {
-            this->scopeContexts.back()->insertName(((IdentifierNode*)id.get())->name(), true);
+            this->scopeContexts.back()->insertName(id->asIdentifier()->name(), true);
         }
 
-        RefPtr<Node> init;
+        ASTNode init;
+        hasInit = false;
         if (this->match(Substitution)) {
             this->nextToken();
-            init = this->isolateCoverGrammar(&Parser::parseAssignmentExpression);
+            init = this->isolateCoverGrammar(builder, &Parser::parseAssignmentExpression<ASTBuilder>);
+            hasInit = true;
         } else if (id->type() != Identifier && !options.inFor) {
             this->expect(Substitution);
         }
 
-        return this->finalize(node, new VariableDeclaratorNode(id.get(), init.get()));
+        return this->finalize(node, builder.createVariableDeclaratorNode(id, init));
     }
 
-    VariableDeclaratorVector parseVariableDeclarationList(DeclarationOptions& options)
+    template <class ASTBuilder>
+    ASTVariableDeclaratorVector parseVariableDeclarationList(ASTBuilder& builder, DeclarationOptions& options)
     {
         DeclarationOptions opt;
         opt.inFor = options.inFor;
 
-        VariableDeclaratorVector list;
-        list.push_back(this->parseVariableDeclaration(opt));
+        ASTVariableDeclaratorVector list;
+        builder.appendVariableDeclarator(list, this->parseVariableDeclaration(builder, opt, options.firstDeclaratorHasInit));
         while (this->match(Comma)) {
             this->nextToken();
-            list.push_back(this->parseVariableDeclaration(opt));
+            bool hasInit;
+            builder.appendVariableDeclarator(list, this->parseVariableDeclaration(builder, opt, hasInit));
         }
 
         return list;
     }
 
-    PassRefPtr<VariableDeclarationNode> parseVariableStatement()
+    template <class ASTBuilder>
+    ASTNode parseVariableStatement(ASTBuilder& builder)
     {
         this->expectKeyword(Var);
         MetaNode node = this->createNode();
         DeclarationOptions opt;
         opt.inFor = false;
-        VariableDeclaratorVector declarations = this->parseVariableDeclarationList(opt);
+        ASTVariableDeclaratorVector declarations = this->parseVariableDeclarationList(builder, opt);
         this->consumeSemicolon();
 
-        return this->finalize(node, new VariableDeclarationNode(std::move(declarations) /*, 'var'*/));
+        return this->finalize(node, builder.createVariableDeclarationNode(std::move(declarations) /*, 'var'*/));
     }
 
     // ECMA-262 13.4 Empty Statement
 
-    PassRefPtr<EmptyStatementNode> parseEmptyStatement()
+    template <class ASTBuilder>
+    ASTNode parseEmptyStatement(ASTBuilder& builder)
     {
         this->expect(SemiColon);
         MetaNode node = this->createNode();
-        return this->finalize(node, new EmptyStatementNode());
+        return this->finalize(node, builder.createEmptyStatementNode());
     }
 
     // ECMA-262 13.5 Expression Statement
 
-    PassRefPtr<ExpressionStatementNode> parseExpressionStatement()
+    template <class ASTBuilder>
+    ASTNode parseExpressionStatement(ASTBuilder& builder)
     {
         MetaNode node = this->createNode();
-        RefPtr<Node> expr = this->parseExpression();
+        ASTNode expr = this->parseExpression(builder);
         this->consumeSemicolon();
-        return this->finalize(node, new ExpressionStatementNode(expr.get()));
+        return this->finalize(node, builder.createExpressionStatementNode(expr));
     }
 
     // ECMA-262 13.6 If statement
 
-    PassRefPtr<IfStatementNode> parseIfStatement()
+    template <class ASTBuilder>
+    ASTNode parseIfStatement(ASTBuilder& builder)
     {
-        RefPtr<Node> consequent;
-        RefPtr<Node> alternate;
+        ASTNode consequent;
+        ASTNode alternate;
 
         this->expectKeyword(If);
         MetaNode node = this->createNode();
         this->expect(LeftParenthesis);
-        RefPtr<Node> test = this->parseExpression();
+        ASTNode test = this->parseExpression(builder);
 
         if (!this->match(RightParenthesis) && this->config.tolerant) {
             this->tolerateUnexpectedToken(this->nextToken());
-            consequent = this->finalize(this->createNode(), new EmptyStatementNode());
+            consequent = this->finalize(this->createNode(), builder.createEmptyStatementNode());
         } else {
             this->expect(RightParenthesis);
-            consequent = this->parseStatement(this->context->strict ? false : true);
+            consequent = this->parseStatement(builder, this->context->strict ? false : true);
             if (this->matchKeyword(Else)) {
                 this->nextToken();
-                alternate = this->parseStatement();
+                alternate = this->parseStatement(builder);
             }
         }
 
-        return this->finalize(node, new IfStatementNode(test.get(), consequent.get(), alternate.get()));
+        return this->finalize(node, builder.createIfStatementNode(test, consequent, alternate));
     }
 
     // ECMA-262 13.7.2 The do-while Statement
 
-    PassRefPtr<DoWhileStatementNode> parseDoWhileStatement()
+    template <class ASTBuilder>
+    ASTNode parseDoWhileStatement(ASTBuilder& builder)
     {
         this->expectKeyword(Do);
         MetaNode node = this->createNode();
 
         bool previousInIteration = this->context->inIteration;
         this->context->inIteration = true;
-        RefPtr<Node> body = this->parseStatement(false);
+        ASTNode body = this->parseStatement(builder, false);
         this->context->inIteration = previousInIteration;
 
         this->expectKeyword(While);
         this->expect(LeftParenthesis);
-        RefPtr<Node> test = this->parseExpression();
+        ASTNode test = this->parseExpression(builder);
         this->expect(RightParenthesis);
         if (this->match(SemiColon)) {
             this->nextToken();
         }
 
-        return this->finalize(node, new DoWhileStatementNode(test.get(), body.get()));
+        return this->finalize(node, builder.createDoWhileStatementNode(test, body));
     }
 
     // ECMA-262 13.7.3 The while Statement
 
-    PassRefPtr<WhileStatementNode> parseWhileStatement()
+    template <class ASTBuilder>
+    ASTNode parseWhileStatement(ASTBuilder& builder)
     {
-        RefPtr<Node> body;
+        ASTNode body;
 
         bool prevInLoop = this->context->inLoop;
         this->context->inLoop = true;
@@ -5479,36 +6234,37 @@ public:
         this->expectKeyword(While);
         MetaNode node = this->createNode();
         this->expect(LeftParenthesis);
-        RefPtr<Node> test = this->parseExpression();
+        ASTNode test = this->parseExpression(builder);
 
         if (!this->match(RightParenthesis) && this->config.tolerant) {
             this->tolerateUnexpectedToken(this->nextToken());
-            body = this->finalize(this->createNode(), new EmptyStatementNode());
+            body = this->finalize(this->createNode(), builder.createEmptyStatementNode());
         } else {
             this->expect(RightParenthesis);
 
             bool previousInIteration = this->context->inIteration;
             this->context->inIteration = true;
-            body = this->parseStatement(false);
+            body = this->parseStatement(builder, false);
             this->context->inIteration = previousInIteration;
         }
 
         this->context->inLoop = prevInLoop;
 
-        return this->finalize(node, new WhileStatementNode(test.get(), body.get()));
+        return this->finalize(node, builder.createWhileStatementNode(test, body));
     }
 
     // ECMA-262 13.7.4 The for Statement
     // ECMA-262 13.7.5 The for-in and for-of Statements
 
-    PassRefPtr<StatementNode> parseForStatement()
+    template <class ASTBuilder>
+    ASTNode parseForStatement(ASTBuilder& builder)
     {
-        RefPtr<Node> init;
-        RefPtr<Node> test;
-        RefPtr<Node> update;
+        ASTNode init;
+        ASTNode test;
+        ASTNode update;
         bool forIn = true;
-        RefPtr<Node> left;
-        RefPtr<Node> right;
+        ASTNode left;
+        ASTNode right;
 
         bool prevInLoop = this->context->inLoop;
 
@@ -5527,30 +6283,30 @@ public:
                 this->context->allowIn = false;
                 DeclarationOptions opt;
                 opt.inFor = true;
-                VariableDeclaratorVector declarations = this->parseVariableDeclarationList(opt);
+                ASTVariableDeclaratorVector declarations = this->parseVariableDeclarationList(builder, opt);
                 this->context->allowIn = previousAllowIn;
 
                 if (declarations.size() == 1 && this->matchKeyword(In)) {
-                    RefPtr<VariableDeclaratorNode> decl = declarations[0];
                     // if (decl->init() && (decl.id.type === Syntax.ArrayPattern || decl.id.type === Syntax.ObjectPattern || this->context->strict)) {
-                    if (decl->init() && (decl->id()->type() == ArrayExpression || decl->id()->type() == ObjectExpression || this->context->strict)) {
+                    // parsePattern accepts only identifiers now
+                    if (opt.firstDeclaratorHasInit && this->context->strict) {
                         this->tolerateError(Messages::ForInOfLoopInitializer, new ASCIIString("for-in"));
                     }
-                    init = this->finalize(metaInit, new VariableDeclarationNode(std::move(declarations) /*, 'var'*/));
+                    init = this->finalize(metaInit, builder.createVariableDeclarationNode(std::move(declarations) /*, 'var'*/));
                     this->nextToken();
                     left = init;
-                    right = this->parseExpression();
-                    init = nullptr;
-                } else if (declarations.size() == 1 && declarations[0]->init() == nullptr
+                    right = this->parseExpression(builder);
+                    init = ASTNode();
+                } else if (declarations.size() == 1 && !opt.firstDeclaratorHasInit
                            && this->lookahead->type == Token::IdentifierToken && this->lookahead->relatedSource() == "of") {
-                    init = this->finalize(metaInit, new VariableDeclarationNode(std::move(declarations) /*, 'var'*/));
+                    init = this->finalize(metaInit, builder.createVariableDeclarationNode(std::move(declarations) /*, 'var'*/));
                     this->nextToken();
                     left = init;
-                    right = this->parseAssignmentExpression();
-                    init = nullptr;
+                    right = this->parseAssignmentExpression(builder);
+                    init = ASTNode();
                     forIn = false;
                 } else {
-                    init = this->finalize(metaInit, new VariableDeclarationNode(std::move(declarations) /*, 'var'*/));
+                    init = this->finalize(metaInit, builder.createVariableDeclarationNode(std::move(declarations) /*, 'var'*/));
                     this->expect(SemiColon);
                 }
             } else if (this->matchKeyword(Const) || this->matchKeyword(Let)) {
@@ -5595,7 +6351,7 @@ public:
                 RefPtr<ScannerResult> initStartToken = this->lookahead;
                 bool previousAllowIn = this->context->allowIn;
                 this->context->allowIn = false;
-                init = this->inheritCoverGrammar(&Parser::parseAssignmentExpression);
+                init = this->inheritCoverGrammar(builder, &Parser::parseAssignmentExpression<ASTBuilder>);
                 this->context->allowIn = previousAllowIn;
 
                 if (this->matchKeyword(In)) {
@@ -5604,10 +6360,10 @@ public:
                     }
 
                     this->nextToken();
-                    this->reinterpretExpressionAsPattern(init.get());
+                    this->reinterpretExpressionAsPattern(init->type());
                     left = init;
-                    right = this->parseExpression();
-                    init = nullptr;
+                    right = this->parseExpression(builder);
+                    init = ASTNode();
                 } else if (this->lookahead->type == Token::IdentifierToken && this->lookahead->relatedSource() == "of") {
                     this->throwError("for of is not supported yet");
                     RELEASE_ASSERT_NOT_REACHED();
@@ -5625,51 +6381,52 @@ public:
                     */
                 } else {
                     if (this->match(Comma)) {
-                        ExpressionNodeVector initSeq;
+                        ASTNodeVector initSeq;
                         initSeq.push_back(init);
                         while (this->match(Comma)) {
                             this->nextToken();
-                            initSeq.push_back(this->isolateCoverGrammar(&Parser::parseAssignmentExpression));
+                            initSeq.push_back(this->isolateCoverGrammar(builder, &Parser::parseAssignmentExpression<ASTBuilder>));
                         }
-                        init = this->finalize(this->startNode(initStartToken), new SequenceExpressionNode(std::move(initSeq)));
+                        init = this->finalize(this->startNode(initStartToken), builder.createSequenceExpressionNode(std::move(initSeq)));
                     }
                     this->expect(SemiColon);
                 }
             }
         }
 
-        if (left == nullptr) {
+        if (!left) {
             this->context->inLoop = true;
             if (!this->match(SemiColon)) {
-                test = this->parseExpression();
+                test = this->parseExpression(builder);
             }
             this->expect(SemiColon);
             if (!this->match(RightParenthesis)) {
-                update = this->parseExpression();
+                update = this->parseExpression(builder);
             }
         }
 
-        RefPtr<Node> body = nullptr;
+        ASTNode body;
         if (!this->match(RightParenthesis) && this->config.tolerant) {
             this->tolerateUnexpectedToken(this->nextToken());
-            body = this->finalize(this->createNode(), new EmptyStatementNode());
+            body = this->finalize(this->createNode(), builder.createEmptyStatementNode());
         } else {
             this->expect(RightParenthesis);
 
             bool previousInIteration = this->context->inIteration;
             this->context->inIteration = true;
-            auto functor = std::bind(&Parser::parseStatement, std::ref(*this), false);
-            body = this->isolateCoverGrammarWithFunctor(functor);
+            body = this->isolateCoverGrammarWithFunctor(builder, [this, &builder]() {
+                return this->parseStatement(builder, false);
+            });
             this->context->inIteration = previousInIteration;
         }
 
         this->context->inLoop = prevInLoop;
 
-        if (left == nullptr) {
-            return this->finalize(node, new ForStatementNode(init.get(), test.get(), update.get(), body.get()));
+        if (!left) {
+            return this->finalize(node, builder.createForStatementNode(init, test, update, body));
         } else {
             if (forIn) {
-                return this->finalize(node, new ForInStatementNode(left.get(), right.get(), body.get(), false));
+                return this->finalize(node, builder.createForInStatementNode(left, right, body));
             } else {
                 this->throwError("For of is not supported yet");
                 RELEASE_ASSERT_NOT_REACHED();
@@ -5707,73 +6464,76 @@ public:
     }
     // ECMA-262 13.8 The continue statement
 
-    PassRefPtr<Node> parseContinueStatement()
+    template <class ASTBuilder>
+    ASTNode parseContinueStatement(ASTBuilder& builder)
     {
         this->expectKeyword(Continue);
         MetaNode node = this->createNode();
 
-        RefPtr<IdentifierNode> label = nullptr;
+        ASTNode label;
         if (this->lookahead->type == IdentifierToken && !this->hasLineTerminator) {
-            label = this->parseVariableIdentifier();
+            label = this->parseVariableIdentifier(builder);
 
-            if (!hasLabel(label->name())) {
-                this->throwError(Messages::UnknownLabel, label->name().string());
+            if (!hasLabel(label->asIdentifier()->name())) {
+                this->throwError(Messages::UnknownLabel, label->asIdentifier()->name().string());
             }
         }
 
         if (label) {
             for (size_t i = 0; i < this->context->labelSet.size(); i++) {
-                if (this->context->labelSet[i].first == label->name() && this->context->labelSet[i].second == 1) {
-                    this->throwError(Messages::UnknownLabel, label->name().string());
+                if (this->context->labelSet[i].first == label->asIdentifier()->name() && this->context->labelSet[i].second == 1) {
+                    this->throwError(Messages::UnknownLabel, label->asIdentifier()->name().string());
                 }
             }
         }
 
         this->consumeSemicolon();
-        if (label == nullptr && !this->context->inIteration) {
+        if (!label && !this->context->inIteration) {
             this->throwError(Messages::IllegalContinue);
         }
 
         if (label) {
-            auto string = label->name().string();
-            return this->finalize(node, new ContinueLabelStatementNode(string));
+            auto string = label->asIdentifier()->name().string();
+            return this->finalize(node, builder.createContinueLabelStatementNode(string));
         } else {
-            return this->finalize(node, new ContinueStatementNode());
+            return this->finalize(node, builder.createContinueStatementNode());
         }
     }
 
     // ECMA-262 13.9 The break statement
 
-    PassRefPtr<Node> parseBreakStatement()
+    template <class ASTBuilder>
+    ASTNode parseBreakStatement(ASTBuilder& builder)
     {
         this->expectKeyword(Break);
         MetaNode node = this->createNode();
 
-        RefPtr<IdentifierNode> label = nullptr;
+        ASTNode label;
         if (this->lookahead->type == IdentifierToken && !this->hasLineTerminator) {
-            label = this->parseVariableIdentifier();
+            label = this->parseVariableIdentifier(builder);
 
-            if (!hasLabel(label->name())) {
-                this->throwError(Messages::UnknownLabel, label->name().string());
+            if (!hasLabel(label->asIdentifier()->name())) {
+                this->throwError(Messages::UnknownLabel, label->asIdentifier()->name().string());
             }
         }
 
         this->consumeSemicolon();
-        if (label == nullptr && !this->context->inIteration && !this->context->inSwitch) {
+        if (!label && !this->context->inIteration && !this->context->inSwitch) {
             this->throwError(Messages::IllegalBreak);
         }
 
         if (label) {
-            auto string = label->name().string();
-            return this->finalize(node, new BreakLabelStatementNode(string));
+            auto string = label->asIdentifier()->name().string();
+            return this->finalize(node, builder.createBreakLabelStatementNode(string));
         } else {
-            return this->finalize(node, new BreakStatementNode());
+            return this->finalize(node, builder.createBreakStatementNode());
         }
     }
 
     // ECMA-262 13.10 The return statement
 
-    PassRefPtr<Node> parseReturnStatement()
+    template <class ASTBuilder>
+    ASTNode parseReturnStatement(ASTBuilder& builder)
     {
         if (!this->context->inFunctionBody) {
             this->tolerateError(Messages::IllegalReturn);
@@ -5783,18 +6543,19 @@ public:
         MetaNode node = this->createNode();
 
         bool hasArgument = !this->match(SemiColon) && !this->match(RightBrace) && !this->hasLineTerminator && this->lookahead->type != EOFToken;
-        RefPtr<Node> argument = nullptr;
+        ASTNode argument;
         if (hasArgument) {
-            argument = this->parseExpression();
+            argument = this->parseExpression(builder);
         }
         this->consumeSemicolon();
 
-        return this->finalize(node, new ReturnStatmentNode(argument.get()));
+        return this->finalize(node, builder.createReturnStatementNode(argument));
     }
 
     // ECMA-262 13.11 The with statement
 
-    PassRefPtr<Node> parseWithStatement()
+    template <class ASTBuilder>
+    ASTNode parseWithStatement(ASTBuilder& builder)
     {
         if (this->context->strict) {
             this->tolerateError(Messages::StrictModeWith);
@@ -5803,7 +6564,7 @@ public:
         this->expectKeyword(With);
         MetaNode node = this->createNode();
         this->expect(LeftParenthesis);
-        RefPtr<Node> object = this->parseExpression();
+        ASTNode object = this->parseExpression(builder);
         this->expect(RightParenthesis);
 
         bool prevInWith = this->context->inWith;
@@ -5813,67 +6574,72 @@ public:
             this->context->labelSet[i].second++;
         }
 
-        RefPtr<StatementNode> body = this->parseStatement(false);
+        ASTNode body = this->parseStatement(builder, false);
         this->context->inWith = prevInWith;
 
         for (size_t i = 0; i < this->context->labelSet.size(); i++) {
             this->context->labelSet[i].second--;
         }
 
-        return this->finalize(node, new WithStatementNode(object, body.get()));
+        this->scopeContexts.back()->m_hasWith = true;
+
+        return this->finalize(node, builder.createWithStatementNode(object, body));
     }
 
     // ECMA-262 13.12 The switch statement
 
-    PassRefPtr<SwitchCaseNode> parseSwitchCase()
+    template <class ASTBuilder>
+    ASTNode parseSwitchCase(ASTBuilder& builder)
     {
         MetaNode node = this->createNode();
 
-        RefPtr<Node> test;
+        ASTNode test;
         if (this->matchKeyword(Default)) {
             node = this->createNode();
             this->nextToken();
-            test = nullptr;
         } else {
             this->expectKeyword(Case);
             node = this->createNode();
-            test = this->parseExpression();
+            test = this->parseExpression(builder);
         }
         this->expect(Colon);
 
-        RefPtr<StatementContainer> consequent = StatementContainer::create();
+        ASTStatementContainer consequent = builder.createStatementContainer();
+        StatementNode* referNode = nullptr;
         while (true) {
             if (this->match(RightBrace) || this->matchKeyword(Default) || this->matchKeyword(Case)) {
                 break;
             }
-            consequent->appendChild(this->parseStatementListItem());
+            referNode = builder.appendChild(consequent, this->parseStatementListItem(builder), referNode);
         }
 
-        return this->finalize(node, new SwitchCaseNode(test.get(), consequent.get()));
+        return this->finalize(node, builder.createSwitchCaseNode(test, consequent));
     }
 
-    PassRefPtr<SwitchStatementNode> parseSwitchStatement()
+    template <class ASTBuilder>
+    ASTNode parseSwitchStatement(ASTBuilder& builder)
     {
         this->expectKeyword(Switch);
         MetaNode node = this->createNode();
 
         this->expect(LeftParenthesis);
-        RefPtr<Node> discriminant = this->parseExpression();
+        ASTNode discriminant = this->parseExpression(builder);
         this->expect(RightParenthesis);
 
         bool previousInSwitch = this->context->inSwitch;
         this->context->inSwitch = true;
 
-        RefPtr<StatementContainer> casesA = StatementContainer::create(), casesB = StatementContainer::create();
-        RefPtr<Node> deflt;
+        ASTStatementContainer casesA = builder.createStatementContainer(), casesB = builder.createStatementContainer();
+        ASTNode deflt;
         bool defaultFound = false;
         this->expect(LeftBrace);
         while (true) {
             if (this->match(RightBrace)) {
                 break;
             }
-            RefPtr<SwitchCaseNode> clause = this->parseSwitchCase();
-            if (clause->isDefaultNode()) {
+            bool isDefault = this->matchKeyword(Default);
+            ASTNode clause = this->parseSwitchCase(builder);
+            if (isDefault) {
                 if (defaultFound) {
                     this->throwError(Messages::MultipleDefaultsInSwitch);
                 }
@@ -5881,9 +6647,9 @@ public:
                 defaultFound = true;
             } else {
                 if (defaultFound) {
-                    casesA->appendChild(clause);
+                    builder.appendChild(casesA, clause);
                 } else {
-                    casesB->appendChild(clause);
+                    builder.appendChild(casesB, clause);
                 }
             }
         }
@@ -5891,40 +6657,39 @@ public:
 
         this->context->inSwitch = previousInSwitch;
 
-        return this->finalize(node, new SwitchStatementNode(discriminant.get(), casesA.get(), deflt.get(), casesB.get(), false));
+        return this->finalize(node, builder.createSwitchStatementNode(discriminant, casesA, deflt, casesB));
     }
 
     // ECMA-262 13.13 Labelled Statements
 
-    PassRefPtr<Node> parseLabelledStatement()
+    template <class ASTBuilder>
+    ASTNode parseLabelledStatement(ASTBuilder& builder)
     {
-        RefPtr<Node> expr = this->parseExpression();
+        ASTNode expr = this->parseExpression(builder);
         MetaNode node = this->createNode();
 
-        StatementNode* statement;
         if ((expr->type() == Identifier) && this->match(Colon)) {
             this->nextToken();
 
-            RefPtr<IdentifierNode> id = (IdentifierNode*)expr.get();
-            if (hasLabel(id->name())) {
-                this->throwError(Messages::Redeclaration, new ASCIIString("Label"), id->name().string());
+            AtomicString name = expr->asIdentifier()->name();
+            if (hasLabel(name)) {
+                this->throwError(Messages::Redeclaration, new ASCIIString("Label"), name.string());
             }
 
-            this->context->labelSet.push_back(std::make_pair(id->name(), 0));
-            RefPtr<StatementNode> labeledBody = this->parseStatement(this->context->strict ? false : true);
-            removeLabel(id->name());
+            this->context->labelSet.push_back(std::make_pair(name, 0));
+            ASTNode labeledBody = this->parseStatement(builder, this->context->strict ? false : true);
+            removeLabel(name);
 
-            statement = new LabeledStatementNode(labeledBody.get(), id->name().string());
-        } else {
-            this->consumeSemicolon();
-            statement = new ExpressionStatementNode(expr.get());
+            return this->finalize(node, builder.createLabeledStatementNode(labeledBody, name.string()));
         }
-        return this->finalize(node, statement);
+        this->consumeSemicolon();
+        return this->finalize(node, builder.createExpressionStatementNode(expr));
     }
 
     // ECMA-262 13.14 The throw statement
 
-    PassRefPtr<Node> parseThrowStatement()
+    template <class ASTBuilder>
+    ASTNode parseThrowStatement(ASTBuilder& builder)
     {
         this->expectKeyword(Throw);
 
@@ -5933,15 +6698,16 @@ public:
         }
 
         MetaNode node = this->createNode();
-        RefPtr<Node> argument = this->parseExpression();
+        ASTNode argument = this->parseExpression(builder);
         this->consumeSemicolon();
 
-        return this->finalize(node, new ThrowStatementNode(argument.get()));
+        return this->finalize(node, builder.createThrowStatementNode(argument));
     }
 
     // ECMA-262 13.15 The try statement
 
-    PassRefPtr<CatchClauseNode> parseCatchClause()
+    template <class ASTBuilder>
+    ASTNode parseCatchClause(ASTBuilder& builder)
     {
         this->expectKeyword(Catch);
 
@@ -5960,7 +6726,7 @@ public:
         this->context->inDirectCatchScope = true;
 
         std::vector<RefPtr<ScannerResult>, GCUtil::gc_malloc_ignore_off_page_allocator<RefPtr<ScannerResult>>> params;
-        RefPtr<Node> param = this->parsePattern(params);
+        ASTNode param = this->parsePattern(builder, params);
 
         std::vector<String*, GCUtil::gc_malloc_ignore_off_page_allocator<String*>> paramMap;
         for (size_t i = 0; i < params.size(); i++) {
@@ -5979,14 +6745,13 @@ public:
         }
 
         if (this->context->strict && param->type() == Identifier) {
-            IdentifierNode* id = (IdentifierNode*)param.get();
-            if (this->scanner->isRestrictedWord(id->name())) {
+            if (this->scanner->isRestrictedWord(param->asIdentifier()->name())) {
                 this->tolerateError(Messages::StrictCatchVariable);
             }
         }
 
         this->expect(RightParenthesis);
-        RefPtr<Node> body = this->parseBlock();
+        ASTNode body = this->parseBlock(builder);
 
         this->context->inCatch = prevInCatch;
 
@@ -5996,34 +6761,38 @@ public:
 
         this->context->functionDeclarationsInDirectCatchScope = std::move(vecBefore);
 
-        return this->finalize(node, new CatchClauseNode(param.get(), nullptr, body.get(), vec));
+        this->scopeContexts.back()->m_hasCatch = true;
+        return this->finalize(node, builder.createCatchClauseNode(param, body, vec));
     }
 
-    PassRefPtr<BlockStatementNode> parseFinallyClause()
+    template <class ASTBuilder>
+    ASTNode parseFinallyClause(ASTBuilder& builder)
     {
         this->expectKeyword(Finally);
-        return this->parseBlock();
+        return this->parseBlock(builder);
     }
 
-    PassRefPtr<TryStatementNode> parseTryStatement()
+    template <class ASTBuilder>
+    ASTNode parseTryStatement(ASTBuilder& builder)
     {
         this->expectKeyword(Try);
         MetaNode node = this->createNode();
 
-        RefPtr<BlockStatementNode> block = this->parseBlock();
-        RefPtr<CatchClauseNode> handler = this->matchKeyword(Catch) ? this->parseCatchClause() : nullptr;
-        RefPtr<BlockStatementNode> finalizer = this->matchKeyword(Finally) ? this->parseFinallyClause() : nullptr;
+        ASTNode block = this->parseBlock(builder);
+        ASTNode handler = this->matchKeyword(Catch) ? this->parseCatchClause(builder) : ASTNode();
+        ASTNode finalizer = this->matchKeyword(Finally) ? this->parseFinallyClause(builder) : ASTNode();
 
         if (!handler && !finalizer) {
             this->throwError(Messages::NoCatchOrFinally);
         }
 
-        return this->finalize(node, new TryStatementNode(block.get(), handler.get(), CatchClauseNodeVector(), finalizer.get()));
+        return this->finalize(node, builder.createTryStatementNode(block, handler, finalizer));
     }
 
     // ECMA-262 13.16 The debugger statement
 
-    PassRefPtr<StatementNode> parseDebuggerStatement()
+    template <class ASTBuilder>
+    ASTNode parseDebuggerStatement(ASTBuilder& builder)
     {
         this->throwError("debugger keyword is not supported yet");
         RELEASE_ASSERT_NOT_REACHED();
@@ -6036,10 +6805,11 @@ public:
     }
 
     // ECMA-262 13 Statements
-    PassRefPtr<StatementNode> parseStatement(bool allowFunctionDeclaration = true)
+    template <class ASTBuilder>
+    ASTNode parseStatement(ASTBuilder& builder, bool allowFunctionDeclaration = true)
     {
         checkRecursiveLimit();
-        RefPtr<StatementNode> statement;
+        ASTNode statement;
         switch (this->lookahead->type) {
         case Token::BooleanLiteralToken:
         case Token::NullLiteralToken:
@@ -6047,76 +6817,76 @@ public:
         case Token::StringLiteralToken:
         case Token::TemplateToken:
         case Token::RegularExpressionToken:
-            statement = this->parseExpressionStatement();
+            statement = this->parseExpressionStatement(builder);
             break;
 
         case Token::PunctuatorToken: {
             PunctuatorsKind value = this->lookahead->valuePunctuatorsKind;
             if (value == LeftBrace) {
-                statement = this->parseBlock();
+                statement = this->parseBlock(builder);
             } else if (value == LeftParenthesis) {
-                statement = this->parseExpressionStatement();
+                statement = this->parseExpressionStatement(builder);
             } else if (value == SemiColon) {
-                statement = this->parseEmptyStatement();
+                statement = this->parseEmptyStatement(builder);
             } else {
-                statement = this->parseExpressionStatement();
+                statement = this->parseExpressionStatement(builder);
             }
             break;
         }
         case Token::IdentifierToken:
-            statement = asStatementNode(this->parseLabelledStatement());
+            statement = this->parseLabelledStatement(builder);
             break;
 
         case Token::KeywordToken:
             switch (this->lookahead->valueKeywordKind) {
             case Break:
-                statement = asStatementNode(this->parseBreakStatement());
+                statement = this->parseBreakStatement(builder);
                 break;
             case Continue:
-                statement = asStatementNode(this->parseContinueStatement());
+                statement = this->parseContinueStatement(builder);
                 break;
             case Debugger:
-                statement = asStatementNode(this->parseDebuggerStatement());
+                statement = this->parseDebuggerStatement(builder);
                 break;
             case Do:
-                statement = asStatementNode(this->parseDoWhileStatement());
+                statement = this->parseDoWhileStatement(builder);
                 break;
             case For:
-                statement = asStatementNode(this->parseForStatement());
+                statement = this->parseForStatement(builder);
                 break;
             case Function: {
                 if (!allowFunctionDeclaration) {
                     this->throwUnexpectedToken(this->lookahead);
                 }
-                statement = asStatementNode(this->parseFunctionDeclaration());
+                statement = this->parseFunctionDeclaration(builder);
                 break;
             }
             case If:
-                statement = asStatementNode(this->parseIfStatement());
+                statement = this->parseIfStatement(builder);
                 break;
             case Return:
-                statement = asStatementNode(this->parseReturnStatement());
+                statement = this->parseReturnStatement(builder);
                 break;
             case Switch:
-                statement = asStatementNode(this->parseSwitchStatement());
+                statement = this->parseSwitchStatement(builder);
                 break;
             case Throw:
-                statement = asStatementNode(this->parseThrowStatement());
+                statement = this->parseThrowStatement(builder);
                 break;
             case Try:
-                statement = asStatementNode(this->parseTryStatement());
+                statement = this->parseTryStatement(builder);
                 break;
             case Var:
-                statement = asStatementNode(this->parseVariableStatement());
+                statement = this->parseVariableStatement(builder);
                 break;
             case While:
-                statement = asStatementNode(this->parseWhileStatement());
+                statement = this->parseWhileStatement(builder);
                 break;
             case With:
-                statement = asStatementNode(this->parseWithStatement());
+                statement = this->parseWithStatement(builder);
                 break;
             default:
-                statement = asStatementNode(this->parseExpressionStatement());
+                statement = this->parseExpressionStatement(builder);
                 break;
             }
             break;
@@ -6128,13 +6898,14 @@ public:
         return statement;
     }
 
-    PassRefPtr<Node> parseArrowFunctionSourceElements()
+    template <class ASTBuilder>
+    ASTNode parseArrowFunctionSourceElements(ASTBuilder& builder)
     {
         ASSERT(this->config.parseSingleFunction);
 
         this->context->inArrowFunction = true;
         if (this->match(LeftBrace)) {
-            return parseFunctionSourceElements();
+            return parseFunctionSourceElements(builder);
         }
 
         bool prevInDirectCatchScope = this->context->inDirectCatchScope;
@@ -6157,10 +6928,13 @@ public:
         this->expect(Arrow);
         MetaNode nodeStart = this->createNode();
 
-        RefPtr<Node> expr = this->isolateCoverGrammar(&Parser::parseAssignmentExpression);
+        // child functions are counted from 1 like in parseFunctionSourceElements
+        this->config.parseSingleFunctionChildIndex = SmallValue((uint32_t)1);
+
+        ASTNode expr = this->isolateCoverGrammar(builder, &Parser::parseAssignmentExpression<ASTBuilder>);
 
-        RefPtr<StatementContainer> body = StatementContainer::create();
-        body->appendChild(this->finalize(nodeStart, new ReturnStatmentNode(expr.get())), nullptr);
+        ASTStatementContainer body = builder.createStatementContainer();
+        builder.appendChild(body, this->finalize(nodeStart, builder.createReturnStatementNode(expr)));
 
         /*
         if (this->context->strict && list.firstRestricted) {
@@ -6181,14 +6955,16 @@ public:
 
         this->context->inDirectCatchScope = prevInDirectCatchScope;
 
-        return this->finalize(nodeStart, new BlockStatementNode(body.get()));
+        return this->finalize(nodeStart, builder.createBlockStatementNode(body));
     }
 
     // ECMA-262 14.1 Function Definition
 
-    PassRefPtr<Node> parseFunctionSourceElements()
+    template <class ASTBuilder>
+    ASTNode parseFunctionSourceElements(ASTBuilder& builder)
     {
-        if (this->config.parseSingleFunction) {
+        // children of the target function are skipped. SyntaxChecker is only used for grandchildren
+        if (this->config.parseSingleFunction && builder.isNodeGenerator()) {
             if (this->config.parseSingleFunctionChildIndex.asUint32()) {
                 size_t realIndex = this->config.parseSingleFunctionChildIndex.asUint32() - 1;
                 this->config.parseSingleFunctionChildIndex = SmallValue(this->config.parseSingleFunctionChildIndex.asUint32() + 1);
@@ -6202,21 +6978,37 @@ public:
                 this->scanner->lineNumber = currentTarget->childBlocks()[realIndex]->sourceElementStart().line;
                 this->scanner->lineStart = currentTarget->childBlocks()[realIndex]->sourceElementStart().index - currentTarget->childBlocks()[realIndex]->sourceElementStart().column;
                 this->lookahead->lineNumber = this->scanner->lineNumber;
-                this->lookahead->lineNumber = this->scanner->lineStart;
+                this->lookahead->lineStart = this->scanner->lineStart;
                 this->lookahead->type = Token::PunctuatorToken;
                 this->lookahead->valuePunctuatorsKind = PunctuatorsKind::RightBrace;
                 this->expect(RightBrace);
-                return this->finalize(this->createNode(), new BlockStatementNode(StatementContainer::create().get()));
+                return this->finalize(this->createNode(), builder.createBlockStatementNode(builder.createStatementContainer()));
             }
             this->config.parseSingleFunctionChildIndex = SmallValue(this->config.parseSingleFunctionChildIndex.asUint32() + 1);
         }
-        bool prevInDirectCatchScope = this->context->inDirectCatchScope;
-        this->context->inDirectCatchScope = false;
 
         MetaNode nodeStart = this->createNode();
 
+        if (builder.isNodeGenerator() && (this->config.parseSingleFunction || this->config.eagerlyParseFunctionBodies)) {
+            ASTStatementContainer body = this->parseFunctionBody(builder, nodeStart);
+            return this->finalize(nodeStart, builder.createBlockStatementNode(body));
+        }
+
+        // while parsing program, body of function is only checked for validating syntax and collecting scope information.
+        // parseSingleFunction builds real AST of the function when it is called first time
+        SyntaxChecker checker;
+        this->parseFunctionBody(checker, nodeStart);
+        return this->finalize(nodeStart, builder.createBlockStatementNode(builder.createStatementContainer()));
+    }
+
+    template <class ASTBuilder>
+    ASTStatementContainer parseFunctionBody(ASTBuilder& builder, const MetaNode& nodeStart)
+    {
+        bool prevInDirectCatchScope = this->context->inDirectCatchScope;
+        this->context->inDirectCatchScope = false;
+
         this->expect(LeftBrace);
-        RefPtr<StatementContainer> body = this->parseDirectivePrologues();
+        ASTStatementContainer body = this->parseDirectivePrologues(builder);
 
         auto previousLabelSet = this->context->labelSet;
         bool previousInIteration = this->context->inIteration;
@@ -6228,22 +7020,12 @@ public:
         this->context->inSwitch = false;
         this->context->inFunctionBody = true;
 
-        if (shouldCreateAST()) {
-            StatementNode* referNode = nullptr;
-            while (this->startMarker.index < this->scanner->length) {
-                if (this->match(RightBrace)) {
-                    break;
-                }
-                referNode = body->appendChild(this->parseStatementListItem().get(), referNode);
-            }
-        } else {
-            StatementNode* referNode = nullptr;
-            while (this->startMarker.index < this->scanner->length) {
-                if (this->match(RightBrace)) {
-                    break;
-                }
-                this->parseStatementListItem();
+        StatementNode* referNode = nullptr;
+        while (this->startMarker.index < this->scanner->length) {
+            if (this->match(RightBrace)) {
+                break;
             }
+            referNode = builder.appendChild(body, this->parseStatementListItem(builder), referNode);
         }
 
         this->expect(RightBrace);
@@ -6253,6 +7035,15 @@ public:
         this->context->inSwitch = previousInSwitch;
         this->context->inFunctionBody = previousInFunctionBody;
 
+        recordFunctionBodyLocation(nodeStart);
+
+        this->context->inDirectCatchScope = prevInDirectCatchScope;
+
+        return body;
+    }
+
+    void recordFunctionBodyLocation(const MetaNode& nodeStart)
+    {
         scopeContexts.back()->m_locStart.line = nodeStart.line;
         scopeContexts.back()->m_locStart.column = nodeStart.column;
         scopeContexts.back()->m_locStart.index = nodeStart.index;
@@ -6262,17 +7053,10 @@ public:
         scopeContexts.back()->m_locEnd.line = this->lastMarker.lineNumber;
         scopeContexts.back()->m_locEnd.column = this->lastMarker.index - this->lastMarker.lineStart;
 #endif
-
-        this->context->inDirectCatchScope = prevInDirectCatchScope;
-
-        if (this->config.parseSingleFunction) {
-            return this->finalize(nodeStart, new BlockStatementNode(body.get()));
-        } else {
-            return this->finalize(nodeStart, new BlockStatementNode(StatementContainer::create().get()));
-        }
     }
 
-    PassRefPtr<FunctionDeclarationNode> parseFunctionDeclaration(bool identifierIsOptional = false)
+    template <class ASTBuilder>
+    ASTNode parseFunctionDeclaration(ASTBuilder& builder, bool identifierIsOptional = false)
     {
         this->expectKeyword(Function);
         MetaNode node = this->createNode();
@@ -6283,12 +7067,12 @@ public:
         }
 
         const char* message = nullptr;
-        RefPtr<IdentifierNode> id;
+        ASTNode id;
         RefPtr<ScannerResult> firstRestricted = nullptr;
 
         if (!identifierIsOptional || !this->match(LeftParenthesis)) {
             RefPtr<ScannerResult> token = this->lookahead;
-            id = this->parseVariableIdentifier();
+            id = this->parseVariableIdentifier(builder);
             if (this->context->strict) {
                 if (this->scanner->isRestrictedWord(token->relatedSource())) {
                     this->tolerateUnexpectedToken(token, Messages::StrictFunctionName);
@@ -6310,21 +7094,22 @@ public:
         this->context->inArrowFunction = false;
 
         this->expect(LeftParenthesis);
-        ParseFormalParametersResult formalParameters = this->parseFormalParameters(firstRestricted);
-        PatternNodeVector params = std::move(formalParameters.params);
+        ParseFormalParametersResult<ASTBuilder> formalParameters = this->parseFormalParameters(builder, firstRestricted);
+        ASTNodeVector params = std::move(formalParameters.params);
         RefPtr<ScannerResult> stricted = formalParameters.stricted;
         firstRestricted = formalParameters.firstRestricted;
         if (formalParameters.message) {
             message = formalParameters.message;
         }
 
-        scopeContexts.back()->insertName(id->name(), true);
-        scopeContexts.back()->insertUsingName(id->name());
-        pushScopeContext(params, id->name());
+        AtomicString fnName = id->asIdentifier()->name();
+        scopeContexts.back()->insertName(fnName, true);
+        scopeContexts.back()->insertUsingName(fnName);
+        pushScopeContext(params, fnName);
         extractNamesFromFunctionParams(params);
 
         bool previousStrict = this->context->strict;
-        RefPtr<Node> body = this->parseFunctionSourceElements();
+        ASTNode body = this->parseFunctionSourceElements(builder);
         if (this->context->strict && firstRestricted) {
             this->throwUnexpectedToken(firstRestricted, message);
         }
@@ -6340,16 +7125,17 @@ public:
             scopeContexts.back()->m_needsSpecialInitialize = true;
         }
 
-        RefPtr<FunctionDeclarationNode> fd = this->finalize(node, new FunctionDeclarationNode(id->name(), std::move(params), body.get(), popScopeContext(node), isGenerator));
+        ASTNode fd = this->finalize(node, builder.createFunctionDeclarationNode(fnName, std::move(params), body, popScopeContext(node), isGenerator));
 
         if (this->context->inDirectCatchScope) {
-            this->context->functionDeclarationsInDirectCatchScope.push_back(fd.get());
+            builder.addFunctionDeclarationInDirectCatchScope(this->context->functionDeclarationsInDirectCatchScope, fd);
         }
 
         return fd;
     }
 
-    PassRefPtr<FunctionExpressionNode> parseFunctionExpression()
+    template <class ASTBuilder>
+    ASTNode parseFunctionExpression(ASTBuilder& builder)
     {
         this->expectKeyword(Function);
         MetaNode node = this->createNode();
@@ -6360,7 +7146,7 @@ public:
         }
 
         const char* message = nullptr;
-        RefPtr<IdentifierNode> id;
+        ASTNode id;
         RefPtr<ScannerResult> firstRestricted = nullptr;
 
         bool previousAllowYield = this->context->allowYield;
@@ -6370,7 +7156,7 @@ public:
 
         if (!this->match(LeftParenthesis)) {
             RefPtr<ScannerResult> token = this->lookahead;
-            id = (!this->context->strict && !isGenerator && this->matchKeyword(Yield)) ? this->parseIdentifierName() : this->parseVariableIdentifier();
+            id = (!this->context->strict && !isGenerator && this->matchKeyword(Yield)) ? this->parseIdentifierName(builder) : this->parseVariableIdentifier(builder);
             if (this->context->strict) {
                 if (this->scanner->isRestrictedWord(token->relatedSource())) {
                     this->tolerateUnexpectedToken(token, Messages::StrictFunctionName);
@@ -6387,8 +7173,8 @@ public:
         }
 
         this->expect(LeftParenthesis);
-        ParseFormalParametersResult formalParameters = this->parseFormalParameters(firstRestricted);
-        PatternNodeVector params = std::move(formalParameters.params);
+        ParseFormalParametersResult<ASTBuilder> formalParameters = this->parseFormalParameters(builder, firstRestricted);
+        ASTNodeVector params = std::move(formalParameters.params);
         RefPtr<ScannerResult> stricted = formalParameters.stricted;
         firstRestricted = formalParameters.firstRestricted;
         if (formalParameters.message) {
@@ -6397,7 +7183,7 @@ public:
 
         AtomicString fnName;
         if (id) {
-            fnName = id->name();
+            fnName = id->asIdentifier()->name();
         }
 
         pushScopeContext(params, fnName);
@@ -6409,7 +7195,7 @@ public:
 
         extractNamesFromFunctionParams(params);
         bool previousStrict = this->context->strict;
-        RefPtr<Node> body = this->parseFunctionSourceElements();
+        ASTNode body = this->parseFunctionSourceElements(builder);
         if (this->context->strict && firstRestricted) {
             this->throwUnexpectedToken(firstRestricted, message);
         }
@@ -6420,19 +7206,20 @@ public:
         this->context->allowYield = previousAllowYield;
         this->context->inArrowFunction = previousInArrowFunction;
 
-        return this->finalize(node, new FunctionExpressionNode(fnName, std::move(params), body.get(), popScopeContext(node), isGenerator));
+        return this->finalize(node, builder.createFunctionExpressionNode(fnName, std::move(params), body, popScopeContext(node), isGenerator));
     }
 
     // ECMA-262 14.1.1 Directive Prologues
 
-    PassRefPtr<Node> parseDirective()
+    template <class ASTBuilder>
+    ASTNode parseDirective(ASTBuilder& builder)
     {
         RefPtr<ScannerResult> token = this->lookahead;
         StringView directiveValue;
         bool isLiteral = false;
 
         MetaNode node = this->createNode();
-        RefPtr<Node> expr = this->parseExpression();
+        ASTNode expr = this->parseExpression(builder);
         if (expr->type() == Literal) {
             isLiteral = true;
             directiveValue = token->valueStringLiteral();
@@ -6440,33 +7227,32 @@ public:
         this->consumeSemicolon();
 
         if (isLiteral) {
-            return this->finalize(node, new DirectiveNode(asExpressionNode(expr).get(), directiveValue));
+            return this->finalize(node, builder.createDirectiveNode(expr, directiveValue));
         } else {
-            return this->finalize(node, new ExpressionStatementNode(expr.get()));
+            return this->finalize(node, builder.createExpressionStatementNode(expr));
         }
     }
 
-    PassRefPtr<StatementContainer> parseDirectivePrologues()
+    template <class ASTBuilder>
+    ASTStatementContainer parseDirectivePrologues(ASTBuilder& builder)
     {
         RefPtr<ScannerResult> firstRestricted = nullptr;
 
-        this->context->inParsingDirective = true;
-        RefPtr<StatementContainer> body = StatementContainer::create();
+        ASTStatementContainer body = builder.createStatementContainer();
         while (true) {
             RefPtr<ScannerResult> token = this->lookahead;
             if (token->type != StringLiteralToken) {
                 break;
             }
 
-            RefPtr<Node> statement = this->parseDirective();
-            body->appendChild(statement->asStatementNode());
+            ASTNode statement = this->parseDirective(builder);
+            builder.appendChild(body, statement);
 
             if (statement->type() != Directive) {
                 break;
             }
 
-            DirectiveNode* directive = (DirectiveNode*)statement.get();
-            if (token->plain && directive->value().equals("use strict")) {
+            if (token->plain && token->valueStringLiteral().equals("use strict")) {
                 this->scopeContexts.back()->m_isStrict = this->context->strict = true;
                 if (firstRestricted) {
                     this->tolerateUnexpectedToken(firstRestricted, Messages::StrictOctalLiteral);
@@ -6478,35 +7264,35 @@ public:
             }
         }
 
-        this->context->inParsingDirective = false;
-
         return body;
     }
 
     // ECMA-262 14.3 Method Definitions
 
-    PassRefPtr<FunctionExpressionNode> parseGetterMethod()
+    template <class ASTBuilder>
+    ASTNode parseGetterMethod(ASTBuilder& builder)
     {
         MetaNode node = this->createNode();
         this->expect(LeftParenthesis);
         this->expect(RightParenthesis);
 
         bool isGenerator = false;
-        ParseFormalParametersResult params(PatternNodeVector(), nullptr, nullptr, nullptr);
+        ParseFormalParametersResult<ASTBuilder> params(ASTNodeVector(), nullptr, nullptr, nullptr);
         bool previousAllowYield = this->context->allowYield;
         this->context->allowYield = false;
-        RefPtr<Node> method = this->parsePropertyMethod(params);
+        ASTNode method = this->parsePropertyMethod(builder, params);
         this->context->allowYield = previousAllowYield;
 
         extractNamesFromFunctionParams(params.params);
-        return this->finalize(node, new FunctionExpressionNode(AtomicString(), std::move(params.params), method.get(), popScopeContext(node), isGenerator));
+        return this->finalize(node, builder.createFunctionExpressionNode(AtomicString(), std::move(params.params), method, popScopeContext(node), isGenerator));
     }
 
-    PassRefPtr<FunctionExpressionNode> parseSetterMethod()
+    template <class ASTBuilder>
+    ASTNode parseSetterMethod(ASTBuilder& builder)
     {
         MetaNode node = this->createNode();
 
-        ParseParameterOptions options;
+        ParseParameterOptions<ASTBuilder> options;
 
         bool isGenerator = false;
         bool previousAllowYield = this->context->allowYield;
@@ -6516,19 +7302,20 @@ public:
         if (this->match(RightParenthesis)) {
             this->tolerateUnexpectedToken(this->lookahead);
         } else {
-            this->parseFormalParameter(options);
+            this->parseFormalParameter(builder, options);
         }
         this->expect(RightParenthesis);
 
-        ParseFormalParametersResult options2(std::move(options.params), options.stricted, options.firstRestricted, options.message);
-        RefPtr<Node> method = this->parsePropertyMethod(options2);
+        ParseFormalParametersResult<ASTBuilder> options2(std::move(options.params), options.stricted, options.firstRestricted, options.message);
+        ASTNode method = this->parsePropertyMethod(builder, options2);
         this->context->allowYield = previousAllowYield;
 
         extractNamesFromFunctionParams(options.params);
-        return this->finalize(node, new FunctionExpressionNode(AtomicString(), std::move(options.params), method.get(), popScopeContext(node), isGenerator));
+        return this->finalize(node, builder.createFunctionExpressionNode(AtomicString(), std::move(options.params), method, popScopeContext(node), isGenerator));
     }
 
-    FunctionExpressionNode* parseGeneratorMethod()
+    template <class ASTBuilder>
+    ASTNode parseGeneratorMethod(ASTBuilder& builder)
     {
         // TODO
         this->throwUnexpectedToken(this->nextToken());
@@ -6550,7 +7337,8 @@ public:
 
     // ECMA-262 14.4 Generator Function Definitions
 
-    Node* parseYieldExpression()
+    template <class ASTBuilder>
+    ASTNode parseYieldExpression(ASTBuilder& builder)
     {
         this->throwError("yield keyword is not supported yet");
         RELEASE_ASSERT_NOT_REACHED();
@@ -6728,7 +7516,8 @@ public:
         return this.finalize(node, new Node.ClassExpression(id, superClass, classBody));
     }
     */
-    Node* parseClassExpression()
+    template <class ASTBuilder>
+    ASTNode parseClassExpression(ASTBuilder& builder)
     {
         this->throwError("class keyword is not supported yet");
         RELEASE_ASSERT_NOT_REACHED();
@@ -6737,14 +7526,14 @@ public:
     // ECMA-262 15.1 Scripts
     // ECMA-262 15.2 Modules
 
-    PassRefPtr<ProgramNode> parseProgram()
+    PassRefPtr<ProgramNode> parseProgram(NodeGenerator& builder)
     {
         MetaNode node = this->createNode();
         scopeContexts.push_back(new ASTScopeContext(this->context->strict));
-        RefPtr<StatementContainer> body = this->parseDirectivePrologues();
+        RefPtr<StatementContainer> body = this->parseDirectivePrologues(builder);
         StatementNode* referNode = nullptr;
         while (this->startMarker.index < this->scanner->length) {
-            referNode = body->appendChild(this->parseStatementListItem().get(), referNode);
+            referNode = builder.appendChild(body, this->parseStatementListItem(builder), referNode);
         }
         scopeContexts.back()->m_locStart.line = node.line;
         scopeContexts.back()->m_locStart.column = node.column;
@@ -6992,11 +7781,19 @@ public:
     */
 };
 
-RefPtr<ProgramNode> parseProgram(::Escargot::Context* ctx, StringView source, ParserASTNodeHandler handler, bool strictFromOutside, size_t stackRemain)
+#undef ASTNode
+#undef ASTNodeVector
+#undef ASTPropertyNodeVector
+#undef ASTVariableDeclaratorVector
+#undef ASTStatementContainer
+
+RefPtr<ProgramNode> parseProgram(::Escargot::Context* ctx, StringView source, ParserASTNodeHandler handler, bool strictFromOutside, size_t stackRemain, bool eagerlyParseFunctionBodies)
 {
     Parser parser(ctx, source, handler, stackRemain);
     parser.context->strict = strictFromOutside;
-    RefPtr<ProgramNode> nd = parser.parseProgram();
+    parser.config.eagerlyParseFunctionBodies = eagerlyParseFunctionBodies;
+    NodeGenerator builder;
+    RefPtr<ProgramNode> nd = parser.parseProgram(builder);
     return nd;
 }
 
@@ -7008,11 +7805,12 @@ std::tuple<RefPtr<Node>, ASTScopeContext*> parseSingleFunction(::Escargot::Conte
     parser.config.parseSingleFunctionTarget = codeBlock;
     auto scopeCtx = new ASTScopeContext(codeBlock->isStrict());
     parser.scopeContexts.pushBack(scopeCtx);
+    NodeGenerator builder;
     RefPtr<Node> nd;
     if (codeBlock->isArrowFunctionExpression()) {
-        nd = parser.parseArrowFunctionSourceElements();
+        nd = parser.parseArrowFunctionSourceElements(builder);
     } else {
-        nd = parser.parseFunctionSourceElements();
+        nd = parser.parseFunctionSourceElements(builder);
     }
     return std::make_tuple(nd, scopeCtx);
 }
@@ -50,6 +50,7 @@ static void ArgumentsObjectNativeSetter(ExecutionState& state, Object* self, con
 
 void* ArgumentsObject::operator new(size_t size)
 {
+    ESCARGOT_PROFILE_ALLOCATION(ArgumentsObject, size);
     static bool typeInited = false;
     static GC_descr descr;
     if (!typeInited) {
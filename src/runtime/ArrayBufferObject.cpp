@@ -92,6 +92,7 @@ bool ArrayBufferObject::cloneBuffer(ArrayBufferObject* srcBuffer, size_t srcByte
 
 void* ArrayBufferObject::operator new(size_t size)
 {
+    ESCARGOT_PROFILE_ALLOCATION(ArrayBufferObject, size);
     static bool typeInited = false;
     static GC_descr descr;
     if (!typeInited) {
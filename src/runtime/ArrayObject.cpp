@@ -235,6 +235,7 @@ void ArrayObject::sort(ExecutionState& state, const std::function<bool(const Val
 
 void* ArrayObject::operator new(size_t size)
 {
+    ESCARGOT_PROFILE_ALLOCATION(ArrayObject, size);
     return CustomAllocator<ArrayObject>().allocate(1);
 }
 
@@ -428,6 +429,7 @@ ArrayIteratorObject::ArrayIteratorObject(ExecutionState& state, Object* a, Type
 
 void* ArrayIteratorObject::operator new(size_t size)
 {
+    ESCARGOT_PROFILE_ALLOCATION(IteratorObject, size);
     static bool typeInited = false;
     static GC_descr descr;
     if (!typeInited) {
@@ -20,9 +20,20 @@
 #include "Escargot.h"
 #include "AtomicString.h"
 #include "Context.h"
+#if defined(ESCARGOT_ENABLE_THREADING)
+#include <mutex>
+#endif
 
 namespace Escargot {
 
+#if defined(ESCARGOT_ENABLE_THREADING)
+// AtomicStringMap is shared with background parsing threads
+static std::mutex g_atomicStringMapMutex;
+#define LOCK_ATOMIC_STRING_MAP() std::lock_guard<std::mutex> atomicStringMapLock(g_atomicStringMapMutex)
+#else
+#define LOCK_ATOMIC_STRING_MAP()
+#endif
+
 AtomicString::AtomicString(ExecutionState& ec, const char16_t* src, size_t len)
 {
     if (isAllASCII(src, len)) {
@@ -69,6 +80,7 @@ AtomicString::AtomicString(Context* c, const SourceStringView& sv)
         return;
     }
 
+    LOCK_ATOMIC_STRING_MAP();
     AtomicStringMap* ec = c->atomicStringMap();
     SourceStringView& str = const_cast<SourceStringView&>(sv);
     String* name = &str;
@@ -93,6 +105,7 @@ AtomicString::AtomicString(Context* c, const StringView& sv)
         return;
     }
 
+    LOCK_ATOMIC_STRING_MAP();
     AtomicStringMap* ec = c->atomicStringMap();
     StringView& str = const_cast<StringView&>(sv);
     String* name = &str;
@@ -121,6 +134,8 @@ void AtomicString::init(AtomicStringMap* ec, String* name)
         m_string = (String*)(v & ~POINTER_VALUE_STRING_SYMBOL_TAG_IN_DATA);
         return;
     }
+
+    LOCK_ATOMIC_STRING_MAP();
     auto iter = ec->find(name);
     if (ec->end() == iter) {
         ec->insert(name);
@@ -32,6 +32,7 @@ BooleanObject::BooleanObject(ExecutionState& state, bool value)
 
 void* BooleanObject::operator new(size_t size)
 {
+    ESCARGOT_PROFILE_ALLOCATION(BooleanObject, size);
     static bool typeInited = false;
     static GC_descr descr;
     if (!typeInited) {
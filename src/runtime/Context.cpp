@@ -83,4 +83,10 @@ void Context::throwException(ExecutionState& state, const Value& exception)
         RELEASE_ASSERT_NOT_REACHED();
     }
 }
+
+void Context::exceptionCaught(const Value& exception)
+{
+    ASSERT(m_sandBoxStack.size());
+    m_sandBoxStack.back()->exceptionCaught(exception);
+}
 }
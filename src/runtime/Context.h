@@ -171,6 +171,8 @@ public:
     }
 
     void throwException(ExecutionState& state, const Value& exception);
+    // native code caught exception thrown by throwException instead of sandbox
+    void exceptionCaught(const Value& exception);
 
 #if ESCARGOT_ENABLE_PROMISE
     JobQueue* jobQueue()
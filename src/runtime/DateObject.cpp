@@ -306,7 +306,7 @@ time64_t DateObject::applyLocalTimezoneOffset(ExecutionState& state, time64_t t)
 
     t += msBetweenYears;
 #ifdef ENABLE_ICU
-    state.context()->vmInstance()->timezone()->getOffset(t, true, stdOffset, dstOffset, succ);
+    state.context()->vmInstance()->timezoneOffsetCache().getOffset(state.context()->vmInstance()->timezone(), t, true, stdOffset, dstOffset, succ);
 #else
     dstOffset = 0;
 #endif
@@ -991,11 +991,116 @@ time64_t DateObject::parseStringToDate_2(ExecutionState& state, String* istr, bo
     return date;
 }
 
+static inline bool parseFixedDigits(const LChar* s, size_t digits, int& result)
+{
+    int value = 0;
+    for (size_t i = 0; i < digits; i++) {
+        if (!isASCIIDigit(s[i])) {
+            return false;
+        }
+        value = value * 10 + (s[i] - '0');
+    }
+    result = value;
+    return true;
+}
+
+// Parses only well-formed ECMAScript date time string format (ES5.1 15.9.1.15) in 8-bit string:
+// YYYY-MM-DD or ±YYYYYY-MM-DD, optionally followed by THH:mm[:ss[.s{1,3}]][Z|±HH:mm].
+// Returns TIME64NAN for anything else (ex. omitted month, trailing spaces, 24:00, leap second),
+// and parseStringToDate_2 or parseStringToDate_1 handles such strings as before.
+time64_t DateObject::parseStringToDate_ISO(ExecutionState& state, String* istr, bool& haveTZ)
+{
+    const auto& data = istr->bufferAccessData();
+    if (!data.has8BitContent) {
+        return TIME64NAN;
+    }
+    const LChar* s = (const LChar*)data.buffer;
+    const LChar* end = s + data.length;
+
+    int year, month, day;
+    if (end - s >= 10 && isASCIIDigit(s[0])) {
+        if (!parseFixedDigits(s, 4, year)) {
+            return TIME64NAN;
+        }
+        s += 4;
+    } else if (end - s >= 13 && (s[0] == '+' || s[0] == '-')) {
+        if (!parseFixedDigits(s + 1, 6, year) || (s[0] == '-' && year == 0)) {
+            return TIME64NAN;
+        }
+        year = s[0] == '-' ? -year : year;
+        s += 7;
+    } else {
+        return TIME64NAN;
+    }
+
+    if (s[0] != '-' || !parseFixedDigits(s + 1, 2, month) || s[3] != '-' || !parseFixedDigits(s + 4, 2, day)) {
+        return TIME64NAN;
+    }
+    s += 6;
+    if (month < 1 || month > 12 || day < 1 || day > daysInMonth[month - 1] + (month == 2 && inLeapYear(year))) {
+        return TIME64NAN;
+    }
+
+    // date-only forms are UTC, date-time forms without offset are local time
+    int hours = 0, minutes = 0, seconds = 0, milliSeconds = 0, timeZoneMinutes = 0;
+    haveTZ = true;
+    if (s != end) {
+        if (end - s < 6 || s[0] != 'T' || !parseFixedDigits(s + 1, 2, hours) || s[3] != ':' || !parseFixedDigits(s + 4, 2, minutes)) {
+            return TIME64NAN;
+        }
+        s += 6;
+        if (end - s >= 3 && s[0] == ':') {
+            if (!parseFixedDigits(s + 1, 2, seconds)) {
+                return TIME64NAN;
+            }
+            s += 3;
+            if (end - s >= 2 && s[0] == '.') {
+                s++;
+                int digits = 0;
+                while (s != end && digits < 3 && isASCIIDigit(*s)) {
+                    milliSeconds = milliSeconds * 10 + (*s++ - '0');
+                    digits++;
+                }
+                if (digits == 0 || (s != end && isASCIIDigit(*s))) {
+                    return TIME64NAN;
+                }
+                for (; digits < 3; digits++) {
+                    milliSeconds *= 10;
+                }
+            }
+        }
+        if (hours > 23 || minutes > 59 || seconds > 59) {
+            return TIME64NAN;
+        }
+
+        if (s == end) {
+            haveTZ = false;
+        } else if (s[0] == 'Z' && end - s == 1) {
+            s++;
+        } else if ((s[0] == '+' || s[0] == '-') && end - s == 6) {
+            int tzHours, tzMinutes;
+            if (!parseFixedDigits(s + 1, 2, tzHours) || s[3] != ':' || !parseFixedDigits(s + 4, 2, tzMinutes) || tzHours > 23 || tzMinutes > 59) {
+                return TIME64NAN;
+            }
+            timeZoneMinutes = (s[0] == '-' ? -1 : 1) * (tzHours * const_Date_minutesPerHour + tzMinutes);
+            s += 6;
+        } else {
+            return TIME64NAN;
+        }
+    }
+
+    ASSERT(s == end);
+    return timeinfoToMs(state, year, month - 1, day, hours, minutes, seconds, milliSeconds) - timeZoneMinutes * const_Date_msPerMinute;
+}
+
 time64_t DateObject::parseStringToDate(ExecutionState& state, String* istr)
 {
     bool haveTZ;
     int offset;
-    time64_t primitiveValue = parseStringToDate_2(state, istr, haveTZ);
+    time64_t primitiveValue = parseStringToDate_ISO(state, istr, haveTZ);
+    if (!IS_VALID_TIME(primitiveValue)) {
+        primitiveValue = parseStringToDate_2(state, istr, haveTZ);
+    }
     if (IS_VALID_TIME(primitiveValue)) {
         if (!haveTZ) { // add local timezone offset
             primitiveValue = applyLocalTimezoneOffset(state, primitiveValue);
@@ -1139,7 +1244,7 @@ void DateObject::resolveCache(ExecutionState& state)
 #endif
     int32_t stdOffset = 0, dstOffset = 0;
 #ifdef ENABLE_ICU
-    state.context()->vmInstance()->timezone()->getOffset(t, false, stdOffset, dstOffset, succ);
+    state.context()->vmInstance()->timezoneOffsetCache().getOffset(state.context()->vmInstance()->timezone(), t, false, stdOffset, dstOffset, succ);
 #endif
 
     m_cachedLocal.isdst = dstOffset == 0 ? 0 : 1;
@@ -1148,7 +1253,14 @@ void DateObject::resolveCache(ExecutionState& state)
     t += (stdOffset + dstOffset);
     t -= msBetweenYears;
 
-    getYMDFromTime(t, m_cachedLocal);
+    getTimeInfoFromTime(t, m_cachedLocal);
+
+    m_isCacheDirty = false;
+}
+
+void DateObject::getTimeInfoFromTime(time64_t t, struct timeinfo& timeinfo)
+{
+    getYMDFromTime(t, timeinfo);
 
     int days = daysFromTime(t);
     int timeInDay = static_cast<int>(t - days * const_Date_msPerDay);
@@ -1156,14 +1268,12 @@ void DateObject::resolveCache(ExecutionState& state)
     ASSERT(timeInDay >= 0);
 
     int weekday = (days + 4) % const_Date_daysPerWeek;
-    m_cachedLocal.wday = weekday >= 0 ? weekday : weekday + const_Date_daysPerWeek;
+    timeinfo.wday = weekday >= 0 ? weekday : weekday + const_Date_daysPerWeek;
     // Do not cast const_Date_msPer[Hour|Minute|Second] into double
-    m_cachedLocal.hour = timeInDay / const_Date_msPerHour;
-    m_cachedLocal.min = (timeInDay / const_Date_msPerMinute) % const_Date_minutesPerHour;
-    m_cachedLocal.sec = (timeInDay / const_Date_msPerSecond) % const_Date_secondsPerMinute;
-    m_cachedLocal.millisec = (timeInDay) % const_Date_msPerSecond;
-
-    m_isCacheDirty = false;
+    timeinfo.hour = timeInDay / const_Date_msPerHour;
+    timeinfo.min = (timeInDay / const_Date_msPerMinute) % const_Date_minutesPerHour;
+    timeinfo.sec = (timeInDay / const_Date_msPerSecond) % const_Date_secondsPerMinute;
+    timeinfo.millisec = (timeInDay) % const_Date_msPerSecond;
 }
 
 
@@ -1228,16 +1338,71 @@ String* DateObject::toFullString(ExecutionState& state)
     }
 }
 
+// writes value in fixed width with leading zeros
+static inline char* writeFixedDigits(char* p, int value, int width)
+{
+    ASSERT(value >= 0);
+    for (int i = width - 1; i >= 0; i--) {
+        p[i] = '0' + value % 10;
+        value /= 10;
+    }
+    return p + width;
+}
+
+static inline char* writeInteger(char* p, int value)
+{
+    char buffer[16];
+    int length = 0;
+    unsigned absValue = value < 0 ? -(unsigned)value : value;
+    do {
+        buffer[length++] = '0' + absValue % 10;
+        absValue /= 10;
+    } while (absValue);
+    if (value < 0) {
+        *p++ = '-';
+    }
+    while (length) {
+        *p++ = buffer[--length];
+    }
+    return p;
+}
+
+static inline char* writeChars(char* p, const char* str, size_t length)
+{
+    memcpy(p, str, length);
+    return p + length;
+}
+
 String* DateObject::toISOString(ExecutionState& state)
 {
-    char buffer[64];
     if (IS_VALID_TIME(m_primitiveValue)) {
-        if (getUTCFullYear(state) >= 0 && getUTCFullYear(state) <= 9999) {
-            snprintf(buffer, sizeof(buffer), "%04d-%02d-%02dT%02d:%02d:%02d.%03dZ", getUTCFullYear(state), getUTCMonth(state) + 1, getUTCDate(state), getUTCHours(state), getUTCMinutes(state), getUTCSeconds(state), getUTCMilliseconds(state));
+        // UTC fields are computed from time value directly, without local time
+        struct timeinfo utc;
+        getTimeInfoFromTime(m_primitiveValue, utc);
+
+        // YYYY-MM-DDTHH:mm:ss.sssZ or ±YYYYYY-MM-DDTHH:mm:ss.sssZ
+        char buffer[32];
+        char* p = buffer;
+        if (utc.year >= 0 && utc.year <= 9999) {
+            p = writeFixedDigits(p, utc.year, 4);
         } else {
-            snprintf(buffer, sizeof(buffer), "%+07d-%02d-%02dT%02d:%02d:%02d.%03dZ", getUTCFullYear(state), getUTCMonth(state) + 1, getUTCDate(state), getUTCHours(state), getUTCMinutes(state), getUTCSeconds(state), getUTCMilliseconds(state));
+            *p++ = utc.year < 0 ? '-' : '+';
+            p = writeFixedDigits(p, std::abs(utc.year), 6);
         }
-        return new ASCIIString(buffer);
+        *p++ = '-';
+        p = writeFixedDigits(p, utc.month + 1, 2);
+        *p++ = '-';
+        p = writeFixedDigits(p, utc.mday, 2);
+        *p++ = 'T';
+        p = writeFixedDigits(p, utc.hour, 2);
+        *p++ = ':';
+        p = writeFixedDigits(p, utc.min, 2);
+        *p++ = ':';
+        p = writeFixedDigits(p, utc.sec, 2);
+        *p++ = '.';
+        p = writeFixedDigits(p, utc.millisec, 3);
+        *p++ = 'Z';
+        return new ASCIIString(buffer, p - buffer);
     } else {
         ErrorObject::throwBuiltinError(state, ErrorObject::RangeError, state.context()->staticStrings().Date.string(), true, state.context()->staticStrings().toISOString.string(), errorMessage_GlobalObject_InvalidDate);
     }
@@ -1247,27 +1412,61 @@ String* DateObject::toISOString(ExecutionState& state)
 
 String* DateObject::toUTCString(ExecutionState& state, String* functionName)
 {
-    char buffer[64];
     if (IS_VALID_TIME(m_primitiveValue)) {
-        snprintf(buffer, sizeof(buffer), "%s, %02d %s %d %02d:%02d:%02d GMT", days[getUTCDay(state)], getUTCDate(state),
-                 months[getUTCMonth(state)], getUTCFullYear(state),
-                 getUTCHours(state), getUTCMinutes(state), getUTCSeconds(state));
-        return new ASCIIString(buffer);
+        struct timeinfo utc;
+        getTimeInfoFromTime(m_primitiveValue, utc);
+
+        // Www, DD Mmm YYYY HH:mm:ss GMT
+        char buffer[48];
+        char* p = buffer;
+        p = writeChars(p, days[utc.wday], 3);
+        *p++ = ',';
+        *p++ = ' ';
+        p = writeFixedDigits(p, utc.mday, 2);
+        *p++ = ' ';
+        p = writeChars(p, months[utc.month], 3);
+        *p++ = ' ';
+        p = writeInteger(p, utc.year);
+        *p++ = ' ';
+        p = writeFixedDigits(p, utc.hour, 2);
+        *p++ = ':';
+        p = writeFixedDigits(p, utc.min, 2);
+        *p++ = ':';
+        p = writeFixedDigits(p, utc.sec, 2);
+        p = writeChars(p, " GMT", 4);
+        return new ASCIIString(buffer, p - buffer);
     } else {
         return new ASCIIString("Invalid Date");
     }
 }
 
+#ifdef ENABLE_ICU
+// formatters for toLocale*String are kept in VMInstance, because creating one loads locale data every time
+static icu::DateFormat* cachedLocaleDateFormat(ExecutionState& state, bool isTimeFormat)
+{
+    VMInstance* vmInstance = state.context()->vmInstance();
+    std::string cacheKey = std::string(isTimeFormat ? "localetimeformat:" : "localedateformat:") + vmInstance->locale().getName();
+    icu::DateFormat* format = (icu::DateFormat*)vmInstance->icuObjectCache().find(cacheKey);
+    if (!format) {
+        if (isTimeFormat) {
+            format = icu::DateFormat::createTimeInstance(icu::DateFormat::MEDIUM, vmInstance->locale());
+        } else {
+            format = icu::DateFormat::createDateInstance(icu::DateFormat::MEDIUM, vmInstance->locale());
+        }
+        vmInstance->icuObjectCache().insert(cacheKey, format, [](void* object) {
+            delete (icu::DateFormat*)object;
+        });
+    }
+    return format;
+}
+#endif
+
 String* DateObject::toLocaleDateString(ExecutionState& state)
 {
     if (IS_VALID_TIME(m_primitiveValue)) {
 #ifdef ENABLE_ICU
         icu::UnicodeString myString;
-        icu::DateFormat* df = icu::DateFormat::createDateInstance(icu::DateFormat::MEDIUM, state.context()->vmInstance()->locale());
-        df->format(primitiveValue(), myString);
-
-        delete df;
-
+        cachedLocaleDateFormat(state, false)->format(primitiveValue(), myString);
         return new UTF16String(myString);
 #else
         return toDateString(state);
@@ -1282,11 +1481,7 @@ String* DateObject::toLocaleTimeString(ExecutionState& state)
     if (IS_VALID_TIME(m_primitiveValue)) {
 #ifdef ENABLE_ICU
         icu::UnicodeString myString;
-        icu::DateFormat* tf = icu::DateFormat::createTimeInstance(icu::DateFormat::MEDIUM, state.context()->vmInstance()->locale());
-        tf->format(primitiveValue(), myString);
-
-        delete tf;
-
+        cachedLocaleDateFormat(state, true)->format(primitiveValue(), myString);
         return new UTF16String(myString);
 #else
         return toTimeString(state);
@@ -1393,6 +1588,7 @@ DECLARE_DATE_UTC_GETTER(Seconds);
 
 void* DateObject::operator new(size_t size)
 {
+    ESCARGOT_PROFILE_ALLOCATION(DateObject, size);
     static bool typeInited = false;
     static GC_descr descr;
     if (!typeInited) {
@@ -155,6 +155,7 @@ private:
     static time64_t parseStringToDate(ExecutionState& state, String* istr);
     static time64_t parseStringToDate_1(ExecutionState& state, String* istr, bool& haveTZ, int& offset);
     static time64_t parseStringToDate_2(ExecutionState& state, String* istr, bool& haveTZ);
+    static time64_t parseStringToDate_ISO(ExecutionState& state, String* istr, bool& haveTZ);
     static int daysInYear(int year);
     static int daysFromMonth(int year, int month);
     static int daysFromYear(int year);
@@ -163,6 +164,8 @@ private:
     static time64_t timeFromYear(int year) { return const_Date_msPerDay * daysFromYear(year); }
     static int yearFromTime(time64_t t);
     static void getYMDFromTime(time64_t t, struct timeinfo& cachedLocal);
+    // fills date and time fields of timeinfo except gmtoff and isdst
+    static void getTimeInfoFromTime(time64_t t, struct timeinfo& timeinfo);
     static bool inLeapYear(int year);
 };
 }
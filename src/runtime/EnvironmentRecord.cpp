@@ -111,19 +111,29 @@ EnvironmentRecord::BindingSlot GlobalEnvironmentRecord::hasBinding(ExecutionStat
 }
 
 FunctionEnvironmentRecordOnHeap::FunctionEnvironmentRecordOnHeap(FunctionObject* function, size_t argc, Value* argv)
-    : FunctionEnvironmentRecord(function)
-    , m_heapStorage(function->codeBlock()->asInterpretedCodeBlock()->identifierOnHeapCount())
+    : FunctionEnvironmentRecordWithHeapSlots(function, argc, argv)
 {
-    m_argc = argc;
-    m_argv = argv;
+    m_heapSlots = reinterpret_cast<SmallValue*>(this + 1);
+}
+
+FunctionEnvironmentRecordOnHeap* FunctionEnvironmentRecordOnHeap::create(FunctionObject* function, size_t argc, Value* argv)
+{
+    size_t heapStorageSize = function->codeBlock()->asInterpretedCodeBlock()->identifierOnHeapCount();
+    size_t size = sizeof(FunctionEnvironmentRecordOnHeap) + heapStorageSize * sizeof(SmallValue);
+    ESCARGOT_PROFILE_ALLOCATION(EnvironmentRecord, size);
+    // not typed. every word after vtable and m_argc can hold a pointer, and slots can hold any value like SmallValueTightVector.
+    // a typed descriptor would skip only those two words, and it would need a descriptor for each count of slots
+    FunctionEnvironmentRecordOnHeap* record = new (GC_MALLOC(size)) FunctionEnvironmentRecordOnHeap(function, argc, argv);
+    for (size_t i = 0; i < heapStorageSize; i++) {
+        new (&record->m_heapSlots[i]) SmallValue();
+    }
+    return record;
 }
 
 FunctionEnvironmentRecordNotIndexed::FunctionEnvironmentRecordNotIndexed(FunctionObject* function, size_t argc, Value* argv)
-    : FunctionEnvironmentRecord(function)
+    : FunctionEnvironmentRecordWithHeapSlots(function, argc, argv)
     , m_heapStorage()
 {
-    m_argc = argc;
-    m_argv = argv;
     const InterpretedCodeBlock::IdentifierInfoVector& vec = function->codeBlock()->asInterpretedCodeBlock()->identifierInfos();
     size_t len = vec.size();
     m_recordVector.resizeWithUninitializedValues(len);
@@ -137,6 +147,24 @@ FunctionEnvironmentRecordNotIndexed::FunctionEnvironmentRecordNotIndexed(Functio
         m_recordVector[i] = record;
         m_heapStorage[i] = Value();
     }
+    m_heapSlots = m_heapStorage.data();
+}
+
+void* FunctionEnvironmentRecordNotIndexed::operator new(size_t size)
+{
+    ESCARGOT_PROFILE_ALLOCATION(EnvironmentRecord, size);
+    static bool typeInited = false;
+    static GC_descr descr;
+    if (!typeInited) {
+        GC_word obj_bitmap[GC_BITMAP_SIZE(FunctionEnvironmentRecordNotIndexed)] = { 0 };
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(FunctionEnvironmentRecordNotIndexed, m_functionObject));
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(FunctionEnvironmentRecordNotIndexed, m_argv));
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(FunctionEnvironmentRecordNotIndexed, m_heapStorage));
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(FunctionEnvironmentRecordNotIndexed, m_recordVector));
+        descr = GC_make_descriptor(obj_bitmap, GC_WORD_LEN(FunctionEnvironmentRecordNotIndexed));
+        typeInited = true;
+    }
+    return GC_MALLOC_EXPLICITLY_TYPED(size, descr);
 }
 
 void DeclarativeEnvironmentRecordNotIndexed::createBinding(ExecutionState& state, const AtomicString& name, bool canDelete, bool isMutable)
@@ -200,6 +228,7 @@ void FunctionEnvironmentRecordNotIndexed::createBinding(ExecutionState& state, c
         record.m_isMutable = isMutable;
         m_recordVector.pushBack(record);
         m_heapStorage.pushBack(Value());
+        m_heapSlots = m_heapStorage.data();
     } else {
         m_recordVector[idx].m_isMutable = isMutable;
     }
@@ -322,6 +322,8 @@ public:
 // DeclarativeEnvironmentRecordNotIndexed record does not create binding self likes FunctionEnvironmentRecord
 // this record is for strict eval now
 class DeclarativeEnvironmentRecordNotIndexed : public DeclarativeEnvironmentRecord {
+    friend class HeapSnapshot;
+
 public:
     DeclarativeEnvironmentRecordNotIndexed()
         : DeclarativeEnvironmentRecord()
@@ -465,13 +467,47 @@ public:
     }
 };
 
-class FunctionEnvironmentRecordOnHeap : public FunctionEnvironmentRecord {
+// function environment record whose variables are read and written by index with heap index opcodes
+class FunctionEnvironmentRecordWithHeapSlots : public FunctionEnvironmentRecord {
+    friend class ByteCodeInterpreter;
+    friend class FunctionObject;
+
+public:
+    virtual size_t argc()
+    {
+        return m_argc;
+    }
+
+    virtual Value* argv()
+    {
+        return m_argv;
+    }
+
+protected:
+    FunctionEnvironmentRecordWithHeapSlots(FunctionObject* function, size_t argc, Value* argv)
+        : FunctionEnvironmentRecord(function)
+        , m_argc(argc)
+        , m_argv(argv)
+        , m_heapSlots(nullptr)
+    {
+    }
+
+    size_t m_argc;
+    Value* m_argv;
+    // FunctionEnvironmentRecordOnHeap has slots right after itself.
+    // FunctionEnvironmentRecordNotIndexed points buffer of its m_heapStorage, and updates this when buffer is reallocated
+    SmallValue* m_heapSlots;
+};
+
+class FunctionEnvironmentRecordOnHeap : public FunctionEnvironmentRecordWithHeapSlots {
     friend class LexicalEnvironment;
     friend class ByteCodeInterpreter;
     friend class FunctionObject;
+    friend class HeapSnapshot;
 
 public:
-    FunctionEnvironmentRecordOnHeap(FunctionObject* function, size_t argc, Value* argv);
+    // record and slots of captured variables are allocated at once
+    static FunctionEnvironmentRecordOnHeap* create(FunctionObject* function, size_t argc, Value* argv);
 
     virtual bool isFunctionEnvironmentRecordOnHeap()
     {
@@ -480,12 +516,12 @@ public:
 
     virtual void setHeapValueByIndex(const size_t& idx, const Value& v)
     {
-        m_heapStorage[idx] = v;
+        m_heapSlots[idx] = v;
     }
 
     virtual Value getHeapValueByIndex(const size_t& idx)
     {
-        return m_heapStorage[idx];
+        return m_heapSlots[idx];
     }
 
     virtual GetBindingValueResult getBindingValue(ExecutionState& state, const AtomicString& name)
@@ -494,7 +530,7 @@ public:
 
         for (size_t i = 0; i < v.size(); i++) {
             if (v[i].m_name == name) {
-                return GetBindingValueResult(m_heapStorage[v[i].m_indexForIndexedStorage]);
+                return GetBindingValueResult(m_heapSlots[v[i].m_indexForIndexedStorage]);
             }
         }
         return GetBindingValueResult();
@@ -514,7 +550,7 @@ public:
 
     virtual void setMutableBindingByIndex(ExecutionState& state, const size_t& idx, const AtomicString& name, const Value& v)
     {
-        m_heapStorage[idx] = v;
+        m_heapSlots[idx] = v;
     }
 
     virtual void setMutableBinding(ExecutionState& state, const AtomicString& name, const Value& V)
@@ -523,31 +559,27 @@ public:
 
         for (size_t i = 0; i < v.size(); i++) {
             if (v[i].m_name == name) {
-                m_heapStorage[v[i].m_indexForIndexedStorage] = V;
+                m_heapSlots[v[i].m_indexForIndexedStorage] = V;
                 return;
             }
         }
         RELEASE_ASSERT_NOT_REACHED();
     }
 
-    virtual size_t argc()
-    {
-        return m_argc;
-    }
+    void* operator new(size_t size) = delete;
+    void* operator new[](size_t size) = delete;
 
-    virtual Value* argv()
+protected:
+    FunctionEnvironmentRecordOnHeap(FunctionObject* function, size_t argc, Value* argv);
+    void* operator new(size_t, void* ptr)
     {
-        return m_argv;
+        return ptr;
     }
-
-protected:
-    size_t m_argc;
-    Value* m_argv;
-    SmallValueTightVector m_heapStorage;
 };
 
-class FunctionEnvironmentRecordNotIndexed : public FunctionEnvironmentRecord {
+class FunctionEnvironmentRecordNotIndexed : public FunctionEnvironmentRecordWithHeapSlots {
     friend class LexicalEnvironment;
+    friend class HeapSnapshot;
 
 public:
     FunctionEnvironmentRecordNotIndexed(FunctionObject* function, size_t argc, Value* argv);
@@ -582,6 +614,7 @@ public:
                 }
                 m_recordVector.erase(i);
                 m_heapStorage.erase(i);
+                m_heapSlots = m_heapStorage.data();
                 return true;
             }
         }
@@ -605,21 +638,13 @@ public:
     virtual void setMutableBinding(ExecutionState& state, const AtomicString& name, const Value& V);
     virtual void setMutableBindingByIndex(ExecutionState& state, const size_t& idx, const AtomicString& name, const Value& v);
 
-    virtual size_t argc()
-    {
-        return m_argc;
-    }
-
-    virtual Value* argv()
-    {
-        return m_argv;
-    }
+    void* operator new(size_t size);
+    void* operator new[](size_t size) = delete;
+    using gc::operator new;
 
     virtual void initializeBinding(ExecutionState& state, const AtomicString& name, const Value& V);
 
 protected:
-    size_t m_argc;
-    Value* m_argv;
     SmallValueTightVector m_heapStorage;
     IdentifierRecordVector m_recordVector;
 };
@@ -144,6 +144,27 @@ ErrorObject::ErrorObject(ExecutionState& state, String* errorMessage)
     setPrototype(state, state.context()->globalObject()->errorPrototype());
 }
 
+void* ErrorObject::operator new(size_t size)
+{
+    ESCARGOT_PROFILE_ALLOCATION(ErrorObject, size);
+    // native error types add no field, so they share this descriptor
+    if (UNLIKELY(size != sizeof(ErrorObject))) {
+        return GC_MALLOC(size);
+    }
+    static bool typeInited = false;
+    static GC_descr descr;
+    if (!typeInited) {
+        GC_word obj_bitmap[GC_BITMAP_SIZE(ErrorObject)] = { 0 };
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(ErrorObject, m_structure));
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(ErrorObject, m_prototype));
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(ErrorObject, m_values));
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(ErrorObject, m_stackTraceData));
+        descr = GC_make_descriptor(obj_bitmap, GC_WORD_LEN(ErrorObject));
+        typeInited = true;
+    }
+    return GC_MALLOC_EXPLICITLY_TYPED(size, descr);
+}
+
 ErrorObject* ErrorObject::createError(ExecutionState& state, ErrorObject::Code code, String* errorMessage)
 {
     if (code == ReferenceError)
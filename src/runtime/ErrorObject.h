@@ -150,6 +150,10 @@ public:
         m_stackTraceData = d;
     }
 
+    void* operator new(size_t size);
+    void* operator new[](size_t size) = delete;
+    using gc::operator new;
+
 protected:
     StackTraceData* m_stackTraceData;
 };
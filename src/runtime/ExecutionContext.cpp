@@ -24,6 +24,22 @@
 
 namespace Escargot {
 
+void* ExecutionContext::operator new(size_t size)
+{
+    ESCARGOT_PROFILE_ALLOCATION(ExecutionContext, size);
+    static bool typeInited = false;
+    static GC_descr descr;
+    if (!typeInited) {
+        GC_word obj_bitmap[GC_BITMAP_SIZE(ExecutionContext)] = { 0 };
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(ExecutionContext, m_context));
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(ExecutionContext, m_parent));
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(ExecutionContext, m_lexicalEnvironment));
+        descr = GC_make_descriptor(obj_bitmap, GC_WORD_LEN(ExecutionContext));
+        typeInited = true;
+    }
+    return GC_MALLOC_EXPLICITLY_TYPED(size, descr);
+}
+
 FunctionObject* ExecutionContext::resolveCallee()
 {
     LexicalEnvironment* env = m_lexicalEnvironment;
@@ -64,6 +64,11 @@ public:
 
     FunctionObject* resolveCallee();
 
+    void* operator new(size_t size);
+    void* operator new[](size_t size) = delete;
+    // keep placement forms of gc visible. alloca'd fast path uses placement new
+    using gc::operator new;
+
 private:
     bool m_inStrictMode;
     Context* m_context;
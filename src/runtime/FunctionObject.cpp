@@ -119,6 +119,28 @@ FunctionObject::FunctionObject(ExecutionState& state, NativeFunctionInfo info)
     setPrototype(state, state.context()->globalObject()->functionPrototype());
 }
 
+void* FunctionObject::operator new(size_t size)
+{
+    ESCARGOT_PROFILE_ALLOCATION(FunctionObject, size);
+    // GlobalRegExpFunctionObject and EvalFunctionObject have fields of their own
+    if (UNLIKELY(size != sizeof(FunctionObject))) {
+        return GC_MALLOC(size);
+    }
+    static bool typeInited = false;
+    static GC_descr descr;
+    if (!typeInited) {
+        GC_word obj_bitmap[GC_BITMAP_SIZE(FunctionObject)] = { 0 };
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(FunctionObject, m_structure));
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(FunctionObject, m_prototype));
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(FunctionObject, m_values));
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(FunctionObject, m_codeBlock));
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(FunctionObject, m_outerEnvironment));
+        descr = GC_make_descriptor(obj_bitmap, GC_WORD_LEN(FunctionObject));
+        typeInited = true;
+    }
+    return GC_MALLOC_EXPLICITLY_TYPED(size, descr);
+}
+
 FunctionObject::FunctionObject(ExecutionState& state, NativeFunctionInfo info, ForBuiltin)
     : Object(state, ESCARGOT_OBJECT_BUILTIN_PROPERTY_NUMBER + 3, false)
     , m_codeBlock(new CodeBlock(state.context(), info))
@@ -225,11 +247,15 @@ NEVER_INLINE void FunctionObject::generateBytecodeBlock(ExecutionState& state)
 #endif
 
 
-    auto ret = state.context()->scriptParser().parseFunction(m_codeBlock->asInterpretedCodeBlock(), stackRemainApprox, &state);
-    RefPtr<Node> ast = std::get<0>(ret);
+    {
+        ASTAllocator allocator;
+        ASTAllocatorScope allocatorScope(&allocator);
+        auto ret = state.context()->scriptParser().parseFunction(m_codeBlock->asInterpretedCodeBlock(), stackRemainApprox, &state);
+        RefPtr<Node> ast = std::get<0>(ret);
 
-    ByteCodeGenerator g;
-    m_codeBlock->m_byteCodeBlock = g.generateByteCode(state.context(), m_codeBlock->asInterpretedCodeBlock(), ast.get(), std::get<1>(ret), false, false, false);
+        ByteCodeGenerator g;
+        m_codeBlock->m_byteCodeBlock = g.generateByteCode(state.context(), m_codeBlock->asInterpretedCodeBlock(), ast.get(), std::get<1>(ret), false, false, false);
+    }
 
     v.pushBack(m_codeBlock);
 
@@ -330,30 +356,68 @@ Value FunctionObject::processCall(ExecutionState& state, const Value& receiverSr
         }
     }
 
+    void* frame = alloca(callFrameSize(state));
+    ExecutionState* newState = prepareCallFrame(state, frame, receiverSrc, argc, argv);
+    ByteCodeBlock* blk = m_codeBlock->asInterpretedCodeBlock()->byteCodeBlock();
+
+    // run function
+    size_t unused;
+    const Value returnValue = ByteCodeInterpreter::interpret(*newState, blk, 0, newState->registerFile(), &unused);
+    if (UNLIKELY(blk->m_shouldClearStack)) {
+        state.context()->vmInstance()->interpreterStack().clearReleasedFrames();
+        clearStack<512>();
+    }
+
+    return returnValue;
+}
+
+size_t FunctionObject::callFrameSize(ExecutionState& state)
+{
+    ASSERT(m_codeBlock->isInterpretedCodeBlock());
     // prepare ByteCodeBlock if needed
     if (UNLIKELY(m_codeBlock->asInterpretedCodeBlock()->byteCodeBlock() == nullptr)) {
         generateBytecodeBlock(state);
     }
 
+    return m_codeBlock->asInterpretedCodeBlock()->byteCodeBlock()->m_frameLayout.m_frameSize;
+}
+
+ExecutionState* FunctionObject::prepareCallFrame(ExecutionState& state, void* frameMemory, const Value& receiverSrc, const size_t& argc, Value* argv)
+{
     ByteCodeBlock* blk = m_codeBlock->asInterpretedCodeBlock()->byteCodeBlock();
+    ASSERT(blk);
+    const ByteCodeFrameLayout& layout = blk->m_frameLayout;
+
+    if (LIKELY(layout.m_hasSimplePrologue && argc == layout.m_parameterCount)) {
+        return prepareSimpleCallFrame(state, frameMemory, receiverSrc, argv);
+    }
+
+    Context* ctx = m_codeBlock->context();
+    bool isStrict = layout.m_isStrict;
+
+    char* frame = (char*)frameMemory;
+    void* stateMemory = frame;
+    frame += CALL_FRAME_ALIGNED_SIZE(ExecutionState);
 
     size_t registerSize = blk->m_requiredRegisterFileSizeInValueSize;
-    size_t stackStorageSize = m_codeBlock->asInterpretedCodeBlock()->identifierOnStackCount();
+    size_t stackStorageSize = layout.m_stackStorageSize;
     size_t literalStorageSize = blk->m_numeralLiteralData.size();
     Value* literalStorageSrc = blk->m_numeralLiteralData.data();
-    size_t parameterCopySize = std::min(argc, (size_t)m_codeBlock->parameterCount());
+    size_t parameterCopySize = std::min(argc, (size_t)layout.m_parameterCount);
 
     // prepare env, ec
     FunctionEnvironmentRecord* record;
-    ExecutionContext* ec;
+    LexicalEnvironment* env;
 
     if (LIKELY(m_codeBlock->canAllocateEnvironmentOnStack())) {
         // no capture, very simple case
-        record = new (alloca(sizeof(FunctionEnvironmentRecordSimple))) FunctionEnvironmentRecordSimple(this);
-        ec = new (alloca(sizeof(ExecutionContext))) ExecutionContext(ctx, state.executionContext(), new (alloca(sizeof(LexicalEnvironment))) LexicalEnvironment(record, outerEnvironment()), isStrict);
+        record = new (frame) FunctionEnvironmentRecordSimple(this);
+        frame += CALL_FRAME_ALIGNED_SIZE(FunctionEnvironmentRecordSimple);
+        env = new (frame) LexicalEnvironment(record, outerEnvironment());
+        frame += CALL_FRAME_ALIGNED_SIZE(LexicalEnvironment);
     } else {
         if (LIKELY(m_codeBlock->canUseIndexedVariableStorage())) {
-            record = new FunctionEnvironmentRecordOnHeap(this, argc, argv);
+            record = FunctionEnvironmentRecordOnHeap::create(this, argc, argv);
         } else {
             if (LIKELY(!m_codeBlock->needsVirtualIDOperation())) {
                 record = new FunctionEnvironmentRecordNotIndexed(this, argc, argv);
@@ -361,10 +425,13 @@ Value FunctionObject::processCall(ExecutionState& state, const Value& receiverSr
                 record = new FunctionEnvironmentRecordNotIndexedWithVirtualID(this, argc, argv);
             }
         }
-        ec = new ExecutionContext(ctx, state.executionContext(), new LexicalEnvironment(record, outerEnvironment()), isStrict);
+        // only captured variables are on heap. closures keep this environment alive
+        env = new LexicalEnvironment(record, outerEnvironment());
     }
+    ExecutionContext* ec = new (frame) ExecutionContext(ctx, state.executionContext(), env, isStrict);
+    frame += CALL_FRAME_ALIGNED_SIZE(ExecutionContext);
 
-    Value* registerFile = (Value*)alloca((registerSize + stackStorageSize + literalStorageSize) * sizeof(Value));
+    Value* registerFile = (Value*)frame;
     Value* stackStorage = registerFile + registerSize;
 
     {
@@ -375,7 +442,7 @@ Value FunctionObject::processCall(ExecutionState& state, const Value& receiverSr
     }
 
     // prepare receiver
-    if (UNLIKELY(m_codeBlock->isArrowFunctionExpression())) {
+    if (UNLIKELY(layout.m_isArrowFunction)) {
         stackStorage[0] = ctx->globalObject();
     } else {
         if (!isStrict) {
@@ -394,7 +461,7 @@ Value FunctionObject::processCall(ExecutionState& state, const Value& receiverSr
     if (UNLIKELY(m_codeBlock->m_isFunctionNameSaveOnHeap)) {
         if (m_codeBlock->canUseIndexedVariableStorage()) {
             ASSERT(record->isFunctionEnvironmentRecordOnHeap());
-            ((FunctionEnvironmentRecordOnHeap*)record)->m_heapStorage[0] = this;
+            ((FunctionEnvironmentRecordOnHeap*)record)->m_heapSlots[0] = this;
         } else {
             record->initializeBinding(state, m_codeBlock->functionName(), this);
         }
@@ -404,7 +471,7 @@ Value FunctionObject::processCall(ExecutionState& state, const Value& receiverSr
         if (m_codeBlock->canUseIndexedVariableStorage()) {
             if (UNLIKELY(m_codeBlock->m_isFunctionNameSaveOnHeap)) {
                 ASSERT(record->isFunctionEnvironmentRecordOnHeap());
-                ((FunctionEnvironmentRecordOnHeap*)record)->m_heapStorage[0] = Value();
+                ((FunctionEnvironmentRecordOnHeap*)record)->m_heapSlots[0] = Value();
             } else {
                 stackStorage[1] = Value();
             }
@@ -440,7 +507,7 @@ Value FunctionObject::processCall(ExecutionState& state, const Value& receiverSr
                     val = Value();
                 if (info[i].m_isHeapAllocated) {
                     ASSERT(record->isFunctionEnvironmentRecordOnHeap());
-                    ((FunctionEnvironmentRecordOnHeap*)record)->m_heapStorage[info[i].m_index] = val;
+                    ((FunctionEnvironmentRecordOnHeap*)record)->m_heapSlots[info[i].m_index] = val;
                 } else {
                     parameterStorageInStack[info[i].m_index] = val;
                 }
@@ -457,19 +524,59 @@ Value FunctionObject::processCall(ExecutionState& state, const Value& receiverSr
         }
     }
 
-    ExecutionState newState(ctx, &state, ec, registerFile);
+    ExecutionState* newState = new (stateMemory) ExecutionState(ctx, &state, ec, registerFile);
 
     if (UNLIKELY(m_codeBlock->usesArgumentsObject())) {
-        generateArgumentsObject(newState, record, stackStorage);
+        generateArgumentsObject(*newState, record, stackStorage);
     }
 
-    // run function
-    size_t unused;
-    const Value returnValue = ByteCodeInterpreter::interpret(newState, blk, 0, registerFile, &unused);
-    if (UNLIKELY(blk->m_shouldClearStack))
-        clearStack<512>();
+    return newState;
+}
 
-    return returnValue;
+// every argument fills a parameter, so frame is set up without looking at code block
+ExecutionState* FunctionObject::prepareSimpleCallFrame(ExecutionState& state, void* frameMemory, const Value& receiverSrc, Value* argv)
+{
+    ByteCodeBlock* blk = m_codeBlock->asInterpretedCodeBlock()->byteCodeBlock();
+    const ByteCodeFrameLayout& layout = blk->m_frameLayout;
+    Context* ctx = m_codeBlock->context();
+
+    char* frame = (char*)frameMemory;
+    void* stateMemory = frame;
+    frame += CALL_FRAME_ALIGNED_SIZE(ExecutionState);
+    FunctionEnvironmentRecord* record = new (frame) FunctionEnvironmentRecordSimple(this);
+    frame += CALL_FRAME_ALIGNED_SIZE(FunctionEnvironmentRecordSimple);
+    LexicalEnvironment* env = new (frame) LexicalEnvironment(record, outerEnvironment());
+    frame += CALL_FRAME_ALIGNED_SIZE(LexicalEnvironment);
+    ExecutionContext* ec = new (frame) ExecutionContext(ctx, state.executionContext(), env, layout.m_isStrict);
+    frame += CALL_FRAME_ALIGNED_SIZE(ExecutionContext);
+
+    Value* registerFile = (Value*)frame;
+    Value* stackStorage = registerFile + blk->m_requiredRegisterFileSizeInValueSize;
+    size_t stackStorageSize = layout.m_stackStorageSize;
+    size_t parameterEnd = layout.m_parameterCount + 2;
+    ASSERT(parameterEnd <= stackStorageSize);
+
+    memcpy(stackStorage + stackStorageSize, blk->m_numeralLiteralData.data(), blk->m_numeralLiteralData.size() * sizeof(Value));
+
+    if (UNLIKELY(layout.m_isArrowFunction)) {
+        stackStorage[0] = ctx->globalObject();
+    } else if (LIKELY(layout.m_isStrict)) {
+        stackStorage[0] = receiverSrc;
+    } else if (receiverSrc.isUndefinedOrNull()) {
+        stackStorage[0] = ctx->globalObject();
+    } else {
+        stackStorage[0] = receiverSrc.toObject(state);
+    }
+    stackStorage[1] = this;
+
+    for (size_t i = 2; i < parameterEnd; i++) {
+        stackStorage[i] = argv[i - 2];
+    }
+    for (size_t i = parameterEnd; i < stackStorageSize; i++) {
+        stackStorage[i] = Value();
+    }
+
+    return new (stateMemory) ExecutionState(ctx, &state, ec, registerFile);
 }
 
 void FunctionObject::generateArgumentsObject(ExecutionState& state, FunctionEnvironmentRecord* fnRecord, Value* stackStorage)
@@ -490,7 +597,7 @@ void FunctionObject::generateArgumentsObject(ExecutionState& state, FunctionEnvi
                     stackStorage[v[i].m_indexForIndexedStorage] = fnRecord->createArgumentsObject(state, state.executionContext());
                 } else {
                     ASSERT(fnRecord->isFunctionEnvironmentRecordOnHeap());
-                    ((FunctionEnvironmentRecordOnHeap*)fnRecord)->m_heapStorage[v[i].m_indexForIndexedStorage] = fnRecord->createArgumentsObject(state, state.executionContext());
+                    ((FunctionEnvironmentRecordOnHeap*)fnRecord)->m_heapSlots[v[i].m_indexForIndexedStorage] = fnRecord->createArgumentsObject(state, state.executionContext());
                 }
                 break;
             }
@@ -33,6 +33,8 @@ class FunctionEnvironmentRecord;
 class FunctionObject : public Object {
     friend class GlobalObject;
     friend class Script;
+    friend class HeapSnapshot;
+    friend class ByteCodeInterpreter;
     void initFunctionObject(ExecutionState& state);
 
     enum ForGlobalBuiltin { __ForGlobalBuiltin__ };
@@ -111,6 +113,10 @@ public:
 
     bool hasInstance(ExecutionState& state, const Value& O);
 
+    void* operator new(size_t size);
+    void* operator new[](size_t size) = delete;
+    using gc::operator new;
+
 protected:
     LexicalEnvironment* outerEnvironment()
     {
@@ -131,6 +137,11 @@ protected:
     }
 
     Value processCall(ExecutionState& state, const Value& receiver, const size_t& argc, Value* argv, bool isNewExpression);
+    // ExecutionState, environment and register file of interpreted function live in frame memory of callFrameSize(),
+    // which is on C++ stack in processCall, or on InterpreterStack for calls made inside interpreter loop
+    size_t callFrameSize(ExecutionState& state);
+    ExecutionState* prepareCallFrame(ExecutionState& state, void* frameMemory, const Value& receiver, const size_t& argc, Value* argv);
+    ExecutionState* prepareSimpleCallFrame(ExecutionState& state, void* frameMemory, const Value& receiver, Value* argv);
     static Value callSlowCase(ExecutionState& state, const Value& callee, const Value& receiver, const size_t& argc, Value* argv, bool isNewExpression);
     void generateArgumentsObject(ExecutionState& state, FunctionEnvironmentRecord* fnRecord, Value* stackStorage);
     void generateBytecodeBlock(ExecutionState& state);
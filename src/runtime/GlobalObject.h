@@ -23,6 +23,7 @@
 #include "runtime/FunctionObject.h"
 #include "runtime/Object.h"
 #include "runtime/GlobalRegExpFunctionObject.h"
+#include "runtime/MathIntrinsic.h"
 
 namespace Escargot {
 
@@ -233,6 +234,15 @@ public:
     {
         return m_stringPrototype;
     }
+    // builtin functions which were installed on String.prototype
+    FunctionObject* stringCharAt()
+    {
+        return m_stringCharAt;
+    }
+    FunctionObject* stringCharCodeAt()
+    {
+        return m_stringCharCodeAt;
+    }
     Object* stringIteratorPrototype()
     {
         return m_stringIteratorPrototype;
@@ -292,6 +302,24 @@ public:
         return m_math;
     }
 
+    // builtin function which was installed on Math object
+    FunctionObject* mathIntrinsic(MathIntrinsicKind kind)
+    {
+        return m_mathIntrinsics[kind];
+    }
+
+    // structure of Math after install. Math gets new structure whenever its property is added, deleted or reconfigured,
+    // so while Math has this, builtin of intrinsic is in the slot of mathIntrinsicIndex unless the value was replaced
+    ObjectStructure* mathStructure()
+    {
+        return m_mathStructure;
+    }
+
+    size_t mathIntrinsicIndex(MathIntrinsicKind kind)
+    {
+        return m_mathIntrinsicIndexes[kind];
+    }
+
     GlobalRegExpFunctionObject* regexp()
     {
         return m_regexp;
@@ -577,6 +605,8 @@ protected:
 
     FunctionObject* m_string;
     Object* m_stringPrototype;
+    FunctionObject* m_stringCharAt;
+    FunctionObject* m_stringCharCodeAt;
     Object* m_stringIteratorPrototype;
 
     FunctionObject* m_number;
@@ -599,6 +629,9 @@ protected:
     Object* m_regexpPrototype;
 
     Object* m_math;
+    FunctionObject* m_mathIntrinsics[MathIntrinsicKindCount];
+    ObjectStructure* m_mathStructure;
+    size_t m_mathIntrinsicIndexes[MathIntrinsicKindCount];
 
     FunctionObject* m_eval;
 
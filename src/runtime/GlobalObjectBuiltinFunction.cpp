@@ -72,6 +72,8 @@ static Value builtinFunctionConstructor(ExecutionState& state, Value thisValue,
         srcToTest.appendString("\r\n){ }");
         String* cur = srcToTest.finalize(&state);
         state.context()->vmInstance()->parsedSourceCodes().push_back(cur);
+        ASTAllocator allocator;
+        ASTAllocatorScope allocatorScope(&allocator);
         esprima::parseProgram(state.context(), StringView(cur, 0, cur->length()), nullptr, false, SIZE_MAX);
     } catch (esprima::Error* orgError) {
         ErrorObject::throwBuiltinError(state, ErrorObject::SyntaxError, "there is a script parse error in parameter name");
@@ -109,8 +111,10 @@ static Value builtinFunctionConstructor(ExecutionState& state, Value thisValue,
         state.throwException(err);
     }
 
+    ASTAllocator* allocator = ((ProgramNode*)parserResult.m_script->topCodeBlock()->cachedASTNode())->allocator();
     parserResult.m_script->topCodeBlock()->cachedASTNode()->deref();
     parserResult.m_script->topCodeBlock()->clearCachedASTNode();
+    delete allocator;
 
     InterpretedCodeBlock* cb = parserResult.m_script->topCodeBlock()->childBlocks()[0];
     cb->updateSourceElementStart(3, 1);
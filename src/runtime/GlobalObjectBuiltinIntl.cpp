@@ -48,6 +48,7 @@
 #include "Context.h"
 #include "StringObject.h"
 #include "ArrayObject.h"
+#include "VMInstance.h"
 
 namespace Escargot {
 
@@ -1169,41 +1170,57 @@ static void initializeCollator(ExecutionState& state, Object* collator, Value lo
         CollatorResolvedOptions opt = collatorResolvedOptions(state, internalSlot);
         UErrorCode status = U_ZERO_ERROR;
         String* locale = opt.locale;
-        UCollator* collator = ucol_open(locale->toUTF8StringData().data(), &status);
-        if (U_FAILURE(status)) {
-            return;
-        }
+        std::string cacheKey = "collator:" + locale->toNonGCUTF8StringData() + ":" + opt.sensitivity->toNonGCUTF8StringData()
+            + (opt.numeric ? ":numeric" : ":") + (opt.ignorePunctuation ? ":ignorePunctuation" : ":");
+        ICUObjectCache& cache = state.context()->vmInstance()->icuObjectCache();
+        UCollator* cachedCollator = (UCollator*)cache.find(cacheKey);
+        if (!cachedCollator) {
+            UCollator* collator = ucol_open(locale->toUTF8StringData().data(), &status);
+            if (U_FAILURE(status)) {
+                return;
+            }
 
-        UColAttributeValue strength = UCOL_PRIMARY;
-        UColAttributeValue caseLevel = UCOL_OFF;
-        String* sensitivity = opt.sensitivity;
-        if (sensitivity->equals("base")) {
-        } else if (sensitivity->equals("accent")) {
-            strength = UCOL_SECONDARY;
-        } else if (sensitivity->equals("case")) {
-            caseLevel = UCOL_ON;
-        } else if (sensitivity->equals("variant")) {
-            strength = UCOL_TERTIARY;
-        } else {
-            ASSERT_NOT_REACHED();
-        }
+            UColAttributeValue strength = UCOL_PRIMARY;
+            UColAttributeValue caseLevel = UCOL_OFF;
+            String* sensitivity = opt.sensitivity;
+            if (sensitivity->equals("base")) {
+            } else if (sensitivity->equals("accent")) {
+                strength = UCOL_SECONDARY;
+            } else if (sensitivity->equals("case")) {
+                caseLevel = UCOL_ON;
+            } else if (sensitivity->equals("variant")) {
+                strength = UCOL_TERTIARY;
+            } else {
+                ASSERT_NOT_REACHED();
+            }
+
+            ucol_setAttribute(collator, UCOL_STRENGTH, strength, &status);
+            ucol_setAttribute(collator, UCOL_CASE_LEVEL, caseLevel, &status);
 
-        ucol_setAttribute(collator, UCOL_STRENGTH, strength, &status);
-        ucol_setAttribute(collator, UCOL_CASE_LEVEL, caseLevel, &status);
+            bool numeric = opt.numeric;
+            ucol_setAttribute(collator, UCOL_NUMERIC_COLLATION, numeric ? UCOL_ON : UCOL_OFF, &status);
 
-        bool numeric = opt.numeric;
-        ucol_setAttribute(collator, UCOL_NUMERIC_COLLATION, numeric ? UCOL_ON : UCOL_OFF, &status);
+            // FIXME: Setting UCOL_ALTERNATE_HANDLING to UCOL_SHIFTED causes punctuation and whitespace to be
+            // ignored. There is currently no way to ignore only punctuation.
+            bool ignorePunctuation = opt.ignorePunctuation;
+            ucol_setAttribute(collator, UCOL_ALTERNATE_HANDLING, ignorePunctuation ? UCOL_SHIFTED : UCOL_DEFAULT, &status);
 
-        // FIXME: Setting UCOL_ALTERNATE_HANDLING to UCOL_SHIFTED causes punctuation and whitespace to be
-        // ignored. There is currently no way to ignore only punctuation.
-        bool ignorePunctuation = opt.ignorePunctuation;
-        ucol_setAttribute(collator, UCOL_ALTERNATE_HANDLING, ignorePunctuation ? UCOL_SHIFTED : UCOL_DEFAULT, &status);
+            // "The method is required to return 0 when comparing Strings that are considered canonically
+            // equivalent by the Unicode standard."
+            ucol_setAttribute(collator, UCOL_NORMALIZATION_MODE, UCOL_ON, &status);
+            if (U_FAILURE(status)) {
+                ucol_close(collator);
+                return;
+            }
+            cache.insert(cacheKey, collator, [](void* object) {
+                ucol_close((UCollator*)object);
+            });
+            cachedCollator = collator;
+        }
 
-        // "The method is required to return 0 when comparing Strings that are considered canonically
-        // equivalent by the Unicode standard."
-        ucol_setAttribute(collator, UCOL_NORMALIZATION_MODE, UCOL_ON, &status);
+        // each Collator owns its clone, which shares locale data with cached one
+        UCollator* collator = ucol_safeClone(cachedCollator, nullptr, nullptr, &status);
         if (U_FAILURE(status)) {
-            ucol_close(collator);
             return;
         }
 
@@ -1811,10 +1828,19 @@ static void initializeDateTimeFormat(ExecutionState& state, Object* dateTimeForm
     // Always use ICU date format generator, rather than our own pattern list and matcher.
     // Covers steps 28-36.
     UErrorCode status = U_ZERO_ERROR;
-    UDateTimePatternGenerator* generator = udatpg_open(dataLocale.toString(state)->toUTF8StringData().data(), &status);
-    if (U_FAILURE(status)) {
-        ErrorObject::throwBuiltinError(state, ErrorObject::TypeError, "failed to initialize DateTimeFormat");
-        return;
+    ICUObjectCache& cache = state.context()->vmInstance()->icuObjectCache();
+    String* dataLocaleString = dataLocale.toString(state);
+    std::string generatorCacheKey = "datetimepatterngenerator:" + dataLocaleString->toNonGCUTF8StringData();
+    UDateTimePatternGenerator* generator = (UDateTimePatternGenerator*)cache.find(generatorCacheKey);
+    if (!generator) {
+        generator = udatpg_open(dataLocaleString->toUTF8StringData().data(), &status);
+        if (U_FAILURE(status)) {
+            ErrorObject::throwBuiltinError(state, ErrorObject::TypeError, "failed to initialize DateTimeFormat");
+            return;
+        }
+        cache.insert(generatorCacheKey, generator, [](void* object) {
+            udatpg_close((UDateTimePatternGenerator*)object);
+        });
     }
 
     String* skeleton = skeletonBuilder.finalize();
@@ -1828,7 +1854,6 @@ static void initializeDateTimeFormat(ExecutionState& state, Object* dateTimeForm
         patternBuffer.resize(patternLength);
         udatpg_getBestPattern(generator, (UChar*)skeletonUTF16String.data(), skeletonUTF16String.length(), (UChar*)patternBuffer.data(), patternLength, &status);
     }
-    udatpg_close(generator);
     if (U_FAILURE(status)) {
         ErrorObject::throwBuiltinError(state, ErrorObject::TypeError, "failed to initialize DateTimeFormat");
         return;
@@ -1928,9 +1953,26 @@ static void initializeDateTimeFormat(ExecutionState& state, Object* dateTimeForm
     }
 
     status = U_ZERO_ERROR;
-    UTF16StringData timeZoneView = dateTimeFormat->internalSlot()->get(state, ObjectPropertyName(state, String::fromASCII("timeZone"))).value(state, dateTimeFormat->internalSlot()).toString(state)->toUTF16StringData();
-    UTF8StringData localeStringView = r->at(String::fromASCII("locale"))->toUTF8StringData();
-    UDateFormat* icuDateFormat = udat_open(UDAT_IGNORE, UDAT_IGNORE, localeStringView.data(), (UChar*)timeZoneView.data(), timeZoneView.length(), (UChar*)patternBuffer.data(), patternBuffer.length(), &status);
+    String* timeZoneString = dateTimeFormat->internalSlot()->get(state, ObjectPropertyName(state, String::fromASCII("timeZone"))).value(state, dateTimeFormat->internalSlot()).toString(state);
+    String* localeString = r->at(String::fromASCII("locale"));
+    std::string dateFormatCacheKey = "datetimeformat:" + localeString->toNonGCUTF8StringData() + ":" + timeZoneString->toNonGCUTF8StringData() + ":"
+        + utf16StringToUTF8String(patternBuffer.data(), patternBuffer.length()).data();
+    UDateFormat* cachedDateFormat = (UDateFormat*)cache.find(dateFormatCacheKey);
+    if (!cachedDateFormat) {
+        UTF16StringData timeZoneView = timeZoneString->toUTF16StringData();
+        UTF8StringData localeStringView = localeString->toUTF8StringData();
+        cachedDateFormat = udat_open(UDAT_IGNORE, UDAT_IGNORE, localeStringView.data(), (UChar*)timeZoneView.data(), timeZoneView.length(), (UChar*)patternBuffer.data(), patternBuffer.length(), &status);
+        if (U_FAILURE(status)) {
+            ErrorObject::throwBuiltinError(state, ErrorObject::TypeError, "failed to initialize DateTimeFormat");
+            return;
+        }
+        cache.insert(dateFormatCacheKey, cachedDateFormat, [](void* object) {
+            udat_close((UDateFormat*)object);
+        });
+    }
+
+    // each DateTimeFormat owns its clone, so cached one is never closed by finalizer
+    UDateFormat* icuDateFormat = udat_clone(cachedDateFormat, &status);
     if (U_FAILURE(status)) {
         ErrorObject::throwBuiltinError(state, ErrorObject::TypeError, "failed to initialize DateTimeFormat");
         return;
@@ -2367,29 +2409,68 @@ static void initializeNumberFormat(ExecutionState& state, Object* numberFormat,
         }
     }
 
-    UErrorCode status = U_ZERO_ERROR;
-    String* localeOption = numberFormat->internalSlot()->get(state, ObjectPropertyName(state, String::fromASCII("locale"))).value(state, numberFormat->internalSlot()).toString(state);
-    UNumberFormat* unumberFormat = unum_open(style, nullptr, 0, localeOption->toUTF8StringData().data(), nullptr, &status);
-    if (U_FAILURE(status)) {
-        ErrorObject::throwBuiltinError(state, ErrorObject::TypeError, "Failed to init NumberFormat");
-    }
+    Object* internalSlot = numberFormat->internalSlot();
+    auto numberOption = [&](const char* name) -> int32_t {
+        return internalSlot->get(state, ObjectPropertyName(state, String::fromASCII(name))).value(state, internalSlot).toNumber(state);
+    };
 
+    UErrorCode status = U_ZERO_ERROR;
+    String* localeOption = internalSlot->get(state, ObjectPropertyName(state, String::fromASCII("locale"))).value(state, internalSlot).toString(state);
+    String* currencyString = nullptr;
     if (styleOption->equals("currency")) {
-        String* currencyString = numberFormat->internalSlot()->get(state, ObjectPropertyName(state, String::fromASCII("currency"))).value(state, numberFormat->internalSlot()).toString(state);
-        unum_setTextAttribute(unumberFormat, UNUM_CURRENCY_CODE, (UChar*)currencyString->toUTF16StringData().data(), 3, &status);
-    }
-
-    if (!numberFormat->internalSlot()->hasOwnProperty(state, ObjectPropertyName(state, String::fromASCII("minimumSignificantDigits")))) {
-        unum_setAttribute(unumberFormat, UNUM_MIN_INTEGER_DIGITS, numberFormat->internalSlot()->get(state, ObjectPropertyName(state, String::fromASCII("minimumIntegerDigits"))).value(state, numberFormat->internalSlot()).toNumber(state));
-        unum_setAttribute(unumberFormat, UNUM_MIN_FRACTION_DIGITS, numberFormat->internalSlot()->get(state, ObjectPropertyName(state, String::fromASCII("minimumFractionDigits"))).value(state, numberFormat->internalSlot()).toNumber(state));
-        unum_setAttribute(unumberFormat, UNUM_MAX_FRACTION_DIGITS, numberFormat->internalSlot()->get(state, ObjectPropertyName(state, String::fromASCII("maximumFractionDigits"))).value(state, numberFormat->internalSlot()).toNumber(state));
+        currencyString = internalSlot->get(state, ObjectPropertyName(state, String::fromASCII("currency"))).value(state, internalSlot).toString(state);
+    }
+    bool useSignificantDigits = internalSlot->hasOwnProperty(state, ObjectPropertyName(state, String::fromASCII("minimumSignificantDigits")));
+    int32_t digits[3];
+    if (!useSignificantDigits) {
+        digits[0] = numberOption("minimumIntegerDigits");
+        digits[1] = numberOption("minimumFractionDigits");
+        digits[2] = numberOption("maximumFractionDigits");
     } else {
-        unum_setAttribute(unumberFormat, UNUM_SIGNIFICANT_DIGITS_USED, true);
-        unum_setAttribute(unumberFormat, UNUM_MIN_SIGNIFICANT_DIGITS, numberFormat->internalSlot()->get(state, ObjectPropertyName(state, String::fromASCII("minimumSignificantDigits"))).value(state, numberFormat->internalSlot()).toNumber(state));
-        unum_setAttribute(unumberFormat, UNUM_MAX_SIGNIFICANT_DIGITS, numberFormat->internalSlot()->get(state, ObjectPropertyName(state, String::fromASCII("maximumSignificantDigits"))).value(state, numberFormat->internalSlot()).toNumber(state));
+        digits[0] = numberOption("minimumSignificantDigits");
+        digits[1] = numberOption("maximumSignificantDigits");
+        digits[2] = 0;
+    }
+    bool useGrouping = internalSlot->get(state, ObjectPropertyName(state, String::fromASCII("useGrouping"))).value(state, internalSlot).toBoolean(state);
+
+    std::string cacheKey = "numberformat:" + localeOption->toNonGCUTF8StringData() + ":" + std::to_string(style) + ":"
+        + (currencyString ? currencyString->toNonGCUTF8StringData() : "") + (useSignificantDigits ? ":significant:" : ":")
+        + std::to_string(digits[0]) + ":" + std::to_string(digits[1]) + ":" + std::to_string(digits[2]) + (useGrouping ? ":grouping" : ":");
+    ICUObjectCache& cache = state.context()->vmInstance()->icuObjectCache();
+    UNumberFormat* cachedNumberFormat = (UNumberFormat*)cache.find(cacheKey);
+    if (!cachedNumberFormat) {
+        UNumberFormat* unumberFormat = unum_open(style, nullptr, 0, localeOption->toUTF8StringData().data(), nullptr, &status);
+        if (U_FAILURE(status)) {
+            ErrorObject::throwBuiltinError(state, ErrorObject::TypeError, "Failed to init NumberFormat");
+        }
+
+        if (currencyString) {
+            unum_setTextAttribute(unumberFormat, UNUM_CURRENCY_CODE, (UChar*)currencyString->toUTF16StringData().data(), 3, &status);
+        }
+
+        if (!useSignificantDigits) {
+            unum_setAttribute(unumberFormat, UNUM_MIN_INTEGER_DIGITS, digits[0]);
+            unum_setAttribute(unumberFormat, UNUM_MIN_FRACTION_DIGITS, digits[1]);
+            unum_setAttribute(unumberFormat, UNUM_MAX_FRACTION_DIGITS, digits[2]);
+        } else {
+            unum_setAttribute(unumberFormat, UNUM_SIGNIFICANT_DIGITS_USED, true);
+            unum_setAttribute(unumberFormat, UNUM_MIN_SIGNIFICANT_DIGITS, digits[0]);
+            unum_setAttribute(unumberFormat, UNUM_MAX_SIGNIFICANT_DIGITS, digits[1]);
+        }
+        unum_setAttribute(unumberFormat, UNUM_GROUPING_USED, useGrouping);
+        unum_setAttribute(unumberFormat, UNUM_ROUNDING_MODE, UNUM_ROUND_HALFUP);
+        if (U_FAILURE(status)) {
+            unum_close(unumberFormat);
+            ErrorObject::throwBuiltinError(state, ErrorObject::TypeError, "Failed to init NumberFormat");
+        }
+        cache.insert(cacheKey, unumberFormat, [](void* object) {
+            unum_close((UNumberFormat*)object);
+        });
+        cachedNumberFormat = unumberFormat;
     }
-    unum_setAttribute(unumberFormat, UNUM_GROUPING_USED, numberFormat->internalSlot()->get(state, ObjectPropertyName(state, String::fromASCII("useGrouping"))).value(state, numberFormat->internalSlot()).toBoolean(state));
-    unum_setAttribute(unumberFormat, UNUM_ROUNDING_MODE, UNUM_ROUND_HALFUP);
+
+    // each NumberFormat owns its clone, so cached one is never closed by finalizer
+    UNumberFormat* unumberFormat = unum_clone(cachedNumberFormat, &status);
     if (U_FAILURE(status)) {
         ErrorObject::throwBuiltinError(state, ErrorObject::TypeError, "Failed to init NumberFormat");
     }
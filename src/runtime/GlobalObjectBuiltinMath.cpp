@@ -33,6 +33,24 @@ static Value builtinMathAbs(ExecutionState& state, Value thisValue, size_t argc,
     return Value(std::abs(argv[0].toNumber(state)));
 }
 
+static double mathMax(double maxValue, double value)
+{
+    if (std::isnan(value))
+        return std::numeric_limits<double>::quiet_NaN();
+    if (value > maxValue || (!value && !maxValue && !std::signbit(value)))
+        return value;
+    return maxValue;
+}
+
+static double mathMin(double minValue, double value)
+{
+    if (std::isnan(value))
+        return std::numeric_limits<double>::quiet_NaN();
+    if (value < minValue || (!value && !minValue && std::signbit(value)))
+        return value;
+    return minValue;
+}
+
 static Value builtinMathMax(ExecutionState& state, Value thisValue, size_t argc, Value* argv, bool isNewExpression)
 {
     if (argc == 0) {
@@ -42,11 +60,9 @@ static Value builtinMathMax(ExecutionState& state, Value thisValue, size_t argc,
         double maxValue = argv[0].toNumber(state);
         for (unsigned i = 1; i < argc; i++) {
             double value = argv[i].toNumber(state);
-            double qnan = std::numeric_limits<double>::quiet_NaN();
             if (std::isnan(value))
-                return Value(qnan);
-            if (value > maxValue || (!value && !maxValue && !std::signbit(value)))
-                maxValue = value;
+                return Value(std::numeric_limits<double>::quiet_NaN());
+            maxValue = mathMax(maxValue, value);
         }
         return Value(maxValue);
     }
@@ -61,29 +77,31 @@ static Value builtinMathMin(ExecutionState& state, Value thisValue, size_t argc,
         double minValue = argv[0].toNumber(state);
         for (unsigned i = 1; i < argc; i++) {
             double value = argv[i].toNumber(state);
-            double qnan = std::numeric_limits<double>::quiet_NaN();
             if (std::isnan(value))
-                return Value(qnan);
-            if (value < minValue || (!value && !minValue && std::signbit(value)))
-                minValue = value;
+                return Value(std::numeric_limits<double>::quiet_NaN());
+            minValue = mathMin(minValue, value);
         }
         return Value(minValue);
     }
     return Value();
 }
 
-static Value builtinMathRound(ExecutionState& state, Value thisValue, size_t argc, Value* argv, bool isNewExpression)
+static double mathRound(double x)
 {
-    double x = argv[0].toNumber(state);
     if (x == static_cast<int64_t>(x)) {
-        return Value(x);
+        return x;
     }
     if (x == -0.5)
-        return Value(-0.0);
+        return -0.0;
     else if (x > -0.5)
-        return Value(round(x));
+        return round(x);
     else
-        return Value(floor(x + 0.5));
+        return floor(x + 0.5);
+}
+
+static Value builtinMathRound(ExecutionState& state, Value thisValue, size_t argc, Value* argv, bool isNewExpression)
+{
+    return Value(mathRound(argv[0].toNumber(state)));
 }
 
 static Value builtinMathSin(ExecutionState& state, Value thisValue, size_t argc, Value* argv, bool isNewExpression)
@@ -194,14 +212,12 @@ static Value builtinMathSqrt(ExecutionState& state, Value thisValue, size_t argc
     return Value(sqrt(x.toNumber(state)));
 }
 
-static Value builtinMathPow(ExecutionState& state, Value thisValue, size_t argc, Value* argv, bool isNewExpression)
+static double mathPow(double x, double y)
 {
-    double x = argv[0].toNumber(state);
-    double y = argv[1].toNumber(state);
     if (UNLIKELY(std::isnan(y)))
-        return Value(std::numeric_limits<double>::quiet_NaN());
+        return std::numeric_limits<double>::quiet_NaN();
     if (UNLIKELY(std::abs(x) == 1 && std::isinf(y)))
-        return Value(std::numeric_limits<double>::quiet_NaN());
+        return std::numeric_limits<double>::quiet_NaN();
 
     int y_int = static_cast<int>(y);
 
@@ -221,11 +237,11 @@ static Value builtinMathPow(ExecutionState& state, Value thisValue, size_t argc,
                     // given us a finite p. This happens very rarely.
 
                     double result = 1.0 / p;
-                    return (result == 0 && std::isinf(p)) ? Value(pow(x, static_cast<double>(y))) // Avoid pow(double, int).
-                                                          : Value(result);
+                    return (result == 0 && std::isinf(p)) ? pow(x, static_cast<double>(y)) // Avoid pow(double, int).
+                                                          : result;
                 }
 
-                return Value(p);
+                return p;
             }
             m *= m;
         }
@@ -234,22 +250,22 @@ static Value builtinMathPow(ExecutionState& state, Value thisValue, size_t argc,
     if (std::isinf(x)) {
         if (x > 0) {
             if (y > 0) {
-                return Value(std::numeric_limits<double>::infinity());
+                return std::numeric_limits<double>::infinity();
             } else {
-                return Value(0.0);
+                return 0.0;
             }
         } else {
             if (y > 0) {
                 if (y == y_int && y_int % 2) { // odd
-                    return Value(-std::numeric_limits<double>::infinity());
+                    return -std::numeric_limits<double>::infinity();
                 } else {
-                    return Value(std::numeric_limits<double>::infinity());
+                    return std::numeric_limits<double>::infinity();
                 }
             } else {
                 if (y == y_int && y_int % 2) {
-                    return Value(-0.0);
+                    return -0.0;
                 } else {
-                    return Value(0.0);
+                    return 0.0;
                 }
             }
         }
@@ -258,19 +274,26 @@ static Value builtinMathPow(ExecutionState& state, Value thisValue, size_t argc,
     if (1 / x == -std::numeric_limits<double>::infinity()) {
         // y cannot be an odd integer because the case is filtered by "if (y_int == y)" above
         if (y > 0) {
-            return Value(0);
+            return 0.0;
         } else if (y < 0) {
-            return Value(std::numeric_limits<double>::infinity());
+            return std::numeric_limits<double>::infinity();
         }
     }
 
     if (y == 0.5) {
-        return Value(sqrt(x));
+        return sqrt(x);
     } else if (y == -0.5) {
-        return Value(1.0 / sqrt(x));
+        return 1.0 / sqrt(x);
     }
 
-    return Value(pow(x, y));
+    return pow(x, y);
+}
+
+static Value builtinMathPow(ExecutionState& state, Value thisValue, size_t argc, Value* argv, bool isNewExpression)
+{
+    double x = argv[0].toNumber(state);
+    double y = argv[1].toNumber(state);
+    return Value(mathPow(x, y));
 }
 
 static Value builtinMathCbrt(ExecutionState& state, Value thisValue, size_t argc, Value* argv, bool isNewExpression)
@@ -396,6 +419,35 @@ static Value builtinMathExpm1(ExecutionState& state, Value thisValue, size_t arg
     return Value(ieee754::expm1(x));
 }
 
+double runMathIntrinsic(MathIntrinsicKind kind, double x, double y)
+{
+    switch (kind) {
+    case MathAbsIntrinsic:
+        return std::abs(x);
+    case MathCeilIntrinsic:
+        return ceil(x);
+    case MathCosIntrinsic:
+        return ieee754::cos(x);
+    case MathFloorIntrinsic:
+        return floor(x);
+    case MathMaxIntrinsic:
+        return mathMax(x, y);
+    case MathMinIntrinsic:
+        return mathMin(x, y);
+    case MathPowIntrinsic:
+        return mathPow(x, y);
+    case MathRoundIntrinsic:
+        return mathRound(x);
+    case MathSinIntrinsic:
+        return ieee754::sin(x);
+    case MathSqrtIntrinsic:
+        return sqrt(x);
+    default:
+        RELEASE_ASSERT_NOT_REACHED();
+        return 0;
+    }
+}
+
 void GlobalObject::installMath(ExecutionState& state)
 {
     m_math = new Object(state);
@@ -423,8 +475,9 @@ void GlobalObject::installMath(ExecutionState& state)
     m_math->defineOwnPropertyThrowsException(state, strings->SQRT2, ObjectPropertyDescriptor(Value(1.4142135623730951), ObjectPropertyDescriptor::ValuePresent));
 
     // initialize math object: $20.2.2.1 Math.abs()
+    m_mathIntrinsics[MathAbsIntrinsic] = new FunctionObject(state, NativeFunctionInfo(state.context()->staticStrings().abs, builtinMathAbs, 1, nullptr, NativeFunctionInfo::Strict));
     m_math->defineOwnPropertyThrowsException(state, ObjectPropertyName(state.context()->staticStrings().abs),
-                                             ObjectPropertyDescriptor(new FunctionObject(state, NativeFunctionInfo(state.context()->staticStrings().abs, builtinMathAbs, 1, nullptr, NativeFunctionInfo::Strict)), (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
+                                             ObjectPropertyDescriptor(m_mathIntrinsics[MathAbsIntrinsic], (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
     // initialize math object: $20.2.2.2 Math.acos()
     m_math->defineOwnPropertyThrowsException(state, ObjectPropertyName(state.context()->staticStrings().acos),
                                              ObjectPropertyDescriptor(new FunctionObject(state, NativeFunctionInfo(state.context()->staticStrings().acos, builtinMathAcos, 1, nullptr, NativeFunctionInfo::Strict)), (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
@@ -450,14 +503,16 @@ void GlobalObject::installMath(ExecutionState& state)
     m_math->defineOwnPropertyThrowsException(state, ObjectPropertyName(state.context()->staticStrings().cbrt),
                                              ObjectPropertyDescriptor(new FunctionObject(state, NativeFunctionInfo(state.context()->staticStrings().cbrt, builtinMathCbrt, 1, nullptr, NativeFunctionInfo::Strict)), (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
     // initialize math object: $20.2.2.10 Math.ceil()
+    m_mathIntrinsics[MathCeilIntrinsic] = new FunctionObject(state, NativeFunctionInfo(state.context()->staticStrings().ceil, builtinMathCeil, 1, nullptr, NativeFunctionInfo::Strict));
     m_math->defineOwnPropertyThrowsException(state, ObjectPropertyName(state.context()->staticStrings().ceil),
-                                             ObjectPropertyDescriptor(new FunctionObject(state, NativeFunctionInfo(state.context()->staticStrings().ceil, builtinMathCeil, 1, nullptr, NativeFunctionInfo::Strict)), (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
+                                             ObjectPropertyDescriptor(m_mathIntrinsics[MathCeilIntrinsic], (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
     // initialize math object: $20.2.2.11 Math.clz32()
     m_math->defineOwnPropertyThrowsException(state, ObjectPropertyName(state.context()->staticStrings().clz32),
                                              ObjectPropertyDescriptor(new FunctionObject(state, NativeFunctionInfo(state.context()->staticStrings().clz32, builtinMathClz32, 1, nullptr, NativeFunctionInfo::Strict)), (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
     // initialize math object: $20.2.2.12 Math.cos()
+    m_mathIntrinsics[MathCosIntrinsic] = new FunctionObject(state, NativeFunctionInfo(state.context()->staticStrings().cos, builtinMathCos, 1, nullptr, NativeFunctionInfo::Strict));
     m_math->defineOwnPropertyThrowsException(state, ObjectPropertyName(state.context()->staticStrings().cos),
-                                             ObjectPropertyDescriptor(new FunctionObject(state, NativeFunctionInfo(state.context()->staticStrings().cos, builtinMathCos, 1, nullptr, NativeFunctionInfo::Strict)), (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
+                                             ObjectPropertyDescriptor(m_mathIntrinsics[MathCosIntrinsic], (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
     // initialize math object: $20.2.2.13 Math.cosh()
     m_math->defineOwnPropertyThrowsException(state, ObjectPropertyName(state.context()->staticStrings().cosh),
                                              ObjectPropertyDescriptor(new FunctionObject(state, NativeFunctionInfo(state.context()->staticStrings().cosh, builtinMathCosh, 1, nullptr, NativeFunctionInfo::Strict)), (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
@@ -468,8 +523,9 @@ void GlobalObject::installMath(ExecutionState& state)
     m_math->defineOwnPropertyThrowsException(state, ObjectPropertyName(state.context()->staticStrings().expm1),
                                              ObjectPropertyDescriptor(new FunctionObject(state, NativeFunctionInfo(state.context()->staticStrings().expm1, builtinMathExpm1, 1, nullptr, NativeFunctionInfo::Strict)), (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
     // initialize math object: $20.2.2.16 Math.floor()
+    m_mathIntrinsics[MathFloorIntrinsic] = new FunctionObject(state, NativeFunctionInfo(state.context()->staticStrings().floor, builtinMathFloor, 1, nullptr, NativeFunctionInfo::Strict));
     m_math->defineOwnPropertyThrowsException(state, ObjectPropertyName(state.context()->staticStrings().floor),
-                                             ObjectPropertyDescriptor(new FunctionObject(state, NativeFunctionInfo(state.context()->staticStrings().floor, builtinMathFloor, 1, nullptr, NativeFunctionInfo::Strict)), (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
+                                             ObjectPropertyDescriptor(m_mathIntrinsics[MathFloorIntrinsic], (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
     // initialize math object: $20.2.2.17 Math.fround()
     m_math->defineOwnPropertyThrowsException(state, ObjectPropertyName(state.context()->staticStrings().fround),
                                              ObjectPropertyDescriptor(new FunctionObject(state, NativeFunctionInfo(state.context()->staticStrings().fround, builtinMathFround, 1, nullptr, NativeFunctionInfo::Strict)), (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
@@ -493,32 +549,38 @@ void GlobalObject::installMath(ExecutionState& state)
     m_math->defineOwnPropertyThrowsException(state, ObjectPropertyName(state.context()->staticStrings().log2),
                                              ObjectPropertyDescriptor(new FunctionObject(state, NativeFunctionInfo(state.context()->staticStrings().log2, builtinMathLog2, 1, nullptr, NativeFunctionInfo::Strict)), (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
     // initialize math object: $20.2.2.24 Math.max()
+    m_mathIntrinsics[MathMaxIntrinsic] = new FunctionObject(state, NativeFunctionInfo(state.context()->staticStrings().max, builtinMathMax, 2, nullptr, NativeFunctionInfo::Strict));
     m_math->defineOwnPropertyThrowsException(state, ObjectPropertyName(state.context()->staticStrings().max),
-                                             ObjectPropertyDescriptor(new FunctionObject(state, NativeFunctionInfo(state.context()->staticStrings().max, builtinMathMax, 2, nullptr, NativeFunctionInfo::Strict)), (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
+                                             ObjectPropertyDescriptor(m_mathIntrinsics[MathMaxIntrinsic], (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
     // initialize math object: $20.2.2.25 Math.min()
+    m_mathIntrinsics[MathMinIntrinsic] = new FunctionObject(state, NativeFunctionInfo(state.context()->staticStrings().min, builtinMathMin, 2, nullptr, NativeFunctionInfo::Strict));
     m_math->defineOwnPropertyThrowsException(state, ObjectPropertyName(state.context()->staticStrings().min),
-                                             ObjectPropertyDescriptor(new FunctionObject(state, NativeFunctionInfo(state.context()->staticStrings().min, builtinMathMin, 2, nullptr, NativeFunctionInfo::Strict)), (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
+                                             ObjectPropertyDescriptor(m_mathIntrinsics[MathMinIntrinsic], (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
     // initialize math object: $20.2.2.26 Math.pow()
+    m_mathIntrinsics[MathPowIntrinsic] = new FunctionObject(state, NativeFunctionInfo(state.context()->staticStrings().pow, builtinMathPow, 2, nullptr, NativeFunctionInfo::Strict));
     m_math->defineOwnPropertyThrowsException(state, ObjectPropertyName(state.context()->staticStrings().pow),
-                                             ObjectPropertyDescriptor(new FunctionObject(state, NativeFunctionInfo(state.context()->staticStrings().pow, builtinMathPow, 2, nullptr, NativeFunctionInfo::Strict)), (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
+                                             ObjectPropertyDescriptor(m_mathIntrinsics[MathPowIntrinsic], (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
     // initialize math object: $20.2.2.27 Math.random()
     m_math->defineOwnPropertyThrowsException(state, ObjectPropertyName(state.context()->staticStrings().random),
                                              ObjectPropertyDescriptor(new FunctionObject(state, NativeFunctionInfo(state.context()->staticStrings().random, builtinMathRandom, 0, nullptr, NativeFunctionInfo::Strict)), (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
     // initialize math object: $20.2.2.28 Math.round()
+    m_mathIntrinsics[MathRoundIntrinsic] = new FunctionObject(state, NativeFunctionInfo(state.context()->staticStrings().round, builtinMathRound, 1, nullptr, NativeFunctionInfo::Strict));
     m_math->defineOwnPropertyThrowsException(state, ObjectPropertyName(state.context()->staticStrings().round),
-                                             ObjectPropertyDescriptor(new FunctionObject(state, NativeFunctionInfo(state.context()->staticStrings().round, builtinMathRound, 1, nullptr, NativeFunctionInfo::Strict)), (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
+                                             ObjectPropertyDescriptor(m_mathIntrinsics[MathRoundIntrinsic], (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
     // initialize math object: $20.2.2.29 Math.sign()
     m_math->defineOwnPropertyThrowsException(state, ObjectPropertyName(state.context()->staticStrings().sign),
                                              ObjectPropertyDescriptor(new FunctionObject(state, NativeFunctionInfo(state.context()->staticStrings().sign, builtinMathSign, 1, nullptr, NativeFunctionInfo::Strict)), (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
     // initialize math object: $20.2.2.30 Math.sin()
+    m_mathIntrinsics[MathSinIntrinsic] = new FunctionObject(state, NativeFunctionInfo(state.context()->staticStrings().sin, builtinMathSin, 1, nullptr, NativeFunctionInfo::Strict));
     m_math->defineOwnPropertyThrowsException(state, ObjectPropertyName(state.context()->staticStrings().sin),
-                                             ObjectPropertyDescriptor(new FunctionObject(state, NativeFunctionInfo(state.context()->staticStrings().sin, builtinMathSin, 1, nullptr, NativeFunctionInfo::Strict)), (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
+                                             ObjectPropertyDescriptor(m_mathIntrinsics[MathSinIntrinsic], (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
     // initialize math object: $20.2.2.31 Math.sinh()
     m_math->defineOwnPropertyThrowsException(state, ObjectPropertyName(state.context()->staticStrings().sinh),
                                              ObjectPropertyDescriptor(new FunctionObject(state, NativeFunctionInfo(state.context()->staticStrings().sinh, builtinMathSinh, 1, nullptr, NativeFunctionInfo::Strict)), (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
     // initialize math object: $20.2.2.32 Math.sqrt()
+    m_mathIntrinsics[MathSqrtIntrinsic] = new FunctionObject(state, NativeFunctionInfo(state.context()->staticStrings().sqrt, builtinMathSqrt, 1, nullptr, NativeFunctionInfo::Strict));
     m_math->defineOwnPropertyThrowsException(state, ObjectPropertyName(state.context()->staticStrings().sqrt),
-                                             ObjectPropertyDescriptor(new FunctionObject(state, NativeFunctionInfo(state.context()->staticStrings().sqrt, builtinMathSqrt, 1, nullptr, NativeFunctionInfo::Strict)), (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
+                                             ObjectPropertyDescriptor(m_mathIntrinsics[MathSqrtIntrinsic], (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
     // initialize math object: $20.2.2.33 Math.tan()
     m_math->defineOwnPropertyThrowsException(state, ObjectPropertyName(state.context()->staticStrings().tan),
                                              ObjectPropertyDescriptor(new FunctionObject(state, NativeFunctionInfo(state.context()->staticStrings().tan, builtinMathTan, 1, nullptr, NativeFunctionInfo::Strict)), (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
@@ -529,6 +591,12 @@ void GlobalObject::installMath(ExecutionState& state)
     m_math->defineOwnPropertyThrowsException(state, ObjectPropertyName(state.context()->staticStrings().trunc),
                                              ObjectPropertyDescriptor(new FunctionObject(state, NativeFunctionInfo(state.context()->staticStrings().trunc, builtinMathTrunc, 1, nullptr, NativeFunctionInfo::Strict)), (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
 
+    m_mathStructure = m_math->structure();
+#define FIND_MATH_INTRINSIC_INDEX(name, Name, argc) \
+    m_mathIntrinsicIndexes[Math##Name##Intrinsic] = m_mathStructure->findProperty(state, state.context()->staticStrings().name);
+    FOR_EACH_MATH_INTRINSIC(FIND_MATH_INTRINSIC_INDEX)
+#undef FIND_MATH_INTRINSIC_INDEX
+
     defineOwnProperty(state, ObjectPropertyName(state.context()->staticStrings().Math),
                       ObjectPropertyDescriptor(m_math, (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
 }
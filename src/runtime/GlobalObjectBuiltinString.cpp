@@ -151,7 +151,7 @@ static Value builtinStringSubstring(ExecutionState& state, Value thisValue, size
                 return state.context()->staticStrings().asciiTable[c].string();
             }
         }
-        return str->substring(from, to);
+        return str->substring(from, to, &state);
     }
 }
 
@@ -178,7 +178,7 @@ static Value builtinStringSubstr(ExecutionState& state, Value thisValue, size_t
     if (resultLength <= 0)
         return String::emptyString;
 
-    return str->substring(intStart, intStart + resultLength);
+    return str->substring(intStart, intStart + resultLength, &state);
 }
 
 static Value builtinStringMatch(ExecutionState& state, Value thisValue, size_t argc, Value* argv, bool isNewExpression)
@@ -492,7 +492,7 @@ static Value builtinStringSplit(ExecutionState& state, Value thisValue, size_t a
                 if (result.m_matchResults[0][0].m_start >= S->length())
                     break;
 
-                String* T = S->substring(p, result.m_matchResults[0][0].m_start);
+                String* T = S->substring(p, result.m_matchResults[0][0].m_start, &state);
                 A->defineOwnProperty(state, ObjectPropertyName(state, Value(lengthA++)), ObjectPropertyDescriptor(T, ObjectPropertyDescriptor::AllPresent));
                 if (lengthA == lim)
                     return A;
@@ -516,7 +516,7 @@ static Value builtinStringSplit(ExecutionState& state, Value thisValue, size_t a
                     if (q >= S->length())
                         break;
 
-                    String* T = S->substring(p, q);
+                    String* T = S->substring(p, q, &state);
                     A->defineOwnProperty(state, ObjectPropertyName(state, Value(lengthA++)), ObjectPropertyDescriptor(T, ObjectPropertyDescriptor::AllPresent));
                     if (lengthA == lim)
                         return A;
@@ -528,7 +528,7 @@ static Value builtinStringSplit(ExecutionState& state, Value thisValue, size_t a
     }
 
     // 14, 15, 16
-    String* T = S->substring(p, s);
+    String* T = S->substring(p, s, &state);
     A->defineOwnProperty(state, ObjectPropertyName(state, Value(lengthA)), ObjectPropertyDescriptor(T, ObjectPropertyDescriptor::AllPresent));
     return A;
 }
@@ -621,7 +621,7 @@ static Value builtinStringSlice(ExecutionState& state, Value thisValue, size_t a
     int from = (start < 0) ? std::max(len + start, 0.0) : std::min(start, (double)len);
     int to = (end < 0) ? std::max(len + end, 0.0) : std::min(end, (double)len);
     int span = std::max(to - from, 0);
-    return str->substring(from, from + span);
+    return str->substring(from, from + span, &state);
 }
 
 static Value builtinStringToLowerCase(ExecutionState& state, Value thisValue, size_t argc, Value* argv, bool isNewExpression)
@@ -744,7 +744,7 @@ static Value builtinStringTrim(ExecutionState& state, Value thisValue, size_t ar
         if (!esprima::isWhiteSpace((*str)[e]) && !esprima::isLineTerminator((*str)[e]))
             break;
     }
-    return new StringView(str, s, e + 1);
+    return str->substring(s, e + 1, &state);
 }
 
 static Value builtinStringValueOf(ExecutionState& state, Value thisValue, size_t argc, Value* argv, bool isNewExpression)
@@ -1016,11 +1016,13 @@ void GlobalObject::installString(ExecutionState& state)
     m_stringPrototype->defineOwnPropertyThrowsException(state, ObjectPropertyName(strings->split),
                                                         ObjectPropertyDescriptor(new FunctionObject(state, NativeFunctionInfo(strings->split, builtinStringSplit, 2, nullptr, NativeFunctionInfo::Strict)), (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
 
+    m_stringCharCodeAt = new FunctionObject(state, NativeFunctionInfo(strings->charCodeAt, builtinStringCharCodeAt, 1, nullptr, NativeFunctionInfo::Strict));
     m_stringPrototype->defineOwnPropertyThrowsException(state, ObjectPropertyName(strings->charCodeAt),
-                                                        ObjectPropertyDescriptor(new FunctionObject(state, NativeFunctionInfo(strings->charCodeAt, builtinStringCharCodeAt, 1, nullptr, NativeFunctionInfo::Strict)), (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
+                                                        ObjectPropertyDescriptor(m_stringCharCodeAt, (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
 
+    m_stringCharAt = new FunctionObject(state, NativeFunctionInfo(strings->charAt, builtinStringCharAt, 1, nullptr, NativeFunctionInfo::Strict));
     m_stringPrototype->defineOwnPropertyThrowsException(state, ObjectPropertyName(strings->charAt),
-                                                        ObjectPropertyDescriptor(new FunctionObject(state, NativeFunctionInfo(strings->charAt, builtinStringCharAt, 1, nullptr, NativeFunctionInfo::Strict)), (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
+                                                        ObjectPropertyDescriptor(m_stringCharAt, (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
 
     m_stringPrototype->defineOwnPropertyThrowsException(state, ObjectPropertyName(strings->toLowerCase),
                                                         ObjectPropertyDescriptor(new FunctionObject(state, NativeFunctionInfo(strings->toLowerCase, builtinStringToLowerCase, 0, nullptr, NativeFunctionInfo::Strict)), (ObjectPropertyDescriptor::PresentAttribute)(ObjectPropertyDescriptor::WritablePresent | ObjectPropertyDescriptor::ConfigurablePresent)));
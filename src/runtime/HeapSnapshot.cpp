@@ -0,0 +1,524 @@
+/*
+ * Copyright (c) 2018-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#include "Escargot.h"
+#include "HeapSnapshot.h"
+#include "Context.h"
+#include "VMInstance.h"
+#include "ArrayObject.h"
+#include "FunctionObject.h"
+#include "Environment.h"
+#include "EnvironmentRecord.h"
+#include "parser/CodeBlock.h"
+
+#ifndef GC_I_PTRFREE
+#define GC_I_PTRFREE 0
+#endif
+
+namespace Escargot {
+
+// maximum length of string preview in node name
+#define HEAP_SNAPSHOT_STRING_PREVIEW_LENGTH 64
+
+HeapSnapshot::HeapSnapshot(Context* context)
+    : m_context(context)
+    , m_currentNode(0)
+{
+    // walking should see same graph from start to end
+    GC_disable();
+
+    Node root;
+    root.m_base = nullptr;
+    root.m_kind = RootKind;
+    root.m_type = SyntheticNode;
+    root.m_name = stringIndex("");
+    root.m_selfSize = 0;
+    root.m_firstEdge = 0;
+    root.m_edgeCount = 0;
+    m_nodes.push_back(root);
+
+    // nodes are appended while processing, so this loop walks graph in breadth-first order
+    for (size_t i = 0; i < m_nodes.size(); i++) {
+        processNode(i);
+    }
+
+    GC_enable();
+
+    computeRetainedSizes();
+}
+
+size_t HeapSnapshot::stringIndex(const std::string& str)
+{
+    auto iter = m_stringIndex.find(str);
+    if (iter != m_stringIndex.end()) {
+        return iter->second;
+    }
+    size_t idx = m_strings.size();
+    m_strings.push_back(str);
+    m_stringIndex.insert(std::make_pair(str, idx));
+    return idx;
+}
+
+size_t HeapSnapshot::nodeFor(void* base, NodeKind kind, const char* nameHint)
+{
+    auto iter = m_nodeIndex.find(base);
+    if (iter != m_nodeIndex.end()) {
+        Node& node = m_nodes[iter->second];
+        // block found by conservative scan first can be reached with its type later
+        if (node.m_kind == UnknownKind && kind != UnknownKind && iter->second > m_currentNode) {
+            node.m_kind = kind;
+        }
+        return iter->second;
+    }
+
+    Node node;
+    node.m_base = base;
+    node.m_kind = kind;
+    node.m_type = HiddenNode;
+    node.m_name = stringIndex(nameHint ? nameHint : "system / Internal");
+    node.m_selfSize = 0;
+    node.m_firstEdge = 0;
+    node.m_edgeCount = 0;
+    size_t idx = m_nodes.size();
+    m_nodes.push_back(node);
+    m_nodeIndex.insert(std::make_pair(base, idx));
+    return idx;
+}
+
+void HeapSnapshot::addEdge(EdgeType type, size_t nameOrIndex, void* ptr, NodeKind kind, const char* nameHint)
+{
+    void* base = GC_base(ptr);
+    if (!base || m_absorbed.find(base) != m_absorbed.end()) {
+        return;
+    }
+
+    size_t to = nodeFor(base, kind, nameHint);
+    if (to == m_currentNode) {
+        return;
+    }
+    m_currentTargets.insert(to);
+
+    Edge edge;
+    edge.m_type = type;
+    edge.m_nameOrIndex = nameOrIndex;
+    edge.m_to = to;
+    m_edges.push_back(edge);
+}
+
+void HeapSnapshot::addValueEdge(EdgeType type, size_t nameOrIndex, const Value& value)
+{
+    if (value.isPointerValue()) {
+        addEdge(type, nameOrIndex, value.asPointerValue(), PointerValueKind);
+    }
+}
+
+void HeapSnapshot::absorb(size_t node, void* ptr)
+{
+    void* base = GC_base(ptr);
+    if (!base || m_nodeIndex.find(base) != m_nodeIndex.end() || m_absorbed.find(base) != m_absorbed.end()) {
+        return;
+    }
+    m_absorbed.insert(base);
+    m_nodes[node].m_selfSize += GC_size(base);
+}
+
+void HeapSnapshot::scanConservatively(size_t node, void* begin, void* end, NodeKind targetKind)
+{
+    for (void** p = (void**)begin; (void*)(p + 1) <= end; p++) {
+        void* base = GC_base(*p);
+        if (!base || base == m_nodes[node].m_base || m_absorbed.find(base) != m_absorbed.end()) {
+            continue;
+        }
+
+        size_t size;
+        if (GC_get_kind_and_size(base, &size) == GC_I_PTRFREE && m_nodeIndex.find(base) == m_nodeIndex.end()) {
+            // pointer-free block like character buffer belongs to node which found it first
+            m_absorbed.insert(base);
+            m_nodes[node].m_selfSize += size;
+            continue;
+        }
+
+        auto iter = m_nodeIndex.find(base);
+        if (iter != m_nodeIndex.end() && m_currentTargets.find(iter->second) != m_currentTargets.end()) {
+            continue;
+        }
+        addEdge(InternalEdge, m_currentTargets.size(), base, targetKind);
+    }
+}
+
+void HeapSnapshot::processNode(size_t idx)
+{
+    m_currentNode = idx;
+    m_currentTargets.clear();
+    m_nodes[idx].m_firstEdge = m_edges.size();
+
+    void* base = m_nodes[idx].m_base;
+    switch (m_nodes[idx].m_kind) {
+    case RootKind: {
+        size_t index = 0;
+        addEdge(ElementEdge, index++, m_context->globalObject(), PointerValueKind);
+        for (auto iter = m_context->vmInstance()->m_rootSet.begin(); iter != m_context->vmInstance()->m_rootSet.end(); iter++) {
+            addEdge(ElementEdge, index++, iter->first, PointerValueKind);
+        }
+        break;
+    }
+    case PointerValueKind: {
+        PointerValue* pv = (PointerValue*)base;
+        m_nodes[idx].m_selfSize = GC_size(base);
+        if (pv->isObject()) {
+            processObject(idx, pv->asObject());
+        } else if (pv->isString()) {
+            processString(idx, pv->asString());
+        } else if (pv->isSymbol()) {
+            m_nodes[idx].m_type = SymbolNode;
+            String* desc = pv->asSymbol()->description();
+            m_nodes[idx].m_name = stringIndex(desc ? desc->toNonGCUTF8StringData() : "");
+            if (desc) {
+                addEdge(InternalEdge, "description", desc, PointerValueKind);
+            }
+            scanConservatively(idx, base, (char*)base + GC_size(base), UnknownKind);
+        } else {
+            scanConservatively(idx, base, (char*)base + GC_size(base), UnknownKind);
+        }
+        break;
+    }
+    case EnvironmentKind:
+        processEnvironment(idx, (LexicalEnvironment*)base);
+        break;
+    case UnknownKind: {
+        size_t size;
+        int kind = GC_get_kind_and_size(base, &size);
+        m_nodes[idx].m_selfSize = size;
+        if (kind != GC_I_PTRFREE) {
+            scanConservatively(idx, base, (char*)base + size, UnknownKind);
+        }
+        break;
+    }
+    }
+
+    m_nodes[idx].m_edgeCount = m_edges.size() - m_nodes[idx].m_firstEdge;
+}
+
+void HeapSnapshot::processObject(size_t idx, Object* obj)
+{
+    ExecutionState state(m_context);
+
+    if (obj->isFunctionObject()) {
+        FunctionObject* fn = obj->asFunctionObject();
+        AtomicString name = fn->codeBlock()->functionName();
+        m_nodes[idx].m_type = ClosureNode;
+        m_nodes[idx].m_name = stringIndex(name.string()->length() ? name.string()->toNonGCUTF8StringData() : "(anonymous function)");
+    } else {
+        m_nodes[idx].m_type = obj->isRegExpObject() ? RegExpNode : ObjectNode;
+        m_nodes[idx].m_name = stringIndex(obj->internalClassProperty());
+    }
+
+    absorb(idx, obj->m_values.data());
+    addEdge(HiddenEdge, "map", obj->m_structure, UnknownKind, "system / ObjectStructure");
+
+    Object* proto = obj->m_prototype;
+    ObjectRareData* rareData = obj->rareData();
+    if (rareData) {
+        absorb(idx, rareData);
+        proto = rareData->m_prototype;
+        if (rareData->m_internalSlot) {
+            addEdge(InternalEdge, "internalSlot", rareData->m_internalSlot, PointerValueKind);
+        }
+    }
+    if (proto) {
+        addEdge(PropertyEdge, "__proto__", proto, PointerValueKind);
+    }
+
+    ObjectStructure* structure = obj->m_structure;
+    for (size_t i = 0; i < structure->propertyCount(); i++) {
+        const ObjectStructureItem& item = structure->readProperty(state, i);
+        if (item.m_descriptor.isDeletedSlot()) {
+            continue;
+        }
+        std::string name = item.m_propertyName.isPlainString() ? item.m_propertyName.plainString()->toNonGCUTF8StringData() : "<symbol>";
+        Value value = obj->readPlainDataField(i, item.m_descriptor);
+        if (item.m_descriptor.isAccessorProperty() && !item.m_descriptor.isNativeAccessorProperty()) {
+            JSGetterSetter* gs = value.asPointerValue()->asJSGetterSetter();
+            absorb(idx, gs);
+            if (gs->hasGetter()) {
+                addValueEdge(PropertyEdge, stringIndex("get " + name), gs->getter());
+            }
+            if (gs->hasSetter()) {
+                addValueEdge(PropertyEdge, stringIndex("set " + name), gs->setter());
+            }
+        } else {
+            // internal data of native accessor is also a value (e.g. prototype of function)
+            addValueEdge(PropertyEdge, stringIndex(name), value);
+        }
+    }
+
+    if (obj->isArrayObject() && obj->asArrayObject()->isFastModeArray()) {
+        ArrayObject* arr = obj->asArrayObject();
+        absorb(idx, arr->m_fastModeData.data());
+        uint32_t length = arr->getArrayLength(state);
+        for (uint32_t i = 0; i < length; i++) {
+            Value v(arr->m_fastModeData[i]);
+            if (!v.isEmpty()) {
+                addValueEdge(ElementEdge, i, v);
+            }
+        }
+    }
+
+    if (obj->isFunctionObject()) {
+        FunctionObject* fn = obj->asFunctionObject();
+        if (fn->outerEnvironment()) {
+            addEdge(InternalEdge, "context", fn->outerEnvironment(), EnvironmentKind, "system / Context");
+        }
+        addEdge(InternalEdge, "shared", fn->codeBlock(), UnknownKind, "system / CodeBlock");
+    }
+
+    // fields of subclasses
+    void* base = m_nodes[idx].m_base;
+    scanConservatively(idx, (char*)base + sizeof(Object), (char*)base + GC_size(base), UnknownKind);
+}
+
+void HeapSnapshot::processString(size_t idx, String* str)
+{
+    void* base = m_nodes[idx].m_base;
+    if (str->isRopeString()) {
+        // flattening rope string to get preview changes the graph
+        m_nodes[idx].m_type = ConcatenatedStringNode;
+        m_nodes[idx].m_name = stringIndex("(concatenated string)");
+    } else {
+        std::string preview = str->toNonGCUTF8StringData();
+        if (preview.length() > HEAP_SNAPSHOT_STRING_PREVIEW_LENGTH) {
+            size_t len = HEAP_SNAPSHOT_STRING_PREVIEW_LENGTH;
+            // do not cut multi-byte sequence of UTF-8
+            while (len && (preview[len] & 0xC0) == 0x80) {
+                len--;
+            }
+            preview.resize(len);
+            preview += "...";
+        }
+        m_nodes[idx].m_type = StringNode;
+        m_nodes[idx].m_name = stringIndex(preview);
+    }
+
+    // pointers in string are character buffer, children of rope string or source of string view
+    scanConservatively(idx, base, (char*)base + GC_size(base), PointerValueKind);
+}
+
+void HeapSnapshot::processEnvironment(size_t idx, LexicalEnvironment* env)
+{
+    void* base = m_nodes[idx].m_base;
+    m_nodes[idx].m_type = ObjectNode;
+    m_nodes[idx].m_selfSize = GC_size(base);
+
+    if (env->outerEnvironment()) {
+        addEdge(InternalEdge, "previous", env->outerEnvironment(), EnvironmentKind, "system / Context");
+    }
+
+    EnvironmentRecord* record = env->record();
+    absorb(idx, record);
+    if (record->isDeclarativeEnvironmentRecord()) {
+        DeclarativeEnvironmentRecord* declarativeRecord = record->asDeclarativeEnvironmentRecord();
+        if (declarativeRecord->isFunctionEnvironmentRecord()) {
+            FunctionEnvironmentRecord* fnRecord = declarativeRecord->asFunctionEnvironmentRecord();
+            addEdge(InternalEdge, "function", fnRecord->functionObject(), PointerValueKind);
+            if (fnRecord->isFunctionEnvironmentRecordOnHeap()) {
+                const InterpretedCodeBlock::IdentifierInfoVector& infos = fnRecord->functionObject()->codeBlock()->asInterpretedCodeBlock()->identifierInfos();
+                for (size_t i = 0; i < infos.size(); i++) {
+                    if (!infos[i].m_needToAllocateOnStack) {
+                        addValueEdge(ContextEdge, stringIndex(infos[i].m_name.string()->toNonGCUTF8StringData()), fnRecord->getHeapValueByIndex(infos[i].m_indexForIndexedStorage));
+                    }
+                }
+            } else if (fnRecord->isFunctionEnvironmentRecordNotIndexed()) {
+                FunctionEnvironmentRecordNotIndexed* notIndexed = (FunctionEnvironmentRecordNotIndexed*)fnRecord;
+                absorb(idx, notIndexed->m_recordVector.data());
+                absorb(idx, notIndexed->m_heapStorage.data());
+                for (size_t i = 0; i < notIndexed->m_recordVector.size(); i++) {
+                    addValueEdge(ContextEdge, stringIndex(notIndexed->m_recordVector[i].m_name.string()->toNonGCUTF8StringData()), notIndexed->m_heapStorage[i]);
+                }
+            }
+        } else if (declarativeRecord->isDeclarativeEnvironmentRecordNotIndexed()) {
+            DeclarativeEnvironmentRecordNotIndexed* notIndexed = (DeclarativeEnvironmentRecordNotIndexed*)declarativeRecord;
+            absorb(idx, notIndexed->m_recordVector.data());
+            absorb(idx, notIndexed->m_heapStorage.data());
+            for (size_t i = 0; i < notIndexed->m_recordVector.size(); i++) {
+                addValueEdge(ContextEdge, stringIndex(notIndexed->m_recordVector[i].m_name.string()->toNonGCUTF8StringData()), notIndexed->m_heapStorage[i]);
+            }
+        }
+    } else if (record->isObjectEnvironmentRecord()) {
+        addEdge(InternalEdge, "object", record->asObjectEnvironmentRecord()->bindingObject(), PointerValueKind);
+    }
+
+    scanConservatively(idx, base, (char*)base + GC_size(base), UnknownKind);
+    if (GC_base(record) == record) {
+        scanConservatively(idx, record, (char*)record + GC_size(record), UnknownKind);
+    }
+}
+
+void HeapSnapshot::computeRetainedSizes()
+{
+    // dominator tree by "A Simple, Fast Dominance Algorithm" of Cooper, Harvey and Kennedy
+    size_t count = m_nodes.size();
+    std::vector<size_t> postOrder;
+    std::vector<size_t> postOrderIndex(count, SIZE_MAX);
+    postOrder.reserve(count);
+
+    std::vector<bool> visited(count, false);
+    std::vector<std::pair<size_t, size_t>> stack; // node, next edge
+    stack.push_back(std::make_pair(0, 0));
+    visited[0] = true;
+    while (stack.size()) {
+        size_t n = stack.back().first;
+        size_t& e = stack.back().second;
+        if (e < m_nodes[n].m_edgeCount) {
+            size_t to = m_edges[m_nodes[n].m_firstEdge + e].m_to;
+            e++;
+            if (!visited[to]) {
+                visited[to] = true;
+                stack.push_back(std::make_pair(to, 0));
+            }
+        } else {
+            postOrderIndex[n] = postOrder.size();
+            postOrder.push_back(n);
+            stack.pop_back();
+        }
+    }
+
+    std::vector<std::vector<size_t>> predecessors(count);
+    for (size_t n = 0; n < count; n++) {
+        for (size_t e = 0; e < m_nodes[n].m_edgeCount; e++) {
+            predecessors[m_edges[m_nodes[n].m_firstEdge + e].m_to].push_back(n);
+        }
+    }
+
+    std::vector<size_t> dominator(count, SIZE_MAX);
+    dominator[0] = 0;
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        // reverse post order except root
+        for (size_t i = postOrder.size() - 1; i-- > 0;) {
+            size_t n = postOrder[i];
+            size_t newDominator = SIZE_MAX;
+            for (size_t p : predecessors[n]) {
+                if (dominator[p] == SIZE_MAX) {
+                    continue;
+                }
+                if (newDominator == SIZE_MAX) {
+                    newDominator = p;
+                    continue;
+                }
+                size_t a = p, b = newDominator;
+                while (a != b) {
+                    while (postOrderIndex[a] < postOrderIndex[b]) {
+                        a = dominator[a];
+                    }
+                    while (postOrderIndex[b] < postOrderIndex[a]) {
+                        b = dominator[b];
+                    }
+                }
+                newDominator = a;
+            }
+            if (dominator[n] != newDominator) {
+                dominator[n] = newDominator;
+                changed = true;
+            }
+        }
+    }
+
+    // dominator of node is always finished after the node in depth-first search
+    m_retainedSizes.resize(count);
+    for (size_t n = 0; n < count; n++) {
+        m_retainedSizes[n] = m_nodes[n].m_selfSize;
+    }
+    for (size_t i = 0; i + 1 < postOrder.size(); i++) {
+        size_t n = postOrder[i];
+        m_retainedSizes[dominator[n]] += m_retainedSizes[n];
+    }
+}
+
+size_t HeapSnapshot::selfSize(void* ptr)
+{
+    auto iter = m_nodeIndex.find(ptr);
+    if (iter == m_nodeIndex.end()) {
+        return 0;
+    }
+    return m_nodes[iter->second].m_selfSize;
+}
+
+size_t HeapSnapshot::retainedSize(void* ptr)
+{
+    auto iter = m_nodeIndex.find(ptr);
+    if (iter == m_nodeIndex.end()) {
+        return 0;
+    }
+    return m_retainedSizes[iter->second];
+}
+
+static void writeJSONString(FILE* fp, const std::string& str)
+{
+    fputc('"', fp);
+    for (size_t i = 0; i < str.length(); i++) {
+        unsigned char c = str[i];
+        if (c == '"' || c == '\\') {
+            fputc('\\', fp);
+            fputc(c, fp);
+        } else if (c < 0x20) {
+            fprintf(fp, "\\u%04x", c);
+        } else {
+            fputc(c, fp);
+        }
+    }
+    fputc('"', fp);
+}
+
+bool HeapSnapshot::write(FILE* fp)
+{
+    const size_t nodeFieldCount = 6;
+
+    fputs("{\"snapshot\":{\"meta\":{"
+          "\"node_fields\":[\"type\",\"name\",\"id\",\"self_size\",\"edge_count\",\"trace_node_id\"],"
+          "\"node_types\":[[\"hidden\",\"array\",\"string\",\"object\",\"code\",\"closure\",\"regexp\",\"number\",\"native\",\"synthetic\",\"concatenated string\",\"sliced string\",\"symbol\"],"
+          "\"string\",\"number\",\"number\",\"number\",\"number\",\"number\"],"
+          "\"edge_fields\":[\"type\",\"name_or_index\",\"to_node\"],"
+          "\"edge_types\":[[\"context\",\"element\",\"property\",\"internal\",\"hidden\",\"shortcut\",\"weak\"],\"string_or_number\",\"node\"],"
+          "\"trace_function_info_fields\":[],\"trace_node_fields\":[],\"sample_fields\":[],\"location_fields\":[]},",
+          fp);
+    fprintf(fp, "\"node_count\":%zu,\"edge_count\":%zu,\"trace_function_count\":0},\n", m_nodes.size(), m_edges.size());
+
+    fputs("\"nodes\":[", fp);
+    for (size_t i = 0; i < m_nodes.size(); i++) {
+        const Node& n = m_nodes[i];
+        fprintf(fp, "%s%d,%zu,%zu,%zu,%zu,0\n", i ? "," : "", (int)n.m_type, n.m_name, i * 2 + 1, n.m_selfSize, n.m_edgeCount);
+    }
+    fputs("],\n\"edges\":[", fp);
+    for (size_t i = 0; i < m_edges.size(); i++) {
+        const Edge& e = m_edges[i];
+        fprintf(fp, "%s%d,%zu,%zu\n", i ? "," : "", (int)e.m_type, e.m_nameOrIndex, e.m_to * nodeFieldCount);
+    }
+    fputs("],\n\"trace_function_infos\":[],\"trace_tree\":[],\"samples\":[],\"locations\":[],\n\"strings\":[", fp);
+    for (size_t i = 0; i < m_strings.size(); i++) {
+        if (i) {
+            fputs(",\n", fp);
+        }
+        writeJSONString(fp, m_strings[i]);
+    }
+    fputs("]}\n", fp);
+
+    return !ferror(fp);
+}
+}
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2018-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#ifndef __EscargotHeapSnapshot__
+#define __EscargotHeapSnapshot__
+
+namespace Escargot {
+
+class Context;
+class Object;
+class String;
+class LexicalEnvironment;
+class Value;
+
+// Graph of heap blocks reachable from global object of a context and root set of its VMInstance.
+// Objects, strings, symbols and environments are walked with their layout, so edges have property or variable names.
+// Every other block is scanned conservatively like GC marker does, and pointer-free blocks found from
+// a node are counted in size of that node (e.g. character buffer of string).
+// Snapshot keeps only addresses of blocks. It does not keep anything alive and is not updated after it is taken.
+class HeapSnapshot {
+public:
+    explicit HeapSnapshot(Context* context);
+
+    size_t nodeCount() const
+    {
+        return m_nodes.size();
+    }
+
+    size_t edgeCount() const
+    {
+        return m_edges.size();
+    }
+
+    // returns 0 if ptr is not a node of this snapshot
+    size_t selfSize(void* ptr);
+    size_t retainedSize(void* ptr);
+
+    // writes snapshot in format of Chrome devtools (.heapsnapshot)
+    bool write(FILE* fp);
+
+private:
+    // order of node_types in Chrome devtools format
+    enum NodeType {
+        HiddenNode,
+        ArrayNode,
+        StringNode,
+        ObjectNode,
+        CodeNode,
+        ClosureNode,
+        RegExpNode,
+        NumberNode,
+        NativeNode,
+        SyntheticNode,
+        ConcatenatedStringNode,
+        SlicedStringNode,
+        SymbolNode,
+    };
+
+    // order of edge_types in Chrome devtools format
+    enum EdgeType {
+        ContextEdge,
+        ElementEdge,
+        PropertyEdge,
+        InternalEdge,
+        HiddenEdge,
+    };
+
+    enum NodeKind {
+        RootKind,
+        PointerValueKind,
+        EnvironmentKind,
+        UnknownKind,
+    };
+
+    struct Node {
+        void* m_base;
+        NodeKind m_kind;
+        NodeType m_type;
+        size_t m_name;
+        size_t m_selfSize;
+        size_t m_firstEdge;
+        size_t m_edgeCount;
+    };
+
+    struct Edge {
+        EdgeType m_type;
+        size_t m_nameOrIndex; // index of string for every type except ElementEdge
+        size_t m_to;
+    };
+
+    size_t nodeFor(void* base, NodeKind kind, const char* nameHint);
+    size_t stringIndex(const std::string& str);
+
+    void addEdge(EdgeType type, size_t nameOrIndex, void* ptr, NodeKind kind, const char* nameHint = nullptr);
+    void addEdge(EdgeType type, const std::string& name, void* ptr, NodeKind kind, const char* nameHint = nullptr)
+    {
+        addEdge(type, stringIndex(name), ptr, kind, nameHint);
+    }
+    void addValueEdge(EdgeType type, size_t nameOrIndex, const Value& value);
+    void absorb(size_t node, void* ptr);
+    // targetKind is kind of every non pointer-free block found in range
+    void scanConservatively(size_t node, void* begin, void* end, NodeKind targetKind);
+
+    void processNode(size_t node);
+    void processObject(size_t node, Object* obj);
+    void processString(size_t node, String* str);
+    void processEnvironment(size_t node, LexicalEnvironment* env);
+
+    void computeRetainedSizes();
+
+    Context* m_context;
+    std::vector<Node> m_nodes;
+    std::vector<Edge> m_edges;
+    std::vector<std::string> m_strings;
+    std::unordered_map<std::string, size_t> m_stringIndex;
+    std::unordered_map<void*, size_t> m_nodeIndex;
+    // pointer-free or exclusively owned blocks counted in size of other node
+    std::unordered_set<void*> m_absorbed;
+    // targets of edges from node being processed
+    std::unordered_set<size_t> m_currentTargets;
+    size_t m_currentNode;
+    std::vector<size_t> m_retainedSizes;
+};
+}
+
+#endif
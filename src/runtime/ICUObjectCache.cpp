@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2018-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#include "Escargot.h"
+#include "ICUObjectCache.h"
+
+#ifdef ENABLE_ICU
+
+namespace Escargot {
+
+void* ICUObjectCache::find(const std::string& key)
+{
+    for (auto iter = m_entries.begin(); iter != m_entries.end(); iter++) {
+        if (iter->m_key == key) {
+            if (iter != m_entries.begin()) {
+                m_entries.splice(m_entries.begin(), m_entries, iter);
+            }
+            return m_entries.front().m_object;
+        }
+    }
+    return nullptr;
+}
+
+void ICUObjectCache::insert(const std::string& key, void* object, Destroyer destroyer)
+{
+    ASSERT(!find(key));
+    while (m_entries.size() && m_entries.size() >= m_capacity) {
+        Entry& last = m_entries.back();
+        last.m_destroyer(last.m_object);
+        m_entries.pop_back();
+    }
+    m_entries.push_front(Entry({ key, object, destroyer }));
+}
+
+void ICUObjectCache::clear()
+{
+    for (auto iter = m_entries.begin(); iter != m_entries.end(); iter++) {
+        iter->m_destroyer(iter->m_object);
+    }
+    m_entries.clear();
+}
+}
+
+#endif
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2018-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#ifndef __EscargotICUObjectCache__
+#define __EscargotICUObjectCache__
+
+#ifdef ENABLE_ICU
+
+#include <list>
+
+#ifndef ICU_OBJECT_CACHE_SIZE
+#define ICU_OBJECT_CACHE_SIZE 16
+#endif
+
+namespace Escargot {
+
+// opening ICU collator or formatter loads locale data, so opened ones are kept by locale and options.
+// Intl objects clone cached one (cloning shares locale data), and toLocale*String methods use it directly.
+// key should have prefix of object type (ex. "collator:"), so that objects of different types do not collide
+class ICUObjectCache {
+public:
+    typedef void (*Destroyer)(void* object);
+
+    ICUObjectCache()
+        : m_capacity(ICU_OBJECT_CACHE_SIZE)
+    {
+    }
+
+    ~ICUObjectCache()
+    {
+        clear();
+    }
+
+    // returns object of key and makes it most recently used, or nullptr
+    void* find(const std::string& key);
+    // cache owns object. least recently used one is destroyed when cache is full
+    void insert(const std::string& key, void* object, Destroyer destroyer);
+    void clear();
+
+    size_t size() const
+    {
+        return m_entries.size();
+    }
+
+private:
+    struct Entry {
+        std::string m_key;
+        void* m_object;
+        Destroyer m_destroyer;
+    };
+    // most recently used one comes first
+    std::list<Entry> m_entries;
+    size_t m_capacity;
+};
+}
+
+#endif
+
+#endif
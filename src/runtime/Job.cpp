@@ -27,64 +27,67 @@
 
 namespace Escargot {
 
-SandBox::SandBoxResult PromiseReactionJob::run()
+SandBox::SandBoxResult Job::run()
 {
     SandBox sandbox(relatedContext());
     ExecutionState state(relatedContext());
     return sandbox.run([&]() -> Value {
-        /* 25.4.2.1.4 Handler is "Identity" case */
-        if (m_reaction.m_handler == (FunctionObject*)1) {
-            Value value[] = { m_argument };
-            return FunctionObject::call(state, m_reaction.m_capability.m_resolveFunction, Value(), 1, value);
-        }
+        return execute(state);
+    });
+}
+
+Value PromiseReactionJob::runReaction(ExecutionState& state, const PromiseReaction& reaction, const Value& argument)
+{
+    /* 25.4.2.1.4 Handler is "Identity" case */
+    if (reaction.m_handler == (FunctionObject*)1) {
+        Value value[] = { argument };
+        return FunctionObject::call(state, reaction.m_capability.m_resolveFunction, Value(), 1, value);
+    }
 
-        /* 25.4.2.1.5 Handler is "Thrower" case */
-        if (m_reaction.m_handler == (FunctionObject*)2) {
-            Value value[] = { m_argument };
-            return FunctionObject::call(state, m_reaction.m_capability.m_rejectFunction, Value(), 1, value);
-        }
+    /* 25.4.2.1.5 Handler is "Thrower" case */
+    if (reaction.m_handler == (FunctionObject*)2) {
+        Value value[] = { argument };
+        return FunctionObject::call(state, reaction.m_capability.m_rejectFunction, Value(), 1, value);
+    }
 
-        SandBox sb(state.context());
-        auto res = sb.run([&]() -> Value {
-            Value arguments[] = { m_argument };
-            Value res = FunctionObject::call(state, m_reaction.m_handler, Value(), 1, arguments);
-            Value value[] = { res };
-            return FunctionObject::call(state, m_reaction.m_capability.m_resolveFunction, Value(), 1, value);
-        });
-        if (!res.error.isEmpty()) {
-            Value reason[] = { res.error };
-            return FunctionObject::call(state, m_reaction.m_capability.m_rejectFunction, Value(), 1, reason);
-        }
-        return res.result;
-    });
+    // abrupt completion of handler is caught here like try-catch statement,
+    // so reaction does not need a sandbox of its own
+    Value error;
+    try {
+        Value arguments[] = { argument };
+        Value res = FunctionObject::call(state, reaction.m_handler, Value(), 1, arguments);
+        Value value[] = { res };
+        return FunctionObject::call(state, reaction.m_capability.m_resolveFunction, Value(), 1, value);
+    } catch (const Value& err) {
+        state.context()->exceptionCaught(err);
+        error = err;
+    }
+    Value reason[] = { error };
+    return FunctionObject::call(state, reaction.m_capability.m_rejectFunction, Value(), 1, reason);
 }
 
-SandBox::SandBoxResult PromiseResolveThenableJob::run()
+Value PromiseResolveThenableJob::execute(ExecutionState& state)
 {
-    SandBox sandbox(relatedContext());
-    ExecutionState state(relatedContext());
-    return sandbox.run([&]() -> Value {
-        auto strings = &state.context()->staticStrings();
-        PromiseReaction::Capability capability = m_promise->createResolvingFunctions(state);
+    auto strings = &state.context()->staticStrings();
+    PromiseReaction::Capability capability = m_promise->createResolvingFunctions(state);
 
-        SandBox sb(state.context());
-        auto res = sb.run([&]() -> Value {
-            Value arguments[] = { capability.m_resolveFunction, capability.m_rejectFunction };
-            Value thenCallResult = FunctionObject::call(state, m_then, m_thenable, 2, arguments);
-            Value value[] = { thenCallResult };
-            return Value();
-        });
-        if (!res.error.isEmpty()) {
-            Object* alreadyResolved = PromiseObject::resolvingFunctionAlreadyResolved(state, capability.m_resolveFunction);
-            if (alreadyResolved->getOwnProperty(state, strings->value).value(state, alreadyResolved).asBoolean())
-                return Value();
-            alreadyResolved->setThrowsException(state, strings->value, Value(true), alreadyResolved);
+    Value error;
+    try {
+        Value arguments[] = { capability.m_resolveFunction, capability.m_rejectFunction };
+        FunctionObject::call(state, m_then, m_thenable, 2, arguments);
+        return Value();
+    } catch (const Value& err) {
+        state.context()->exceptionCaught(err);
+        error = err;
+    }
 
-            Value reason[] = { res.error };
-            return FunctionObject::call(state, capability.m_rejectFunction, Value(), 1, reason);
-        }
+    Object* alreadyResolved = PromiseObject::resolvingFunctionAlreadyResolved(state, capability.m_resolveFunction);
+    if (alreadyResolved->getOwnProperty(state, strings->value).value(state, alreadyResolved).asBoolean())
         return Value();
-    });
+    alreadyResolved->setThrowsException(state, strings->value, Value(true), alreadyResolved);
+
+    Value reason[] = { error };
+    return FunctionObject::call(state, capability.m_rejectFunction, Value(), 1, reason);
 }
 }
 
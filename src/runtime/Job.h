@@ -51,7 +51,10 @@ public:
         RELEASE_ASSERT_NOT_REACHED();
     }
 
-    virtual SandBox::SandBoxResult run() = 0;
+    SandBox::SandBoxResult run();
+    // run job in sandbox which is already made by caller
+    virtual Value execute(ExecutionState& state) = 0;
+
     Context* relatedContext() const
     {
         return m_relatedContext;
@@ -76,7 +79,13 @@ public:
     {
     }
 
-    SandBox::SandBoxResult run();
+    Value execute(ExecutionState& state)
+    {
+        return runReaction(state, m_reaction, m_argument);
+    }
+
+    // job queue runs reactions which are not wrapped by job object with this
+    static Value runReaction(ExecutionState& state, const PromiseReaction& reaction, const Value& argument);
 
 private:
     PromiseReaction m_reaction;
@@ -93,7 +102,7 @@ public:
     {
     }
 
-    SandBox::SandBoxResult run();
+    Value execute(ExecutionState& state);
 
 private:
     PromiseObject* m_promise;
@@ -38,10 +38,114 @@ size_t DefaultJobQueue::enqueueJob(ExecutionState& state, Job* job)
     if (state.context()->vmInstance()->m_jobQueueListener) {
         state.context()->vmInstance()->m_jobQueueListener(state, job);
     } else {
-        m_jobs.push_back(job);
+        Entry* entry = pushEntry();
+        entry->m_relatedContext = job->relatedContext();
+        entry->m_job = job;
     }
     return 0;
 }
+
+size_t DefaultJobQueue::enqueuePromiseReaction(ExecutionState& state, const PromiseReaction& reaction, const Value& argument)
+{
+    if (state.context()->vmInstance()->m_jobQueueListener) {
+        // listener takes job object
+        return enqueueJob(state, new PromiseReactionJob(state.context(), reaction, argument));
+    }
+
+    Entry* entry = pushEntry();
+    entry->m_relatedContext = state.context();
+    entry->m_job = nullptr;
+    entry->m_reaction = reaction;
+    entry->m_argument = argument;
+    return 0;
+}
+
+DefaultJobQueue::Entry* DefaultJobQueue::pushEntry()
+{
+    if (m_size == m_capacity) {
+        size_t newCapacity = m_capacity ? m_capacity * 2 : 16;
+        Entry* newEntries = (Entry*)GC_MALLOC(sizeof(Entry) * newCapacity);
+        for (size_t i = 0; i < m_size; i++) {
+            newEntries[i] = entryAt(i);
+        }
+        if (m_entries) {
+            GC_FREE(m_entries);
+        }
+        m_entries = newEntries;
+        m_head = 0;
+        m_capacity = newCapacity;
+    }
+    Entry* entry = &m_entries[(m_head + m_size) & (m_capacity - 1)];
+    m_size++;
+    return entry;
+}
+
+void DefaultJobQueue::popEntry(Entry& entry)
+{
+    ASSERT(m_size);
+    Entry& front = m_entries[m_head];
+    entry = front;
+    // don't keep values of finished job alive
+    memset(&front, 0, sizeof(Entry));
+    m_head = (m_head + 1) & (m_capacity - 1);
+    m_size--;
+}
+
+Value DefaultJobQueue::runEntry(ExecutionState& state, Entry& entry)
+{
+    if (entry.m_job) {
+        return entry.m_job->execute(state);
+    }
+    return PromiseReactionJob::runReaction(state, entry.m_reaction, entry.m_argument);
+}
+
+SandBox::SandBoxResult DefaultJobQueue::runNextJob()
+{
+    Entry entry;
+    popEntry(entry);
+    SandBox sandbox(entry.m_relatedContext);
+    ExecutionState state(entry.m_relatedContext);
+    return sandbox.run([&]() -> Value {
+        return runEntry(state, entry);
+    });
+}
+
+SandBox::SandBoxResult DefaultJobQueue::runJobs()
+{
+    ASSERT(hasNextJob());
+    // exception thrown in a job goes to sandbox of its context, so jobs of another context are left to next batch
+    Context* context = entryAt(0).m_relatedContext;
+    SandBox sandbox(context);
+    return sandbox.run([&]() -> Value {
+        Value result;
+        while (hasNextJob() && entryAt(0).m_relatedContext == context) {
+            Entry entry;
+            popEntry(entry);
+            ExecutionState state(entry.m_relatedContext);
+            result = runEntry(state, entry);
+        }
+        return result;
+    });
+}
+
+void DefaultJobQueue::removeJobsRelatedWith(Context* context)
+{
+    size_t size = m_size;
+    size_t newSize = 0;
+    for (size_t i = 0; i < size; i++) {
+        Entry& entry = entryAt(i);
+        if (entry.m_relatedContext != context) {
+            if (newSize != i) {
+                entryAt(newSize) = entry;
+            }
+            newSize++;
+        }
+    }
+    for (size_t i = newSize; i < size; i++) {
+        memset(&entryAt(i), 0, sizeof(Entry));
+    }
+    m_size = newSize;
+}
 }
 
 #endif
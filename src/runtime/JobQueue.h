@@ -35,11 +35,24 @@ public:
     virtual ~JobQueue() {}
     static JobQueue* create();
     virtual size_t enqueueJob(ExecutionState& state, Job* job) = 0;
+    virtual size_t enqueuePromiseReaction(ExecutionState& state, const PromiseReaction& reaction, const Value& argument)
+    {
+        return enqueueJob(state, new PromiseReactionJob(state.context(), reaction, argument));
+    }
 };
 
+// Jobs are stored in a growable ring buffer.
+// Promise reactions are stored in the buffer itself, so they don't need a Job object each
 class DefaultJobQueue : public JobQueue {
 private:
-    DefaultJobQueue() {}
+    DefaultJobQueue()
+        : m_entries(nullptr)
+        , m_head(0)
+        , m_size(0)
+        , m_capacity(0)
+    {
+    }
+
 public:
     static DefaultJobQueue* create()
     {
@@ -47,23 +60,25 @@ public:
     }
 
     size_t enqueueJob(ExecutionState& state, Job* job);
+    size_t enqueuePromiseReaction(ExecutionState& state, const PromiseReaction& reaction, const Value& argument);
+
     bool hasNextJob()
     {
-        return !m_jobs.empty();
+        return m_size != 0;
     }
 
-    Job* nextJob()
+    size_t jobCount()
     {
-        ASSERT(!m_jobs.empty());
-        Job* job = m_jobs.front();
-        m_jobs.pop_front();
-        return job;
+        return m_size;
     }
 
-    std::list<Job*, gc_allocator<Job*>>& impl()
-    {
-        return m_jobs;
-    }
+    // run next job in its own sandbox
+    SandBox::SandBoxResult runNextJob();
+    // run jobs of the same context in one sandbox until queue is empty, next job is related with another context, or a job throws
+    // result is result of last job or error of the job which threw
+    SandBox::SandBoxResult runJobs();
+
+    void removeJobsRelatedWith(Context* context);
 
     static DefaultJobQueue* get(JobQueue* jobQueue)
     {
@@ -71,7 +86,27 @@ public:
     }
 
 private:
-    std::list<Job*, gc_allocator<Job*>> m_jobs;
+    struct Entry {
+        Context* m_relatedContext;
+        Job* m_job; // nullptr if entry is promise reaction
+        PromiseReaction m_reaction;
+        Value m_argument;
+    };
+
+    Entry& entryAt(size_t index)
+    {
+        ASSERT(index < m_size);
+        return m_entries[(m_head + index) & (m_capacity - 1)];
+    }
+
+    Entry* pushEntry();
+    void popEntry(Entry& entry);
+    Value runEntry(ExecutionState& state, Entry& entry);
+
+    Entry* m_entries;
+    size_t m_head;
+    size_t m_size;
+    size_t m_capacity; // power of 2
 };
 }
 #endif // ESCARGOT_ENABLE_PROMISE
@@ -32,6 +32,7 @@ MapObject::MapObject(ExecutionState& state)
 
 void* MapObject::operator new(size_t size)
 {
+    ESCARGOT_PROFILE_ALLOCATION(MapObject, size);
     static bool typeInited = false;
     static GC_descr descr;
     if (!typeInited) {
@@ -156,6 +157,7 @@ MapIteratorObject::MapIteratorObject(ExecutionState& state, MapObject* map, Type
 
 void* MapIteratorObject::operator new(size_t size)
 {
+    ESCARGOT_PROFILE_ALLOCATION(IteratorObject, size);
     static bool typeInited = false;
     static GC_descr descr;
     if (!typeInited) {
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2018-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#ifndef __EscargotMathIntrinsic__
+#define __EscargotMathIntrinsic__
+
+namespace Escargot {
+
+// Math functions which CallMathIntrinsic computes without calling function object
+// when callee is still the original builtin and every argument is number
+// F(name, Name, argumentCount)
+#define FOR_EACH_MATH_INTRINSIC(F) \
+    F(abs, Abs, 1)                 \
+    F(ceil, Ceil, 1)               \
+    F(cos, Cos, 1)                 \
+    F(floor, Floor, 1)             \
+    F(max, Max, 2)                 \
+    F(min, Min, 2)                 \
+    F(pow, Pow, 2)                 \
+    F(round, Round, 1)             \
+    F(sin, Sin, 1)                 \
+    F(sqrt, Sqrt, 1)
+
+enum MathIntrinsicKind : uint8_t {
+#define DECLARE_MATH_INTRINSIC_KIND(name, Name, argc) Math##Name##Intrinsic,
+    FOR_EACH_MATH_INTRINSIC(DECLARE_MATH_INTRINSIC_KIND)
+#undef DECLARE_MATH_INTRINSIC_KIND
+        MathIntrinsicKindCount
+};
+
+// same result with calling builtin function with number arguments. y is ignored by unary functions
+double runMathIntrinsic(MathIntrinsicKind kind, double x, double y);
+}
+
+#endif
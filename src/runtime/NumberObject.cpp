@@ -35,6 +35,7 @@ NumberObject::NumberObject(ExecutionState& state, double value)
 
 void* NumberObject::operator new(size_t size)
 {
+    ESCARGOT_PROFILE_ALLOCATION(NumberObject, size);
     static bool typeInited = false;
     static GC_descr descr;
     if (!typeInited) {
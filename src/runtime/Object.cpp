@@ -81,6 +81,7 @@ ObjectRareData::ObjectRareData(Object* obj)
 
 void* ObjectRareData::operator new(size_t size)
 {
+    ESCARGOT_PROFILE_ALLOCATION(ObjectRareData, size);
     static bool typeInited = false;
     static GC_descr descr;
     if (!typeInited) {
@@ -344,6 +345,26 @@ void Object::initPlainObject(ExecutionState& state)
     m_prototype = state.context()->globalObject()->objectPrototype()->asObject();
 }
 
+void* Object::operator new(size_t size)
+{
+    ESCARGOT_PROFILE_ALLOCATION(Object, size);
+    // subclass which has fields of its own but no operator new is allocated conservatively
+    if (UNLIKELY(size != sizeof(Object))) {
+        return GC_MALLOC(size);
+    }
+    static bool typeInited = false;
+    static GC_descr descr;
+    if (!typeInited) {
+        GC_word obj_bitmap[GC_BITMAP_SIZE(Object)] = { 0 };
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(Object, m_structure));
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(Object, m_prototype));
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(Object, m_values));
+        descr = GC_make_descriptor(obj_bitmap, GC_WORD_LEN(Object));
+        typeInited = true;
+    }
+    return GC_MALLOC_EXPLICITLY_TYPED(size, descr);
+}
+
 Object* Object::createBuiltinObjectPrototype(ExecutionState& state)
 {
     Object* obj = new Object(state, ESCARGOT_OBJECT_BUILTIN_PROPERTY_NUMBER, false);
@@ -400,6 +421,10 @@ void Object::markAsPrototypeObject(ExecutionState& state)
     ensureObjectRareData();
     rareData()->m_isEverSetAsPrototypeObject = true;
 
+    if (UNLIKELY(m_structure->isDictionaryMode())) {
+        escapeDictionaryMode(state);
+    }
+
     if (!state.context()->vmInstance()->didSomePrototypeObjectDefineIndexedProperty()) {
         if (structure()->hasIndexPropertyName()) {
             state.context()->vmInstance()->somePrototypeObjectDefineIndexedProperty(state);
@@ -420,7 +445,7 @@ ObjectGetResult Object::getOwnProperty(ExecutionState& state, const ObjectProper
         const ObjectStructureItem& item = m_structure->readProperty(state, idx);
         if (item.m_descriptor.isDataProperty()) {
             if (LIKELY(!item.m_descriptor.isNativeAccessorProperty())) {
-                return ObjectGetResult(m_values[idx], item.m_descriptor.isWritable(), item.m_descriptor.isEnumerable(), item.m_descriptor.isConfigurable());
+                return ObjectGetResult(readPlainDataField(idx, item.m_descriptor), item.m_descriptor.isWritable(), item.m_descriptor.isEnumerable(), item.m_descriptor.isConfigurable());
             } else {
                 ObjectPropertyNativeGetterSetterData* data = item.m_descriptor.nativeGetterSetterData();
                 return ObjectGetResult(data->m_getter(state, this, m_values[idx]), item.m_descriptor.isWritable(), item.m_descriptor.isEnumerable(), item.m_descriptor.isConfigurable());
@@ -453,15 +478,31 @@ bool Object::defineOwnProperty(ExecutionState& state, const ObjectPropertyName&
             return false;
 
         auto structureBefore = m_structure;
-        m_structure = m_structure->addProperty(state, propertyName, desc.toObjectStructurePropertyDescriptor());
-        ASSERT(structureBefore != m_structure);
+        ObjectStructurePropertyDescriptor structureDesc = desc.toObjectStructurePropertyDescriptor();
+#ifdef ESCARGOT_64
+        if (LIKELY(desc.isDataProperty() && desc.isValuePresent())) {
+            structureDesc = selectFieldRepresentation(structureDesc, desc.value());
+        }
+#endif
+        m_structure = m_structure->addProperty(state, propertyName, structureDesc);
+        ASSERT(structureBefore != m_structure || m_structure->isDictionaryMode());
         if (LIKELY(desc.isDataProperty())) {
+#ifdef ESCARGOT_64
+            if (structureDesc.hasDoubleRepresentation()) {
+                pushBackValue(SmallValue::fromUnboxedDouble(desc.value().asNumber()));
+                return true;
+            }
+#endif
             if (LIKELY(desc.isValuePresent()))
-                m_values.pushBack(desc.value(), m_structure->propertyCount());
+                pushBackValue(desc.value());
             else
-                m_values.pushBack(Value(), m_structure->propertyCount());
+                pushBackValue(Value());
         } else {
-            m_values.pushBack(Value(new JSGetterSetter(desc.getterSetter())), m_structure->propertyCount());
+            pushBackValue(Value(new JSGetterSetter(desc.getterSetter())));
+        }
+
+        if (UNLIKELY(m_structure->isStructureWithFastAccess() && !m_structure->isDictionaryMode())) {
+            convertIntoDictionaryModeIfPossible(state);
         }
 
         // ASSERT(m_values.size() == m_structure->propertyCount());
@@ -487,7 +528,7 @@ bool Object::defineOwnProperty(ExecutionState& state, const ObjectPropertyName&
         if (item.m_descriptor.isNativeAccessorProperty()) {
             v = this->get(state, ObjectPropertyName(state, propertyName)).value(state, this);
         } else {
-            v = m_values[idx];
+            v = readPlainDataField(idx, item.m_descriptor);
         }
         ObjectPropertyDescriptor newDesc = ObjectPropertyDescriptor::fromObjectStructurePropertyDescriptor(item.m_descriptor, v);
 
@@ -635,6 +676,13 @@ bool Object::defineOwnProperty(ExecutionState& state, const ObjectPropertyName&
             auto structureBefore = m_structure;
             if (!structure()->isStructureWithFastAccess())
                 m_structure = structure()->convertToWithFastAccess(state);
+            else if (!structure()->isDictionaryMode())
+                convertIntoDictionaryModeIfPossible(state);
+
+            if (m_structure->m_properties[idx].m_descriptor.hasDoubleRepresentation()) {
+                // new descriptor has tagged representation. value of field is in newDesc
+                m_values[idx] = SmallValue();
+            }
 
             if (newDesc.isDataDescriptor() && m_structure->m_properties[idx].m_descriptor.isNativeAccessorProperty()) {
                 auto newNative = new ObjectPropertyNativeGetterSetterData(newDesc.isWritable(), newDesc.isEnumerable(), newDesc.isConfigurable(),
@@ -644,9 +692,15 @@ bool Object::defineOwnProperty(ExecutionState& state, const ObjectPropertyName&
                 m_structure->m_properties[idx].m_descriptor = newDesc.toObjectStructurePropertyDescriptor();
             }
 
-            m_structure = new ObjectStructureWithFastAccess(state, *((ObjectStructureWithFastAccess*)m_structure));
+            if (m_structure->isDictionaryMode()) {
+                // attributes are changed in place
+                ensureObjectRareData()->m_shouldUpdateEnumerateObjectData = true;
+                ((ObjectStructureWithFastAccess*)m_structure)->m_lookupCountSinceChange = 0;
+            } else {
+                m_structure = new ObjectStructureWithFastAccess(state, *((ObjectStructureWithFastAccess*)m_structure));
+            }
 
-            ASSERT(structureBefore != m_structure);
+            ASSERT(structureBefore != m_structure || m_structure->isDictionaryMode());
             if (newDesc.isDataDescriptor()) {
                 return setOwnDataPropertyUtilForObjectInner(state, idx, m_structure->m_properties[idx], newDesc.value());
             } else {
@@ -675,6 +729,9 @@ void Object::enumeration(ExecutionState& state, bool (*callback)(ExecutionState&
     size_t cnt = m_structure->propertyCount();
     for (size_t i = 0; i < cnt; i++) {
         const ObjectStructureItem& item = m_structure->readProperty(state, i);
+        if (UNLIKELY(item.m_descriptor.isDeletedSlot())) {
+            continue;
+        }
         if (shouldSkipSymbolKey && item.m_propertyName.isSymbol()) {
             continue;
         }
@@ -805,14 +862,111 @@ void Object::throwCannotDeleteError(ExecutionState& state, const PropertyName& P
     ErrorObject::throwBuiltinError(state, ErrorObject::Code::TypeError, P.toExceptionString(), false, String::emptyString, errorMessage_DefineProperty_NotConfigurable);
 }
 
+#ifdef ESCARGOT_64
+void Object::generalizeFieldRepresentation(ExecutionState& state)
+{
+    size_t cnt = m_structure->propertyCount();
+    for (size_t i = 0; i < cnt; i++) {
+        if (m_structure->m_properties[i].m_descriptor.hasDoubleRepresentation()) {
+            double d = m_values[i].asUnboxedDouble();
+            m_values[i] = SmallValue();
+            m_values[i] = Value(d);
+        }
+    }
+    m_structure = m_structure->generalizedStructure(state);
+}
+#endif
+
 void Object::deleteOwnProperty(ExecutionState& state, size_t idx)
 {
+    if (m_structure->isStructureWithFastAccess() && !m_structure->isDictionaryMode()) {
+        convertIntoDictionaryModeIfPossible(state);
+    }
+
+    if (m_structure->isDictionaryMode()) {
+        m_structure->removePropertyInDictionaryMode(idx);
+        m_values[idx] = SmallValue();
+        ObjectStructureWithFastAccess* structure = (ObjectStructureWithFastAccess*)m_structure;
+        if (structure->m_deletedSlotCount * 2 > structure->propertyCount()) {
+            compactDictionaryMode();
+        }
+        // structure is not changed, so for-in should be notified
+        ensureObjectRareData()->m_shouldUpdateEnumerateObjectData = true;
+        return;
+    }
+
     m_structure = m_structure->removeProperty(state, idx);
     m_values.erase(idx, m_structure->propertyCount() + 1);
 
     // ASSERT(m_values.size() == m_structure->propertyCount());
 }
 
+// structure of prototype objects and global object is cached (e.g. prototype chain in inline cache, global variable access),
+// so they are not changed into dictionary mode
+void Object::convertIntoDictionaryModeIfPossible(ExecutionState& state)
+{
+    ASSERT(!m_structure->isDictionaryMode());
+    if (isEverSetAsPrototypeObject() || isGlobalObject()) {
+        return;
+    }
+    m_structure = m_structure->convertToDictionaryMode(state);
+}
+
+void Object::pushBackValueInDictionaryMode(const SmallValue& value)
+{
+    ObjectStructureWithFastAccess* structure = (ObjectStructureWithFastAccess*)m_structure;
+    size_t count = structure->propertyCount();
+    if (count > structure->m_valueCapacity) {
+        size_t newCapacity = std::max(count, structure->m_valueCapacity * 2);
+        m_values.resizeWithUninitializedValues(count - 1, newCapacity);
+        structure->m_valueCapacity = newCapacity;
+    }
+    m_values[count - 1] = value;
+}
+
+// structure made here is not shared, but inline caches can hold it.
+// next change of object turns it into dictionary mode again
+void Object::escapeDictionaryMode(ExecutionState& state)
+{
+    compactDictionaryMode();
+    m_structure = m_structure->escapeDictionaryMode(state);
+}
+
+void Object::noteInlineCacheMissInDictionaryMode(ExecutionState& state)
+{
+    ASSERT(m_structure->isDictionaryMode());
+    ObjectStructureWithFastAccess* structure = (ObjectStructureWithFastAccess*)m_structure;
+    // leaving costs O(property count), so it is paid by as many lookups
+    size_t threshold = std::max(structure->propertyCount(), (size_t)ESCARGOT_OBJECT_DICTIONARY_MODE_ESCAPE_MIN_LOOKUP_COUNT);
+    if (++structure->m_lookupCountSinceChange > threshold) {
+        escapeDictionaryMode(state);
+    }
+}
+
+// remove deleted slots of dictionary mode. indexes of properties are changed
+void Object::compactDictionaryMode()
+{
+    ASSERT(m_structure->isDictionaryMode());
+    ObjectStructureWithFastAccess* structure = (ObjectStructureWithFastAccess*)m_structure;
+    size_t count = structure->propertyCount();
+    size_t newCount = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (!structure->m_properties[i].m_descriptor.isDeletedSlot()) {
+            if (newCount != i) {
+                structure->m_properties[newCount] = structure->m_properties[i];
+                m_values[newCount] = m_values[i];
+            }
+            newCount++;
+        }
+    }
+    structure->m_properties.resizeWithUninitializedValues(newCount);
+    structure->m_properties.shrinkToFit();
+    m_values.resizeWithUninitializedValues(newCount, newCount);
+    structure->m_valueCapacity = newCount;
+    structure->m_deletedSlotCount = 0;
+    structure->buildPropertyNameMap();
+}
+
 uint64_t Object::length(ExecutionState& state)
 {
     // ES6
@@ -1000,7 +1154,7 @@ bool Object::defineNativeDataAccessorProperty(ExecutionState& state, const Objec
     ASSERT(isExtensible());
 
     m_structure = m_structure->addProperty(state, P.toPropertyName(state), ObjectStructurePropertyDescriptor::createDataButHasNativeGetterSetterDescriptor(data));
-    m_values.pushBack(objectInternalData, m_structure->propertyCount());
+    pushBackValue(objectInternalData);
 
     return true;
 }
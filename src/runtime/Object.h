@@ -521,6 +521,7 @@ class Object : public PointerValue {
     friend class VMInstance;
     friend class GlobalObject;
     friend class ByteCodeInterpreter;
+    friend class HeapSnapshot;
     friend struct ObjectRareData;
     static Object* createBuiltinObjectPrototype(ExecutionState& state);
 
@@ -786,6 +787,13 @@ public:
     Object* iterator(ExecutionState& state);
     std::pair<Value, bool> iteratorNext(ExecutionState& state); // http://www.ecma-international.org/ecma-262/7.0/index.html#sec-iteratornext
 
+    // plain objects are allocated with precise layout.
+    // subclass without its own operator new falls back to conservative allocation
+    void* operator new(size_t size);
+    void* operator new[](size_t size) = delete;
+    // keep placement forms of gc (e.g. new (GC)) visible
+    using gc::operator new;
+
 protected:
     Object(ExecutionState& state, size_t defaultSpace, bool initPlainArea);
     void initPlainObject(ExecutionState& state);
@@ -810,16 +818,57 @@ protected:
     }
 
 
+    // read and write plain data field with considering representation of field
+    ALWAYS_INLINE Value readPlainDataField(size_t idx, const ObjectStructurePropertyDescriptor& desc)
+    {
+#ifdef ESCARGOT_64
+        if (desc.hasDoubleRepresentation()) {
+            return Value(m_values[idx].asUnboxedDouble());
+        }
+#endif
+        return m_values[idx];
+    }
+
+    ALWAYS_INLINE void writePlainDataField(ExecutionState& state, size_t idx, const ObjectStructurePropertyDescriptor& desc, const Value& newValue)
+    {
+#ifdef ESCARGOT_64
+        if (desc.hasDoubleRepresentation()) {
+            if (LIKELY(newValue.isNumber())) {
+                m_values[idx].setUnboxedDouble(newValue.asNumber());
+                return;
+            }
+            generalizeFieldRepresentation(state);
+        }
+#endif
+        m_values[idx] = newValue;
+    }
+
+#ifdef ESCARGOT_64
+    // value of new field can be stored unboxed if structure is shared through transition table.
+    // int32 values have unboxed tagged form already, so only they keep tagged representation
+    // and objects with int fields keep sharing structures with each other
+    ALWAYS_INLINE ObjectStructurePropertyDescriptor selectFieldRepresentation(const ObjectStructurePropertyDescriptor& desc, const Value& value)
+    {
+        if (value.isDouble() && desc.isPlainDataProperty() && m_structure->inTransitionMode() && !m_structure->isStructureWithFastAccess()) {
+            return desc.toDoubleRepresentation();
+        }
+        return desc;
+    }
+
+    // box every double field and move to structure with tagged fields
+    void generalizeFieldRepresentation(ExecutionState& state);
+#endif
+
     ALWAYS_INLINE Value uncheckedGetOwnDataProperty(ExecutionState& state, size_t idx)
     {
         ASSERT(m_structure->readProperty(state, idx).m_descriptor.isDataProperty());
-        return m_values[idx];
+        return readPlainDataField(idx, m_structure->readProperty(state, idx).m_descriptor);
     }
 
     ALWAYS_INLINE void uncheckedSetOwnDataProperty(ExecutionState& state, size_t idx, const Value& newValue)
     {
         ASSERT(m_structure->readProperty(state, idx).m_descriptor.isDataProperty());
-        m_values[idx] = newValue;
+        writePlainDataField(state, idx, m_structure->readProperty(state, idx).m_descriptor, newValue);
     }
 
     ALWAYS_INLINE Value getOwnDataPropertyUtilForObject(ExecutionState& state, size_t idx)
@@ -832,7 +881,7 @@ protected:
         ASSERT(m_structure->readProperty(state, idx).m_descriptor.isDataProperty());
         const ObjectStructureItem& item = m_structure->readProperty(state, idx);
         if (LIKELY(item.m_descriptor.isPlainDataProperty())) {
-            return m_values[idx];
+            return readPlainDataField(idx, item.m_descriptor);
         } else {
             return item.m_descriptor.nativeGetterSetterData()->m_getter(state, this, m_values[idx]);
         }
@@ -841,7 +890,7 @@ protected:
     ALWAYS_INLINE bool setOwnDataPropertyUtilForObjectInner(ExecutionState& state, size_t idx, const ObjectStructureItem& item, const Value& newValue)
     {
         if (LIKELY(item.m_descriptor.isPlainDataProperty())) {
-            m_values[idx] = newValue;
+            writePlainDataField(state, idx, item.m_descriptor, newValue);
             return true;
         } else {
             return item.m_descriptor.nativeGetterSetterData()->m_setter(state, this, m_values[idx], newValue);
@@ -864,7 +913,7 @@ protected:
         const ObjectStructureItem& item = m_structure->readProperty(state, idx);
         if (LIKELY(item.m_descriptor.isDataProperty())) {
             if (LIKELY(item.m_descriptor.isPlainDataProperty())) {
-                return m_values[idx];
+                return readPlainDataField(idx, item.m_descriptor);
             } else {
                 return item.m_descriptor.nativeGetterSetterData()->m_getter(state, this, m_values[idx]);
             }
@@ -893,6 +942,24 @@ protected:
 
     void markAsPrototypeObject(ExecutionState& state);
     void deleteOwnProperty(ExecutionState& state, size_t idx);
+
+    // append value of property which is just added to structure
+    ALWAYS_INLINE void pushBackValue(const SmallValue& value)
+    {
+        if (UNLIKELY(m_structure->isDictionaryMode())) {
+            pushBackValueInDictionaryMode(value);
+            return;
+        }
+        m_values.pushBack(value, m_structure->propertyCount());
+    }
+
+    // object in dictionary mode owns its structure and changes it in place
+    void convertIntoDictionaryModeIfPossible(ExecutionState& state);
+    void pushBackValueInDictionaryMode(const SmallValue& value);
+    void compactDictionaryMode();
+    void escapeDictionaryMode(ExecutionState& state);
+    // called on inline cache miss. object which stopped changing gets cacheable structure again
+    void noteInlineCacheMissInDictionaryMode(ExecutionState& state);
 };
 }
 
@@ -22,14 +22,23 @@
 
 namespace Escargot {
 
+#ifndef NDEBUG
+ObjectStructure::Statistics ObjectStructure::s_statistics;
+#endif
+
 void* ObjectStructure::operator new(size_t size)
 {
+    ESCARGOT_PROFILE_ALLOCATION(ObjectStructure, size);
+    ESCARGOT_OBJECT_STRUCTURE_STATISTICS(s_statistics.m_structureCount++);
     static bool typeInited = false;
     static GC_descr descr;
     if (!typeInited) {
         GC_word obj_bitmap[GC_BITMAP_SIZE(ObjectStructure)] = { 0 };
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(ObjectStructure, m_properties));
-        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(ObjectStructure, m_transitionTable));
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(ObjectStructure, m_inlineTransitionItem.m_propertyName));
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(ObjectStructure, m_inlineTransitionItem.m_descriptor));
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(ObjectStructure, m_transitionTableData));
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(ObjectStructure, m_generalizedStructure));
         descr = GC_make_descriptor(obj_bitmap, GC_WORD_LEN(ObjectStructure));
         typeInited = true;
     }
@@ -38,17 +47,68 @@ void* ObjectStructure::operator new(size_t size)
 
 void* ObjectStructureWithFastAccess::operator new(size_t size)
 {
+    ESCARGOT_PROFILE_ALLOCATION(ObjectStructure, size);
+    ESCARGOT_OBJECT_STRUCTURE_STATISTICS(s_statistics.m_structureCount++);
     static bool typeInited = false;
     static GC_descr descr;
     if (!typeInited) {
         const size_t len = GC_BITMAP_SIZE(ObjectStructureWithFastAccess);
         GC_word obj_bitmap[len] = { 0 };
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(ObjectStructureWithFastAccess, m_properties));
-        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(ObjectStructureWithFastAccess, m_transitionTable));
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(ObjectStructureWithFastAccess, m_inlineTransitionItem.m_propertyName));
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(ObjectStructureWithFastAccess, m_inlineTransitionItem.m_descriptor));
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(ObjectStructureWithFastAccess, m_transitionTableData));
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(ObjectStructureWithFastAccess, m_generalizedStructure));
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(ObjectStructureWithFastAccess, m_propertyNameMap));
         descr = GC_make_descriptor(obj_bitmap, GC_WORD_LEN(ObjectStructureWithFastAccess));
         typeInited = true;
     }
     return GC_MALLOC_EXPLICITLY_TYPED(size, descr);
 }
+
+void ObjectStructure::addTransition(const PropertyName& s, const ObjectStructurePropertyDescriptor& desc, ObjectStructure* structure)
+{
+    ASSERT(m_needsTransitionTable);
+    ESCARGOT_OBJECT_STRUCTURE_STATISTICS(s_statistics.m_transitionCount++);
+
+    switch (m_transitionTableMode) {
+    case TransitionTableEmpty:
+        m_inlineTransitionItem = ObjectStructureItem(s, desc);
+        m_transitionTableData = structure;
+        m_transitionTableMode = TransitionTableInline;
+        break;
+    case TransitionTableInline: {
+        ObjectStructureTransitionTableVector* table = new ObjectStructureTransitionTableVector();
+        table->pushBack(ObjectStructureTransitionItem(m_inlineTransitionItem.m_propertyName, m_inlineTransitionItem.m_descriptor, (ObjectStructure*)m_transitionTableData));
+        table->pushBack(ObjectStructureTransitionItem(s, desc, structure));
+        m_inlineTransitionItem = ObjectStructureItem(PropertyName(AtomicString()), ObjectStructurePropertyDescriptor::createDataDescriptor());
+        m_transitionTableData = table;
+        m_transitionTableMode = TransitionTableVector;
+        ESCARGOT_OBJECT_STRUCTURE_STATISTICS(s_statistics.m_vectorTableCount++);
+        break;
+    }
+    case TransitionTableVector: {
+        ObjectStructureTransitionTableVector& vector = transitionTableVector();
+        if (vector.size() < ESCARGOT_OBJECT_STRUCTURE_TRANSITION_MAP_MIN_SIZE) {
+            vector.pushBack(ObjectStructureTransitionItem(s, desc, structure));
+            break;
+        }
+        ObjectStructureTransitionTableMap* table = new (GC) ObjectStructureTransitionTableMap();
+        for (size_t i = 0; i < vector.size(); i++) {
+            table->insert(std::make_pair(ObjectStructureItem(vector[i].m_propertyName, vector[i].m_descriptor), vector[i].m_structure));
+        }
+        table->insert(std::make_pair(ObjectStructureItem(s, desc), structure));
+        m_transitionTableData = table;
+        m_transitionTableMode = TransitionTableHashMap;
+        ESCARGOT_OBJECT_STRUCTURE_STATISTICS(s_statistics.m_hashMapTableCount++);
+        break;
+    }
+    default:
+        ASSERT(m_transitionTableMode == TransitionTableHashMap);
+        transitionTableMap().insert(std::make_pair(ObjectStructureItem(s, desc), structure));
+        break;
+    }
+
+    ESCARGOT_OBJECT_STRUCTURE_STATISTICS(s_statistics.m_maxTransitionFanOut = std::max(s_statistics.m_maxTransitionFanOut, transitionCount()));
+}
 }
@@ -25,6 +25,14 @@
 #include "runtime/PropertyName.h"
 #include "runtime/ObjectStructurePropertyDescriptor.h"
 
+// counters of structures and transition tables are kept only in debug build
+// because they are updated on every transition lookup
+#ifndef NDEBUG
+#define ESCARGOT_OBJECT_STRUCTURE_STATISTICS(...) __VA_ARGS__
+#else
+#define ESCARGOT_OBJECT_STRUCTURE_STATISTICS(...)
+#endif
+
 namespace Escargot {
 
 class ObjectStructure;
@@ -56,7 +64,29 @@ struct ObjectStructureTransitionItem : public gc {
 typedef Vector<ObjectStructureItem, GCUtil::gc_malloc_ignore_off_page_allocator<ObjectStructureItem>> ObjectStructureItemVector;
 typedef Vector<ObjectStructureTransitionItem, GCUtil::gc_malloc_ignore_off_page_allocator<ObjectStructureTransitionItem>> ObjectStructureTransitionTableVector;
 
+struct ObjectStructureTransitionKeyHash {
+    size_t operator()(const ObjectStructureItem& x) const
+    {
+        return x.m_propertyName.hashValue();
+    }
+};
+
+struct ObjectStructureTransitionKeyEqual {
+    bool operator()(const ObjectStructureItem& a, const ObjectStructureItem& b) const
+    {
+        return a.m_descriptor == b.m_descriptor && a.m_propertyName == b.m_propertyName;
+    }
+};
+
+typedef std::unordered_map<ObjectStructureItem, ObjectStructure*, ObjectStructureTransitionKeyHash, ObjectStructureTransitionKeyEqual,
+                           gc_allocator<std::pair<const ObjectStructureItem, ObjectStructure*>>>
+    ObjectStructureTransitionTableMap;
+
 #define ESCARGOT_OBJECT_STRUCTURE_ACCESS_CACHE_BUILD_MIN_SIZE 96
+// object leaves dictionary mode after this many inline cache misses (or its property count if greater) without a change
+#define ESCARGOT_OBJECT_DICTIONARY_MODE_ESCAPE_MIN_LOOKUP_COUNT 64
+// transition table is moved into hash map when it has more transitions than this
+#define ESCARGOT_OBJECT_STRUCTURE_TRANSITION_MAP_MIN_SIZE 8
 
 class ObjectStructure : public gc {
     friend class Object;
@@ -64,20 +94,30 @@ class ObjectStructure : public gc {
 
 public:
     ObjectStructure(ExecutionState&, bool needsTransitionTable = true)
+        : m_inlineTransitionItem(PropertyName(AtomicString()), ObjectStructurePropertyDescriptor::createDataDescriptor())
     {
         m_needsTransitionTable = needsTransitionTable;
         m_isProtectedByTransitionTable = false;
         m_hasIndexPropertyName = false;
         m_isStructureWithFastAccess = false;
+        m_isDictionaryMode = false;
+        m_transitionTableMode = TransitionTableEmpty;
+        m_transitionTableData = nullptr;
+        m_generalizedStructure = nullptr;
     }
 
     ObjectStructure(ExecutionState&, ObjectStructureItemVector&& properties, bool needsTransitionTable, bool hasIndexPropertyName)
         : m_properties(std::move(properties))
+        , m_inlineTransitionItem(PropertyName(AtomicString()), ObjectStructurePropertyDescriptor::createDataDescriptor())
     {
         m_needsTransitionTable = needsTransitionTable;
         m_isProtectedByTransitionTable = false;
         m_hasIndexPropertyName = hasIndexPropertyName;
         m_isStructureWithFastAccess = false;
+        m_isDictionaryMode = false;
+        m_transitionTableMode = TransitionTableEmpty;
+        m_transitionTableData = nullptr;
+        m_generalizedStructure = nullptr;
     }
 
     size_t findProperty(ExecutionState& state, String* propertyName)
@@ -126,6 +166,15 @@ public:
     ObjectStructure* removeProperty(ExecutionState& state, size_t pIndex);
     ObjectStructure* escapeTransitionMode(ExecutionState& state);
     ObjectStructure* convertToWithFastAccess(ExecutionState& state);
+    // returns structure in dictionary mode which is owned by one object
+    ObjectStructure* convertToDictionaryMode(ExecutionState& state);
+    // returns structure which is not in dictionary mode. deleted slots should be compacted before
+    ObjectStructure* escapeDictionaryMode(ExecutionState& state);
+    void removePropertyInDictionaryMode(size_t pIndex);
+#ifdef ESCARGOT_64
+    // returns structure which has same properties but every field has tagged representation
+    ObjectStructure* generalizedStructure(ExecutionState& state);
+#endif
 
     bool inTransitionMode()
     {
@@ -142,6 +191,13 @@ public:
         return m_isStructureWithFastAccess;
     }
 
+    // structure in dictionary mode is changed in place instead of making new structure,
+    // so it should not be cached by inline caches. it may have deleted slots (see isDeletedSlot)
+    bool isDictionaryMode()
+    {
+        return m_isDictionaryMode;
+    }
+
     bool isProtectedByTransitionTable()
     {
         return m_isProtectedByTransitionTable;
@@ -152,28 +208,119 @@ public:
         return m_properties.size();
     }
 
+    size_t transitionCount()
+    {
+        switch (m_transitionTableMode) {
+        case TransitionTableInline:
+            return 1;
+        case TransitionTableVector:
+            return transitionTableVector().size();
+        case TransitionTableHashMap:
+            return transitionTableMap().size();
+        default:
+            return 0;
+        }
+    }
+
+#ifndef NDEBUG
+    // accumulated since process started
+    struct Statistics {
+        size_t m_structureCount;
+        size_t m_transitionCount;
+        size_t m_vectorTableCount; // tables grown over one transition
+        size_t m_hashMapTableCount; // tables moved into hash map
+        size_t m_maxTransitionFanOut;
+        size_t m_transitionLookupCount;
+        size_t m_transitionLookupDepth; // sum of entries compared by lookups
+    };
+
+    static const Statistics& statistics()
+    {
+        return s_statistics;
+    }
+#endif
+
     void* operator new(size_t size);
     void* operator new[](size_t size) = delete;
 
 protected:
+    // most of structures have zero or one transition, so single transition is kept in structure itself.
+    // a few transitions are searched linearly and table is moved into hash map when fan-out grows
+    enum TransitionTableMode : uint8_t {
+        TransitionTableEmpty,
+        TransitionTableInline, // m_inlineTransitionItem -> (ObjectStructure*)m_transitionTableData
+        TransitionTableVector, // (ObjectStructureTransitionTableVector*)m_transitionTableData
+        TransitionTableHashMap, // (ObjectStructureTransitionTableMap*)m_transitionTableData
+    };
+
+#ifndef NDEBUG
+    static Statistics s_statistics;
+#endif
+
     bool m_isProtectedByTransitionTable;
     bool m_needsTransitionTable;
     bool m_hasIndexPropertyName;
     bool m_isStructureWithFastAccess;
+    bool m_isDictionaryMode;
+    uint8_t m_transitionTableMode;
     ObjectStructureItemVector m_properties;
-    ObjectStructureTransitionTableVector m_transitionTable;
+    ObjectStructureItem m_inlineTransitionItem;
+    void* m_transitionTableData;
+    // cache of generalizedStructure()
+    ObjectStructure* m_generalizedStructure;
 
-    size_t searchTransitionTable(const PropertyName& s, const ObjectStructurePropertyDescriptor& desc)
+    ObjectStructureTransitionTableVector& transitionTableVector()
+    {
+        ASSERT(m_transitionTableMode == TransitionTableVector);
+        return *(ObjectStructureTransitionTableVector*)m_transitionTableData;
+    }
+
+    ObjectStructureTransitionTableMap& transitionTableMap()
+    {
+        ASSERT(m_transitionTableMode == TransitionTableHashMap);
+        return *(ObjectStructureTransitionTableMap*)m_transitionTableData;
+    }
+
+    ObjectStructure* searchTransitionTable(const PropertyName& s, const ObjectStructurePropertyDescriptor& desc)
     {
         ASSERT(m_needsTransitionTable);
-        for (size_t i = 0; i < m_transitionTable.size(); i++) {
-            if (m_transitionTable[i].m_descriptor == desc && m_transitionTable[i].m_propertyName == s) {
-                return i;
+        ESCARGOT_OBJECT_STRUCTURE_STATISTICS(s_statistics.m_transitionLookupCount++);
+        switch (m_transitionTableMode) {
+        case TransitionTableInline:
+            ESCARGOT_OBJECT_STRUCTURE_STATISTICS(s_statistics.m_transitionLookupDepth++);
+            if (m_inlineTransitionItem.m_descriptor == desc && m_inlineTransitionItem.m_propertyName == s) {
+                return (ObjectStructure*)m_transitionTableData;
             }
+            return nullptr;
+        case TransitionTableVector: {
+            ObjectStructureTransitionTableVector& table = transitionTableVector();
+            size_t siz = table.size();
+            for (size_t i = 0; i < siz; i++) {
+                if (table[i].m_descriptor == desc && table[i].m_propertyName == s) {
+                    ESCARGOT_OBJECT_STRUCTURE_STATISTICS(s_statistics.m_transitionLookupDepth += i + 1);
+                    return table[i].m_structure;
+                }
+            }
+            ESCARGOT_OBJECT_STRUCTURE_STATISTICS(s_statistics.m_transitionLookupDepth += siz);
+            return nullptr;
+        }
+        case TransitionTableHashMap: {
+            ESCARGOT_OBJECT_STRUCTURE_STATISTICS(s_statistics.m_transitionLookupDepth++);
+            ObjectStructureTransitionTableMap& table = transitionTableMap();
+            auto iter = table.find(ObjectStructureItem(s, desc));
+            if (iter == table.end()) {
+                return nullptr;
+            }
+            return iter->second;
+        }
+        default:
+            ASSERT(m_transitionTableMode == TransitionTableEmpty);
+            return nullptr;
         }
-        return SIZE_MAX;
     }
 
+    void addTransition(const PropertyName& s, const ObjectStructurePropertyDescriptor& desc, ObjectStructure* structure);
+
     size_t findPropertyWithMap(const PropertyName& s)
     {
         const PropertyNameMap& map = propertyNameMap();
@@ -196,6 +343,9 @@ public:
     ObjectStructureWithFastAccess(ExecutionState& state)
         : ObjectStructure(state, false)
         , m_propertyNameMap(new (GC) PropertyNameMap())
+        , m_deletedSlotCount(0)
+        , m_lookupCountSinceChange(0)
+        , m_valueCapacity(0)
     {
         m_isStructureWithFastAccess = true;
         buildPropertyNameMap();
@@ -204,6 +354,9 @@ public:
     ObjectStructureWithFastAccess(ExecutionState& state, ObjectStructureItemVector&& properties, bool hasIndexPropertyName)
         : ObjectStructure(state, std::move(properties), false, hasIndexPropertyName)
         , m_propertyNameMap(new (GC) PropertyNameMap())
+        , m_deletedSlotCount(0)
+        , m_lookupCountSinceChange(0)
+        , m_valueCapacity(0)
     {
         m_isStructureWithFastAccess = true;
         buildPropertyNameMap();
@@ -212,7 +365,11 @@ public:
     ObjectStructureWithFastAccess(ExecutionState& state, ObjectStructureWithFastAccess& old)
         : ObjectStructure(state, std::move(old.m_properties), old.m_needsTransitionTable, old.m_hasIndexPropertyName)
         , m_propertyNameMap(old.m_propertyNameMap)
+        , m_deletedSlotCount(0)
+        , m_lookupCountSinceChange(0)
+        , m_valueCapacity(0)
     {
+        ASSERT(!old.m_isDictionaryMode);
         m_isStructureWithFastAccess = true;
         old.m_propertyNameMap = nullptr;
     }
@@ -230,6 +387,10 @@ public:
     void* operator new[](size_t size) = delete;
 
     PropertyNameMap* m_propertyNameMap;
+    // for dictionary mode
+    size_t m_deletedSlotCount;
+    size_t m_lookupCountSinceChange; // inline cache misses since structure was changed last
+    size_t m_valueCapacity; // allocated size of Object::m_values
 };
 
 inline PropertyNameMap& ObjectStructure::propertyNameMap()
@@ -247,18 +408,22 @@ inline ObjectStructure* ObjectStructure::addProperty(ExecutionState& state, cons
         m_properties.pushBack(newItem);
         m_hasIndexPropertyName = m_hasIndexPropertyName | nameIsIndexString;
         propertyNameMap().insert(std::make_pair(name, m_properties.size() - 1));
+        if (m_isDictionaryMode) {
+            ((ObjectStructureWithFastAccess*)this)->m_lookupCountSinceChange = 0;
+            return this;
+        }
         ObjectStructureWithFastAccess* self = (ObjectStructureWithFastAccess*)this;
         ObjectStructureWithFastAccess* newSelf = new ObjectStructureWithFastAccess(state, *self);
         return newSelf;
     }
 
     if (m_needsTransitionTable) {
-        size_t r = searchTransitionTable(name, desc);
-        if (r != SIZE_MAX) {
-            return m_transitionTable[r].m_structure;
+        ObjectStructure* r = searchTransitionTable(name, desc);
+        if (r) {
+            return r;
         }
     } else {
-        ASSERT(m_transitionTable.size() == 0);
+        ASSERT(m_transitionTableMode == TransitionTableEmpty);
     }
 
     ObjectStructureItemVector newProperties(m_properties, newItem);
@@ -270,9 +435,8 @@ inline ObjectStructure* ObjectStructure::addProperty(ExecutionState& state, cons
         newObjectStructure = new ObjectStructure(state, std::move(newProperties), m_needsTransitionTable, m_hasIndexPropertyName | nameIsIndexString);
 
     if (m_needsTransitionTable && !newObjectStructure->isStructureWithFastAccess()) {
-        ObjectStructureTransitionItem newTransitionItem(name, desc, newObjectStructure);
         newObjectStructure->m_isProtectedByTransitionTable = true;
-        m_transitionTable.pushBack(newTransitionItem);
+        addTransition(name, desc, newObjectStructure);
     }
 
     return newObjectStructure;
@@ -280,6 +444,7 @@ inline ObjectStructure* ObjectStructure::addProperty(ExecutionState& state, cons
 
 inline ObjectStructure* ObjectStructure::removeProperty(ExecutionState& state, size_t pIndex)
 {
+    ASSERT(!m_isDictionaryMode);
     if (m_isStructureWithFastAccess) {
         m_properties.erase(pIndex);
         propertyNameMap().clear();
@@ -323,6 +488,73 @@ inline ObjectStructure* ObjectStructure::convertToWithFastAccess(ExecutionState&
     ObjectStructureItemVector v = m_properties;
     return new ObjectStructureWithFastAccess(state, std::move(v), m_hasIndexPropertyName);
 }
+
+inline ObjectStructure* ObjectStructure::convertToDictionaryMode(ExecutionState& state)
+{
+    ASSERT(!m_isDictionaryMode);
+    ObjectStructureWithFastAccess* newSelf;
+    if (m_isStructureWithFastAccess) {
+        // fast access structure is owned by one object. new structure is made so inline caches don't hit
+        newSelf = new ObjectStructureWithFastAccess(state, *((ObjectStructureWithFastAccess*)this));
+    } else {
+        ObjectStructureItemVector v = m_properties;
+        newSelf = new ObjectStructureWithFastAccess(state, std::move(v), m_hasIndexPropertyName);
+    }
+    newSelf->m_isDictionaryMode = true;
+    newSelf->m_valueCapacity = newSelf->m_properties.size();
+    return newSelf;
+}
+
+inline ObjectStructure* ObjectStructure::escapeDictionaryMode(ExecutionState& state)
+{
+    ASSERT(m_isDictionaryMode);
+    ObjectStructureWithFastAccess* self = (ObjectStructureWithFastAccess*)this;
+    ASSERT(self->m_deletedSlotCount == 0);
+    ObjectStructureWithFastAccess* newSelf = new ObjectStructureWithFastAccess(state, std::move(m_properties), m_hasIndexPropertyName);
+    self->m_propertyNameMap = nullptr;
+    return newSelf;
+}
+
+inline void ObjectStructure::removePropertyInDictionaryMode(size_t pIndex)
+{
+    ASSERT(m_isDictionaryMode);
+    ObjectStructureWithFastAccess* self = (ObjectStructureWithFastAccess*)this;
+    propertyNameMap().erase(m_properties[pIndex].m_propertyName);
+    m_properties[pIndex].m_descriptor = ObjectStructurePropertyDescriptor::createDeletedSlotDescriptor();
+    self->m_deletedSlotCount++;
+    self->m_lookupCountSinceChange = 0;
+}
+
+#ifdef ESCARGOT_64
+inline ObjectStructure* ObjectStructure::generalizedStructure(ExecutionState& state)
+{
+    if (m_isDictionaryMode) {
+        // dictionary mode structure is always changed in place
+        for (size_t i = 0; i < m_properties.size(); i++) {
+            m_properties[i].m_descriptor = m_properties[i].m_descriptor.toTaggedRepresentation();
+        }
+        ((ObjectStructureWithFastAccess*)this)->m_lookupCountSinceChange = 0;
+        return this;
+    }
+
+    ObjectStructureItemVector newProperties(m_properties);
+    for (size_t i = 0; i < newProperties.size(); i++) {
+        newProperties[i].m_descriptor = newProperties[i].m_descriptor.toTaggedRepresentation();
+    }
+
+    if (m_isStructureWithFastAccess) {
+        // structure with fast access is owned by only one object, so there is nothing to share
+        return new ObjectStructureWithFastAccess(state, std::move(newProperties), m_hasIndexPropertyName);
+    }
+
+    if (!m_generalizedStructure) {
+        m_generalizedStructure = new ObjectStructure(state, std::move(newProperties), m_needsTransitionTable, m_hasIndexPropertyName);
+        // generalized structure is reachable from this structure
+        m_generalizedStructure->m_isProtectedByTransitionTable = m_isProtectedByTransitionTable;
+    }
+    return m_generalizedStructure;
+}
+#endif
 }
 
 namespace std {
@@ -83,6 +83,20 @@ public:
         return ObjectStructurePropertyDescriptor(nativeGetterSetterData);
     }
 
+    // marks slot of deleted property in dictionary mode structure.
+    // accessor descriptor has writable flag only with JS setter, so this is not a descriptor of any property
+    static ObjectStructurePropertyDescriptor createDeletedSlotDescriptor()
+    {
+        ObjectStructurePropertyDescriptor ret(NotPresent, HasJSGetterSetter);
+        ret.m_descriptorData.m_data |= 2;
+        return ret;
+    }
+
+    bool isDeletedSlot() const
+    {
+        return m_descriptorData.m_data == (1 | 2 | 64);
+    }
+
     bool isPlainDataWritableEnumerableConfigurable() const
     {
         return isPlainDataProperty() && m_descriptorData.presentAttributes() == AllPresent;
@@ -136,6 +150,37 @@ public:
         return m_descriptorData.mode() == HasDataButHasNativeGetterSetter;
     }
 
+#ifdef ESCARGOT_64
+    // plain data property whose value is always a number can be stored as raw double in Object::m_values.
+    // representation is a part of descriptor so transition table gives different structure for each representation
+    bool hasDoubleRepresentation() const
+    {
+        return (m_descriptorData.m_data & (1 | 128)) == (1 | 128);
+    }
+
+    ObjectStructurePropertyDescriptor toDoubleRepresentation() const
+    {
+        ASSERT(isPlainDataProperty());
+        ObjectStructurePropertyDescriptor ret(*this);
+        ret.m_descriptorData.m_data |= 128;
+        return ret;
+    }
+
+    ObjectStructurePropertyDescriptor toTaggedRepresentation() const
+    {
+        ObjectStructurePropertyDescriptor ret(*this);
+        if (hasDoubleRepresentation()) {
+            ret.m_descriptorData.m_data &= ~(size_t)128;
+        }
+        return ret;
+    }
+#else
+    bool hasDoubleRepresentation() const
+    {
+        return false;
+    }
+#endif
+
     bool operator==(const ObjectStructurePropertyDescriptor& desc) const
     {
         return m_descriptorData.m_data == desc.m_descriptorData.m_data;
@@ -174,6 +219,7 @@ protected:
             m_data |= (attribute & PresentAttribute::HasJSGetter) ? 16 : 0; // 16
             m_data |= (attribute & PresentAttribute::HasJSSetter) ? 32 : 0; // 32
             m_data |= (mode) ? 64 : 0; // 64
+            // 128 is used for double representation
             ASSERT(mode < 2);
         }
 
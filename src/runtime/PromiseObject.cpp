@@ -34,6 +34,7 @@ PromiseObject::PromiseObject(ExecutionState& state)
 
 void* PromiseObject::operator new(size_t size)
 {
+    ESCARGOT_PROFILE_ALLOCATION(PromiseObject, size);
     static bool typeInited = false;
     static GC_descr descr;
     if (!typeInited) {
@@ -132,7 +133,7 @@ void PromiseObject::rejectPromise(ExecutionState& state, Value reason)
 void PromiseObject::triggerPromiseReactions(ExecutionState& state, PromiseObject::Reactions& reactions)
 {
     for (size_t i = 0; i < reactions.size(); i++)
-        state.context()->jobQueue()->enqueueJob(state, new PromiseReactionJob(state.context(), reactions[i], m_promiseResult));
+        state.context()->jobQueue()->enqueuePromiseReaction(state, reactions[i], m_promiseResult);
 }
 }
 
@@ -34,6 +34,7 @@ ProxyObject::ProxyObject(ExecutionState& state)
 
 void* ProxyObject::operator new(size_t size)
 {
+    ESCARGOT_PROFILE_ALLOCATION(ProxyObject, size);
     static GC_descr descr;
 
     return GC_MALLOC_EXPLICITLY_TYPED(size, descr);
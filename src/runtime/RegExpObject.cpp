@@ -54,6 +54,7 @@ void RegExpObject::initRegExpObject(ExecutionState& state)
 
 void* RegExpObject::operator new(size_t size)
 {
+    ESCARGOT_PROFILE_ALLOCATION(RegExpObject, size);
     static bool typeInited = false;
     static GC_descr descr;
     if (!typeInited) {
@@ -415,7 +416,7 @@ ArrayObject* RegExpObject::createMatchedArray(ExecutionState& state, String* str
     size_t len = result.m_matchResults.size();
     ret->setThrowsException(state, state.context()->staticStrings().length, Value(len), ret);
     for (size_t idx = 0; idx < len; idx++) {
-        ret->defineOwnProperty(state, ObjectPropertyName(state, Value(idx)), ObjectPropertyDescriptor(Value(new StringView(str, result.m_matchResults[idx][0].m_start, result.m_matchResults[idx][0].m_end)), ObjectPropertyDescriptor::AllPresent));
+        ret->defineOwnProperty(state, ObjectPropertyName(state, Value(idx)), ObjectPropertyDescriptor(Value(str->substring(result.m_matchResults[idx][0].m_start, result.m_matchResults[idx][0].m_end, &state)), ObjectPropertyDescriptor::AllPresent));
     }
     return ret;
 }
@@ -433,7 +434,7 @@ ArrayObject* RegExpObject::createRegExpMatchedArray(ExecutionState& state, const
             if (result.m_matchResults[i][j].m_start == std::numeric_limits<unsigned>::max()) {
                 arr->defineOwnPropertyThrowsException(state, ObjectPropertyName(state, Value(idx++)), ObjectPropertyDescriptor(Value(), ObjectPropertyDescriptor::AllPresent));
             } else {
-                arr->defineOwnPropertyThrowsException(state, ObjectPropertyName(state, Value(idx++)), ObjectPropertyDescriptor(Value(new StringView(input, result.m_matchResults[i][j].m_start, result.m_matchResults[i][j].m_end)), ObjectPropertyDescriptor::AllPresent));
+                arr->defineOwnPropertyThrowsException(state, ObjectPropertyName(state, Value(idx++)), ObjectPropertyDescriptor(Value(input->substring(result.m_matchResults[i][j].m_start, result.m_matchResults[i][j].m_end, &state)), ObjectPropertyDescriptor::AllPresent));
             }
         }
     }
@@ -450,7 +451,7 @@ void RegExpObject::pushBackToRegExpMatchedArray(ExecutionState& state, ArrayObje
             if (std::numeric_limits<unsigned>::max() == result.m_matchResults[i][j].m_start) {
                 array->defineOwnPropertyThrowsException(state, ObjectPropertyName(state, Value(index++)), ObjectPropertyDescriptor(Value(), ObjectPropertyDescriptor::AllPresent));
             } else {
-                array->defineOwnPropertyThrowsException(state, ObjectPropertyName(state, Value(index++)), ObjectPropertyDescriptor(str->substring(result.m_matchResults[i][j].m_start, result.m_matchResults[i][j].m_end), ObjectPropertyDescriptor::AllPresent));
+                array->defineOwnPropertyThrowsException(state, ObjectPropertyName(state, Value(index++)), ObjectPropertyDescriptor(str->substring(result.m_matchResults[i][j].m_start, result.m_matchResults[i][j].m_end, &state), ObjectPropertyDescriptor::AllPresent));
             }
             if (index == limit)
                 return;
@@ -20,12 +20,109 @@
 #include "Escargot.h"
 #include "RopeString.h"
 #include "StringBuilder.h"
+#include "StringView.h"
 #include "ErrorObject.h"
 
 namespace Escargot {
 
+// Growable character buffer of strings made by repeated appending (s += x).
+// Each rope on buffer sees prefix of buffer in its length, and characters in the prefix never change.
+// So rope whose length equals used length of buffer can append in place,
+// while other ropes on the same buffer keep seeing their own content
+class RopeStringAppendBuffer : public String {
+public:
+    RopeStringAppendBuffer(bool is8Bit, void* buffer, size_t capacity)
+        : String()
+        , m_capacity(capacity)
+    {
+        m_bufferAccessData.has8BitContent = is8Bit;
+        m_bufferAccessData.length = 0;
+        m_bufferAccessData.buffer = buffer;
+    }
+
+    virtual size_t length() const
+    {
+        return m_bufferAccessData.length;
+    }
+
+    virtual char16_t charAt(const size_t& idx) const
+    {
+        return m_bufferAccessData.charAt(idx);
+    }
+
+    virtual UTF16StringData toUTF16StringData() const
+    {
+        return StringView(const_cast<RopeStringAppendBuffer*>(this), 0, length()).toUTF16StringData();
+    }
+
+    virtual UTF8StringData toUTF8StringData() const
+    {
+        return m_bufferAccessData.toUTF8String<UTF8StringData, UTF8StringDataNonGCStd>();
+    }
+
+    virtual UTF8StringDataNonGCStd toNonGCUTF8StringData() const
+    {
+        return m_bufferAccessData.toUTF8String<UTF8StringDataNonGCStd>();
+    }
+
+    virtual const LChar* characters8() const
+    {
+        ASSERT(m_bufferAccessData.has8BitContent);
+        return (const LChar*)m_bufferAccessData.buffer;
+    }
+
+    virtual const char16_t* characters16() const
+    {
+        ASSERT(!m_bufferAccessData.has8BitContent);
+        return (const char16_t*)m_bufferAccessData.buffer;
+    }
+
+    bool canAppend(size_t length, bool is8Bit) const
+    {
+        return m_bufferAccessData.has8BitContent == is8Bit && m_capacity - m_bufferAccessData.length >= length;
+    }
+
+    void append(const StringBufferAccessData& data)
+    {
+        ASSERT(m_capacity - m_bufferAccessData.length >= data.length);
+        size_t used = m_bufferAccessData.length;
+        if (m_bufferAccessData.has8BitContent) {
+            ASSERT(data.has8BitContent);
+            memcpy((LChar*)m_bufferAccessData.buffer + used, data.buffer, data.length * sizeof(LChar));
+        } else if (!data.has8BitContent) {
+            memcpy((char16_t*)m_bufferAccessData.buffer + used, data.buffer, data.length * sizeof(char16_t));
+        } else {
+            char16_t* dst = (char16_t*)m_bufferAccessData.buffer + used;
+            const LChar* src = (const LChar*)data.buffer;
+            for (size_t i = 0; i < data.length; i++) {
+                dst[i] = src[i];
+            }
+        }
+        m_bufferAccessData.length = used + data.length;
+    }
+
+    void* operator new(size_t size)
+    {
+        ESCARGOT_PROFILE_ALLOCATION(RopeString, size);
+        static bool typeInited = false;
+        static GC_descr descr;
+        if (!typeInited) {
+            GC_word obj_bitmap[GC_BITMAP_SIZE(RopeStringAppendBuffer)] = { 0 };
+            GC_set_bit(obj_bitmap, GC_WORD_OFFSET(RopeStringAppendBuffer, m_bufferAccessData.buffer));
+            descr = GC_make_descriptor(obj_bitmap, GC_WORD_LEN(RopeStringAppendBuffer));
+            typeInited = true;
+        }
+        return GC_MALLOC_EXPLICITLY_TYPED(size, descr);
+    }
+    void* operator new[](size_t size) = delete;
+
+private:
+    size_t m_capacity;
+};
+
 void* RopeString::operator new(size_t size)
 {
+    ESCARGOT_PROFILE_ALLOCATION(RopeString, size);
     static bool typeInited = false;
     static GC_descr descr;
     if (!typeInited) {
@@ -52,16 +149,8 @@ String* RopeString::createRopeString(String* lstr, String* rstr, ExecutionState*
             ret.resizeWithUninitializedValues(len);
 
             LChar* result = ret.data();
-            const LChar* buffer = (const LChar*)lData.buffer;
-            for (size_t i = 0; i < lData.length; i++) {
-                result[i] = buffer[i];
-            }
-
-            result += lData.length;
-            buffer = (const LChar*)rData.buffer;
-            for (size_t i = 0; i < rData.length; i++) {
-                result[i] = buffer[i];
-            }
+            memcpy(result, lData.buffer, lData.length * sizeof(LChar));
+            memcpy(result + lData.length, rData.buffer, rData.length * sizeof(LChar));
             return new Latin1String(std::move(ret));
         } else {
             StringBuilder builder;
@@ -77,11 +166,6 @@ String* RopeString::createRopeString(String* lstr, String* rstr, ExecutionState*
         }
     }
 
-    RopeString* rope = new RopeString();
-    rope->m_contentLength = llen + rlen;
-    rope->m_left = lstr;
-    rope->m_right = rstr;
-
     bool l8bit;
     if (lstr->isRopeString()) {
         l8bit = ((RopeString*)lstr)->m_has8BitContent;
@@ -96,26 +180,121 @@ String* RopeString::createRopeString(String* lstr, String* rstr, ExecutionState*
         r8bit = rstr->has8BitContent();
     }
 
+    // string appended repeatedly (s += x) grows in append buffer instead of making a deep rope
+    if (lstr->isRopeString()) {
+        RopeString* left = (RopeString*)lstr;
+        if ((left->m_isOnAppendBuffer && left->m_left->length() == llen) || left->isAppendedRepeatedly()) {
+            String* appended = appendToBuffer(left, rstr, l8bit & r8bit);
+            if (appended) {
+                return appended;
+            }
+        }
+    }
+
+    RopeString* rope = new RopeString();
+    rope->m_contentLength = llen + rlen;
+    rope->m_left = lstr;
+    rope->m_right = rstr;
     rope->m_has8BitContent = l8bit & r8bit;
-    /*
-    bool has8 = true;
-    if (!lstr->has8BitContent()) {
-        if (!isAllLatin1((char16_t*)lstr->bufferAccessData().buffer, llen)) {
-            has8 = false;
+    return rope;
+}
+
+String* RopeString::appendToBuffer(RopeString* lstr, String* rstr, bool is8Bit)
+{
+    size_t llen = lstr->length();
+    size_t rlen = rstr->length();
+
+    RopeStringAppendBuffer* buffer = nullptr;
+    if (lstr->m_isOnAppendBuffer) {
+        buffer = (RopeStringAppendBuffer*)lstr->m_left;
+        ASSERT(buffer->length() == llen);
+        if (!buffer->canAppend(rlen, is8Bit)) {
+            buffer = nullptr;
         }
     }
 
-    if (has8 && !rstr->has8BitContent()) {
-        if (!isAllLatin1((char16_t*)rstr->bufferAccessData().buffer, rlen)) {
-            has8 = false;
+    if (!buffer) {
+        // length is not limited without ExecutionState. capacity of limited length fits in size_t even in bytes
+        if (llen + rlen > STRING_MAXIMUM_LENGTH) {
+            return nullptr;
         }
+        size_t capacity = llen + rlen;
+        capacity = std::min(capacity + capacity / 2, (size_t)STRING_MAXIMUM_LENGTH);
+        void* characters = GC_MALLOC_ATOMIC(capacity * (is8Bit ? sizeof(LChar) : sizeof(char16_t)));
+        if (UNLIKELY(!characters)) {
+            return nullptr;
+        }
+        buffer = new RopeStringAppendBuffer(is8Bit, characters, capacity);
+        // unflattened left rope is copied once here
+        buffer->append(lstr->bufferAccessData());
     }
+    buffer->append(rstr->bufferAccessData());
 
-    rope->m_has8BitContent = has8;
-    */
+    RopeString* rope = new RopeString();
+    rope->m_contentLength = llen + rlen;
+    rope->m_left = buffer;
+    rope->m_right = nullptr;
+    rope->m_has8BitContent = is8Bit;
+    rope->m_isOnAppendBuffer = true;
+    rope->m_bufferAccessData = buffer->bufferAccessData();
     return rope;
 }
 
+bool RopeString::isAppendedRepeatedly() const
+{
+    const RopeString* cur = this;
+    for (size_t depth = 1; depth < ROPE_STRING_APPEND_BUFFER_MIN_DEPTH; depth++) {
+        if (!cur->m_right || !cur->m_left->isRopeString()) {
+            return false;
+        }
+        cur = (const RopeString*)cur->m_left;
+    }
+    return cur->m_right;
+}
+
+char16_t RopeString::charAtInTree(size_t idx) const
+{
+    ASSERT(m_right);
+    String* cur = const_cast<RopeString*>(this);
+    size_t curIndex = idx;
+    for (size_t depth = 0; depth < ROPE_STRING_MAX_SEARCH_DEPTH; depth++) {
+        if (!cur->isRopeString() || !((RopeString*)cur)->m_right) {
+            return cur->charAt(curIndex);
+        }
+        RopeString* rope = (RopeString*)cur;
+        size_t leftLength = rope->m_left->length();
+        if (curIndex < leftLength) {
+            cur = rope->m_left;
+        } else {
+            curIndex -= leftLength;
+            cur = rope->m_right;
+        }
+    }
+    return normalString()->charAt(idx);
+}
+
+String* RopeString::childContaining(size_t& from, size_t& to)
+{
+    String* cur = this;
+    for (size_t depth = 0; depth < ROPE_STRING_MAX_SEARCH_DEPTH; depth++) {
+        if (!cur->isRopeString() || !((RopeString*)cur)->m_right) {
+            break;
+        }
+        RopeString* rope = (RopeString*)cur;
+        size_t leftLength = rope->m_left->length();
+        if (to <= leftLength) {
+            cur = rope->m_left;
+        } else if (from >= leftLength) {
+            from -= leftLength;
+            to -= leftLength;
+            cur = rope->m_right;
+        } else {
+            break;
+        }
+    }
+    return cur;
+}
+
 template <typename A, typename B>
 void RopeString::flattenRopeStringWorker()
 {
@@ -145,7 +324,9 @@ void RopeString::flattenRopeStringWorker()
         pos -= data.length;
         size_t subLength = data.length;
 
-        if (data.has8BitContent) {
+        if (sizeof(result[0]) == (data.has8BitContent ? sizeof(LChar) : sizeof(char16_t))) {
+            memcpy(&result[pos], data.buffer, subLength * sizeof(result[0]));
+        } else if (data.has8BitContent) {
             auto ptr = (const LChar*)data.buffer;
             for (size_t i = 0; i < subLength; i++) {
                 result[i + pos] = ptr[i];
@@ -171,8 +352,28 @@ void RopeString::flattenRopeString()
     }
 }
 
+// append buffer can be longer than rope on it, so these are read through buffer access data
+UTF16StringData RopeString::toUTF16StringData() const
+{
+    if (UNLIKELY(m_isOnAppendBuffer)) {
+        return StringView(m_left, 0, length()).toUTF16StringData();
+    }
+    return normalString()->toUTF16StringData();
+}
+
+UTF8StringData RopeString::toUTF8StringData() const
+{
+    if (UNLIKELY(m_isOnAppendBuffer)) {
+        return m_bufferAccessData.toUTF8String<UTF8StringData, UTF8StringDataNonGCStd>();
+    }
+    return normalString()->toUTF8StringData();
+}
+
 UTF8StringDataNonGCStd RopeString::toNonGCUTF8StringData() const
 {
+    if (UNLIKELY(m_isOnAppendBuffer)) {
+        return m_bufferAccessData.toUTF8String<UTF8StringDataNonGCStd>();
+    }
     return normalString()->toNonGCUTF8StringData();
 }
 }
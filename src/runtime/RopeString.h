@@ -35,6 +35,7 @@ public:
         m_right = String::emptyString;
         m_contentLength = 0;
         m_has8BitContent = true;
+        m_isOnAppendBuffer = false;
         m_bufferAccessData.hasSpecialImpl = true;
     }
 
@@ -42,6 +43,7 @@ public:
     // if (l+r).length() < ROPE_STRING_MIN_LENGTH
     // then create just normalString
     // provide ExecutionState if you need limit of string length(exception can be thrown only in ExecutionState area)
+    // appending repeatedly to result of concatenation (s += x) writes into growable buffer shared with left string
     static String* createRopeString(String* lstr, String* rstr, ExecutionState* state = nullptr);
 
     virtual size_t length() const
@@ -50,19 +52,19 @@ public:
     }
     virtual char16_t charAt(const size_t& idx) const
     {
-        return normalString()->charAt(idx);
+        if (m_right) {
+            return charAtInTree(idx);
+        }
+        return m_left->charAt(idx);
     }
-    virtual UTF16StringData toUTF16StringData() const
-    {
-        return normalString()->toUTF16StringData();
-    }
-    virtual UTF8StringData toUTF8StringData() const
-    {
-        return normalString()->toUTF8StringData();
-    }
-
+    virtual UTF16StringData toUTF16StringData() const;
+    virtual UTF8StringData toUTF8StringData() const;
     virtual UTF8StringDataNonGCStd toNonGCUTF8StringData() const;
 
+    // returns child which has whole [from, to) and adjusts range into it.
+    // returns this if there is no such child within ROPE_STRING_MAX_SEARCH_DEPTH
+    String* childContaining(size_t& from, size_t& to);
+
     virtual bool isRopeString()
     {
         return true;
@@ -96,19 +98,27 @@ protected:
     template <typename A, typename B>
     void flattenRopeStringWorker();
     void flattenRopeString();
-
+    char16_t charAtInTree(size_t idx) const;
+    // true when left spine has ROPE_STRING_APPEND_BUFFER_MIN_DEPTH unflattened ropes
+    bool isAppendedRepeatedly() const;
+    // returns nullptr if buffer cannot be allocated. caller makes ordinary rope then
+    static String* appendToBuffer(RopeString* lstr, String* rstr, bool r8bit);
+
+    // m_right is nullptr when rope is flattened or is on append buffer.
+    // m_left is flattened string, or append buffer whose prefix of m_contentLength is content of rope
     String* m_left;
     String* m_right;
     struct {
         bool m_has8BitContent : 1;
+        bool m_isOnAppendBuffer : 1;
 #if ESCARGOT_32
-        size_t m_contentLength : 31;
+        size_t m_contentLength : 30;
 #else
-        size_t m_contentLength : 63;
+        size_t m_contentLength : 62;
 #endif
     };
 #if !defined(COMPILER_MSVC)
-    static_assert(STRING_MAXIMUM_LENGTH < (std::numeric_limits<size_t>::max() / 2), "");
+    static_assert(STRING_MAXIMUM_LENGTH < (std::numeric_limits<size_t>::max() / 4), "");
 #endif
 };
 }
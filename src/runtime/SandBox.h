@@ -71,6 +71,12 @@ public:
 
     SandBoxResult run(const std::function<Value()>& scriptRunner); // for capsule script executing with try-catch
     void throwException(ExecutionState& state, Value exception);
+    // exception thrown in this sandbox is handled before reaching run, like try-catch statement
+    void exceptionCaught(const Value& exception)
+    {
+        fillStackDataIntoErrorObject(exception);
+        m_stackTraceData.clear();
+    }
 
     Context* context()
     {
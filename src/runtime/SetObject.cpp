@@ -32,6 +32,7 @@ SetObject::SetObject(ExecutionState& state)
 
 void* SetObject::operator new(size_t size)
 {
+    ESCARGOT_PROFILE_ALLOCATION(SetObject, size);
     static bool typeInited = false;
     static GC_descr descr;
     if (!typeInited) {
@@ -141,6 +142,7 @@ SetIteratorObject::SetIteratorObject(ExecutionState& state, SetObject* set, Type
 
 void* SetIteratorObject::operator new(size_t size)
 {
+    ESCARGOT_PROFILE_ALLOCATION(IteratorObject, size);
     static bool typeInited = false;
     static GC_descr descr;
     if (!typeInited) {
@@ -285,6 +285,35 @@ public:
         }
     }
 
+#ifdef ESCARGOT_64
+    // field with double representation holds bits of double instead of tagged value.
+    // see ObjectStructurePropertyDescriptor::hasDoubleRepresentation
+    // bits are moved by unboxedDoubleEncodeOffset above every user space address,
+    // so conservative scanning of Object::m_values never takes them as pointers.
+    // NaN is canonicalized so the addition cannot wrap around
+    // this needs user space addresses of 49 bits at most (47 or 48 bits on x86-64 and AArch64).
+    // the first VMInstance checks it with isBelowUnboxedDoubles
+    static SmallValue fromUnboxedDouble(double v)
+    {
+        return SmallValue(SmallValueData((void*)encodeUnboxedDouble(v)));
+    }
+
+    double asUnboxedDouble() const
+    {
+        return bitwise_cast<double>((uintptr_t)m_data.payload - unboxedDoubleEncodeOffset);
+    }
+
+    void setUnboxedDouble(double v)
+    {
+        m_data.payload = encodeUnboxedDouble(v);
+    }
+
+    static bool isBelowUnboxedDoubles(const void* address)
+    {
+        return (uintptr_t)address < unboxedDoubleEncodeOffset;
+    }
+#endif
+
     void operator=(PointerValue* from)
     {
         ASSERT(from);
@@ -377,6 +406,19 @@ protected:
     }
 
 
+#ifdef ESCARGOT_64
+    static const uintptr_t unboxedDoubleEncodeOffset = (uintptr_t)1 << 49;
+    COMPILE_ASSERT(sizeof(uintptr_t) == 8 && sizeof(double) == 8, "");
+
+    static intptr_t encodeUnboxedDouble(double v)
+    {
+        if (UNLIKELY(std::isnan(v))) {
+            v = std::numeric_limits<double>::quiet_NaN();
+        }
+        return (intptr_t)(bitwise_cast<uintptr_t>(v) + unboxedDoubleEncodeOffset);
+    }
+#endif
+
     SmallValueData m_data;
 };
 
@@ -68,22 +68,46 @@ void StaticStrings::initStaticStrings(AtomicStringMap* atomicStringMap)
 #undef INIT_STATIC_STRING
 }
 
+void StaticStrings::setNumberToStringCacheSize(size_t size)
+{
+    // rounding up huge size would overflow
+    size = std::min(size, (size_t)STRING_NUMBER_TO_STRING_CACHE_MAX_SIZE);
+    size_t roundedSize = 0;
+    if (size) {
+        roundedSize = 1;
+        while (roundedSize < size) {
+            roundedSize <<= 1;
+        }
+    }
+    numberToStringCacheSize = roundedSize;
+    numberToStringCache = nullptr;
+}
+
 ::Escargot::String* StaticStrings::dtoa(double d) const
 {
-    auto iter = dtoaCache.begin();
+    ASSERT(!std::isnan(d) && !(d == 0 && std::signbit(d)));
+    if (UNLIKELY(!numberToStringCacheSize)) {
+        return String::fromDouble(d);
+    }
 
-    while (iter != dtoaCache.end()) {
-        if ((*iter).first == d) {
-            return (*iter).second;
-        }
-        iter++;
+    if (UNLIKELY(!numberToStringCache)) {
+        numberToStringCache = (NumberToStringCacheEntry*)GC_MALLOC(sizeof(NumberToStringCacheEntry) * numberToStringCacheSize);
+        memset(numberToStringCache, 0, sizeof(NumberToStringCacheEntry) * numberToStringCacheSize);
     }
 
-    ::Escargot::String* s = String::fromDouble(d);
-    dtoaCache.push_front(std::make_pair(d, s));
-    if (dtoaCache.size() > dtoaCacheSize) {
-        dtoaCache.pop_back();
+    // integers keep most of bits in upper half of double, so fold them before mixing
+    uint64_t bits;
+    memcpy(&bits, &d, sizeof(double));
+    bits ^= bits >> 32;
+    bits *= 0x9E3779B97F4A7C15ULL;
+    NumberToStringCacheEntry& entry = numberToStringCache[(bits >> 32) & (numberToStringCacheSize - 1)];
+    if (LIKELY(entry.string && entry.number == d)) {
+        return entry.string;
     }
+
+    ::Escargot::String* s = String::fromDouble(d);
+    entry.number = d;
+    entry.string = s;
     return s;
 }
 }
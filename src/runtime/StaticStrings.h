@@ -375,8 +375,9 @@ namespace Escargot {
 class StaticStrings {
 public:
     StaticStrings()
-        : dtoaCacheSize(5)
+        : numberToStringCache(nullptr)
     {
+        setNumberToStringCacheSize(STRING_NUMBER_TO_STRING_CACHE_SIZE);
     }
     AtomicString NegativeInfinity;
     AtomicString stringTrue;
@@ -414,9 +415,17 @@ public:
 
     void initStaticStrings(AtomicStringMap* map);
 
-    const size_t dtoaCacheSize; // 5;
-    mutable std::list<std::pair<double, ::Escargot::String*>, GCUtil::gc_malloc_ignore_off_page_allocator<std::pair<double, ::Escargot::String*>>> dtoaCache;
+    // direct-mapped cache of number to string. entries are allocated when it is used first time.
+    // size is rounded up to power of two, and 0 disables cache
+    struct NumberToStringCacheEntry {
+        double number;
+        ::Escargot::String* string;
+    };
+    mutable NumberToStringCacheEntry* numberToStringCache;
+    size_t numberToStringCacheSize;
 
+    void setNumberToStringCacheSize(size_t size);
+    // d should not be NaN or -0
     ::Escargot::String* dtoa(double d) const;
 };
 }
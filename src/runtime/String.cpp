@@ -46,6 +46,9 @@
 #include "Escargot.h"
 #include "String.h"
 #include "Value.h"
+#include "RopeString.h"
+#include "StringView.h"
+#include "VMInstance.h"
 
 #include "fast-dtoa.h"
 #include "bignum-dtoa.h"
@@ -435,11 +438,72 @@ void CreateExponentialRepresentation(
                                  kMaxExponentLength - first_char_pos);
 }
 
+static const char s_twoDigits[] = "00010203040506070809"
+                                   "10111213141516171819"
+                                   "20212223242526272829"
+                                   "30313233343536373839"
+                                   "40414243444546474849"
+                                   "50515253545556575859"
+                                   "60616263646566676869"
+                                   "70717273747576777879"
+                                   "80818283848586878889"
+                                   "90919293949596979899";
+
+// number of decimal digits of value. comparisons are summed instead of branched on
+static size_t decimalIntegerLength(uint64_t value)
+{
+    static const uint64_t powersOf10[] = { 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL, 1000000000ULL, 10000000000ULL,
+                                           100000000000ULL, 1000000000000ULL, 10000000000000ULL, 100000000000000ULL, 1000000000000000ULL,
+                                           10000000000000000ULL, 100000000000000000ULL, 1000000000000000000ULL, 10000000000000000000ULL };
+    size_t length = 1;
+    for (size_t i = 0; i < sizeof(powersOf10) / sizeof(uint64_t); i++) {
+        length += value >= powersOf10[i];
+    }
+    return length;
+}
+
+// writes decimal digits of value ending at bufferEnd, and returns position of first digit
+// digit count is computed first, so writing digits does not depend on value of each digit pair
+static char* formatDecimalInteger(uint64_t value, char* bufferEnd)
+{
+    size_t length = decimalIntegerLength(value);
+    char* p = bufferEnd;
+    for (size_t i = 0; i < length / 2; i++) {
+        size_t pair = (value % 100) * 2;
+        value /= 100;
+        p -= 2;
+        p[0] = s_twoDigits[pair];
+        p[1] = s_twoDigits[pair + 1];
+    }
+    if (length & 1) {
+        *--p = '0' + value;
+    }
+    return p;
+}
+
+static ASCIIStringData integerToASCIIStringData(int64_t number)
+{
+    char buffer[24];
+    char* end = buffer + sizeof(buffer);
+    char* p = formatDecimalInteger(number < 0 ? -(uint64_t)number : number, end);
+    if (number < 0) {
+        *--p = '-';
+    }
+    return ASCIIStringData(p, end - p);
+}
+
 ASCIIStringData dtoa(double number)
 {
     if (number == 0) {
         return ASCIIStringData("0", 1);
     }
+
+    // shortest representation of integer below 2^53 is the integer itself
+    const double maxSafeInteger = 9007199254740991.0;
+    if (std::abs(number) <= maxSafeInteger && number == (int64_t)number) {
+        return integerToASCIIStringData((int64_t)number);
+    }
+
     const int flags = UNIQUE_ZERO | EMIT_POSITIVE_EXPONENT_SIGN;
     bool sign = false;
     if (number < 0) {
@@ -488,15 +552,16 @@ ASCIIStringData dtoa(double number)
         CreateExponentialRepresentation(flags, decimal_rep, decimal_rep_length, exponent,
                                         &builder);
     }
-    ASCIIStringDataNonGCStd str;
-    if (sign)
-        str += '-';
+    size_t length = builder.position();
     char* buf = builder.Finalize();
-    while (*buf) {
-        str += *buf;
-        buf++;
+    if (sign) {
+        ASCIIStringData str;
+        str.resizeWithUninitializedValues(length + 1);
+        str[0] = '-';
+        memcpy(str.data() + 1, buf, length);
+        return str;
     }
-    return ASCIIStringData(str.data(), str.length());
+    return ASCIIStringData(buf, length);
 }
 
 String* String::fromASCII(const char* src)
@@ -504,6 +569,11 @@ String* String::fromASCII(const char* src)
     return new ASCIIString(src, strlen(src));
 }
 
+String* String::fromInt32(int32_t v)
+{
+    return new ASCIIString(integerToASCIIStringData(v));
+}
+
 String* String::fromDouble(double v)
 {
     auto s = dtoa(v);
@@ -714,11 +784,30 @@ size_t String::rfind(String* str, size_t pos)
     return SIZE_MAX;
 }
 
-String* String::substring(size_t from, size_t to)
+String* String::substring(size_t from, size_t to, ExecutionState* state)
 {
+    if (UNLIKELY(isRopeString())) {
+        // part of unflattened rope is taken without flattening whole rope
+        String* child = ((RopeString*)this)->childContaining(from, to);
+        if (child != this) {
+            return child->substring(from, to, state);
+        }
+    }
+
     if (to - from > STRING_SUB_STRING_MIN_VIEW_LENGTH) {
-        StringView* str = new StringView(this, from, to);
-        return str;
+        VMInstance* instance = state ? state->context()->vmInstance() : nullptr;
+        size_t ratio = instance ? instance->subStringViewRetentionRatio() : STRING_SUB_STRING_MAX_RETENTION_RATIO;
+        size_t charSize = has8BitContent() ? sizeof(LChar) : sizeof(char16_t);
+        if (LIKELY(StringView::shouldMakeView(ratio, length(), to - from))) {
+            if (instance) {
+                instance->subStringViewStatistics().recordView((to - from) * charSize, length() * charSize);
+            }
+            StringView* str = new StringView(this, from, to);
+            return str;
+        }
+        if (instance) {
+            instance->subStringViewStatistics().recordCopy((to - from) * charSize);
+        }
     }
     StringBuilder builder;
     builder.appendSubString(this, from, to);
@@ -728,6 +817,7 @@ String* String::substring(size_t from, size_t to)
 
 void* ASCIIString::operator new(size_t size)
 {
+    ESCARGOT_PROFILE_ALLOCATION(ASCIIString, size);
     static bool typeInited = false;
     static GC_descr descr;
     if (!typeInited) {
@@ -741,6 +831,7 @@ void* ASCIIString::operator new(size_t size)
 
 void* Latin1String::operator new(size_t size)
 {
+    ESCARGOT_PROFILE_ALLOCATION(Latin1String, size);
     static bool typeInited = false;
     static GC_descr descr;
     if (!typeInited) {
@@ -754,6 +845,7 @@ void* Latin1String::operator new(size_t size)
 
 void* UTF16String::operator new(size_t size)
 {
+    ESCARGOT_PROFILE_ALLOCATION(UTF16String, size);
     static bool typeInited = false;
     static GC_descr descr;
     if (!typeInited) {
@@ -64,6 +64,7 @@ class Latin1String;
 class UTF16String;
 class RopeString;
 class StringView;
+class ExecutionState;
 
 struct StringBufferAccessData {
     bool has8BitContent;
@@ -175,6 +176,12 @@ public:
         return false;
     }
 
+    // characters can be read from bufferAccessData() without flattening rope
+    bool hasFlatBuffer() const
+    {
+        return !m_bufferAccessData.hasSpecialImpl;
+    }
+
     bool has8BitContent() const
     {
         return bufferAccessData().has8BitContent;
@@ -183,11 +190,7 @@ public:
     static String* fromASCII(const char* s);
     static String* fromCharCode(char32_t code);
     static String* fromDouble(double v);
-    static String* fromInt32(int32_t v)
-    {
-        // TODO
-        return fromDouble(v);
-    }
+    static String* fromInt32(int32_t v);
     static String* fromUTF8(const char* src, size_t len);
 
     virtual size_t length() const = 0;
@@ -229,7 +232,8 @@ public:
     size_t find(String* str, size_t pos = 0);
     size_t rfind(String* str, size_t pos);
 
-    String* substring(size_t from, size_t to);
+    // result can be a view of this string. provide ExecutionState to apply retention ratio of VMInstance and count the result
+    String* substring(size_t from, size_t to, ExecutionState* state = nullptr);
 
     template <typename T>
     static inline size_t stringHash(T* src, size_t length)
@@ -34,6 +34,7 @@ StringObject::StringObject(ExecutionState& state, String* value)
 
 void* StringObject::operator new(size_t size)
 {
+    ESCARGOT_PROFILE_ALLOCATION(StringObject, size);
     static bool typeInited = false;
     static GC_descr descr;
     if (!typeInited) {
@@ -110,6 +111,7 @@ StringIteratorObject::StringIteratorObject(ExecutionState& state, String* s)
 
 void* StringIteratorObject::operator new(size_t size)
 {
+    ESCARGOT_PROFILE_ALLOCATION(IteratorObject, size);
     static bool typeInited = false;
     static GC_descr descr;
     if (!typeInited) {
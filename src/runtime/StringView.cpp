@@ -24,6 +24,7 @@ namespace Escargot {
 
 void* StringView::operator new(size_t size)
 {
+    ESCARGOT_PROFILE_ALLOCATION(StringView, size);
     static bool typeInited = false;
     static GC_descr descr;
     if (!typeInited) {
@@ -37,6 +38,7 @@ void* StringView::operator new(size_t size)
 
 void* SourceStringView::operator new(size_t size)
 {
+    ESCARGOT_PROFILE_ALLOCATION(StringView, size);
     static bool typeInited = false;
     static GC_descr descr;
     if (!typeInited) {
@@ -152,6 +152,44 @@ public:
     void* operator new(size_t size);
     void* operator new[](size_t size) = delete;
 
+    // view made by substring keeps whole source string alive.
+    // if source is longer than (length of substring * ratio), substring is copied instead. 0 means no limit
+    static bool shouldMakeView(size_t maxRetentionRatio, size_t sourceLength, size_t viewLength)
+    {
+        return !maxRetentionRatio || sourceLength / maxRetentionRatio <= viewLength;
+    }
+
+    // substrings made in a VMInstance. nothing is subtracted when views die
+    struct Statistics {
+        Statistics()
+            : m_viewCount(0)
+            , m_viewBytes(0)
+            , m_viewedSourceBytes(0)
+            , m_copiedCount(0)
+            , m_copiedBytes(0)
+        {
+        }
+
+        void recordView(size_t viewBytes, size_t sourceBytes)
+        {
+            m_viewCount++;
+            m_viewBytes += viewBytes;
+            m_viewedSourceBytes += sourceBytes;
+        }
+
+        void recordCopy(size_t bytes)
+        {
+            m_copiedCount++;
+            m_copiedBytes += bytes;
+        }
+
+        size_t m_viewCount;
+        size_t m_viewBytes;
+        size_t m_viewedSourceBytes; // sum of source sizes at the time each view was made. source shared by views is counted for each
+        size_t m_copiedCount; // substrings copied due to retention ratio
+        size_t m_copiedBytes;
+    };
+
     String* string() const
     {
         return m_string;
@@ -33,6 +33,7 @@ SymbolObject::SymbolObject(ExecutionState& state, Symbol* value)
 
 void* SymbolObject::operator new(size_t size)
 {
+    ESCARGOT_PROFILE_ALLOCATION(SymbolObject, size);
     static bool typeInited = false;
     static GC_descr descr;
     if (!typeInited) {
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2018-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#include "Escargot.h"
+#include "TimezoneOffsetCache.h"
+
+#ifdef ENABLE_ICU
+
+namespace Escargot {
+
+void TimezoneOffsetCache::clear()
+{
+    for (size_t i = 0; i < 2; i++) {
+        for (size_t j = 0; j < TIMEZONE_OFFSET_CACHE_SIZE; j++) {
+            m_ranges[i][j].m_start = 1;
+            m_ranges[i][j].m_end = 0;
+            m_ranges[i][j].m_lastUsed = 0;
+        }
+    }
+    m_useCount = 0;
+}
+
+TimezoneOffsetCache::Range* TimezoneOffsetCache::leastRecentlyUsedRange(bool isLocalTime)
+{
+    Range* ranges = m_ranges[isLocalTime];
+    Range* result = &ranges[0];
+    for (size_t i = 1; i < TIMEZONE_OFFSET_CACHE_SIZE; i++) {
+        if (ranges[i].m_lastUsed < result->m_lastUsed) {
+            result = &ranges[i];
+        }
+    }
+    return result;
+}
+
+void TimezoneOffsetCache::getOffset(icu::TimeZone* timezone, int64_t t, bool isLocalTime, int32_t& rawOffset, int32_t& dstOffset, UErrorCode& status)
+{
+    Range* ranges = m_ranges[isLocalTime];
+    m_useCount++;
+
+    // find range which contains t, or nearest range within delta
+    Range* before = nullptr;
+    Range* after = nullptr;
+    for (size_t i = 0; i < TIMEZONE_OFFSET_CACHE_SIZE; i++) {
+        Range& range = ranges[i];
+        if (range.isEmpty()) {
+            continue;
+        }
+        if (range.m_start <= t && t <= range.m_end) {
+            range.m_lastUsed = m_useCount;
+            rawOffset = range.m_rawOffset;
+            dstOffset = range.m_dstOffset;
+            return;
+        }
+        if (range.m_end < t && t - range.m_end <= TIMEZONE_OFFSET_CACHE_DELTA && (!before || before->m_end < range.m_end)) {
+            before = &range;
+        } else if (t < range.m_start && range.m_start - t <= TIMEZONE_OFFSET_CACHE_DELTA && (!after || range.m_start < after->m_start)) {
+            after = &range;
+        }
+    }
+
+    int32_t probeRawOffset, probeDstOffset;
+    if (before) {
+        // probe ahead of t, so that following queries hit extended range
+        int64_t probe = before->m_end + TIMEZONE_OFFSET_CACHE_DELTA;
+        timezone->getOffset(probe, isLocalTime, probeRawOffset, probeDstOffset, status);
+        if (U_FAILURE(status)) {
+            return;
+        }
+        before->m_lastUsed = m_useCount;
+        if (before->hasSameOffset(probeRawOffset, probeDstOffset)) {
+            before->m_end = probe;
+            rawOffset = probeRawOffset;
+            dstOffset = probeDstOffset;
+            return;
+        }
+
+        // offset changes once in (m_end, probe]
+        timezone->getOffset(t, isLocalTime, rawOffset, dstOffset, status);
+        if (U_FAILURE(status)) {
+            return;
+        }
+        if (before->hasSameOffset(rawOffset, dstOffset)) {
+            before->m_end = t;
+        } else {
+            Range* range = leastRecentlyUsedRange(isLocalTime);
+            bool sameWithProbe = rawOffset == probeRawOffset && dstOffset == probeDstOffset;
+            *range = { t, sameWithProbe ? probe : t, rawOffset, dstOffset, m_useCount };
+        }
+        return;
+    }
+
+    if (after) {
+        int64_t probe = after->m_start - TIMEZONE_OFFSET_CACHE_DELTA;
+        timezone->getOffset(probe, isLocalTime, probeRawOffset, probeDstOffset, status);
+        if (U_FAILURE(status)) {
+            return;
+        }
+        after->m_lastUsed = m_useCount;
+        if (after->hasSameOffset(probeRawOffset, probeDstOffset)) {
+            after->m_start = probe;
+            rawOffset = probeRawOffset;
+            dstOffset = probeDstOffset;
+            return;
+        }
+
+        // offset changes once in [probe, m_start)
+        timezone->getOffset(t, isLocalTime, rawOffset, dstOffset, status);
+        if (U_FAILURE(status)) {
+            return;
+        }
+        if (after->hasSameOffset(rawOffset, dstOffset)) {
+            after->m_start = t;
+        } else {
+            Range* range = leastRecentlyUsedRange(isLocalTime);
+            bool sameWithProbe = rawOffset == probeRawOffset && dstOffset == probeDstOffset;
+            *range = { sameWithProbe ? probe : t, t, rawOffset, dstOffset, m_useCount };
+        }
+        return;
+    }
+
+    timezone->getOffset(t, isLocalTime, rawOffset, dstOffset, status);
+    if (U_FAILURE(status)) {
+        return;
+    }
+    Range* range = leastRecentlyUsedRange(isLocalTime);
+    *range = { t, t, rawOffset, dstOffset, m_useCount };
+}
+}
+
+#endif
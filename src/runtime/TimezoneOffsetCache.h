@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2018-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#ifndef __EscargotTimezoneOffsetCache__
+#define __EscargotTimezoneOffsetCache__
+
+#ifdef ENABLE_ICU
+
+// number of time ranges remembered for each of utc and local time queries
+#ifndef TIMEZONE_OFFSET_CACHE_SIZE
+#define TIMEZONE_OFFSET_CACHE_SIZE 8
+#endif
+
+// cached range is extended by at most this amount at once.
+// it assumes that timezone offset changes at most once in this amount of time
+#ifndef TIMEZONE_OFFSET_CACHE_DELTA
+#define TIMEZONE_OFFSET_CACHE_DELTA (15 * 24 * 60 * 60 * 1000LL)
+#endif
+
+namespace Escargot {
+
+// Remembers time ranges [start, end] in which offset of timezone does not change,
+// so that local time of Date is computed without asking ICU for every query.
+// A query near a cached range probes one point TIMEZONE_OFFSET_CACHE_DELTA ahead of the range,
+// and extends the range to the probe when offset is not changed until there.
+class TimezoneOffsetCache {
+public:
+    TimezoneOffsetCache()
+    {
+        clear();
+    }
+
+    // same as icu::TimeZone::getOffset with time in milliseconds
+    void getOffset(icu::TimeZone* timezone, int64_t t, bool isLocalTime, int32_t& rawOffset, int32_t& dstOffset, UErrorCode& status);
+    // should be called when timezone is changed
+    void clear();
+
+private:
+    struct Range {
+        int64_t m_start;
+        int64_t m_end;
+        int32_t m_rawOffset;
+        int32_t m_dstOffset;
+        size_t m_lastUsed;
+
+        bool isEmpty() const
+        {
+            return m_start > m_end;
+        }
+
+        bool hasSameOffset(int32_t rawOffset, int32_t dstOffset) const
+        {
+            return m_rawOffset == rawOffset && m_dstOffset == dstOffset;
+        }
+    };
+
+    Range* leastRecentlyUsedRange(bool isLocalTime);
+
+    Range m_ranges[2][TIMEZONE_OFFSET_CACHE_SIZE];
+    size_t m_useCount;
+};
+}
+
+#endif
+
+#endif
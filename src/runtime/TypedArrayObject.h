@@ -138,6 +138,7 @@ public:
 
     void* operator new(size_t size)
     {
+        ESCARGOT_PROFILE_ALLOCATION(TypedArrayObject, size);
         static bool typeInited = false;
         static GC_descr descr;
         if (!typeInited) {
@@ -151,11 +151,19 @@ static ObjectPropertyNativeGetterSetterData regexpLastIndexGetterSetterData(
 
 VMInstance::VMInstance(const char* locale, const char* timezone)
     : m_didSomePrototypeObjectDefineIndexedProperty(false)
+    , m_keepsSourceLocationTable(false)
+    , m_subStringViewRetentionRatio(STRING_SUB_STRING_MAX_RETENTION_RATIO)
     , m_compiledByteCodeSize(0)
     , m_cachedUTC(nullptr)
 {
     if (!String::emptyString) {
         String::emptyString = new (NoGC) ASCIIString("");
+#ifdef ESCARGOT_64
+        // unboxed double fields of objects are encoded above every address of heap and stack.
+        // user space can be wider than that (e.g. 5-level paging, 52-bit VA on AArch64)
+        volatile int stackVariable = 0;
+        RELEASE_ASSERT(SmallValue::isBelowUnboxedDoubles((void*)&stackVariable) && SmallValue::isBelowUnboxedDoubles(String::emptyString));
+#endif
     }
     m_staticStrings.initStaticStrings(&m_atomicStringMap);
 
@@ -292,6 +300,9 @@ void VMInstance::clearCaches()
     m_regexpCache.clear();
     m_cachedUTC = nullptr;
     globalSymbolRegistry().clear();
+#ifdef ENABLE_ICU
+    m_icuObjectCache.clear();
+#endif
 }
 
 void VMInstance::somePrototypeObjectDefineIndexedProperty(ExecutionState& state)
@@ -345,7 +356,7 @@ Value VMInstance::drainJobQueue()
 
     DefaultJobQueue* jobQueue = DefaultJobQueue::get(this->jobQueue());
     while (jobQueue->hasNextJob()) {
-        auto jobResult = jobQueue->nextJob()->run();
+        auto jobResult = jobQueue->runJobs();
         if (!jobResult.error.isEmpty())
             return jobResult.error;
     }
@@ -23,11 +23,15 @@
 #include "runtime/Context.h"
 #include "runtime/AtomicString.h"
 #include "runtime/GlobalObject.h"
+#include "runtime/ICUObjectCache.h"
+#include "runtime/TimezoneOffsetCache.h"
 #include "runtime/RegExpObject.h"
 #include "runtime/StaticStrings.h"
 #include "runtime/String.h"
+#include "runtime/StringView.h"
 #include "runtime/Symbol.h"
 #include "runtime/ToStringRecursionPreventer.h"
+#include "interpreter/InterpreterStack.h"
 
 namespace Escargot {
 
@@ -62,6 +66,7 @@ class VMInstance : public gc {
     friend class VMInstanceRef;
     friend class DefaultJobQueue;
     friend class ScriptParser;
+    friend class HeapSnapshot;
 
 public:
     VMInstance(const char* locale = nullptr, const char* timezone = nullptr);
@@ -103,6 +108,7 @@ public:
 
     void setTimezone()
     {
+        m_timezoneOffsetCache.clear();
         if (m_timezoneID == "") {
             icu::TimeZone* tz = icu::TimeZone::createDefault();
             ASSERT(tz != nullptr);
@@ -117,6 +123,16 @@ public:
     {
         m_timezoneID = id;
     }
+
+    TimezoneOffsetCache& timezoneOffsetCache()
+    {
+        return m_timezoneOffsetCache;
+    }
+
+    ICUObjectCache& icuObjectCache()
+    {
+        return m_icuObjectCache;
+    }
 #endif
     DateObject* cachedUTC() const
     {
@@ -162,6 +178,44 @@ public:
 
     void somePrototypeObjectDefineIndexedProperty(ExecutionState& state);
 
+    // if true, source location table of bytecode is made while bytecode is generated first time,
+    // so source location of stack trace is computed without parsing function again
+    bool keepsSourceLocationTable()
+    {
+        return m_keepsSourceLocationTable;
+    }
+
+    void setKeepsSourceLocationTable(bool keeps)
+    {
+        m_keepsSourceLocationTable = keeps;
+    }
+
+    size_t numberToStringCacheSize()
+    {
+        return m_staticStrings.numberToStringCacheSize;
+    }
+
+    void setNumberToStringCacheSize(size_t size)
+    {
+        m_staticStrings.setNumberToStringCacheSize(size);
+    }
+
+    // substring longer than (its length * ratio) is copied instead of being a view. 0 means no limit
+    size_t subStringViewRetentionRatio()
+    {
+        return m_subStringViewRetentionRatio;
+    }
+
+    void setSubStringViewRetentionRatio(size_t ratio)
+    {
+        m_subStringViewRetentionRatio = ratio;
+    }
+
+    StringView::Statistics& subStringViewStatistics()
+    {
+        return m_subStringViewStatistics;
+    }
+
     ToStringRecursionPreventer& toStringRecursionPreventer()
     {
         return m_toStringRecursionPreventer;
@@ -199,6 +253,11 @@ public:
         return m_compiledByteCodeSize;
     }
 
+    InterpreterStack& interpreterStack()
+    {
+        return m_interpreterStack;
+    }
+
 protected:
     StaticStrings m_staticStrings;
     AtomicStringMap m_atomicStringMap;
@@ -211,6 +270,10 @@ protected:
 
     // this flag should affect VM-wide array object
     bool m_didSomePrototypeObjectDefineIndexedProperty;
+    bool m_keepsSourceLocationTable;
+
+    size_t m_subStringViewRetentionRatio;
+    StringView::Statistics m_subStringViewStatistics;
 
     ObjectStructure* m_defaultStructureForObject;
     ObjectStructure* m_defaultStructureForFunctionObject;
@@ -232,6 +295,8 @@ protected:
     Vector<CodeBlock*, GCUtil::gc_malloc_ignore_off_page_allocator<CodeBlock*>> m_compiledCodeBlocks;
     size_t m_compiledByteCodeSize;
 
+    InterpreterStack m_interpreterStack;
+
     ToStringRecursionPreventer m_toStringRecursionPreventer;
 
     // regexp object data
@@ -243,6 +308,8 @@ protected:
     icu::Locale m_locale;
     icu::TimeZone* m_timezone;
     icu::UnicodeString m_timezoneID;
+    TimezoneOffsetCache m_timezoneOffsetCache;
+    ICUObjectCache m_icuObjectCache;
 #endif
     DateObject* m_cachedUTC;
 
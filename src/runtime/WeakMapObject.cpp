@@ -45,6 +45,7 @@ void* WeakMapObject::WeakMapObjectDataItem::operator new(size_t size)
 
 void* WeakMapObject::operator new(size_t size)
 {
+    ESCARGOT_PROFILE_ALLOCATION(WeakMapObject, size);
     static bool typeInited = false;
     static GC_descr descr;
     if (!typeInited) {
@@ -32,6 +32,7 @@ WeakSetObject::WeakSetObject(ExecutionState& state)
 
 void* WeakSetObject::operator new(size_t size)
 {
+    ESCARGOT_PROFILE_ALLOCATION(WeakSetObject, size);
     static bool typeInited = false;
     static GC_descr descr;
     if (!typeInited) {
@@ -31,7 +31,7 @@ static Value builtinDrainJobQueue(ExecutionState& state, Value thisValue, size_t
 {
     DefaultJobQueue* jobQueue = DefaultJobQueue::get(state.context()->jobQueue());
     while (jobQueue->hasNextJob()) {
-        auto jobResult = jobQueue->nextJob()->run();
+        auto jobResult = jobQueue->runJobs();
         if (!jobResult.error.isEmpty())
             return Value(false);
     }
@@ -21,19 +21,23 @@
 #include "runtime/VMInstance.h"
 #include "runtime/ExecutionContext.h"
 #include "util/Vector.h"
+#include "util/Util.h"
 #include "runtime/Value.h"
 #include "parser/ScriptParser.h"
+#include "runtime/HeapSnapshot.h"
 #ifdef ESCARGOT_ENABLE_PROMISE
 #include "runtime/JobQueue.h"
 #endif
+#ifdef ESCARGOT_ENABLE_THREADING
+#include <thread>
+#endif
 
 namespace Escargot {
 void installTestFunctions(Escargot::ExecutionState& state);
 }
 
-NEVER_INLINE bool eval(Escargot::Context* context, Escargot::String* str, Escargot::String* fileName, bool shouldPrintScriptResult)
+NEVER_INLINE bool execute(Escargot::Context* context, const Escargot::ScriptParser::ScriptParserResult& result, bool shouldPrintScriptResult)
 {
-    auto result = context->scriptParser().parse(str, fileName);
     if (result.m_error) {
         static char msg[10240];
         auto err = result.m_error->message->toUTF8StringData();
@@ -49,7 +53,7 @@ NEVER_INLINE bool eval(Escargot::Context* context, Escargot::String* str, Escarg
 #ifdef ESCARGOT_ENABLE_PROMISE
             Escargot::DefaultJobQueue* jobQueue = Escargot::DefaultJobQueue::get(context->jobQueue());
             while (jobQueue->hasNextJob()) {
-                auto jobResult = jobQueue->nextJob()->run();
+                auto jobResult = jobQueue->runNextJob();
                 if (shouldPrintScriptResult) {
                     if (!jobResult.result.isEmpty()) {
                         printf("%s\n", jobResult.result.toString(state)->toUTF8StringData().data());
@@ -71,6 +75,55 @@ NEVER_INLINE bool eval(Escargot::Context* context, Escargot::String* str, Escarg
     return true;
 }
 
+NEVER_INLINE bool eval(Escargot::Context* context, Escargot::String* str, Escargot::String* fileName, bool shouldPrintScriptResult)
+{
+    auto result = context->scriptParser().parse(str, fileName);
+    return execute(context, result, shouldPrintScriptResult);
+}
+
+// parse without executing and report throughput of parser
+NEVER_INLINE bool parseOnly(Escargot::Context* context, Escargot::String* str, Escargot::String* fileName)
+{
+    uint64_t start = Escargot::longTickCount();
+    auto result = context->scriptParser().parse(str, fileName);
+    uint64_t elapsed = Escargot::longTickCount() - start;
+    if (result.m_error) {
+        puts(result.m_error->message->toUTF8StringData().data());
+        return false;
+    }
+    double mbPerSecond = elapsed ? (str->length() / (1024.0 * 1024.0)) / (elapsed / 1000000.0) : 0;
+    printf("%s: %zu chars (%s) parsed in %.3fms, %.2fMB/s\n", fileName->toUTF8StringData().data(), str->length(),
+           str->has8BitContent() ? "8-bit" : "16-bit", elapsed / 1000.0, mbPerSecond);
+    return true;
+}
+
+#ifdef ESCARGOT_ENABLE_THREADING
+// parse every script on its own thread, then execute them in order
+NEVER_INLINE bool evalInBackground(Escargot::Context* context, std::vector<Escargot::BackgroundParseTask*>& tasks)
+{
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < tasks.size(); i++) {
+        Escargot::BackgroundParseTask* task = tasks[i];
+        threads.push_back(std::thread([task]() {
+            task->run();
+        }));
+    }
+    for (size_t i = 0; i < threads.size(); i++) {
+        threads[i].join();
+    }
+
+    bool success = true;
+    for (size_t i = 0; i < tasks.size(); i++) {
+        auto result = context->scriptParser().finalizeBackgroundParseTask(tasks[i]);
+        if (success && !execute(context, result, false)) {
+            success = false;
+        }
+    }
+    tasks.clear();
+    return success;
+}
+#endif
+
 int main(int argc, char* argv[])
 {
 #ifndef NDEBUG
@@ -89,6 +142,14 @@ int main(int argc, char* argv[])
 #endif
 
     bool runShell = true;
+    bool shouldParseOnly = false;
+    bool shouldProfileAllocation = false;
+    const char* heapSnapshotFile = nullptr;
+#ifdef ESCARGOT_ENABLE_THREADING
+    // with --parse-in-background, files are parsed in parallel before running any of them
+    bool parseInBackground = false;
+    std::vector<Escargot::BackgroundParseTask*> backgroundParseTasks;
+#endif
 
     Escargot::FunctionObject* fnRead = context->globalObject()->getOwnProperty(stateForInit, Escargot::ObjectPropertyName(stateForInit, Escargot::String::fromUTF8("read", 4))).value(stateForInit, context->globalObject()).asFunction();
 
@@ -99,6 +160,30 @@ int main(int argc, char* argv[])
                     runShell = true;
                     continue;
                 }
+                if (strcmp(argv[i], "--parse-only") == 0) {
+                    shouldParseOnly = true;
+                    continue;
+                }
+                // --heap-profile counts allocations by type, --heap-profile=<bytes> also samples allocation sites
+                if (strncmp(argv[i], "--heap-profile", 14) == 0 && (argv[i][14] == '\0' || argv[i][14] == '=')) {
+                    shouldProfileAllocation = true;
+                    Escargot::AllocationProfiler::start(argv[i][14] == '=' ? strtoul(argv[i] + 15, nullptr, 10) : 0);
+                    continue;
+                }
+                if (strcmp(argv[i], "--keep-source-location-table") == 0) {
+                    instance->setKeepsSourceLocationTable(true);
+                    continue;
+                }
+                if (strncmp(argv[i], "--heap-snapshot=", 16) == 0) {
+                    heapSnapshotFile = argv[i] + 16;
+                    continue;
+                }
+#ifdef ESCARGOT_ENABLE_THREADING
+                if (strcmp(argv[i], "--parse-in-background") == 0) {
+                    parseInBackground = true;
+                    continue;
+                }
+#endif
             } else { // `-option` case
                 if (strcmp(argv[i], "-e") == 0) {
                     runShell = false;
@@ -124,6 +209,18 @@ int main(int argc, char* argv[])
             Escargot::Value arg(Escargot::String::fromUTF8(argv[i], strlen(argv[i])));
             Escargot::String* src = Escargot::FunctionObject::call(stateForInit, fnRead, Escargot::Value(), 1, &arg).asString();
 
+            if (shouldParseOnly) {
+                if (!parseOnly(context, src, Escargot::String::fromUTF8(argv[i], strlen(argv[i]))))
+                    return 3;
+                continue;
+            }
+
+#ifdef ESCARGOT_ENABLE_THREADING
+            if (parseInBackground) {
+                backgroundParseTasks.push_back(context->scriptParser().createBackgroundParseTask(src, Escargot::String::fromUTF8(argv[i], strlen(argv[i]))));
+                continue;
+            }
+#endif
             if (!eval(context, src, Escargot::String::fromUTF8(argv[i], strlen(argv[i])), false))
                 return 3;
         } else {
@@ -133,6 +230,26 @@ int main(int argc, char* argv[])
         }
     }
 
+#ifdef ESCARGOT_ENABLE_THREADING
+    if (!evalInBackground(context, backgroundParseTasks))
+        return 3;
+#endif
+
+    if (shouldProfileAllocation) {
+        Escargot::AllocationProfiler::stop();
+        fputs(Escargot::AllocationProfiler::report(context->vmInstance()).data(), stderr);
+    }
+
+    if (heapSnapshotFile) {
+        FILE* fp = fopen(heapSnapshotFile, "w");
+        if (!fp || !Escargot::HeapSnapshot(context).write(fp)) {
+            fprintf(stderr, "Cannot write heap snapshot to %s\n", heapSnapshotFile);
+        }
+        if (fp) {
+            fclose(fp);
+        }
+    }
+
     while (runShell) {
         static char buf[2048];
         printf("escargot> ");
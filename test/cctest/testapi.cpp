@@ -16,10 +16,28 @@
 
 #include <EscargotPublic.h>
 #include <string.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+#ifdef ESCARGOT_ENABLE_THREADING
+#include <atomic>
+#include <thread>
+#endif
 
 #define CHECK(name, cond) \
     printf(name" | %s\n", (cond) ? "pass" : "fail");
 
+static Escargot::SandBoxRef::SandBoxResult evaluateScript(Escargot::ContextRef* ctx, const char* sourceName, const char* script)
+{
+    Escargot::ScriptRef* scriptRef = ctx->scriptParser()->parse(Escargot::StringRef::fromASCII(script, strlen(script)), Escargot::StringRef::fromASCII(sourceName)).m_script;
+    Escargot::SandBoxRef* sb = Escargot::SandBoxRef::create(ctx);
+    auto sandBoxResult = sb->run([&](Escargot::ExecutionStateRef* state) -> Escargot::ValueRef* {
+        return scriptRef->execute(state);
+    });
+    sb->destroy();
+    return sandBoxResult;
+}
+
 int main(int argc, char* argv[])
 {
 #ifndef NDEBUG
@@ -173,6 +191,403 @@ int main(int argc, char* argv[])
         sb->destroy();
     }
 
+    // AST arena test
+    {
+        // AST of script is released by its first execution or by finalizer of script which is never executed
+        const char* arenaScript = "var arenaObject = { a: [1, 2, 3], f: function(x) { return x * 2; } }; arenaObject.f(arenaObject.a[2])";
+        for (size_t i = 0; i < 100; i++) {
+            ctx->scriptParser()->parse(Escargot::StringRef::fromASCII(arenaScript, strlen(arenaScript)), Escargot::StringRef::fromASCII("Arena.js"));
+        }
+        Escargot::ScriptRef* kept = ctx->scriptParser()->parse(Escargot::StringRef::fromASCII(arenaScript, strlen(arenaScript)), Escargot::StringRef::fromASCII("Arena.js")).m_script;
+        GC_gcollect();
+        GC_invoke_finalizers();
+        GC_gcollect();
+        Escargot::SandBoxRef* arenaSandBox = Escargot::SandBoxRef::create(ctx);
+        Escargot::ValueRef* arenaResult = arenaSandBox->run([&](Escargot::ExecutionStateRef* state) -> Escargot::ValueRef* {
+            return kept->execute(state);
+        }).result;
+        arenaSandBox->destroy();
+        CHECK("AST arena kept by unexecuted script", arenaResult->isNumber() && arenaResult->toNumber(es) == 6);
+        const char* brokenScript = "var arenaBroken = { a: [1, 2, 3 }";
+        CHECK("AST arena released on parse error", !ctx->scriptParser()->parse(Escargot::StringRef::fromASCII(brokenScript, strlen(brokenScript)), Escargot::StringRef::fromASCII("Arena.js")).m_script);
+    }
+
+#ifdef ESCARGOT_ENABLE_THREADING
+    // background parse test
+    {
+        // main thread keeps collecting while workers parse. every object made by parser should survive it
+        std::string backgroundScript;
+        for (size_t i = 0; i < 500; i++) {
+            backgroundScript += "function bgF" + std::to_string(i) + "(x) { var s = 'str" + std::to_string(i) + "'; return s + x; }";
+        }
+        backgroundScript += "var bgObject = { name: 'background', list: [1, 2, 3] };"
+                            "bgF499(bgObject.name) + bgObject.list.reduce(function(a, b) { return a + b; }, 0) === 'str499background6'";
+        const char* brokenScript = "var bgBroken = { a: [1, 2, 3 };";
+        std::vector<Escargot::BackgroundParseTaskRef*> tasks;
+        for (size_t i = 0; i < 8; i++) {
+            const char* source = i == 7 ? brokenScript : backgroundScript.data();
+            tasks.push_back(ctx->scriptParser()->createBackgroundParseTask(Escargot::StringRef::fromASCII(source, strlen(source)), Escargot::StringRef::fromASCII("Background.js")));
+        }
+        std::atomic<size_t> finishedCount(0);
+        std::vector<std::thread> threads;
+        for (size_t i = 0; i < tasks.size(); i++) {
+            Escargot::BackgroundParseTaskRef* task = tasks[i];
+            threads.push_back(std::thread([task, &finishedCount]() {
+                task->run();
+                finishedCount++;
+            }));
+        }
+        do {
+            GC_gcollect();
+        } while (finishedCount < tasks.size());
+        for (size_t i = 0; i < threads.size(); i++) {
+            threads[i].join();
+        }
+        bool allParsed = true;
+        for (size_t i = 0; i < 7; i++) {
+            Escargot::ScriptRef* parsed = ctx->scriptParser()->finalizeBackgroundParseTask(tasks[i]).m_script;
+            Escargot::SandBoxRef* sb = Escargot::SandBoxRef::create(ctx);
+            Escargot::ValueRef* result = sb->run([&](Escargot::ExecutionStateRef* state) -> Escargot::ValueRef* {
+                return parsed->execute(state);
+            }).result;
+            sb->destroy();
+            allParsed = allParsed && result->isTrue();
+        }
+        CHECK("Background parse while collecting", allParsed);
+        auto brokenResult = ctx->scriptParser()->finalizeBackgroundParseTask(tasks[7]);
+        CHECK("Background parse error", !brokenResult.m_script && brokenResult.m_error->length());
+    }
+#endif
+
+    // heap snapshot test
+    {
+        // chain -> next -> next -> payload, and payload is reachable only through the chain
+        evaluateScript(ctx, "HeapSnapshot.js", "var snapshotChain = { next: { next: {} } }; var snapshotPayload = [];"
+                                               "for (var i = 0; i < 10000; i++) snapshotPayload.push(i);"
+                                               "snapshotChain.next.next.payload = snapshotPayload; snapshotPayload = undefined;");
+        Escargot::ValueRef* chain = evaluateScript(ctx, "HeapSnapshot.js", "snapshotChain").result;
+        Escargot::ValueRef* next = evaluateScript(ctx, "HeapSnapshot.js", "snapshotChain.next").result;
+        Escargot::ValueRef* payload = evaluateScript(ctx, "HeapSnapshot.js", "snapshotChain.next.next.payload").result;
+
+        Escargot::HeapSnapshotRef* snapshot = Escargot::HeapSnapshotRef::take(ctx);
+        CHECK("HeapSnapshot has nodes", snapshot->nodeCount() > 1 && snapshot->edgeCount() > 1);
+        CHECK("HeapSnapshot self size of array", snapshot->selfSize(payload) >= 10000 * sizeof(void*));
+        CHECK("HeapSnapshot retained size of chain", snapshot->retainedSize(chain) >= snapshot->selfSize(chain) + snapshot->retainedSize(next));
+        CHECK("HeapSnapshot retained size includes dominated array", snapshot->retainedSize(next) >= snapshot->selfSize(payload));
+        CHECK("HeapSnapshot primitive is not a node", snapshot->retainedSize(Escargot::ValueRef::create(1)) == 0);
+        CHECK("HeapSnapshot write", snapshot->writeToFile("testapi.heapsnapshot"));
+        snapshot->destroy();
+        remove("testapi.heapsnapshot");
+
+        // payload is not dominated by chain once global object refers it directly
+        evaluateScript(ctx, "HeapSnapshot.js", "var snapshotKeep = snapshotChain.next.next.payload;");
+        snapshot = Escargot::HeapSnapshotRef::take(ctx);
+        CHECK("HeapSnapshot retained size of shared array", snapshot->retainedSize(chain) < snapshot->selfSize(payload));
+        snapshot->destroy();
+    }
+
+    // rope string and substring view test
+    {
+        // appending in place must not change strings sharing the buffer. ropeBase is moved into buffer by its fifth append
+        evaluateScript(ctx, "RopeString.js", "var ropeBase = 'abcdefghijklmnopqrstuvwxyz' + '0123'; ropeBase += '45'; ropeBase += '678'; ropeBase += '9'; ropeBase += '!';"
+                                             "var ropeA = ropeBase + 'aaaaaaaa'; var ropeB = ropeBase + 'bbbbbbbb'; var ropeC = ropeA + '\\u0100';"
+                                             "var ropeLoop = ''; for (var i = 0; i < 1000; i++) ropeLoop += 'chunk' + i + ';';"
+                                             "var ropeDeep = 'x'; for (var i = 0; i < 100; i++) ropeDeep = 'abcdefghijklmnopqrstuvwxyz' + ropeDeep;");
+        CHECK("RopeString shared buffer 1", evaluateScript(ctx, "RopeString.js", "ropeBase === 'abcdefghijklmnopqrstuvwxyz0123456789!'").result->isTrue());
+        CHECK("RopeString shared buffer 2", evaluateScript(ctx, "RopeString.js", "ropeA.slice(-8) === 'aaaaaaaa' && ropeB.slice(-8) === 'bbbbbbbb' && ropeA.length === 45").result->isTrue());
+        CHECK("RopeString widening append", evaluateScript(ctx, "RopeString.js", "ropeC.charCodeAt(45) === 0x100 && ropeC.indexOf('aaaaaaaa') === 37").result->isTrue());
+        CHECK("RopeString append loop", evaluateScript(ctx, "RopeString.js", "ropeLoop.split(';')[999] === 'chunk999' && ropeLoop.substring(5, 12) === '0;chunk'").result->isTrue());
+        CHECK("RopeString charAt and substring on tree", evaluateScript(ctx, "RopeString.js", "ropeDeep.charAt(ropeDeep.length - 1) === 'x' && ropeDeep.substring(26, 30) === 'abcd' && ropeDeep.length === 2601").result->isTrue());
+
+        // 100-character token of 2601-character source is copied with ratio 16, and is a view without limit
+        Escargot::VMInstanceRef::SubStringViewStatistics before = vm->subStringViewStatistics();
+        CHECK("SubStringView copied by ratio", evaluateScript(ctx, "RopeString.js", "ropeDeep.substring(100, 200).length === 100").result->isTrue() && vm->subStringViewStatistics().copiedCount == before.copiedCount + 1);
+        vm->setSubStringViewRetentionRatio(0);
+        before = vm->subStringViewStatistics();
+        CHECK("SubStringView made without limit", evaluateScript(ctx, "RopeString.js", "ropeDeep.substring(100, 200) === ropeDeep.substring(100, 200)").result->isTrue() && vm->subStringViewStatistics().viewCount == before.viewCount + 2);
+        CHECK("SubStringView viewed source bytes", vm->subStringViewStatistics().viewedSourceBytes >= before.viewedSourceBytes + 2 * 2500);
+        vm->setSubStringViewRetentionRatio(16);
+    }
+
+    // stack trace location test
+    {
+        const char* script = "function stackOuter() {\n"
+                             "    stackInner();\n"
+                             "}\r\n"
+                             "function stackInner() {\n"
+                             "    var a = 1; throw new Error('stack');\n"
+                             "}\n"
+                             "stackOuter();\n";
+        // throw statement in stackInner, call in stackOuter and call in global code. column starts from 1
+        auto hasExpectedLocations = [](const Escargot::SandBoxRef::SandBoxResult& result) -> bool {
+            const size_t expected[3][2] = { { 5, 16 }, { 2, 5 }, { 7, 1 } };
+            if (result.stackTraceData.size() < 3) {
+                return false;
+            }
+            for (size_t i = 0; i < 3; i++) {
+                if (result.stackTraceData[i].loc.line != expected[i][0] || result.stackTraceData[i].loc.column != expected[i][1]) {
+                    return false;
+                }
+            }
+            return true;
+        };
+        CHECK("Stack trace with reparsing", hasExpectedLocations(evaluateScript(ctx, "StackTrace.js", script)));
+        vm->setKeepsSourceLocationTable(true);
+        CHECK("Stack trace with source location table", hasExpectedLocations(evaluateScript(ctx, "StackTrace.js", script)));
+        vm->setKeepsSourceLocationTable(false);
+    }
+
+    // interpreter stack test
+    {
+        // JS functions called from JS run on InterpreterStack inside one interpreter loop, so throw unwinds those frames in the loop
+        evaluateScript(ctx, "InterpreterStack.js", "function thrower(n) { if (n === 0) throw new Error('deep'); return thrower(n - 1) + 1; }"
+                                                   "function catcher(n) { try { return thrower(n); } catch (e) { return e.message + n; } }"
+                                                   "function keepsLocals(a) { var b = a * 2; try { thrower(10); } catch (e) { } return a + b; }"
+                                                   "function withFinally(n) { var log = []; try { try { thrower(n); } finally { log.push('f'); } } catch (e) { log.push(e.message); } return log.join(); }"
+                                                   "var depth = 0; function recurse() { depth++; recurse(); }"
+                                                   "function overflow() { depth = 0; try { recurse(); } catch (e) { return (e instanceof RangeError && e.message === 'Maximum call stack size exceeded') ? depth : -1; } return -2; }"
+                                                   "function catchAt(n) { if (n === 0) { return overflow() > 0 ? 'caught' : 'wrong'; } return catchAt(n - 1); }"
+                                                   "function sum(n) { return n ? n + sum(n - 1) : 0; }");
+        CHECK("Interpreter stack throw across frames", evaluateScript(ctx, "InterpreterStack.js", "var ok = catcher(50) === 'deep50' && keepsLocals(3) === 9 && withFinally(30) === 'f,deep';"
+                                                                                                 "for (var i = 0; i < 100; i++) ok = ok && catcher(i) === 'deep' + i; ok")
+                                                          .result->isTrue());
+        // frames that do not fit in INTERPRETER_STACK_LIMIT (32MB) are called with C++ recursion until it overflows
+        CHECK("Interpreter stack overflow", evaluateScript(ctx, "InterpreterStack.js", "var first = overflow(), second = overflow(); first > 10000 && second > 10000").result->isTrue());
+        CHECK("Interpreter stack overflow caught in frames", evaluateScript(ctx, "InterpreterStack.js", "catchAt(1000) === 'caught' && sum(10000) === 50005000 && catcher(5) === 'deep5'").result->isTrue());
+        GC_gcollect();
+        CHECK("Interpreter stack after collection", evaluateScript(ctx, "InterpreterStack.js", "sum(10000) === 50005000 && overflow() > 10000").result->isTrue());
+
+        const char* script = "function traceA() {\n"
+                             "    return traceB(2);\n"
+                             "}\n"
+                             "function traceB(n) {\n"
+                             "    return n ? traceB(n - 1) : traceC();\n"
+                             "}\n"
+                             "function traceC() { null.x; }\n"
+                             "traceA();\n";
+        // every inline frame adds its call site: traceC, three traceB, traceA and global code
+        Escargot::SandBoxRef::SandBoxResult result = evaluateScript(ctx, "InterpreterStackTrace.js", script);
+        const size_t expectedLines[] = { 7, 5, 5, 5, 2, 8 };
+        bool hasExpectedLines = result.error && result.stackTraceData.size() >= 6;
+        for (size_t i = 0; hasExpectedLines && i < 6; i++) {
+            hasExpectedLines = result.stackTraceData[i].loc.line == expectedLines[i];
+        }
+        CHECK("Interpreter stack trace", hasExpectedLines);
+    }
+
+    // lazy function parsing test
+    {
+        // function bodies are only syntax checked while parsing program and get AST when they are called first time.
+        // same code should give same results and same errors at top level (always built) and in (nested) functions
+        evaluateScript(ctx, "LazyParse.js", "function lazyResults(src) { var body = 'var result; ' + src + '; return result;';"
+                                            "var results = [eval(body.replace('return result;', 'result')), eval('(function() { ' + body + ' })')(), eval('(() => { ' + body + ' })')(),"
+                                            "eval('(function() { return (() => (function() { ' + body + ' })())(); })')()];"
+                                            "return results.every(function(r) { return JSON.stringify([r]) === JSON.stringify([results[0]]); }); }"
+                                            "function lazyErrorOf(src) { try { eval(src); return 'none'; } catch (e) { return e.name + ': ' + e.message; } }"
+                                            "function lazyErrors(src) { var error = lazyErrorOf(src); return error !== 'none' && error === lazyErrorOf('(function() { ' + src + ' })')"
+                                            "&& error === lazyErrorOf('(() => { ' + src + ' })') && error === lazyErrorOf('(function() { var f = () => { ' + src + ' }; })'); }");
+        CHECK("Lazy parsing same results", evaluateScript(ctx, "LazyParse.js", "['result = 0; for (var i = 0; i < 10; i++) result += i * 2',"
+                                                                           "\"result = ''; outer: for (var k in { a: 1, b: 2 }) { for (;;) { result += k; continue outer; } }\","
+                                                                           "'var o = { get x() { return 7; }, \"y\": 2, 3: 4, __proto__: { z: 1 } }; result = o.x + o.y + o[3] + o.z',"
+                                                                           "'try { throw 5; } catch (e) { result = e; } finally { result++; }',"
+                                                                           "'var f = (a, b) => a * b, g = x => (y => x + y); result = f(6, 7) + g(1)(2)',"
+                                                                           "'var h = function fact(n) { return n ? n * fact(n - 1) : 1; }; result = h(5)',"
+                                                                           "'result = typeof eval(\"this\") + eval(\"typeof result\")',"
+                                                                           "'switch (3) { case 1: result = 1; case 3: result = 3; default: result += 1; }',"
+                                                                           "'result = [1, , 3].length + `a${1 + 1}b` + (1, 2) + ([1, 2] + -(~3))',"
+                                                                           "'result = (function() { return arguments.length; })(1, 2, 3) + (() => 1)()'].every(lazyResults)")
+                                                          .result->isTrue());
+        CHECK("Lazy parsing same errors", evaluateScript(ctx, "LazyParse.js", "['var o = { a: 1, get a() {} };', '\"use strict\"; var o = { a: 1, a: 2 };', 'var o = { __proto__: 1, \"__proto__\": 2 };',"
+                                                                          "'\"use strict\"; with (o) {}', '\"use strict\"; var eval = 1;', '\"use strict\"; arguments = 1;', '\"use strict\"; (function eval() {});',"
+                                                                          "'\"use strict\"; for (var i = 0 in o) {}', 'break;', 'continue foo;', 'a: a: 1;', 'switch (1) { default: default: }',"
+                                                                          "'1 +;', 'a = 1 = 2;', 'var a = (b, c) => ;', '\"use strict\"; (eval) => 1;', '(1) => 1;', 'new;', 'try {} x;'].every(lazyErrors)")
+                                                         .result->isTrue());
+    }
+
+    // unboxed double field test
+    {
+        // number fields of objects in transition mode are stored as raw doubles.
+        // storing something else generalizes the field of the structure, so objects sharing it must keep their values
+        evaluateScript(ctx, "UnboxedDouble.js", "function makePoint(x, y) { return { x: x, y: y }; } function readX(o) { return o.x; } function writeX(o, v) { o.x = v; }"
+                                                "var p1 = makePoint(1.5, 2.5), p2 = makePoint(-0, NaN), p3 = makePoint(Infinity, 1e300);"
+                                                "for (var i = 0; i < 10; i++) { readX(p1); writeX(p3, Infinity); }");
+        CHECK("Unboxed double values", evaluateScript(ctx, "UnboxedDouble.js", "p1.x === 1.5 && p1.y === 2.5 && Object.is(p2.x, -0) && Number.isNaN(p2.y) && p3.x === Infinity && p3.y === 1e300").result->isTrue());
+        CHECK("Unboxed double to pointer", evaluateScript(ctx, "UnboxedDouble.js", "writeX(p2, 'str'); writeX(p1, { v: 3 }); p2.x === 'str' && p1.x.v === 3 && readX(p3) === Infinity"
+                                                                                   "&& Number.isNaN(p2.y) && p1.y === 2.5 && readX(p1).v === 3 && readX(p2) === 'str'").result->isTrue());
+        CHECK("Unboxed double from pointer", evaluateScript(ctx, "UnboxedDouble.js", "writeX(p1, 0.25); writeX(p2, -0); var p4 = makePoint(7.5, 'y');"
+                                                                                     "readX(p1) === 0.25 && Object.is(readX(p2), -0) && readX(p4) === 7.5 && p4.y === 'y' && makePoint(null, 1).x === null").result->isTrue());
+        CHECK("Unboxed double integer and double", evaluateScript(ctx, "UnboxedDouble.js", "var q = makePoint(0.5, 1); for (var i = 0; i < 100; i++) { q.x += 1; q.y = q.y * 2; }"
+                                                                                           "q.x === 100.5 && q.y === Math.pow(2, 100) && (q.x = 3, q.x === 3) && (q.x = 2147483648, q.x === 2147483648)").result->isTrue());
+        CHECK("Unboxed double reflection", evaluateScript(ctx, "UnboxedDouble.js", "var r = makePoint(1.25, -2.5); JSON.stringify(r) === '{\"x\":1.25,\"y\":-2.5}' && Object.keys(r).join() === 'x,y'"
+                                                                                   "&& Object.getOwnPropertyDescriptor(r, 'y').value === -2.5 && Object.values(r)[0] === 1.25").result->isTrue());
+        CHECK("Unboxed double to accessor", evaluateScript(ctx, "UnboxedDouble.js", "var s = makePoint(4.5, 5.5); Object.defineProperty(s, 'x', { get: function() { return 'g'; } });"
+                                                                                    "s.x === 'g' && s.y === 5.5 && readX(s) === 'g' && makePoint(6.5, 0).x === 6.5").result->isTrue());
+        CHECK("Unboxed double freeze and delete", evaluateScript(ctx, "UnboxedDouble.js", "var t = makePoint(8.5, 9.5); Object.freeze(t); writeX(t, 1); var u = makePoint(10.5, 11.5); delete u.x;"
+                                                                                          "t.x === 8.5 && t.y === 9.5 && !('x' in u) && u.y === 11.5 && (u.x = 12.5, u.x === 12.5)").result->isTrue());
+        GC_gcollect();
+        CHECK("Unboxed double after collection", evaluateScript(ctx, "UnboxedDouble.js", "p1.x === 0.25 && p1.y === 2.5 && p3.y === 1e300 && Number.isNaN(p2.y) && q.x === 2147483648").result->isTrue());
+    }
+
+    // dictionary mode object test
+    {
+        evaluateScript(ctx, "Dictionary.js", "var dict = {}; for (var i = 0; i < 1000; i++) dict['k' + i] = i;"
+                                             "for (var i = 0; i < 1000; i += 2) delete dict['k' + i];"
+                                             "dict.k1 = 'one'; Object.defineProperty(dict, 'k3', { enumerable: false });"
+                                             "function readK5(o) { return o.k5; } for (var i = 0; i < 10; i++) readK5(dict);");
+        CHECK("Dictionary mode keys", evaluateScript(ctx, "Dictionary.js", "var keys = Object.keys(dict); keys.length === 499 && keys[0] === 'k1' && keys[1] === 'k5' && keys[498] === 'k999'").result->isTrue());
+        CHECK("Dictionary mode values", evaluateScript(ctx, "Dictionary.js", "dict.k1 === 'one' && dict.k3 === 3 && dict.k999 === 999 && !('k0' in dict) && dict.k0 === undefined").result->isTrue());
+        CHECK("Dictionary mode for-in with delete", evaluateScript(ctx, "Dictionary.js", "var seen = 0; for (var k in dict) { delete dict.k999; seen++; } seen === 498").result->isTrue());
+        CHECK("Dictionary mode inline cache", evaluateScript(ctx, "Dictionary.js", "delete dict.k5; readK5(dict) === undefined && (dict.k5 = 5, readK5(dict) === 5)").result->isTrue());
+        // named reads without change bring object back to cacheable structure, and next delete makes it dictionary again
+        CHECK("Dictionary mode left after reads", evaluateScript(ctx, "Dictionary.js", "var dictRead = {}; for (var i = 0; i < 200; i++) dictRead['k' + i] = i; delete dictRead.k0;"
+                                                                                     "function readK7(o) { return o.k7; } var sum = 0; for (var i = 0; i < 1000; i++) sum += readK7(dictRead);"
+                                                                                     "dictRead.k7 = 8; delete dictRead.k9; dictRead.extra = 1; var keys = Object.keys(dictRead);"
+                                                                                     "sum === 7000 && readK7(dictRead) === 8 && dictRead.k9 === undefined && keys.length === 199 && keys[0] === 'k1' && keys[198] === 'extra'")
+                                                    .result->isTrue());
+        CHECK("Dictionary mode as prototype", evaluateScript(ctx, "Dictionary.js", "var child = Object.create(dict); child.k7 === 7 && Object.keys(dict).length === 498").result->isTrue());
+    }
+
+#ifndef NDEBUG
+    // object structure transition table test
+    {
+        // 20 different first properties of empty object make one transition table with fan-out 20
+        Escargot::VMInstanceRef::ObjectStructureStatistics before = vm->objectStructureStatistics();
+        evaluateScript(ctx, "Transition.js", "function makeShapes() { var r = []; for (var i = 0; i < 20; i++) { var o = {}; o['fanOut' + i] = i; o.tail = i; r.push(o); } return r; }"
+                                             "var shapes = makeShapes();");
+        Escargot::VMInstanceRef::ObjectStructureStatistics after = vm->objectStructureStatistics();
+        CHECK("Transition table moved into hash map", after.hashMapTableCount > before.hashMapTableCount && after.maxTransitionFanOut >= 20);
+        CHECK("Transition table lookups", after.transitionLookupCount > before.transitionLookupCount && after.transitionLookupDepth >= after.transitionLookupCount);
+
+        // same shapes again are found in tables without making new structures
+        before = after;
+        // local variable keeps global object from getting new property
+        CHECK("Transition table hit", evaluateScript(ctx, "Transition.js", "(function() { var again = makeShapes(); return again[7].fanOut7 === 7 && again[19].tail === 19 && Object.keys(again[3]).join() === 'fanOut3,tail'; })()").result->isTrue());
+        after = vm->objectStructureStatistics();
+        CHECK("Transition table reuses structures", after.structureCount == before.structureCount && after.transitionCount == before.transitionCount);
+    }
+#endif
+
+    // Math and String intrinsic test
+    {
+        CHECK("Math intrinsic numbers", evaluateScript(ctx, "Intrinsic.js", "Math.floor(-1.5) === -2 && Math.ceil(1.2) === 2 && Math.abs(-3) === 3 && Math.sqrt(16) === 4 && Math.round(2.5) === 3 && Math.pow(2, 10) === 1024").result->isTrue());
+        CHECK("Math intrinsic -0 and NaN", evaluateScript(ctx, "Intrinsic.js", "1 / Math.round(-0.5) === -Infinity && 1 / Math.max(-0, 0) === Infinity && 1 / Math.min(0, -0) === -Infinity && isNaN(Math.max(1, NaN)) && Math.sin(0) === 0 && Math.cos(0) === 1").result->isTrue());
+        CHECK("Math intrinsic non-number arguments", evaluateScript(ctx, "Intrinsic.js", "var calls = 0; var o = { valueOf: function() { calls++; return 2.5; } }; Math.floor(o) === 2 && Math.max(o, '7') === 7 && calls === 2").result->isTrue());
+        CHECK("Math intrinsic shadowed Math", evaluateScript(ctx, "Intrinsic.js", "(function() { var Math = { floor: function(x) { return 'local' + x; } }; return Math.floor(1.5); })() === 'local1.5'").result->isTrue());
+        CHECK("Math intrinsic replaced function", evaluateScript(ctx, "Intrinsic.js", "var savedFloor = Math.floor; function floorIt(x) { return Math.floor(x); } floorIt(1.5);"
+                                                                                      "Math.floor = function(x) { return this === Math ? 'replaced' : 'bad receiver'; }; var r = floorIt(1.5); Math.floor = savedFloor; r === 'replaced' && floorIt(1.5) === 1").result->isTrue());
+        CHECK("Math intrinsic property added to Math", evaluateScript(ctx, "Intrinsic.js", "(function() { Math.extraProperty = 1; var ok = Math.floor(1.5) === 1; delete Math.extraProperty; return ok && Math.floor(2.5) === 2; })()").result->isTrue());
+        CHECK("Math intrinsic accessor", evaluateScript(ctx, "Intrinsic.js", "(function() { var savedFloor = Math.floor; var getterCalls = 0; Object.defineProperty(Math, 'floor', { get: function() { getterCalls++; return savedFloor; }, configurable: true });"
+                                                                              " var x = 1.5; var r = Math.floor(x) + Math.floor(2.5); Object.defineProperty(Math, 'floor', { value: savedFloor, writable: true, configurable: true });"
+                                                                              " return r === 3 && getterCalls === 2 && Math.floor(1.5) === 1; })()").result->isTrue());
+        CHECK("Math intrinsic deleted function", evaluateScript(ctx, "Intrinsic.js", "(function() { var savedFloor = Math.floor; delete Math.floor; var threw = false; try { Math.floor(1.5); } catch (e) { threw = e instanceof TypeError; }"
+                                                                                      " Math.floor = savedFloor; return threw && Math.floor(1.5) === 1; })()").result->isTrue());
+        CHECK("Math intrinsic replaced Math", evaluateScript(ctx, "Intrinsic.js", "var savedMath = Math; Math = { floor: function(x) { return 'other' + x; } }; var r = Math.floor(1.5) === 'other1.5'; Math = savedMath; r && Math.floor(1.5) === 1").result->isTrue());
+        CHECK("Math intrinsic replaced function with arguments", evaluateScript(ctx, "Intrinsic.js", "(function() { var savedFloor = Math.floor; var y = 2.5; Math.floor = function(x) { return 'replaced' + x; };"
+                                                                                                      " var r = Math.floor(y) === 'replaced2.5' && Math.floor({ valueOf: function() { return 3.5; } }) === 'replaced3.5'; Math.floor = savedFloor; return r; })()").result->isTrue());
+        // callee is loaded before arguments are evaluated
+        CHECK("Math intrinsic evaluation order", evaluateScript(ctx, "Intrinsic.js", "(function() { var savedFloor = Math.floor; var r = Math.floor((Math.floor = function() { return 'g'; }, 1.5)); Math.floor = savedFloor; return r === 1; })()").result->isTrue());
+
+        evaluateScript(ctx, "Intrinsic.js", "var latin = 'ab\\u00e9'; var wide = 'a\\uac00'; var ropeStr = 'abcdefghijklmnopqrstuvwxyz'; ropeStr += '0123456789';");
+        CHECK("String index fast path", evaluateScript(ctx, "Intrinsic.js", "latin[0] === 'a' && latin[2] === '\\u00e9' && wide[1] === '\\uac00' && latin[3] === undefined && ropeStr[30] === '4'").result->isTrue());
+        CHECK("String charCodeAt intrinsic", evaluateScript(ctx, "Intrinsic.js", "latin.charCodeAt(2) === 0xe9 && wide.charCodeAt(1) === 0xac00 && isNaN(latin.charCodeAt(3)) && latin.charCodeAt('1') === 98 && ropeStr.charCodeAt(35) === 57").result->isTrue());
+        CHECK("String charAt intrinsic", evaluateScript(ctx, "Intrinsic.js", "latin.charAt(1) === 'b' && wide.charAt(1) === '\\uac00' && latin.charAt(5) === '' && latin.charAt(-1) === ''").result->isTrue());
+        CHECK("String intrinsic non-string receiver", evaluateScript(ctx, "Intrinsic.js", "var fake = { charAt: function(i) { return 'fake' + i; } }; fake.charAt(1) === 'fake1' && String.prototype.charCodeAt.call(12, 1) === 50").result->isTrue());
+        CHECK("String intrinsic replaced function", evaluateScript(ctx, "Intrinsic.js", "var savedCharAt = String.prototype.charAt; String.prototype.charAt = function(i) { return 'replaced'; };"
+                                                                                        "var r = latin.charAt(0); String.prototype.charAt = savedCharAt; r === 'replaced' && latin.charAt(0) === 'a'").result->isTrue());
+    }
+
+    // number to string cache test
+    {
+        // number to string results should not depend on cache
+        const char* numberToStringScript = "[0, -0, 7, -7, 127, 128, -2147483648, 2147483647, 4294967296, 9007199254740991, -9007199254740991, 9007199254740992,"
+                                           " 123456789012345680000, 1e21, 0.1, -1.5, 1e-7, 5e-324, 1.7976931348623157e308].join() + ',' + [1024, 1024][1] + ({ 1000: 'k' })[1000]";
+        const char* numberToStringExpected = "0,0,7,-7,127,128,-2147483648,2147483647,4294967296,9007199254740991,-9007199254740991,9007199254740992,"
+                                             "123456789012345680000,1e+21,0.1,-1.5,1e-7,5e-324,1.7976931348623157e+308,1024k";
+        std::string numberToStringCheck = std::string("(") + numberToStringScript + ") === '" + numberToStringExpected + "'";
+        CHECK("Number to string", evaluateScript(ctx, "Intrinsic.js", numberToStringCheck.data()).result->isTrue() && evaluateScript(ctx, "Intrinsic.js", numberToStringCheck.data()).result->isTrue());
+        size_t numberToStringCacheSize = vm->numberToStringCacheSize();
+        vm->setNumberToStringCacheSize(0);
+        CHECK("Number to string without cache", evaluateScript(ctx, "Intrinsic.js", numberToStringCheck.data()).result->isTrue() && vm->numberToStringCacheSize() == 0);
+        vm->setNumberToStringCacheSize(100);
+        CHECK("Number to string cache size", evaluateScript(ctx, "Intrinsic.js", numberToStringCheck.data()).result->isTrue() && vm->numberToStringCacheSize() == 128);
+        vm->setNumberToStringCacheSize(~(size_t)0);
+        size_t clampedSize = vm->numberToStringCacheSize();
+        CHECK("Number to string cache size clamped", clampedSize && clampedSize < ~(size_t)0 && !(clampedSize & (clampedSize - 1)));
+        vm->setNumberToStringCacheSize(numberToStringCacheSize);
+    }
+
+    // locale formatter cache test
+    {
+        CHECK("Locale date string", evaluateScript(ctx, "LocaleCache.js", "var d1 = new Date(2001, 1, 3, 4, 5, 6); var d2 = new Date(2010, 10, 20, 21, 22, 23);"
+                                                                          "d1.toLocaleDateString() === d1.toLocaleDateString() && d1.toLocaleDateString() !== d2.toLocaleDateString()"
+                                                                          " && d1.toLocaleTimeString() === d1.toLocaleTimeString() && d1.toLocaleTimeString() !== d2.toLocaleTimeString()").result->isTrue());
+        CHECK("Intl collator cache", evaluateScript(ctx, "LocaleCache.js", "typeof Intl === 'undefined' || (function() { var a = new Intl.Collator('en'); var b = new Intl.Collator('en'); var n = new Intl.Collator('en', { numeric: true });"
+                                                                           " return a.compare('a', 'b') < 0 && b.compare('a', 'b') < 0 && a.compare('a10', 'a9') < 0 && n.compare('a10', 'a9') > 0; })()").result->isTrue());
+        CHECK("Intl number format cache", evaluateScript(ctx, "LocaleCache.js", "typeof Intl === 'undefined' || (function() { var a = new Intl.NumberFormat('en'); var b = new Intl.NumberFormat('en', { minimumFractionDigits: 2 });"
+                                                                                " return a.format(1) === '1' && b.format(1) === '1.00' && new Intl.NumberFormat('en').format(1) === '1'; })()").result->isTrue());
+        CHECK("Intl date format cache", evaluateScript(ctx, "LocaleCache.js", "typeof Intl === 'undefined' || (function() { var d = Date.UTC(2001, 1, 3); var a = new Intl.DateTimeFormat('en', { timeZone: 'UTC' });"
+                                                                              " var b = new Intl.DateTimeFormat('en', { timeZone: 'UTC' }); var y = new Intl.DateTimeFormat('en', { timeZone: 'UTC', year: 'numeric' });"
+                                                                              " return a.format(d) === b.format(d) && y.format(d) === '2001'; })()").result->isTrue());
+    }
+
+    // timezone offset cache test
+    {
+        // local time should round trip while cached ranges are extended across DST changes, forward and backward
+        CHECK("Timezone offset round trip", evaluateScript(ctx, "TimezoneOffset.js", "(function() { for (var day = 0; day < 731; day += 3) { var d = new Date(2016, 0, 1 + day, 12, 30);"
+                                                                                     " if (d.getHours() !== 12 || d.getMinutes() !== 30 || new Date(d.getFullYear(), d.getMonth(), d.getDate(), 12, 30).getTime() !== d.getTime()) return false; }"
+                                                                                     " for (var t = Date.UTC(2018, 0, 1); t > Date.UTC(2016, 0, 1); t -= 7 * 3600000) { var e = new Date(t);"
+                                                                                     " if (e.getTime() - Date.UTC(e.getFullYear(), e.getMonth(), e.getDate(), e.getHours(), e.getMinutes()) !== e.getTimezoneOffset() * 60000) return false; }"
+                                                                                     " return true; })()").result->isTrue());
+        CHECK("Timezone offset far dates", evaluateScript(ctx, "TimezoneOffset.js", "var far = [new Date(1900, 5, 1, 10), new Date(2100, 11, 1, 10), new Date(1970, 0, 1, 10)];"
+                                                                                    "far.every(function(d) { return d.getHours() === 10 && d.getMinutes() === 0; })").result->isTrue());
+    }
+
+    // date string fast path test
+    {
+        CHECK("ISO date parse", evaluateScript(ctx, "DateString.js", "Date.parse('2017-03-04T05:06:07.089Z') === Date.UTC(2017, 2, 4, 5, 6, 7, 89) && Date.parse('2016-02-29') === Date.UTC(2016, 1, 29)"
+                                                                     " && Date.parse('+020000-01-01T00:00:00.000Z') === Date.UTC(20000, 0, 1) && Date.parse('-000001-12-31T23:59Z') === Date.UTC(-1, 11, 31, 23, 59)"
+                                                                     " && Date.parse('2017-03-04T05:06:07.5+09:00') === Date.UTC(2017, 2, 3, 20, 6, 7, 500) && Date.parse('2017-03-04T05:06') === new Date(2017, 2, 4, 5, 6).getTime()").result->isTrue());
+        // leading space skips fast path, so results of previous parsers are compared, including strings which fast path rejects
+        CHECK("ISO date parse same with previous parser", evaluateScript(ctx, "DateString.js", "['2017-03-04', '1969-12-31T23:59:59.999Z', '2000-02-29T12:00:00+05:30', '2000-02-29T12:00:00-11:45', '2017-03-04T05:06:07',"
+                                                                                               " '2017-03-04T05:06:07.1Z', '2017-03-04T05:06:07.12Z', '+002017-03-04T05:06Z', '-271821-04-20T00:00:00Z', '2017-03-04T24:00:00Z', '2017-03-04T05:06:07.123456Z',"
+                                                                                               " '2017-02-29', '2017-13-01', '2017-01-32', '2017-01-01T25:00Z', '2017-01-01T10:60Z', '-000000-01-01', '2017-01-01T10:00+0900']"
+                                                                                               ".every(function(s) { var a = Date.parse(s); var b = Date.parse(' ' + s); return a === b || (isNaN(a) && isNaN(b)); })").result->isTrue());
+        CHECK("ISO date format", evaluateScript(ctx, "DateString.js", "new Date(Date.UTC(2017, 2, 4, 5, 6, 7, 89)).toISOString() === '2017-03-04T05:06:07.089Z' && new Date(Date.UTC(-1, 0, 1)).toISOString() === '-000001-01-01T00:00:00.000Z'"
+                                                                      " && new Date(8.64e15).toISOString() === '+275760-09-13T00:00:00.000Z' && new Date(Date.UTC(1969, 11, 31, 23, 59, 59, 999)).toISOString() === '1969-12-31T23:59:59.999Z'").result->isTrue());
+        CHECK("UTC date format", evaluateScript(ctx, "DateString.js", "new Date(Date.UTC(2017, 2, 4, 5, 6, 7)).toUTCString() === 'Sat, 04 Mar 2017 05:06:07 GMT' && new Date(Date.UTC(-1, 0, 1)).toUTCString() === 'Fri, 01 Jan -1 00:00:00 GMT'"
+                                                                      " && new Date(0).toGMTString() === 'Thu, 01 Jan 1970 00:00:00 GMT' && new Date(NaN).toUTCString() === 'Invalid Date'").result->isTrue());
+        CHECK("ISO date round trip", evaluateScript(ctx, "DateString.js", "(function() { for (var t = -62198755200000; t < 253402300800000; t += 86400000 * 97 + 3723004) {"
+                                                                          " if (Date.parse(new Date(t).toISOString()) !== t || Date.parse(new Date(-t).toISOString()) !== -t) return false; } return true; })()").result->isTrue());
+    }
+
+#ifdef ESCARGOT_ENABLE_PROMISE
+    // promise job queue test
+    {
+        // more jobs than initial capacity of queue, and rejection by handler
+        evaluateScript(ctx, "JobQueue.js", "var jobOrder = []; var jobChain = Promise.resolve(0);"
+                                           "for (var i = 0; i < 100; i++) { (function(i) { Promise.resolve(i).then(function(v) { jobOrder.push(v); }); })(i); }"
+                                           "for (var i = 0; i < 1000; i++) jobChain = jobChain.then(function(v) { return v + 1; });"
+                                           "var jobRejected = Promise.resolve().then(function() { throw 'jobError'; }).catch(function(e) { return e; });");
+        CHECK("JobQueue drain", vm->drainJobQueue()->isEmpty());
+        CHECK("JobQueue order", evaluateScript(ctx, "JobQueue.js", "jobOrder.length === 100 && jobOrder.every(function(v, i) { return v === i; })").result->isTrue());
+        evaluateScript(ctx, "JobQueue.js", "var jobChainResult; jobChain.then(function(v) { jobChainResult = v; });"
+                                           "var jobRejectedResult; jobRejected.then(function(v) { jobRejectedResult = v; });");
+        vm->drainJobQueue();
+        CHECK("JobQueue promise chain", evaluateScript(ctx, "JobQueue.js", "jobChainResult === 1000").result->isTrue());
+        CHECK("JobQueue rejection by handler", evaluateScript(ctx, "JobQueue.js", "jobRejectedResult === 'jobError'").result->isTrue());
+
+        // reactions of two contexts are queued alternately, and each throws in sandbox of its own context
+        Escargot::ContextRef* ctx2 = Escargot::ContextRef::create(vm);
+        const char* throwingReactions = "var jobCaught = []; for (var i = 0; i < 3; i++) { Promise.resolve(i).then(function(v) { throw v; }).catch(function(e) { jobCaught.push(e); }); }";
+        evaluateScript(ctx, "JobQueue.js", throwingReactions);
+        evaluateScript(ctx2, "JobQueue.js", throwingReactions);
+        CHECK("JobQueue drain with two contexts", vm->drainJobQueue()->isEmpty());
+        CHECK("JobQueue throwing reactions of two contexts", evaluateScript(ctx, "JobQueue.js", "jobCaught.join() === '0,1,2'").result->isTrue()
+                  && evaluateScript(ctx2, "JobQueue.js", "jobCaught.join() === '0,1,2'").result->isTrue());
+        ctx2->destroy();
+    }
+#endif
+
     es->destroy();
     ctx->destroy();
     vm->destroy();
@@ -0,0 +1,37 @@
+#!/bin/bash
+
+# usage: tools/benchmark/background-parse.sh <path to escargot built with THREADING=1> [number of files]
+# loads N generated scripts serially and with --parse-in-background, which parses them on N threads
+# before running them in order. scripts only declare things, so the time is mostly parsing
+if [[ -z "$1" ]]; then
+    echo "usage: $0 <path to escargot> [number of files]"
+    exit 1
+fi
+
+cmd=$1
+count=${2:-16}
+dir=`mktemp -d`
+trap "rm -rf $dir" EXIT
+
+files=""
+for ((n = 0; n < count; n++)); do
+    awk -v n=$n 'BEGIN {
+        for (i = 0; i < 2000; i++) {
+            printf("var record_%d_%d = { id: %d, name: \"record %d\", tags: [\"a\", \"b\", %d], point: { x: %d * 2 + 1, y: (%d - 3) / 4 } };\n", n, i, i, i, i, i, i);
+            printf("function handler_%d_%d(event, options) { if (event.type === \"click\" && options.enabled) { return record_%d_%d.point.x + event.x * (options.scale || 1); }", n, i, n, i);
+            printf(" return [event.x, event.y].map(function(v) { return v > 0 ? v : -v; }).reduce(function(a, b) { return a + b; }, 0); }\n");
+        }
+    }' > $dir/module$n.js
+    files="$files $dir/module$n.js"
+done
+
+run() {
+    local start=`date +%s%N`
+    $cmd "$@" $files > /dev/null || echo "background-parse: failed" >&2
+    local end=`date +%s%N`
+    echo $(((end - start) / 1000000))
+}
+
+serial=`run`
+parallel=`run --parse-in-background`
+echo "background-parse: $count files, serial $serial ms, parallel $parallel ms"
@@ -0,0 +1,53 @@
+// call setup cost by shape of callee: argument count equal to parameter count (no copying),
+// fewer or more arguments than parameters, and a callee whose environment is on heap because a closure captures it
+function exact(a, b, c) {
+    return a + b + c;
+}
+
+function missing(a, b, c) {
+    return c === undefined ? a + b : a + b + c;
+}
+
+function captured(a, b, c) {
+    var read = function() {
+        return a + b + c;
+    };
+    return a;
+}
+
+var calls = 2000000;
+var results = [];
+function report(name, start, sum) {
+    var elapsed = Math.max(Date.now() - start, 1);
+    results.push(name + " " + (calls / 1000 / elapsed).toFixed(2) + " M calls/s (check " + sum + ")");
+}
+
+var sum = 0;
+var start = Date.now();
+for (var i = 0; i < calls; i++) {
+    sum += exact(i & 1, 2, 3);
+}
+report("exact", start, sum);
+
+sum = 0;
+start = Date.now();
+for (var i = 0; i < calls; i++) {
+    sum += missing(i & 1, 2);
+}
+report("missing", start, sum);
+
+sum = 0;
+start = Date.now();
+for (var i = 0; i < calls; i++) {
+    sum += exact(i & 1, 2, 3, 4, 5);
+}
+report("extra", start, sum);
+
+sum = 0;
+start = Date.now();
+for (var i = 0; i < calls; i++) {
+    sum += captured(i & 1, 2, 3);
+}
+report("captured", start, sum);
+
+print("call-overhead: " + results.join(", "));
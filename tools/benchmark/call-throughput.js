@@ -0,0 +1,35 @@
+// calls of small JS functions from a loop: plain, method, constructor and closure calls
+function add(a, b) {
+    return a + b;
+}
+
+function Point(x, y) {
+    this.x = x;
+    this.y = y;
+}
+Point.prototype.length2 = function() {
+    return this.x * this.x + this.y * this.y;
+};
+
+function makeCounter() {
+    var count = 0;
+    return function() {
+        return ++count;
+    };
+}
+
+var calls = 3000000;
+var counter = makeCounter();
+var sum = 0;
+var start = Date.now();
+for (var i = 0; i < calls; i++) {
+    sum = add(sum, 1);
+    sum += new Point(i & 7, 1).length2() & 1;
+    counter();
+}
+var elapsed = Date.now() - start;
+
+if (counter() !== calls + 1) {
+    throw new Error("call-throughput: wrong result");
+}
+print("call-throughput: " + elapsed + " ms, " + (calls * 4 / 1000 / elapsed).toFixed(2) + " M calls/s");
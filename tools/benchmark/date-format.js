@@ -0,0 +1,31 @@
+// local time formatting of timestamps a few minutes apart, as log pipelines and SunSpider date-format-* do.
+// every local getter needs timezone offset, so run with a DST zone (e.g. TZ=America/New_York) to see offset cache
+function pad(n) {
+    return n < 10 ? "0" + n : "" + n;
+}
+
+function format(d) {
+    var offset = -d.getTimezoneOffset();
+    var sign = offset < 0 ? "-" : "+";
+    offset = Math.abs(offset);
+    return d.getFullYear() + "-" + pad(d.getMonth() + 1) + "-" + pad(d.getDate()) + " " + pad(d.getHours()) + ":" + pad(d.getMinutes()) + ":" + pad(d.getSeconds())
+        + " " + sign + pad(Math.floor(offset / 60)) + pad(offset % 60) + " " + d.getDay();
+}
+
+var iterations = 100000;
+// start a day before DST change of 2021 in US, so intervals of both offsets are used
+var base = Date.UTC(2021, 2, 13, 12, 0, 0);
+var length = 0;
+var start = Date.now();
+for (var i = 0; i < iterations; i++) {
+    length += format(new Date(base + i * 7000)).length;
+}
+var getterElapsed = Date.now() - start;
+
+start = Date.now();
+for (var i = 0; i < iterations / 10; i++) {
+    length += new Date(base + i * 60000).toString().length;
+}
+var toStringElapsed = Date.now() - start;
+
+print("date-format: " + getterElapsed + " ms by getters, " + toStringElapsed + " ms by toString for 1/10 dates (check " + length + ")");
@@ -0,0 +1,31 @@
+// stores non-integer numbers into object fields from a loop. such fields are unboxed doubles,
+// so the loop should not allocate. run with --profile-allocation or BENCHMARK_RSS=1 to see it
+function Particle(x, y) {
+    this.x = x;
+    this.y = y;
+    this.vx = 0.5;
+    this.vy = -0.25;
+}
+
+var particles = [];
+for (var i = 0; i < 1000; i++) {
+    particles.push(new Particle(i * 0.1, i * 0.2));
+}
+
+var steps = 3000;
+var start = Date.now();
+for (var s = 0; s < steps; s++) {
+    for (var i = 0; i < particles.length; i++) {
+        var p = particles[i];
+        p.vy -= 0.001;
+        p.x += p.vx * 0.01;
+        p.y += p.vy * 0.01;
+    }
+}
+var elapsed = Date.now() - start;
+
+var check = 0;
+for (var i = 0; i < particles.length; i++) {
+    check += particles[i].x + particles[i].y;
+}
+print("double-fields: " + elapsed + " ms (" + particles.length * steps + " updates, check " + Math.round(check) + ")");
@@ -0,0 +1,23 @@
+// Intl object construction: collators and formatters of a few locales and options made repeatedly, then used once
+if (typeof Intl === "undefined") {
+    print("intl: skipped (built without Intl)");
+} else {
+    var locales = ["en-US", "de-DE", "ko-KR", "fr-FR"];
+    var iterations = 5000;
+    var date = new Date(2001, 1, 3, 4, 5, 6);
+    var length = 0;
+
+    var start = Date.now();
+    for (var i = 0; i < iterations; i++) {
+        var locale = locales[i % locales.length];
+        length += new Intl.Collator(locale, { sensitivity: "base" }).compare("a", "B") < 0 ? 1 : 0;
+        length += new Intl.NumberFormat(locale, { minimumFractionDigits: 2 }).format(i).length;
+        length += new Intl.DateTimeFormat(locale, { year: "numeric", month: "long" }).format(date).length;
+        length += (i * 1.5).toLocaleString(locale).length;
+        length += date.toLocaleDateString(locale).length;
+    }
+    if (length === 0) {
+        throw new Error("intl: wrong result");
+    }
+    print("intl: " + (Date.now() - start) + " ms for " + (iterations * 5) + " collators and formatters");
+}
@@ -0,0 +1,28 @@
+// ISO 8601 round trips as ingestion does it: new Date(isoString) and toISOString on every record,
+// plus toUTCString and strings which need legacy parser
+var iterations = 100000;
+var base = Date.UTC(2020, 0, 1, 0, 0, 0, 123);
+var strings = [];
+for (var i = 0; i < 1000; i++) {
+    strings.push(new Date(base + i * 86399001).toISOString());
+}
+
+var check = 0;
+var start = Date.now();
+for (var i = 0; i < iterations; i++) {
+    var d = new Date(strings[i % strings.length]);
+    if (d.toISOString() === strings[i % strings.length]) {
+        check++;
+    }
+}
+var roundTripElapsed = Date.now() - start;
+
+start = Date.now();
+for (var i = 0; i < iterations / 10; i++) {
+    check += new Date(base + i * 1000).toUTCString().length;
+    check += Date.parse("2021-03-04") > 0 ? 1 : 0;
+    check += Date.parse("Thu, 04 Mar 2021 05:06:07 GMT") > 0 ? 1 : 0;
+}
+var otherElapsed = Date.now() - start;
+
+print("iso-date: " + roundTripElapsed + " ms for " + iterations + " round trips, " + otherElapsed + " ms for other formats (check " + check + ")");
@@ -0,0 +1,51 @@
+// numeric code calling Math functions in hot loops, like SunSpider math-* and 3d-* do.
+// the last loop replaces Math.sqrt, so its calls take the guarded slow path of the intrinsic
+function rotate(points, angle) {
+    var c = Math.cos(angle);
+    var s = Math.sin(angle);
+    for (var i = 0; i < points.length; i += 2) {
+        var x = points[i];
+        var y = points[i + 1];
+        points[i] = x * c - y * s;
+        points[i + 1] = x * s + y * c;
+    }
+}
+
+function bounds(points) {
+    var lo = Infinity;
+    var hi = -Infinity;
+    var length = 0;
+    for (var i = 0; i < points.length; i += 2) {
+        lo = Math.min(lo, Math.floor(points[i]));
+        hi = Math.max(hi, Math.ceil(points[i + 1]));
+        length += Math.sqrt(Math.pow(points[i], 2) + points[i + 1] * points[i + 1]);
+    }
+    return Math.round(Math.abs(hi - lo) + length);
+}
+
+var points = [];
+for (var i = 0; i < 2000; i++) {
+    points.push(i * 0.5, 1000 - i * 0.25);
+}
+
+var iterations = 300;
+var check = 0;
+var start = Date.now();
+for (var i = 0; i < iterations; i++) {
+    rotate(points, 0.01);
+    check += bounds(points);
+}
+var elapsed = Date.now() - start;
+
+var originalSqrt = Math.sqrt;
+Math.sqrt = function(v) {
+    return originalSqrt(v);
+};
+start = Date.now();
+for (var i = 0; i < iterations / 10; i++) {
+    check += bounds(points);
+}
+var replacedElapsed = Date.now() - start;
+Math.sqrt = originalSqrt;
+
+print("math-heavy: " + elapsed + " ms, " + replacedElapsed + " ms with Math.sqrt replaced for 1/10 iterations (check " + check + ")");
@@ -0,0 +1,32 @@
+// number to string conversion as CSV and log formatting do it: integers, doubles, repeated values
+// which hit number-string cache, and numbers used as property keys
+var iterations = 200000;
+var length = 0;
+
+var start = Date.now();
+for (var i = 0; i < iterations; i++) {
+    length += String(i * 7919).length + ("" + (-i)).length;
+}
+var intElapsed = Date.now() - start;
+
+start = Date.now();
+for (var i = 0; i < iterations; i++) {
+    length += String(i / 7).length + (i * 0.1).toString().length;
+}
+var doubleElapsed = Date.now() - start;
+
+start = Date.now();
+for (var i = 0; i < iterations; i++) {
+    length += String((i & 63) + 0.5).length + String(1e6 + (i & 255)).length;
+}
+var repeatedElapsed = Date.now() - start;
+
+var keyed = {};
+start = Date.now();
+for (var i = 0; i < iterations; i++) {
+    keyed[i * 3 + 0.25] = i;
+}
+length += Object.keys(keyed).length;
+var keyElapsed = Date.now() - start;
+
+print("number-to-string: int " + intElapsed + " ms, double " + doubleElapsed + " ms, repeated " + repeatedElapsed + " ms, keys " + keyElapsed + " ms (check " + length + ")");
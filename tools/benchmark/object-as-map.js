@@ -0,0 +1,32 @@
+// plain objects used as hash maps: thousands of string keys added, read, overwritten, deleted and redefined.
+// such objects go to dictionary mode, where every mutation should be done in place
+var keyCount = 5000;
+var rounds = 40;
+var keys = [];
+for (var i = 0; i < keyCount; i++) {
+    keys.push("key" + i);
+}
+
+var found = 0;
+var start = Date.now();
+for (var r = 0; r < rounds; r++) {
+    var map = {};
+    for (var i = 0; i < keyCount; i++) {
+        map[keys[i]] = i;
+    }
+    for (var i = 0; i < keyCount; i += 2) {
+        delete map[keys[i]];
+    }
+    for (var i = 1; i < keyCount; i += 50) {
+        Object.defineProperty(map, keys[i], { enumerable: false });
+    }
+    for (var i = 0; i < keyCount; i++) {
+        if (map[keys[i]] !== undefined) {
+            found++;
+        }
+        map[keys[(i * 7) % keyCount]] = r;
+    }
+}
+var elapsed = Date.now() - start;
+
+print("object-as-map: " + elapsed + " ms (" + rounds + " rounds of " + keyCount + " keys, check " + found + ")");
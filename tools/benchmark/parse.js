@@ -0,0 +1,18 @@
+// parse throughput of large inputs with many tokens and AST nodes per line: expressions, object and array literals, nested functions
+// run with BENCHMARK_RSS=1 tools/benchmark/run.sh to see peak RSS of parsing as well
+var parts = [];
+for (var i = 0; i < 3000; i++) {
+    parts.push("var record_" + i + " = { id: " + i + ", name: 'record " + i + "', tags: ['a', 'b', " + i + "], point: { x: " + i + " * 2 + 1, y: (" + i + " - 3) / 4 } };\n");
+    parts.push("function handler_" + i + "(event, options) { if (event.type === 'click' && options.enabled) { return record_" + i + ".point.x + event.x * (options.scale || 1); }"
+               + " return [event.x, event.y].map(function(v) { return v > 0 ? v : -v; }).reduce(function(a, b) { return a + b; }, 0); }\n");
+}
+var source = parts.join("");
+
+var iterations = 10;
+var start = Date.now();
+for (var i = 0; i < iterations; i++) {
+    Function(source);
+}
+var elapsed = Date.now() - start;
+
+print("parse: " + elapsed + " ms, " + (source.length * iterations / 1024 / 1024 / (elapsed / 1000)).toFixed(2) + " MB/s");
@@ -0,0 +1,50 @@
+// promise reaction throughput: long then chains, fan-out of reactions on one promise and rejections caught downstream
+var chains = 200;
+var links = 500;
+var fanOut = 100000;
+var settled = 0;
+var sum = 0;
+
+var start = Date.now();
+for (var i = 0; i < chains; i++) {
+    var p = Promise.resolve(0);
+    for (var j = 0; j < links; j++) {
+        p = p.then(function(v) {
+            return v + 1;
+        });
+    }
+    p.then(function(v) {
+        sum += v;
+        settled++;
+    });
+}
+
+var root = Promise.resolve(1);
+for (var i = 0; i < fanOut; i++) {
+    root.then(function(v) {
+        sum += v;
+    });
+}
+
+for (var i = 0; i < chains; i++) {
+    Promise.reject(i).then(function(v) {
+        return v;
+    }).catch(function(e) {
+        settled++;
+    });
+}
+
+// reactions run after this script, when the job queue is drained
+Promise.resolve().then(function() {
+    var check = function() {
+        if (settled < chains * 2) {
+            Promise.resolve().then(check);
+            return;
+        }
+        if (sum !== chains * links + fanOut) {
+            throw new Error("promise-chain: wrong result");
+        }
+        print("promise-chain: " + (Date.now() - start) + " ms for " + (chains * (links + 1) + fanOut + chains * 2) + " reactions");
+    };
+    check();
+});
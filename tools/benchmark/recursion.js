@@ -0,0 +1,28 @@
+// deep recursion of JS functions, crossing chunks of interpreter stack on the way down and back up
+function depth(n) {
+    if (n === 0) {
+        return 0;
+    }
+    return depth(n - 1) + 1;
+}
+
+function fib(n) {
+    return n < 2 ? n : fib(n - 1) + fib(n - 2);
+}
+
+var iterations = 200;
+var start = Date.now();
+var total = 0;
+for (var i = 0; i < iterations; i++) {
+    total += depth(5000);
+}
+var deepElapsed = Date.now() - start;
+
+start = Date.now();
+var fibResult = fib(27);
+var fibElapsed = Date.now() - start;
+
+if (total !== 5000 * iterations || fibResult !== 196418) {
+    throw new Error("recursion: wrong result");
+}
+print("recursion: depth 5000 x " + iterations + " " + deepElapsed + " ms, fib(27) " + fibElapsed + " ms");
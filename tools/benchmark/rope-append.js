@@ -0,0 +1,25 @@
+// string building: long s += x loops, which use append buffer, and short concatenations, which stay ropes
+var iterations = 20;
+var start = Date.now();
+var length = 0;
+for (var i = 0; i < iterations; i++) {
+    var s = "";
+    for (var j = 0; j < 100000; j++) {
+        s += "item" + j + ",";
+    }
+    length += s.length;
+}
+var appendElapsed = Date.now() - start;
+
+start = Date.now();
+var total = 0;
+for (var i = 0; i < 300000; i++) {
+    var t = "prefix of the string " + i + " and suffix of the string";
+    total += t.length;
+}
+var concatElapsed = Date.now() - start;
+
+if (length !== 988890 * iterations || total <= 0) {
+    throw new Error("rope-append: wrong result");
+}
+print("rope-append: s += x " + appendElapsed + " ms, short concatenation " + concatElapsed + " ms");
@@ -0,0 +1,28 @@
+#!/bin/bash
+
+# usage: tools/benchmark/run.sh <path to escargot> [benchmark name...]
+# runs micro benchmarks in this directory. every benchmark prints its own result line
+# BENCHMARK_RSS=1 prints peak RSS of each benchmark too (needs GNU time)
+# background-parse.sh is run separately because it loads many files
+if [[ -z "$1" ]]; then
+    echo "usage: $0 <path to escargot> [benchmark name...]"
+    exit 1
+fi
+
+cmd=$1
+shift
+BENCHMARK_BASE=`dirname $0`
+
+if [[ $# -eq 0 ]]; then
+    tests=`ls $BENCHMARK_BASE/*.js | xargs -n 1 basename | sed 's/\.js$//'`
+else
+    tests=$@
+fi
+
+for t in $tests; do
+    if [[ -n "$BENCHMARK_RSS" ]]; then
+        /usr/bin/time -f "$t: %M KB peak RSS" $cmd $BENCHMARK_BASE/$t.js || echo "$t: failed"
+    else
+        $cmd $BENCHMARK_BASE/$t.js || echo "$t: failed"
+    fi
+done
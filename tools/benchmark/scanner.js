@@ -0,0 +1,18 @@
+// throughput of scanner and pre-parser: comments, identifiers, string literals and function bodies
+var parts = [];
+for (var i = 0; i < 2000; i++) {
+    parts.push("// line comment number " + i + " with some words in it\n");
+    parts.push("/* block comment number " + i + "\n   spanning two lines */\n");
+    parts.push("var identifier_number_" + i + " = 'single quoted string " + i + "' + \"double quoted string\" + " + i + ";\n");
+    parts.push("function function_number_" + i + "(first, second) { var local = first + second * identifier_number_" + i + "; return local; }\n");
+}
+var source = parts.join("");
+
+var iterations = 20;
+var start = Date.now();
+for (var i = 0; i < iterations; i++) {
+    Function(source);
+}
+var elapsed = Date.now() - start;
+
+print("scanner: " + elapsed + " ms, " + (source.length * iterations / 1024 / 1024 / (elapsed / 1000)).toFixed(2) + " MB/s");
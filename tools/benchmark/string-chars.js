@@ -0,0 +1,50 @@
+// character access on primitive strings as hash functions and parsers do it:
+// charCodeAt, charAt and indexing on 8-bit and 16-bit flat strings
+function hash(s) {
+    var h = 0;
+    for (var i = 0; i < s.length; i++) {
+        h = (h * 31 + s.charCodeAt(i)) | 0;
+    }
+    return h;
+}
+
+function countDigits(s) {
+    var count = 0;
+    for (var i = 0; i < s.length; i++) {
+        var c = s.charAt(i);
+        if (c >= "0" && c <= "9") {
+            count++;
+        }
+    }
+    return count;
+}
+
+function countSpaces(s) {
+    var count = 0;
+    for (var i = 0; i < s.length; i++) {
+        if (s[i] === " ") {
+            count++;
+        }
+    }
+    return count;
+}
+
+var latin1 = "";
+var utf16 = "";
+for (var i = 0; i < 1000; i++) {
+    latin1 += "item " + i + ";";
+    utf16 += "\uAC00 " + i + ";";
+}
+
+var iterations = 200;
+var check = 0;
+var start = Date.now();
+for (var i = 0; i < iterations; i++) {
+    var s = (i & 1) ? utf16 : latin1;
+    check += hash(s) & 0xff;
+    check += countDigits(s);
+    check += countSpaces(s);
+}
+var elapsed = Date.now() - start;
+
+print("string-chars: " + elapsed + " ms (" + iterations * (latin1.length + utf16.length) / 2 * 3 + " reads, check " + check + ")");
@@ -0,0 +1,35 @@
+// objects built from many key orders, as JSON-derived objects are, so structures get wide transition fan-out.
+// --profile-allocation also prints structure counts and transition lookup depth
+var names = [];
+for (var i = 0; i < 40; i++) {
+    names.push("field" + i);
+}
+
+var iterations = 20000;
+var total = 0;
+var start = Date.now();
+for (var i = 0; i < iterations; i++) {
+    var o = {};
+    // first key picks one of 40 transitions from empty structure, and next keys fan out again
+    for (var k = 0; k < 8; k++) {
+        o[names[(i + k * (i % 7 + 1)) % names.length]] = k;
+    }
+    total += o[names[i % names.length]] === undefined ? 0 : 1;
+}
+var literalElapsed = Date.now() - start;
+
+var sources = [];
+for (var i = 0; i < 50; i++) {
+    var parts = [];
+    for (var k = 0; k < 6; k++) {
+        parts.push('"' + names[(i * 3 + k * 5) % names.length] + '":' + k);
+    }
+    sources.push("{" + parts.join(",") + "}");
+}
+start = Date.now();
+for (var i = 0; i < iterations; i++) {
+    total += Object.keys(JSON.parse(sources[i % sources.length])).length;
+}
+var jsonElapsed = Date.now() - start;
+
+print("structure-creation: " + literalElapsed + " ms by keys, " + jsonElapsed + " ms by JSON.parse (" + iterations + " objects each, check " + total + ")");
@@ -0,0 +1,32 @@
+// errors thrown from a few frames deep and caught, with error.stack read by the handler as logging does.
+// run with --keep-source-location-table too to compare with the table kept from first bytecode generation
+function fail(n) {
+    if (n === 0) {
+        throw new Error("failed");
+    }
+    return fail(n - 1) + 1;
+}
+
+function handle(n, readStack) {
+    try {
+        return fail(n);
+    } catch (e) {
+        return readStack ? e.stack.length : e.message.length;
+    }
+}
+
+var iterations = 20000;
+var length = 0;
+var start = Date.now();
+for (var i = 0; i < iterations; i++) {
+    length += handle(i % 10, false);
+}
+var plainElapsed = Date.now() - start;
+
+start = Date.now();
+for (var i = 0; i < iterations; i++) {
+    length += handle(i % 10, true);
+}
+var stackElapsed = Date.now() - start;
+
+print("throw-with-stack: " + iterations + " throws, " + plainElapsed + " ms without stack, " + stackElapsed + " ms with stack (check " + length + ")");